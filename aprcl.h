@@ -81,6 +81,9 @@ FLINT_DLL int aprcl_is_mul_coprime_ui_fmpz(ulong x, const fmpz_t y, const fmpz_t
 --------------------------------------------------------------------------------
 */
 
+/* returned by the primality tests when the computation is cancelled */
+#define APRCL_CANCELLED -1
+
 FLINT_DLL int aprcl_is_prime(const fmpz_t n);
 
 /* Gauss test configuration */
@@ -154,6 +154,7 @@ _aprcl_is_prime_gauss(const fmpz_t n, const aprcl_config config)
     int *lambdas;
     ulong i, j, k, nmod4;
     primality_test_status result;
+    int cancelled = 0;
 
     /* 
         Condition (Lp) is satisfied iff:
@@ -179,6 +180,14 @@ _aprcl_is_prime_gauss(const fmpz_t n, const aprcl_config config)
         ulong q;
         if (result == COMPOSITE) break;
 
+        /* cancelled: neither prime nor composite proved */
+        if (flint_cancelled())
+        {
+            result = UNKNOWN;
+            cancelled = 1;
+            break;
+        }
+
         q = fmpz_get_ui(config->qs->p + i);
 
         /* n == q, q - prime => n - prime */
@@ -329,7 +338,7 @@ _aprcl_is_prime_gauss(const fmpz_t n, const aprcl_config config)
 
   
     /* if n can be prime we do final division */
-    if (result == UNKNOWN || result == PROBABPRIME)
+    if (!cancelled && (result == UNKNOWN || result == PROBABPRIME))
     {
         int f_division;
         f_division = aprcl_is_prime_final_division(n, config->s, config->R);
@@ -363,6 +372,9 @@ aprcl_is_prime_gauss_min_R(const fmpz_t n, ulong R)
 
     aprcl_config_gauss_clear(config);
 
+    if (result == UNKNOWN && flint_cancelled())
+        return APRCL_CANCELLED;
+
     if (result == PRIME)
         return 1;
     return 0;
@@ -412,6 +424,9 @@ aprcl_is_prime_gauss(const fmpz_t n)
         aprcl_config_gauss_clear(config);
     }
 
+    if (result == UNKNOWN && flint_cancelled())
+        return APRCL_CANCELLED;
+
     if (result == PROBABPRIME || result == UNKNOWN)
     {
         flint_printf("aprcl_is_prime_gauss: failed to prove n prime\n");
@@ -613,6 +613,13 @@ _aprcl_is_prime_jacobi(const fmpz_t n, const aprcl_config config)
         if (result == COMPOSITE)
             break;
 
+        /* cancelled: neither prime nor composite proved */
+        if (flint_cancelled())
+        {
+            result = UNKNOWN;
+            break;
+        }
+
         q = fmpz_get_ui(config->qs->p + i); /* set q; q must get into ulong */
 
         /* if n == q; q - prime => n - prime */
@@ -825,6 +832,9 @@ aprcl_is_prime_jacobi(const fmpz_t n)
 
     aprcl_config_jacobi_clear(config);
 
+    if (result == UNKNOWN && flint_cancelled())
+        return APRCL_CANCELLED;
+
     if (result == PROBABPRIME || result == UNKNOWN)
     {
         flint_printf("aprcl_is_prime_jacobi: failed to prove n prime\n");
@@ -41,8 +41,18 @@ void flint_set_abort(FLINT_NORETURN void (*func)(void))
 #endif
 }
 
+FLINT_TLS_PREFIX FLINT_NORETURN void (*thread_abort_func)(void) = NULL;
+
+void flint_set_thread_abort(FLINT_NORETURN void (*func)(void))
+{
+    thread_abort_func = func;
+}
+
 FLINT_NORETURN void flint_abort()
 {
+    if (thread_abort_func != NULL)
+        (*thread_abort_func)();
+
     (*abort_func)();
 }
 
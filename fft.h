@@ -259,6 +259,9 @@ FLINT_DLL slong fft_adjust_limbs(mp_size_t limbs);
 FLINT_DLL void fft_mulmod_2expp1(mp_limb_t * r, mp_limb_t * i1, mp_limb_t * i2, 
                                         mp_size_t n, mp_size_t w, mp_limb_t * tt);
 
+FLINT_DLL int _flint_mpn_mul_fft_params(flint_bitcnt_t * depth,
+                            flint_bitcnt_t * w, mp_size_t n1, mp_size_t n2);
+
 FLINT_DLL void flint_mpn_mul_fft_main(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
                         mp_srcptr i2, mp_size_t n2);
 
@@ -279,6 +282,29 @@ FLINT_DLL void fft_convolution_precache(mp_limb_t ** ii, mp_limb_t ** jj,
                slong depth, slong limbs, slong trunc, mp_limb_t ** t1,
 	                    mp_limb_t ** t2, mp_limb_t ** s1, mp_limb_t ** tt);
 
+typedef struct
+{
+   mp_size_t n1;        /* maximum length of the other operand */
+   mp_size_t n2;
+   flint_bitcnt_t depth;
+   flint_bitcnt_t w;
+   flint_bitcnt_t bits;  /* bits per FFT coefficient */
+   mp_size_t j2;        /* number of FFT coefficients of the operand */
+   slong trunc;
+   mp_limb_t ** jj;     /* transformed operand, NULL if not used */
+   mp_ptr i2;           /* copy of the operand */
+} fft_mul_precache_struct;
+
+typedef fft_mul_precache_struct fft_mul_precache_t[1];
+
+FLINT_DLL void flint_mpn_mul_fft_precache_init(fft_mul_precache_t pre,
+                              mp_srcptr i2, mp_size_t n2, mp_size_t n1);
+
+FLINT_DLL void flint_mpn_mul_fft_precache_clear(fft_mul_precache_t pre);
+
+FLINT_DLL void flint_mpn_mul_fft_precache(mp_ptr r1, mp_srcptr i1,
+                                  mp_size_t n1, const fft_mul_precache_t pre);
+
 #ifdef __cplusplus
 }
 #endif
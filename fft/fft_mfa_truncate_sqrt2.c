@@ -13,6 +13,7 @@
 #include "flint.h"
 #include "ulong_extras.h"
 #include "fft.h"
+#include "thread_support.h"
       
 void fft_butterfly_twiddle(mp_limb_t * u, mp_limb_t * v, 
     mp_limb_t * s, mp_limb_t * t, mp_size_t limbs, flint_bitcnt_t b1, flint_bitcnt_t b2)
@@ -379,8 +380,7 @@ void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n,
 #if FLINT_USES_PTHREAD
     pthread_mutex_t mutex;
 #endif
-    slong num_threads;
-    thread_pool_handle * threads;
+    slong num_workers;
     fft_outer_arg_t * args;
 
     while ((UWORD(1)<<depth) < n2) depth++;
@@ -393,13 +393,13 @@ void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n,
    
     /* FFTs on columns */
 
-    num_threads = flint_request_threads(&threads,
-                             FLINT_MIN(flint_get_num_threads(), (n1 + 15)/16));
+    num_workers = FLINT_MIN(flint_get_num_threads(), (n1 + 15)/16);
+    num_workers = FLINT_MAX(num_workers, 1);
 
     args = (fft_outer_arg_t *)
-                       flint_malloc(sizeof(fft_outer_arg_t)*(num_threads + 1));
+                       flint_malloc(sizeof(fft_outer_arg_t)*num_workers);
 
-    for (i = 0; i < num_threads + 1; i++)
+    for (i = 0; i < num_workers; i++)
     {
        args[i].i = &shared_i;
        args[i].n1 = n1;
@@ -418,14 +418,8 @@ void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n,
 #endif
     }
 
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wake(global_thread_pool, threads[i], 0,
-                                                 _fft_outer1_worker, &args[i]);
-
-    _fft_outer1_worker(&args[num_threads]);
-
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wait(global_thread_pool, threads[i]);
+    flint_run_task_array(_fft_outer1_worker, args,
+                                                  sizeof(args[0]), num_workers);
 
     /* second half matrix fourier FFT : n2 rows, n1 cols */
     ii += 2*n;
@@ -435,22 +429,14 @@ void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n,
     shared_i = 0;
 
     
-    for (i = 0; i < num_threads + 1; i++)
+    for (i = 0; i < num_workers; i++)
     {
        args[i].trunc = trunc2;
        args[i].ii = ii;
     }
 
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wake(global_thread_pool, threads[i], 0,
-                                                 _fft_outer2_worker, &args[i]);
-
-    _fft_outer2_worker(&args[num_threads]);
-
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wait(global_thread_pool, threads[i]);
-
-    flint_give_back_threads(threads, num_threads);
+    flint_run_task_array(_fft_outer2_worker, args,
+                                                  sizeof(args[0]), num_workers);
 
     flint_free(args);
 
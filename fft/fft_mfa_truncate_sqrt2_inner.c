@@ -13,6 +13,7 @@
 #include "flint.h"
 #include "ulong_extras.h"
 #include "fft.h"
+#include "thread_support.h"
 
 typedef struct
 {
@@ -146,8 +147,7 @@ void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n,
 #if FLINT_USES_PTHREAD
     pthread_mutex_t mutex;
 #endif
-    slong num_threads;
-    thread_pool_handle * threads;
+    slong num_workers;
     fft_inner_arg_t * args;
 
     while ((UWORD(1)<<depth) < n2) depth++;
@@ -161,13 +161,13 @@ void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n,
 
    /* convolutions on relevant rows */
 
-    num_threads = flint_request_threads(&threads,
-                             FLINT_MIN(flint_get_num_threads(), (trunc2 + 15)/16));
+    num_workers = FLINT_MIN(flint_get_num_threads(), (trunc2 + 15)/16);
+    num_workers = FLINT_MAX(num_workers, 1);
 
     args = (fft_inner_arg_t *)
-                       flint_malloc(sizeof(fft_inner_arg_t)*(num_threads + 1));
+                       flint_malloc(sizeof(fft_inner_arg_t)*num_workers);
 
-    for (i = 0; i < num_threads + 1; i++)
+    for (i = 0; i < num_workers; i++)
     {
        args[i].i = &shared_i;
        args[i].n1 = n1;
@@ -187,14 +187,8 @@ void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n,
 #endif
     }
 
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wake(global_thread_pool, threads[i], 0,
-                                                 _fft_inner1_worker, &args[i]);
-
-    _fft_inner1_worker(&args[num_threads]);
-
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wait(global_thread_pool, threads[i]);
+    flint_run_task_array(_fft_inner1_worker, args,
+                                                  sizeof(args[0]), num_workers);
 
     ii -= 2*n;
     jj -= 2*n;
@@ -203,22 +197,14 @@ void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n,
 
     shared_i = 0;
 
-    for (i = 0; i < num_threads + 1; i++)
+    for (i = 0; i < num_workers; i++)
     {
        args[i].ii = ii;
        args[i].jj = jj;
     }
 
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wake(global_thread_pool, threads[i], 0,
-                                                 _fft_inner2_worker, &args[i]);
-
-    _fft_inner2_worker(&args[num_threads]);
-
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wait(global_thread_pool, threads[i]);
-
-    flint_give_back_threads(threads, num_threads);
+    flint_run_task_array(_fft_inner2_worker, args,
+                                                  sizeof(args[0]), num_workers);
 
     flint_free(args);
 
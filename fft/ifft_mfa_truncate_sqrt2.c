@@ -13,6 +13,7 @@
 #include "flint.h"
 #include "ulong_extras.h"
 #include "fft.h"
+#include "thread_support.h"
 
 void ifft_butterfly_twiddle(mp_limb_t * u, mp_limb_t * v, 
    mp_limb_t * s, mp_limb_t * t, mp_size_t limbs, flint_bitcnt_t b1, flint_bitcnt_t b2)
@@ -427,8 +428,7 @@ void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, flint_bitcnt_t
 #if FLINT_USES_PTHREAD
     pthread_mutex_t mutex;
 #endif
-    slong num_threads;
-    thread_pool_handle * threads;
+    slong num_workers;
     ifft_outer_arg_t * args;
   
     while ((UWORD(1)<<depth) < n2) depth++;
@@ -442,13 +442,13 @@ void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, flint_bitcnt_t
    
    /* column IFFTs */
 
-    num_threads = flint_request_threads(&threads,
-                             FLINT_MIN(flint_get_num_threads(), (n1 + 15)/16));
+    num_workers = FLINT_MIN(flint_get_num_threads(), (n1 + 15)/16);
+    num_workers = FLINT_MAX(num_workers, 1);
 
     args = (ifft_outer_arg_t *)
-                      flint_malloc(sizeof(ifft_outer_arg_t)*(num_threads + 1));
+                      flint_malloc(sizeof(ifft_outer_arg_t)*num_workers);
 
-    for (i = 0; i < num_threads + 1; i++)
+    for (i = 0; i < num_workers; i++)
     {
        args[i].i = &shared_i;
        args[i].n1 = n1;
@@ -469,14 +469,8 @@ void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, flint_bitcnt_t
 #endif
     }
 
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wake(global_thread_pool, threads[i], 0,
-                                                _ifft_outer1_worker, &args[i]);
-
-    _ifft_outer1_worker(&args[num_threads]);
-
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wait(global_thread_pool, threads[i]);
+    flint_run_task_array(_ifft_outer1_worker, args,
+                                                  sizeof(args[0]), num_workers);
    
     /* second half IFFT : n2 rows, n1 cols */
     ii += 2*n;
@@ -485,21 +479,13 @@ void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, flint_bitcnt_t
 
     shared_i = 0;
 
-    for (i = 0; i < num_threads + 1; i++)
+    for (i = 0; i < num_workers; i++)
     {
        args[i].ii = ii;
     }
 
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wake(global_thread_pool, threads[i], 0,
-                                                _ifft_outer2_worker, &args[i]);
-
-    _ifft_outer2_worker(&args[num_threads]);
-
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wait(global_thread_pool, threads[i]);
-
-    flint_give_back_threads(threads, num_threads);
+    flint_run_task_array(_ifft_outer2_worker, args,
+                                                  sizeof(args[0]), num_workers);
 
     flint_free(args);
 
@@ -0,0 +1,127 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "gmp.h"
+#include "flint.h"
+#include "fft.h"
+#include "mpn_extras.h"
+
+void flint_mpn_mul_fft_precache_init(fft_mul_precache_t pre,
+                                  mp_srcptr i2, mp_size_t n2, mp_size_t n1)
+{
+   mp_size_t i, j, n, limbs, size, j1;
+   mp_limb_t ** t1, ** t2, ** s1, * ptr;
+
+   pre->n1 = n1;
+   pre->n2 = n2;
+   pre->i2 = flint_malloc(n2*sizeof(mp_limb_t));
+   flint_mpn_copyi(pre->i2, i2, n2);
+
+   /* too small for the FFT: flint_mpn_mul_fft_main needs more than 128
+      coefficients of 28 bits */
+   if ((n1*FLINT_BITS - 1)/28 + (n2*FLINT_BITS - 1)/28 + 1 <= 128)
+   {
+      pre->jj = NULL;
+      return;
+   }
+
+   _flint_mpn_mul_fft_params(&pre->depth, &pre->w, n1, n2);
+
+   n = (WORD(1) << pre->depth);
+   pre->bits = (n*pre->w - (pre->depth + 1))/2;
+   limbs = (n*pre->w)/FLINT_BITS;
+   size = limbs + 1;
+
+   j1 = (n1*FLINT_BITS - 1)/pre->bits + 1;
+   pre->j2 = (n2*FLINT_BITS - 1)/pre->bits + 1;
+
+   pre->trunc = j1 + pre->j2 - 1;
+   if (pre->trunc <= 2*n) pre->trunc = 2*n + 1; /* trunc must exceed 2n */
+
+   /*
+      the transforms are serial and swap pointers with the temporaries, so
+      one set of these is needed and it must live as long as jj
+   */
+   pre->jj = (mp_limb_t **) flint_malloc((4*(n + n*size) + 3*size + 3)
+                                                        *sizeof(mp_limb_t));
+   for (i = 0, ptr = (mp_limb_t *) pre->jj + 4*n; i < 4*n; i++, ptr += size)
+      pre->jj[i] = ptr;
+   t1 = (mp_limb_t **) ptr;
+   t2 = t1 + 1;
+   s1 = t2 + 1;
+   ptr += 3;
+
+   t1[0] = ptr;
+   t2[0] = t1[0] + size;
+   s1[0] = t2[0] + size;
+
+   pre->j2 = fft_split_bits(pre->jj, i2, n2, pre->bits, limbs);
+   for (j = pre->j2; j < 4*n; j++)
+      flint_mpn_zero(pre->jj[j], size);
+
+   fft_precache(pre->jj, pre->depth, limbs, pre->trunc, t1, t2, s1);
+}
+
+void flint_mpn_mul_fft_precache_clear(fft_mul_precache_t pre)
+{
+   if (pre->jj != NULL)
+      flint_free(pre->jj);
+
+   flint_free(pre->i2);
+}
+
+void flint_mpn_mul_fft_precache(mp_ptr r1, mp_srcptr i1, mp_size_t n1,
+                                                const fft_mul_precache_t pre)
+{
+   mp_size_t i, j, j1, n, limbs, size, n2 = pre->n2;
+   mp_limb_t ** ii, ** t1, ** t2, ** s1, ** tt, * ptr;
+
+   if (pre->jj == NULL || n1 > pre->n1)
+   {
+      if (n1 >= n2)
+         mpn_mul(r1, i1, n1, pre->i2, n2);
+      else
+         mpn_mul(r1, pre->i2, n2, i1, n1);
+
+      return;
+   }
+
+   n = (WORD(1) << pre->depth);
+   limbs = (n*pre->w)/FLINT_BITS;
+   size = limbs + 1;
+
+   ii = (mp_limb_t **) flint_malloc((4*(n + n*size) + 5*size + 4)
+                                                        *sizeof(mp_limb_t));
+   for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size)
+      ii[i] = ptr;
+   t1 = (mp_limb_t **) ptr;
+   t2 = t1 + 1;
+   s1 = t2 + 1;
+   tt = s1 + 1;
+   ptr += 4;
+
+   t1[0] = ptr;
+   t2[0] = t1[0] + size;
+   s1[0] = t2[0] + size;
+   tt[0] = s1[0] + size;
+
+   j1 = fft_split_bits(ii, i1, n1, pre->bits, limbs);
+   for (j = j1; j < 4*n; j++)
+      flint_mpn_zero(ii[j], size);
+
+   fft_convolution_precache(ii, pre->jj, pre->depth, limbs, pre->trunc,
+                                                          t1, t2, s1, tt);
+
+   flint_mpn_zero(r1, n1 + n2);
+   fft_combine_bits(r1, ii, j1 + pre->j2 - 1, pre->bits, limbs, n1 + n2);
+
+   flint_free(ii);
+}
@@ -72,21 +72,20 @@ mp_size_t fft_split_limbs(mp_limb_t ** poly, mp_srcptr limbs,
 #if FLINT_USES_PTHREAD
     pthread_mutex_t mutex;
 #endif
-    slong num_threads;
-    thread_pool_handle * threads;
+    slong num_workers;
     split_limbs_arg_t * args;
     
 #if FLINT_USES_PTHREAD
     pthread_mutex_init(&mutex, NULL);
 #endif
 
-    num_threads = flint_request_threads(&threads,
-                            FLINT_MIN(flint_get_num_threads(), (num + 15)/16));
+    num_workers = FLINT_MIN(flint_get_num_threads(), (num + 15)/16);
+    num_workers = FLINT_MAX(num_workers, 1);
 
     args = (split_limbs_arg_t *)
-                     flint_malloc(sizeof(split_limbs_arg_t)*(num_threads + 1));
+                     flint_malloc(sizeof(split_limbs_arg_t)*num_workers);
 
-    for (i = 0; i < num_threads + 1; i++)
+    for (i = 0; i < num_workers; i++)
     {
        args[i].i = &shared_i;
        args[i].num = num;
@@ -99,16 +98,8 @@ mp_size_t fft_split_limbs(mp_limb_t ** poly, mp_srcptr limbs,
 #endif
     }
 
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wake(global_thread_pool, threads[i], 0,
-                                                _split_limbs_worker, &args[i]);
-
-    _split_limbs_worker(&args[num_threads]);
-
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wait(global_thread_pool, threads[i]);
-
-    flint_give_back_threads(threads, num_threads);
+    flint_run_task_array(_split_limbs_worker, args,
+                                                  sizeof(args[0]), num_workers);
 
     flint_free(args);
 
@@ -217,8 +208,7 @@ mp_size_t fft_split_bits(mp_limb_t ** poly, mp_srcptr limbs,
 #if FLINT_USES_PTHREAD
     pthread_mutex_t mutex;
 #endif
-    slong num_threads;
-    thread_pool_handle * threads;
+    slong num_workers;
     split_bits_arg_t * args;
    
     if (top_bits == 0)
@@ -233,13 +223,13 @@ mp_size_t fft_split_bits(mp_limb_t ** poly, mp_srcptr limbs,
     pthread_mutex_init(&mutex, NULL);
 #endif
 
-    num_threads = flint_request_threads(&threads,
-                     FLINT_MIN(flint_get_num_threads(), (length - 1 + 15)/16));
+    num_workers = FLINT_MIN(flint_get_num_threads(), (length - 1 + 15)/16);
+    num_workers = FLINT_MAX(num_workers, 1);
 
     args = (split_bits_arg_t *)
-                      flint_malloc(sizeof(split_bits_arg_t)*(num_threads + 1));
+                      flint_malloc(sizeof(split_bits_arg_t)*num_workers);
 
-    for (i = 0; i < num_threads + 1; i++)
+    for (i = 0; i < num_workers; i++)
     {
        args[i].i = &shared_i;
        args[i].length = length;
@@ -254,16 +244,8 @@ mp_size_t fft_split_bits(mp_limb_t ** poly, mp_srcptr limbs,
 #endif
     }
 
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wake(global_thread_pool, threads[i], 0,
-                                                 _split_bits_worker, &args[i]);
-
-    _split_bits_worker(&args[num_threads]);
-
-    for (i = 0; i < num_threads; i++)
-        thread_pool_wait(global_thread_pool, threads[i]);
-
-    flint_give_back_threads(threads, num_threads);
+    flint_run_task_array(_split_bits_worker, args,
+                                                  sizeof(args[0]), num_workers);
 
     flint_free(args);
 
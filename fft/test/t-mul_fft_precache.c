@@ -0,0 +1,99 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fft.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    slong i, k;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_fft_precache....");
+    fflush(stdout);
+
+    _flint_rand_init_gmp(state);
+
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        mp_size_t n1, n2, n1max, j;
+        mp_limb_t * i1, * i2, * r1, * r2;
+        fft_mul_precache_t pre;
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        n2 = n_randint(state, 1 + (UWORD(1) << n_randint(state, 15))) + 1;
+        n1max = n_randint(state, 1 + (UWORD(1) << n_randint(state, 15))) + 1;
+
+        i2 = flint_malloc(n2*sizeof(mp_limb_t));
+        flint_mpn_urandomb(i2, state->gmp_state, n2*FLINT_BITS);
+
+        flint_mpn_mul_fft_precache_init(pre, i2, n2, n1max);
+
+        /* the operand may be modified once the precache is set up */
+        flint_mpn_zero(i2, n2);
+        flint_free(i2);
+
+        for (k = 0; k < 4; k++)
+        {
+            if (k == 3)
+                n1 = n1max + n_randint(state, 100) + 1;
+            else
+                n1 = n_randint(state, n1max) + 1;
+
+            i1 = flint_malloc(3*(n1 + n2)*sizeof(mp_limb_t));
+            r1 = i1 + n1;
+            r2 = r1 + n1 + n2;
+
+            flint_mpn_urandomb(i1, state->gmp_state, n1*FLINT_BITS);
+            if (n_randint(state, 2))
+                flint_mpn_urandomb(i1, state->gmp_state,
+                                         n_randint(state, n1*FLINT_BITS) + 1);
+
+            if (n1 >= n2)
+                mpn_mul(r2, i1, n1, pre->i2, n2);
+            else
+                mpn_mul(r2, pre->i2, n2, i1, n1);
+
+            flint_mpn_mul_fft_precache(r1, i1, n1, pre);
+
+            for (j = 0; j < n1 + n2; j++)
+            {
+                if (r1[j] != r2[j])
+                {
+                    flint_printf("FAIL:\n");
+                    flint_printf("n1 = %wd, n2 = %wd, n1max = %wd\n",
+                                                            n1, n2, n1max);
+                    flint_printf("error in limb %wd, %wx != %wx\n",
+                                                          j, r1[j], r2[j]);
+                    abort();
+                }
+            }
+
+            flint_free(i1);
+        }
+
+        flint_mpn_mul_fft_precache_clear(pre);
+    }
+
+    flint_set_num_threads(1);
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
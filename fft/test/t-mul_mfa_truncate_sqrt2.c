@@ -15,6 +15,22 @@
 #include "flint.h"
 #include "ulong_extras.h"
 #include "fft.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    mp_limb_t * r, * i1, * i2;
+    mp_size_t limbs;
+    flint_bitcnt_t depth, w;
+} _mul_arg_struct;
+
+static void _mul_task(void * varg)
+{
+    _mul_arg_struct * arg = (_mul_arg_struct *) varg;
+
+    mul_mfa_truncate_sqrt2(arg->r, arg->i1, arg->limbs, arg->i2, arg->limbs,
+                                                         arg->depth, arg->w);
+}
 
 int
 main(void)
@@ -100,6 +116,61 @@ main(void)
         }
     }
 
+    /* several products nested inside tasks, sharing the scheduler */
+    for (depth = 8; depth <= 11; depth++)
+    {
+        _mul_arg_struct args[4];
+        mp_size_t n = (UWORD(1)<<depth);
+        flint_bitcnt_t bits1, bits;
+        mp_size_t trunc, int_limbs, j;
+        mp_limb_t * r2;
+        slong k;
+
+        w = n_randint(state, 2) + 1;
+        bits1 = (n*w - (depth + 1))/2;
+        trunc = 2*n + 2*n_randint(state, n) + 2;
+        bits = (trunc/2)*bits1;
+        int_limbs = (bits - 1)/FLINT_BITS + 1;
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        for (k = 0; k < 4; k++)
+        {
+            args[k].i1 = flint_malloc(4*int_limbs*sizeof(mp_limb_t));
+            args[k].i2 = args[k].i1 + int_limbs;
+            args[k].r = args[k].i2 + int_limbs;
+            args[k].limbs = int_limbs;
+            args[k].depth = depth;
+            args[k].w = w;
+
+            random_fermat(args[k].i1, state, int_limbs);
+            random_fermat(args[k].i2, state, int_limbs);
+        }
+
+        flint_run_task_array(_mul_task, args, sizeof(_mul_arg_struct), 4);
+
+        r2 = flint_malloc(2*int_limbs*sizeof(mp_limb_t));
+
+        for (k = 0; k < 4; k++)
+        {
+            mpn_mul(r2, args[k].i1, int_limbs, args[k].i2, int_limbs);
+
+            for (j = 0; j < 2*int_limbs; j++)
+            {
+                if (args[k].r[j] != r2[j])
+                {
+                    flint_printf("error in nested product %wd, limb %wd, %wx != %wx\n",
+                                                       k, j, args[k].r[j], r2[j]);
+                    abort();
+                }
+            }
+
+            flint_free(args[k].i1);
+        }
+
+        flint_free(r2);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
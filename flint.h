@@ -101,6 +101,34 @@ FLINT_DLL void __flint_set_memory_functions(void *(*alloc_func) (size_t),
      void *(*calloc_func) (size_t, size_t), void *(*realloc_func) (void *, size_t),
                                                               void (*free_func) (void *));
 
+typedef struct
+{
+    ulong allocs;
+    ulong reallocs;
+    ulong frees;
+    slong live;     /* bytes currently allocated */
+    slong peak;     /* maximum of live since the last reset */
+    ulong total;    /* bytes requested */
+} flint_memory_stats_struct;
+
+typedef flint_memory_stats_struct flint_memory_stats_t[1];
+
+FLINT_DLL void flint_memory_stats_enable(int enable);
+FLINT_DLL int flint_memory_stats_enabled(void);
+FLINT_DLL void flint_memory_stats_get(flint_memory_stats_t stats);
+FLINT_DLL void flint_memory_stats_get_total(flint_memory_stats_t stats);
+FLINT_DLL void flint_memory_stats_reset(void);
+FLINT_DLL slong flint_memory_stats_module(const char * name);
+FLINT_DLL slong flint_memory_stats_set_module(slong module);
+FLINT_DLL void flint_memory_stats_get_module(flint_memory_stats_t stats,
+                                                                slong module);
+FLINT_DLL void flint_memory_stats_reset_module(slong module);
+FLINT_DLL slong _flint_memory_stats_enter(const char * name);
+FLINT_DLL slong _flint_memory_stats_current_module(void);
+
+FLINT_DLL void flint_set_memory_limit(slong bytes);
+FLINT_DLL slong flint_get_memory_limit(void);
+
 #ifdef __GNUC__
 #define FLINT_NORETURN __attribute__ ((noreturn))
 #else
@@ -114,6 +142,9 @@ FLINT_DLL void flint_set_abort(FLINT_NORETURN void (*func)(void));
    * is called. EXPERIMENTALLY use at your own risk!
    * May disappear in future versions.
    */
+FLINT_DLL void flint_set_thread_abort(FLINT_NORETURN void (*func)(void));
+  /* as flint_set_abort, for the calling thread only; NULL restores the
+   * function set by flint_set_abort */
 
 
 #if defined(_WIN64) || defined(__mips64)
@@ -178,6 +209,22 @@ FLINT_DLL void flint_reset_num_workers(int max_workers);
 FLINT_DLL int flint_set_thread_affinity(int * cpus, slong length);
 FLINT_DLL int flint_restore_thread_affinity();
 
+typedef struct
+{
+    volatile int cancelled;
+    double deadline;    /* seconds since the epoch, 0 for none */
+} flint_cancel_struct;
+
+typedef flint_cancel_struct flint_cancel_t[1];
+
+FLINT_DLL void flint_cancel_init(flint_cancel_t C);
+FLINT_DLL void flint_cancel_clear(flint_cancel_t C);
+FLINT_DLL void flint_cancel_request(flint_cancel_t C);
+FLINT_DLL void flint_cancel_set_timeout(flint_cancel_t C, double seconds);
+FLINT_DLL int flint_cancel_is_requested(flint_cancel_t C);
+FLINT_DLL flint_cancel_struct * flint_set_cancel(flint_cancel_struct * C);
+FLINT_DLL int flint_cancelled(void);
+
 int flint_test_multiplier(void);
 
 typedef struct
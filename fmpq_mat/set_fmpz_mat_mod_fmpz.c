@@ -10,11 +10,33 @@
 */
 
 #include "fmpq_mat.h"
+#include "thread_support.h"
 
-int
-fmpq_mat_set_fmpz_mat_mod_fmpz(fmpq_mat_t X,
-                                    const fmpz_mat_t Xmod, const fmpz_t mod)
+/* entries before the reconstruction is split into tasks */
+#define RECONSTRUCT_TASK_CUTOFF 1024
+
+typedef struct
 {
+    fmpq_mat_struct * X;
+    const fmpz_mat_struct * Xmod;
+    const fmpz * mod;
+    slong start, stop;
+    int success;
+} _reconstruct_arg_struct;
+
+typedef struct
+{
+    _reconstruct_arg_struct * args;
+    slong num;
+} _reconstruct_tasks_struct;
+
+/* reconstruct rows start to stop, with their own running denominator */
+static void _reconstruct_worker(void * varg)
+{
+    _reconstruct_arg_struct * arg = (_reconstruct_arg_struct *) varg;
+    fmpq_mat_struct * X = arg->X;
+    const fmpz_mat_struct * Xmod = arg->Xmod;
+    const fmpz * mod = arg->mod;
     fmpz_t num, den, t, u, d;
     slong i, j;
 
@@ -28,7 +50,7 @@ fmpq_mat_set_fmpz_mat_mod_fmpz(fmpq_mat_t X,
 
     fmpz_one(d);
 
-    for (i = 0; i < Xmod->r; i++)
+    for (i = arg->start; i < arg->stop; i++)
     {
         for (j = 0; j < Xmod->c; j++)
         {
@@ -40,9 +62,9 @@ fmpq_mat_set_fmpz_mat_mod_fmpz(fmpq_mat_t X,
             success = _fmpq_reconstruct_fmpz(num, den, t, mod);
 
             if (!success)
-	       goto cleanup;
+                goto cleanup;
 
-	    fmpz_mul(den, den, d);
+            fmpz_mul(den, den, d);
             fmpz_set(d, den);
 
             fmpz_set(fmpq_mat_entry_num(X, i, j), num);
@@ -58,5 +80,66 @@ cleanup:
     fmpz_clear(t);
     fmpz_clear(u);
 
+    arg->success = success;
+}
+
+static void _reconstruct_spawn(void * varg)
+{
+    _reconstruct_tasks_struct * T = (_reconstruct_tasks_struct *) varg;
+    thread_pool_task_group_t G;
+    slong j;
+
+    thread_pool_task_group_init(G);
+
+    for (j = 0; j + 1 < T->num; j++)
+        thread_pool_spawn(G, _reconstruct_worker, T->args + j);
+    _reconstruct_worker(T->args + T->num - 1);
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+}
+
+int
+fmpq_mat_set_fmpz_mat_mod_fmpz(fmpq_mat_t X,
+                                    const fmpz_mat_t Xmod, const fmpz_t mod)
+{
+    _reconstruct_arg_struct arg;
+    _reconstruct_tasks_struct T;
+    slong j, num, r = Xmod->r, threads = flint_get_num_threads();
+    int success;
+
+    arg.X = X;
+    arg.Xmod = Xmod;
+    arg.mod = mod;
+
+    num = (threads > 1 && r*Xmod->c >= RECONSTRUCT_TASK_CUTOFF) ?
+                                              FLINT_MIN(r, 4*threads) : 1;
+
+    if (num <= 1)
+    {
+        arg.start = 0;
+        arg.stop = r;
+        _reconstruct_worker(&arg);
+        return arg.success;
+    }
+
+    T.num = num;
+    T.args = flint_malloc(num*sizeof(_reconstruct_arg_struct));
+
+    for (j = 0; j < num; j++)
+    {
+        T.args[j] = arg;
+        T.args[j].start = j*r/num;
+        T.args[j].stop = (j + 1)*r/num;
+    }
+
+    flint_run_tasks(_reconstruct_spawn, &T, threads);
+
+    success = 1;
+    for (j = 0; j < num; j++)
+        success = success && T.args[j].success;
+
+    flint_free(T.args);
+
     return success;
 }
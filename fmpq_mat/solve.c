@@ -16,7 +16,7 @@ fmpq_mat_solve_fmpz_mat(fmpq_mat_t X, const fmpz_mat_t A, const fmpz_mat_t B)
 {
     if (fmpz_mat_nrows(A) <= 15)
         return fmpq_mat_solve_fmpz_mat_fraction_free(X, A, B);
-    else if (fmpz_mat_ncols(B) == 1)
+    else if (fmpz_mat_ncols(B) < fmpz_mat_nrows(A))
     	return fmpq_mat_solve_fmpz_mat_dixon(X, A, B);
     else
         return fmpq_mat_solve_fmpz_mat_multi_mod(X, A, B);
@@ -27,7 +27,7 @@ fmpq_mat_solve(fmpq_mat_t X, const fmpq_mat_t A, const fmpq_mat_t B)
 {
     if (fmpq_mat_nrows(A) <= 15)
         return fmpq_mat_solve_fraction_free(X, A, B);
-    else if (fmpq_mat_ncols(B) == 1)
+    else if (fmpq_mat_ncols(B) < fmpq_mat_nrows(A))
     	return fmpq_mat_solve_dixon(X, A, B);
     else
         return fmpq_mat_solve_multi_mod(X, A, B);
@@ -81,6 +81,39 @@ FLINT_DLL void _fmpz_cleanup_mpz_content(void);
 
 FLINT_DLL void _fmpz_cleanup(void);
 
+/* arena allocation of limbs *************************************************/
+
+typedef struct
+{
+    void * block;       /* most recent block, linked to the earlier ones */
+    size_t block_size;  /* size of the first block */
+    void * prev;        /* arena which was current when this one was entered */
+    int active;
+    int hooked;         /* counted among the arenas using the GMP hooks */
+} fmpz_arena_struct;
+
+typedef fmpz_arena_struct fmpz_arena_t[1];
+
+FLINT_DLL extern volatile slong _fmpz_arena_num_blocks;
+
+FLINT_DLL void fmpz_arena_init(fmpz_arena_t A, size_t size);
+
+FLINT_DLL void fmpz_arena_clear(fmpz_arena_t A);
+
+FLINT_DLL void fmpz_arena_enter(fmpz_arena_t A);
+
+FLINT_DLL void fmpz_arena_leave(fmpz_arena_t A);
+
+FLINT_DLL void fmpz_arena_reset(fmpz_arena_t A);
+
+FLINT_DLL size_t fmpz_arena_used(const fmpz_arena_t A);
+
+FLINT_DLL fmpz_arena_struct * _fmpz_arena_owner(const void * ptr);
+
+FLINT_DLL void _fmpz_arena_evict(__mpz_struct * z, const fmpz_arena_struct * A);
+
+FLINT_DLL void _fmpz_cleanup_mpz_arena(const fmpz_arena_struct * A);
+
 FLINT_DLL __mpz_struct * _fmpz_promote(fmpz_t f);
 
 FLINT_DLL __mpz_struct * _fmpz_promote_val(fmpz_t f);
@@ -787,6 +820,9 @@ FLINT_DLL void _fmpz_CRT_ui_precomp(fmpz_t out, const fmpz_t r1, const fmpz_t m1
 FLINT_DLL void fmpz_CRT_ui(fmpz_t out, const fmpz_t r1, const fmpz_t m1,
     ulong r2, ulong m2, int sign);
 
+FLINT_DLL void _fmpz_CRT(fmpz_t out, const fmpz_t r1, const fmpz_t m1,
+      fmpz_t r2, fmpz_t m2, const fmpz_t m1m2, fmpz_t c, int sign);
+
 FLINT_DLL void fmpz_CRT(fmpz_t out, const fmpz_t r1, const fmpz_t m1,
                                                fmpz_t r2, fmpz_t m2, int sign);
 
@@ -0,0 +1,563 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <string.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+
+#if FLINT_USES_PTHREAD
+#include <pthread.h>
+#endif
+
+/*
+    The limbs of an mpz are allocated by GMP through its memory functions.
+    While any arena exists these are replaced by the functions below, which
+    serve requests from the arena active on the calling thread and pass
+    everything else on to the previous functions. The previous functions
+    are restored when the last arena is cleared.
+
+    Any thread may free or reallocate limbs in an arena, so every free and
+    reallocation has to decide whether a pointer lies in an arena. Blocks
+    are aligned to pages of FMPZ_ARENA_PAGE_SIZE bytes and the pages of all
+    blocks are entered in a hash table which is normally read without a
+    lock (see KEY_GET). A pointer which does not lie in an arena is never
+    looked up in a block, so blocks can be released by other threads at
+    any time; a block which contains a pointer still in use cannot be
+    released.
+
+    The fmpz memory managers which cache cleared mpz's call
+    _fmpz_arena_evict so that no cached mpz keeps limbs in an arena which
+    is not active on its thread.
+*/
+
+#define FMPZ_ARENA_PAGE_BITS 18
+
+#define FMPZ_ARENA_PAGE_SIZE ((size_t) 1 << FMPZ_ARENA_PAGE_BITS)
+
+#define FMPZ_ARENA_TABLE_BITS 14
+
+#define FMPZ_ARENA_TABLE_SIZE (WORD(1) << FMPZ_ARENA_TABLE_BITS)
+
+/* the table is kept at most three quarters full */
+#define FMPZ_ARENA_MAX_PAGES (3*FMPZ_ARENA_TABLE_SIZE/4)
+
+#define FMPZ_ARENA_EMPTY UWORD(0)
+
+#define FMPZ_ARENA_DELETED UWORD_MAX
+
+/*
+    A key is stored with release semantics after its block and loaded with
+    acquire semantics before it, so that a reader which sees the key also
+    sees the block. Without the atomic builtins the lock-free lookup is
+    only used on x86, whose stores are not reordered with each other.
+*/
+#if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)) && FLINT_USES_PTHREAD
+#define KEY_GET(i) __atomic_load_n(&_fmpz_arena_keys[i], __ATOMIC_ACQUIRE)
+#define KEY_SET(i, v) __atomic_store_n(&_fmpz_arena_keys[i], (v), __ATOMIC_RELEASE)
+#define FMPZ_ARENA_FIND_LOCKED 0
+#else
+#define KEY_GET(i) (_fmpz_arena_keys[i])
+#define KEY_SET(i, v) (_fmpz_arena_keys[i] = (v))
+#if FLINT_USES_PTHREAD && !defined(__i386__) && !defined(__x86_64__) \
+    && !defined(_M_IX86) && !defined(_M_X64)
+#define FMPZ_ARENA_FIND_LOCKED 1
+#else
+#define FMPZ_ARENA_FIND_LOCKED 0
+#endif
+#endif
+
+#if FLINT64
+#define FMPZ_ARENA_HASH_MUL UWORD(0x9e3779b97f4a7c15)
+#else
+#define FMPZ_ARENA_HASH_MUL UWORD(0x9e3779b9)
+#endif
+
+#define FMPZ_ARENA_DEFAULT_SIZE (WORD(1) << 20)
+
+/* allocations are rounded up to a multiple of this many bytes */
+#define FMPZ_ARENA_ALIGN (2*sizeof(mp_limb_t))
+
+typedef struct _fmpz_arena_block_struct
+{
+    struct _fmpz_arena_block_struct * next; /* earlier block of the arena */
+    fmpz_arena_struct * arena;
+    char * data;                            /* page aligned storage */
+    void * alloc;                           /* allocation containing data */
+    size_t size;                            /* bytes of storage */
+    size_t used;
+    char * last;                            /* most recent allocation */
+} _fmpz_arena_block_struct;
+
+static void * (* _gmp_alloc)(size_t);
+static void * (* _gmp_realloc)(void *, size_t, size_t);
+static void (* _gmp_free)(void *, size_t);
+
+static int _fmpz_arena_installed = 0;
+
+static slong _fmpz_arena_num_arenas = 0;
+
+/* page number plus one of each page of a block, and the block */
+static volatile ulong _fmpz_arena_keys[FMPZ_ARENA_TABLE_SIZE];
+static _fmpz_arena_block_struct * volatile
+                                    _fmpz_arena_vals[FMPZ_ARENA_TABLE_SIZE];
+
+static slong _fmpz_arena_num_pages = 0;
+
+volatile slong _fmpz_arena_num_blocks = 0;
+
+#if FLINT_USES_PTHREAD
+static pthread_mutex_t _fmpz_arena_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+FLINT_TLS_PREFIX fmpz_arena_struct * _fmpz_arena_current = NULL;
+
+#define PAGE_KEY(ptr) (((ulong) (ptr) >> FMPZ_ARENA_PAGE_BITS) + 1)
+
+#define PAGE_HASH(key) \
+    ((slong) (((key)*FMPZ_ARENA_HASH_MUL) >> (FLINT_BITS - FMPZ_ARENA_TABLE_BITS)))
+
+#define NEXT_SLOT(i) (((i) + 1) & (FMPZ_ARENA_TABLE_SIZE - 1))
+
+static _fmpz_arena_block_struct * _fmpz_arena_find(const void * ptr)
+{
+    _fmpz_arena_block_struct * b = NULL;
+    ulong k, key;
+    slong i, j;
+
+    if (_fmpz_arena_num_blocks == 0)
+        return NULL;
+
+    key = PAGE_KEY(ptr);
+    i = PAGE_HASH(key);
+
+#if FMPZ_ARENA_FIND_LOCKED
+    pthread_mutex_lock(&_fmpz_arena_lock);
+#endif
+
+    for (j = 0; j < FMPZ_ARENA_TABLE_SIZE; j++)
+    {
+        k = KEY_GET(i);
+
+        if (k == key)
+        {
+            b = _fmpz_arena_vals[i];
+            break;
+        }
+
+        if (k == FMPZ_ARENA_EMPTY)
+            break;
+
+        i = NEXT_SLOT(i);
+    }
+
+#if FMPZ_ARENA_FIND_LOCKED
+    pthread_mutex_unlock(&_fmpz_arena_lock);
+#endif
+
+    return b;
+}
+
+/*
+    Keys are only ever inserted at the first free slot of their probe
+    sequence and a deleted slot is only emptied when the next slot is
+    empty, so a reader never stops short of a key which is present.
+*/
+static int _fmpz_arena_register(_fmpz_arena_block_struct * b)
+{
+    slong i, j, num = b->size >> FMPZ_ARENA_PAGE_BITS;
+    ulong key;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&_fmpz_arena_lock);
+#endif
+
+    if (_fmpz_arena_num_pages + num > FMPZ_ARENA_MAX_PAGES)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&_fmpz_arena_lock);
+#endif
+        return 0;
+    }
+
+    for (j = 0; j < num; j++)
+    {
+        key = PAGE_KEY(b->data) + j;
+
+        for (i = PAGE_HASH(key); _fmpz_arena_keys[i] != FMPZ_ARENA_EMPTY &&
+                      _fmpz_arena_keys[i] != FMPZ_ARENA_DELETED; i = NEXT_SLOT(i))
+            ;
+
+        _fmpz_arena_vals[i] = b;
+        KEY_SET(i, key);
+    }
+
+    _fmpz_arena_num_pages += num;
+    _fmpz_arena_num_blocks++;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&_fmpz_arena_lock);
+#endif
+
+    return 1;
+}
+
+static void _fmpz_arena_unregister(_fmpz_arena_block_struct * b)
+{
+    slong i, j, num = b->size >> FMPZ_ARENA_PAGE_BITS;
+    ulong key;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&_fmpz_arena_lock);
+#endif
+
+    for (j = 0; j < num; j++)
+    {
+        key = PAGE_KEY(b->data) + j;
+
+        for (i = PAGE_HASH(key); _fmpz_arena_keys[i] != key; i = NEXT_SLOT(i))
+            ;
+
+        KEY_SET(i, FMPZ_ARENA_DELETED);
+
+        /* empty the run of deleted slots ending here if it can be done */
+        if (_fmpz_arena_keys[NEXT_SLOT(i)] == FMPZ_ARENA_EMPTY)
+        {
+            while (_fmpz_arena_keys[i] == FMPZ_ARENA_DELETED)
+            {
+                KEY_SET(i, FMPZ_ARENA_EMPTY);
+                i = (i - 1) & (FMPZ_ARENA_TABLE_SIZE - 1);
+            }
+        }
+    }
+
+    _fmpz_arena_num_pages -= num;
+    _fmpz_arena_num_blocks--;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&_fmpz_arena_lock);
+#endif
+}
+
+static _fmpz_arena_block_struct * _fmpz_arena_new_block(
+                                         fmpz_arena_struct * A, size_t size)
+{
+    _fmpz_arena_block_struct * b;
+
+    size = (size + FMPZ_ARENA_PAGE_SIZE - 1) & ~(FMPZ_ARENA_PAGE_SIZE - 1);
+
+    b = flint_malloc(sizeof(_fmpz_arena_block_struct));
+    b->alloc = flint_malloc(size + FMPZ_ARENA_PAGE_SIZE - 1);
+    b->data = (char *) (((ulong) b->alloc + FMPZ_ARENA_PAGE_SIZE - 1)
+                                          & ~(ulong) (FMPZ_ARENA_PAGE_SIZE - 1));
+    b->arena = A;
+    b->size = size;
+    b->used = 0;
+    b->last = NULL;
+
+    if (!_fmpz_arena_register(b))
+    {
+        flint_free(b->alloc);
+        flint_free(b);
+        flint_throw(FLINT_ERROR, "Arena page table is full "
+            "(%wd bytes in arenas).\n",
+            (slong) (FMPZ_ARENA_MAX_PAGES*FMPZ_ARENA_PAGE_SIZE));
+    }
+
+    return b;
+}
+
+static void _fmpz_arena_free_block(_fmpz_arena_block_struct * b)
+{
+    _fmpz_arena_unregister(b);
+    flint_free(b->alloc);
+    flint_free(b);
+}
+
+static void * _fmpz_arena_bump(fmpz_arena_struct * A, size_t size)
+{
+    _fmpz_arena_block_struct * b = A->block;
+    char * ptr;
+
+    size = (size + FMPZ_ARENA_ALIGN - 1) & ~(FMPZ_ARENA_ALIGN - 1);
+
+    if (b == NULL || b->used + size > b->size)
+    {
+        size_t bsize = (b == NULL) ? A->block_size : 2*b->size;
+
+        b = _fmpz_arena_new_block(A, FLINT_MAX(bsize, size));
+        b->next = A->block;
+        A->block = b;
+    }
+
+    ptr = b->data + b->used;
+    b->used += size;
+    b->last = ptr;
+
+    return ptr;
+}
+
+/* give back ptr if it was the most recent allocation of the current arena */
+static void _fmpz_arena_release(_fmpz_arena_block_struct * b, void * ptr)
+{
+    if (b->arena == _fmpz_arena_current && b == b->arena->block
+                                        && (char *) ptr == b->last)
+    {
+        b->used = b->last - b->data;
+        b->last = NULL;
+    }
+}
+
+static void * _fmpz_arena_alloc_func(size_t size)
+{
+    if (_fmpz_arena_current != NULL)
+        return _fmpz_arena_bump(_fmpz_arena_current, size);
+
+    return _gmp_alloc(size);
+}
+
+static void * _fmpz_arena_realloc_func(void * ptr,
+                                             size_t old_size, size_t new_size)
+{
+    fmpz_arena_struct * A = _fmpz_arena_current;
+    _fmpz_arena_block_struct * b = _fmpz_arena_find(ptr);
+    void * ptr2;
+
+    if (b == NULL && A == NULL)
+        return _gmp_realloc(ptr, old_size, new_size);
+
+    if (b != NULL && b->arena == A && b == A->block && (char *) ptr == b->last)
+    {
+        size_t size = (new_size + FMPZ_ARENA_ALIGN - 1)
+                                                   & ~(FMPZ_ARENA_ALIGN - 1);
+
+        /* extend or shrink in place */
+        if (b->last - b->data + size <= b->size)
+        {
+            b->used = b->last - b->data + size;
+            return ptr;
+        }
+    }
+
+    if (A != NULL)
+        ptr2 = _fmpz_arena_bump(A, new_size);
+    else
+        ptr2 = _gmp_alloc(new_size);
+
+    memcpy(ptr2, ptr, FLINT_MIN(old_size, new_size));
+
+    if (b == NULL)
+        _gmp_free(ptr, old_size);
+    else
+        _fmpz_arena_release(b, ptr);
+
+    return ptr2;
+}
+
+static void _fmpz_arena_free_func(void * ptr, size_t size)
+{
+    _fmpz_arena_block_struct * b = _fmpz_arena_find(ptr);
+
+    if (b == NULL)
+        _gmp_free(ptr, size);
+    else
+        _fmpz_arena_release(b, ptr);
+}
+
+/* called with the lock held */
+static void _fmpz_arena_install(void)
+{
+    if (!_fmpz_arena_installed)
+    {
+        mp_get_memory_functions(&_gmp_alloc, &_gmp_realloc, &_gmp_free);
+        mp_set_memory_functions(_fmpz_arena_alloc_func,
+                                _fmpz_arena_realloc_func, _fmpz_arena_free_func);
+        _fmpz_arena_installed = 1;
+    }
+}
+
+/*
+    Called with the lock held when no arena is left. If other functions
+    were installed on top of ours they may pass requests on to ours, which
+    then have to stay.
+*/
+static void _fmpz_arena_uninstall(void)
+{
+    void * (* alloc_func)(size_t);
+    void * (* realloc_func)(void *, size_t, size_t);
+    void (* free_func)(void *, size_t);
+
+    mp_get_memory_functions(&alloc_func, &realloc_func, &free_func);
+
+    if (_fmpz_arena_installed && alloc_func == _fmpz_arena_alloc_func)
+    {
+        mp_set_memory_functions(_gmp_alloc, _gmp_realloc, _gmp_free);
+        _fmpz_arena_installed = 0;
+    }
+}
+
+void fmpz_arena_init(fmpz_arena_t A, size_t size)
+{
+    A->block = NULL;
+    A->block_size = (size == 0) ? FMPZ_ARENA_DEFAULT_SIZE : size;
+    A->prev = NULL;
+    A->active = 0;
+    A->hooked = 0;
+}
+
+static void _fmpz_arena_free_blocks(_fmpz_arena_block_struct * b)
+{
+    _fmpz_arena_block_struct * next;
+
+    while (b != NULL)
+    {
+        next = b->next;
+        _fmpz_arena_free_block(b);
+        b = next;
+    }
+}
+
+void fmpz_arena_clear(fmpz_arena_t A)
+{
+    if (A->active)
+    {
+        flint_printf("Exception (fmpz_arena_clear). Arena is active.\n");
+        flint_abort();
+    }
+
+    _fmpz_cleanup_mpz_arena(A);
+    _fmpz_arena_free_blocks(A->block);
+    A->block = NULL;
+
+    if (A->hooked)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&_fmpz_arena_lock);
+#endif
+
+        if (--_fmpz_arena_num_arenas == 0)
+            _fmpz_arena_uninstall();
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&_fmpz_arena_lock);
+#endif
+
+        A->hooked = 0;
+    }
+}
+
+void fmpz_arena_enter(fmpz_arena_t A)
+{
+    if (A->active)
+    {
+        flint_printf("Exception (fmpz_arena_enter). Arena is already active.\n");
+        flint_abort();
+    }
+
+    if (!A->hooked)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&_fmpz_arena_lock);
+#endif
+
+        _fmpz_arena_num_arenas++;
+        _fmpz_arena_install();
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&_fmpz_arena_lock);
+#endif
+
+        A->hooked = 1;
+    }
+
+    A->prev = _fmpz_arena_current;
+    A->active = 1;
+    _fmpz_arena_current = A;
+}
+
+void fmpz_arena_leave(fmpz_arena_t A)
+{
+    if (_fmpz_arena_current != A)
+    {
+        flint_printf("Exception (fmpz_arena_leave). Arena is not the current arena.\n");
+        flint_abort();
+    }
+
+    _fmpz_arena_current = A->prev;
+    A->prev = NULL;
+    A->active = 0;
+
+    _fmpz_cleanup_mpz_arena(A);
+}
+
+void fmpz_arena_reset(fmpz_arena_t A)
+{
+    _fmpz_arena_block_struct * b = A->block;
+
+    if (A->active)
+    {
+        flint_printf("Exception (fmpz_arena_reset). Arena is active.\n");
+        flint_abort();
+    }
+
+    _fmpz_cleanup_mpz_arena(A);
+
+    if (b != NULL)
+    {
+        /* keep the largest block for reuse */
+        _fmpz_arena_free_blocks(b->next);
+        b->next = NULL;
+        b->used = 0;
+        b->last = NULL;
+    }
+}
+
+size_t fmpz_arena_used(const fmpz_arena_t A)
+{
+    const _fmpz_arena_block_struct * b;
+    size_t used = 0;
+
+    for (b = A->block; b != NULL; b = b->next)
+        used += b->used;
+
+    return used;
+}
+
+fmpz_arena_struct * _fmpz_arena_owner(const void * ptr)
+{
+    _fmpz_arena_block_struct * b = _fmpz_arena_find(ptr);
+
+    return (b == NULL) ? NULL : b->arena;
+}
+
+void _fmpz_arena_evict(__mpz_struct * z, const fmpz_arena_struct * A)
+{
+    fmpz_arena_struct * B = _fmpz_arena_owner(z->_mp_d), * C;
+
+    if (B == NULL)
+        return;
+
+    if (A == NULL)
+    {
+        /* keep the limbs only if B is active on this thread */
+        for (C = _fmpz_arena_current; C != NULL && C != B; C = C->prev)
+            ;
+
+        if (C != NULL)
+            return;
+    }
+    else if (B != A)
+        return;
+
+    mpz_clear(z);
+    mpz_init2(z, 2*FLINT_BITS);
+}
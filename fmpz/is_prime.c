@@ -289,8 +289,8 @@ int fmpz_is_prime(const fmpz_t n)
    }
 
    /* aprcl_is_prime() actually throws, but it does not hurt to have
-      this fallback here */
-   if (res < 0)
+      this fallback here; a cancelled test returns APRCL_CANCELLED */
+   if (res < 0 && !flint_cancelled())
    {
       flint_printf("Exception in fmpz_is_prime: failed to prove ");
       fmpz_print(n);
@@ -80,6 +80,8 @@ void _fmpz_clear_mpz(fmpz f)
 
     if (ptr->_mp_alloc > FLINT_MPZ_MAX_CACHE_LIMBS)
         mpz_realloc2(ptr, 1);
+    else if (_fmpz_arena_num_blocks != 0)
+        _fmpz_arena_evict(ptr, NULL);
 
 #if FLINT_USES_PTHREAD
     pthread_mutex_lock(&fmpz_lock);
@@ -112,6 +114,23 @@ void _fmpz_cleanup_mpz_content(void)
     mpz_free_num = mpz_free_alloc = 0;
 }
 
+void _fmpz_cleanup_mpz_arena(const fmpz_arena_struct * A)
+{
+    ulong i;
+
+#if FLINT_USES_PTHREAD
+    pthread_once(&fmpz_initialised, fmpz_lock_init);
+    pthread_mutex_lock(&fmpz_lock);
+#endif
+
+    for (i = 0; i < mpz_free_num; i++)
+        _fmpz_arena_evict(mpz_free_arr[i], A);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&fmpz_lock);
+#endif
+}
+
 void _fmpz_cleanup(void)
 {
 #if FLINT_USES_PTHREAD
@@ -31,6 +31,10 @@ void _fmpz_cleanup_mpz_content(void)
 {
 }
 
+void _fmpz_cleanup_mpz_arena(const fmpz_arena_struct * A)
+{
+}
+
 void _fmpz_cleanup(void)
 {
 }
@@ -157,6 +157,8 @@ void _fmpz_clear_mpz(fmpz f)
     {
         if (ptr->_mp_alloc > FLINT_MPZ_MAX_CACHE_LIMBS)
             mpz_realloc2(ptr, 2*FLINT_BITS);
+        else if (_fmpz_arena_num_blocks != 0)
+            _fmpz_arena_evict(ptr, NULL);
 
         if (mpz_free_num == mpz_free_alloc)
         {
@@ -198,6 +200,14 @@ void _fmpz_cleanup_mpz_content(void)
     mpz_free_num = mpz_free_alloc = 0;
 }
 
+void _fmpz_cleanup_mpz_arena(const fmpz_arena_struct * A)
+{
+    ulong i;
+
+    for (i = 0; i < mpz_free_num; i++)
+        _fmpz_arena_evict(mpz_free_arr[i], A);
+}
+
 void _fmpz_cleanup(void)
 {
     _fmpz_cleanup_mpz_content();
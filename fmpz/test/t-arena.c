@@ -0,0 +1,189 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    void * (* alloc_func)(size_t);
+    void * (* alloc_func2)(size_t);
+    void * (* realloc_func)(void *, size_t, size_t);
+    void (* free_func)(void *, size_t);
+    FLINT_TEST_INIT(state);
+
+    mp_get_memory_functions(&alloc_func, &realloc_func, &free_func);
+
+    flint_printf("arena....");
+    fflush(stdout);
+
+    /* products and sums computed in an arena, copied out after leaving */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        fmpz_arena_t A, B;
+        fmpz * a, * b, * c, * t;
+        fmpz_t s, out;
+        slong len = n_randint(state, 50) + 1;
+        flint_bitcnt_t bits = n_randint(state, 5000) + 1;
+        int round;
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        c = _fmpz_vec_init(len);
+        fmpz_init(s);
+        fmpz_init(out);
+
+        _fmpz_vec_randtest(a, state, len, bits);
+        _fmpz_vec_randtest(b, state, len, bits);
+
+        for (j = 0; j < len; j++)
+            fmpz_addmul(s, a + j, b + j);
+
+        fmpz_arena_init(A, n_randint(state, 4096));
+        fmpz_arena_init(B, 0);
+
+        for (round = 0; round < 2; round++)
+        {
+            fmpz_t u;
+
+            fmpz_arena_enter(A);
+
+            t = _fmpz_vec_init(len);
+            fmpz_init(u);
+
+            for (j = 0; j < len; j++)
+            {
+                fmpz_mul(t + j, a + j, b + j);
+                fmpz_add(u, u, t + j);
+            }
+
+            /* smaller limb arrays may be cached from before */
+            if (fmpz_size(u) > 64 &&
+                    _fmpz_arena_owner(COEFF_TO_PTR(*u)->_mp_d) != A)
+            {
+                flint_printf("FAIL (limbs not in arena):\n");
+                fflush(stdout);
+                flint_abort();
+            }
+
+            /* nested arena */
+            fmpz_arena_enter(B);
+            for (j = 0; j < len; j++)
+                fmpz_mul(c + j, a + j, b + j);
+            fmpz_arena_leave(B);
+
+            result = _fmpz_vec_equal(c, t, len);
+            if (!result)
+            {
+                flint_printf("FAIL (nested):\n");
+                fflush(stdout);
+                flint_abort();
+            }
+
+            fmpz_arena_leave(A);
+
+            fmpz_set(out, u);
+            fmpz_clear(u);
+            _fmpz_vec_clear(t, len);
+
+            /* c was written in B */
+            _fmpz_vec_zero(c, len);
+            fmpz_arena_reset(B);
+            fmpz_arena_reset(A);
+
+            result = (fmpz_arena_used(A) == 0 && fmpz_equal(out, s));
+            if (!result)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("round = %d, used = %wu\n", round,
+                                                 (ulong) fmpz_arena_used(A));
+                fmpz_print(out); flint_printf("\n");
+                fmpz_print(s); flint_printf("\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_arena_clear(A);
+        fmpz_arena_clear(B);
+
+        /* the memory functions of GMP are restored */
+        mp_get_memory_functions(&alloc_func2, NULL, NULL);
+        if (alloc_func2 != alloc_func)
+        {
+            flint_printf("FAIL (memory functions not restored):\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+        _fmpz_vec_clear(c, len);
+        fmpz_clear(s);
+        fmpz_clear(out);
+    }
+
+    /* limbs in the arena reallocated and freed by other threads */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        fmpz_arena_t A;
+        fmpz * a, * b, * c;
+        fmpz_t p;
+        slong len = n_randint(state, 3000) + 1;
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        c = _fmpz_vec_init(len);
+        fmpz_init(p);
+
+        _fmpz_vec_randtest(a, state, len, 500);
+        fmpz_randtest_not_zero(p, state, 300);
+        fmpz_abs(p, p);
+
+        _fmpz_vec_scalar_mod_fmpz(b, a, len, p);
+
+        fmpz_arena_init(A, 0);
+        fmpz_arena_enter(A);
+
+        _fmpz_vec_set(c, a, len);
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        _fmpz_vec_scalar_mod_fmpz_threaded(c, c, len, p);
+
+        result = _fmpz_vec_equal(b, c, len);
+        if (!result)
+        {
+            flint_printf("FAIL (threaded):\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        _fmpz_vec_clear(c, len);
+        fmpz_arena_leave(A);
+        fmpz_arena_clear(A);
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+        fmpz_clear(p);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -130,6 +130,8 @@ typedef struct ecm_s {
     mp_limb_t n_size;
     mp_limb_t normbits;
 
+    volatile int * stop;    /* if set nonzero, abandon the current curve */
+
 } ecm_s;
 
 typedef ecm_s ecm_t[1];
@@ -16,6 +16,7 @@
 #include "flint.h"
 #include "fmpz.h"
 #include "mpn_extras.h"
+#include "thread_support.h"
 
 static
 ulong n_ecm_primorial[] =
@@ -43,16 +44,190 @@ ulong n_ecm_primorial[] =
 #define num_n_ecm_primorials 9
 #endif
 
+typedef struct
+{
+    mp_srcptr n;
+    const ecm_s * ecm_inf;      /* tables and constants shared by all curves */
+    const mp_limb_t * prime_array;
+    mp_limb_t num, B1, B2, P;
+    mp_limb_t curves;
+    flint_rand_s * state;
+    const fmpz * nm8;
+    flint_cancel_struct * cancel;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+    volatile mp_limb_t next_curve;
+    volatile int found;
+    int ret;                    /* -1, 1 or 2 as for fmpz_factor_ecm */
+    mp_size_t fac_size;
+    mp_ptr fac;                 /* factor, shifted by normbits */
+} _ecm_curves_arg_struct;
+
+/* take the next curve and its sigma, return 0 if there are none left */
+static int _ecm_next_curve(fmpz_t sig, _ecm_curves_arg_struct * arg)
+{
+    int more;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&arg->mutex);
+#endif
+
+    more = !arg->found && arg->next_curve < arg->curves && !flint_cancelled();
+
+    if (more)
+    {
+        arg->next_curve++;
+        fmpz_randm(sig, arg->state, arg->nm8);
+        fmpz_add_ui(sig, sig, 7);
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&arg->mutex);
+#endif
+
+    return more;
+}
+
+/* try curves until one of the threads finds a factor */
+static void _ecm_curves_worker(void * varg)
+{
+    _ecm_curves_arg_struct * arg = (_ecm_curves_arg_struct *) varg;
+    mp_limb_t n_size = arg->ecm_inf->n_size, cy;
+    mp_ptr n = (mp_ptr) arg->n, mpsig, f;
+    __mpz_struct * mpz_ptr;
+    flint_cancel_struct * old_cancel;
+    fmpz_t sig;
+    ecm_t ecm_inf;
+    int ret, stage;
+
+    /* the caller's token is checked by every thread */
+    old_cancel = flint_set_cancel(arg->cancel);
+
+    fmpz_factor_ecm_init(ecm_inf, n_size);
+    flint_mpn_copyi(ecm_inf->ninv, arg->ecm_inf->ninv, n_size);
+    flint_mpn_copyi(ecm_inf->one, arg->ecm_inf->one, n_size);
+    ecm_inf->normbits = arg->ecm_inf->normbits;
+    ecm_inf->GCD_table = arg->ecm_inf->GCD_table;
+    ecm_inf->prime_table = arg->ecm_inf->prime_table;
+    ecm_inf->stop = &arg->found;
+
+    fmpz_init(sig);
+    mpsig = flint_malloc(n_size * sizeof(mp_limb_t));
+    f = flint_malloc(n_size * sizeof(mp_limb_t));
+
+    while (_ecm_next_curve(sig, arg))
+    {
+        mpn_zero(mpsig, n_size);
+        
+        if ((!COEFF_IS_MPZ(*sig)))
+        {
+            mpsig[0] = fmpz_get_ui(sig);
+            if (ecm_inf->normbits)
+            {
+                cy = mpn_lshift(mpsig, mpsig, 1, ecm_inf->normbits);
+                if (cy)
+                   mpsig[1] = cy;
+            }
+        }
+        else
+        {
+            mpz_ptr = COEFF_TO_PTR(*sig);
+
+            if (ecm_inf->normbits)
+            {
+                cy = mpn_lshift(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size, ecm_inf->normbits);
+                if (cy)
+                    mpsig[mpz_ptr->_mp_size] = cy;
+            } else
+            {
+                flint_mpn_copyi(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size);
+            }
+        }
+
+        /************************ SELECT CURVE ************************/
+
+        ret = fmpz_factor_ecm_select_curve(f, mpsig, n, ecm_inf);
+
+        if (ret == -1)
+            continue;   /* no inverse, try another curve */
+
+        if (ret)
+        {
+            /* Found factor while selecting curve,
+               very very lucky :) */
+            stage = -1;
+            goto found;
+        }
+
+        /************************** STAGE I ***************************/
+
+        ret = fmpz_factor_ecm_stage_I(f, arg->prime_array, arg->num,
+                                                           arg->B1, n, ecm_inf);
+
+        if (ret)
+        {
+            /* Found factor after stage I */
+            stage = 1;
+            goto found;
+        }
+
+        /************************** STAGE II ***************************/
+
+        ret = fmpz_factor_ecm_stage_II(f, arg->B1, arg->B2, arg->P, n, ecm_inf);
+
+        if (ret)
+        {
+            /* Found factor after stage II */
+            stage = 2;
+            goto found;
+        }
+
+        continue;
+
+found:
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&arg->mutex);
+#endif
+        if (!arg->found)
+        {
+            arg->found = 1;
+            arg->ret = stage;
+            arg->fac_size = ret;
+            flint_mpn_copyi(arg->fac, f, ret);
+        }
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&arg->mutex);
+#endif
+
+        break;
+    }
+
+    flint_free(mpsig);
+    flint_free(f);
+    fmpz_clear(sig);
+
+    ecm_inf->GCD_table = NULL;
+    ecm_inf->prime_table = NULL;
+    fmpz_factor_ecm_clear(ecm_inf);
+
+    flint_set_cancel(old_cancel);
+}
+
 int
 fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
                 flint_rand_t state, const fmpz_t n_in)
 {
-    fmpz_t sig, nm8;
-    mp_limb_t P, num, maxP, mmin, mmax, mdiff, prod, maxj, n_size, cy;
+    fmpz_t nm8;
+    mp_limb_t P, num, maxP, mmin, mmax, mdiff, prod, maxj, n_size;
     int i, j, ret;
     ecm_t ecm_inf;
     __mpz_struct *fac, *mpz_ptr;
-    mp_ptr n, mpsig;
+    mp_ptr n;
+    _ecm_curves_arg_struct arg;
+    thread_pool_handle * threads;
+    slong num_threads;
 
     TMP_INIT;
 
@@ -71,7 +246,6 @@ fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
     TMP_START;
 
     n      = TMP_ALLOC(n_size * sizeof(mp_limb_t));
-    mpsig  = TMP_ALLOC(n_size * sizeof(mp_limb_t));
 
     if ((!COEFF_IS_MPZ(* n_in)))
     {
@@ -92,7 +266,6 @@ fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
     flint_mpn_preinvn(ecm_inf->ninv, n, n_size);
     ecm_inf->one[0] = UWORD(1) << ecm_inf->normbits;
 
-    fmpz_init(sig);
     fmpz_init(nm8);
     fmpz_sub_ui(nm8, n_in, 8);
 
@@ -174,97 +347,60 @@ fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
 
     /****************************** TRY "CURVES" *****************************/
 
-    for (j = 0; j < curves; j++)
-    {
-        fmpz_randm(sig, state, nm8);
-        fmpz_add_ui(sig, sig, 7);
-
-        mpn_zero(mpsig, ecm_inf->n_size);
-        
-        if ((!COEFF_IS_MPZ(*sig)))
-        {
-            mpsig[0] = fmpz_get_ui(sig);
-            if (ecm_inf->normbits)
-            {
-                cy = mpn_lshift(mpsig, mpsig, 1, ecm_inf->normbits);
-                if (cy)
-                   mpsig[1] = cy;
-            }
-        }
-        else
-        {
-            mpz_ptr = COEFF_TO_PTR(*sig);
-
-            if (ecm_inf->normbits)
-            {
-                cy = mpn_lshift(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size, ecm_inf->normbits);
-                if (cy)
-                    mpsig[mpz_ptr->_mp_size] = cy;
-            } else
-            {
-                flint_mpn_copyi(mpsig, mpz_ptr->_mp_d, mpz_ptr->_mp_size);
-            }
-        }
-
-        /************************ SELECT CURVE ************************/
-
-        ret = fmpz_factor_ecm_select_curve(fac->_mp_d, mpsig, n, ecm_inf);
+    /* curves are independent, share them among the threads */
+    arg.n = n;
+    arg.ecm_inf = ecm_inf;
+    arg.prime_array = prime_array;
+    arg.num = num;
+    arg.B1 = B1;
+    arg.B2 = B2;
+    arg.P = P;
+    arg.curves = curves;
+    arg.state = state;
+    arg.nm8 = nm8;
+    arg.cancel = flint_set_cancel(NULL);
+    flint_set_cancel(arg.cancel);
+    arg.next_curve = 0;
+    arg.found = 0;
+    arg.ret = 0;
+    arg.fac_size = 0;
+    arg.fac = fac->_mp_d;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&arg.mutex, NULL);
+#endif
 
-        if (ret)
-        {
-            /* Found factor while selecting curve,
-               very very lucky :) */
+    num_threads = flint_request_threads(&threads,
+                                  FLINT_MIN(curves, flint_get_num_threads()));
 
-            if (ecm_inf->normbits)
-               mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-            MPN_NORM(fac->_mp_d, ret);
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                                     _ecm_curves_worker, &arg);
 
-            fac->_mp_size = ret;
-            _fmpz_demote_val(f);    
-            ret = -1;
-            goto cleanup;
-        }
+    _ecm_curves_worker(&arg);
 
-        if (ret != -1)
-        {
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
 
-            /************************** STAGE I ***************************/
+    flint_give_back_threads(threads, num_threads);
 
-            ret = fmpz_factor_ecm_stage_I(fac->_mp_d, prime_array, num, B1, n, ecm_inf);
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&arg.mutex);
+#endif
 
-            if (ret)
-            {
-                /* Found factor after stage I */
-                if (ecm_inf->normbits)
-                   mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-                MPN_NORM(fac->_mp_d, ret);
+    ret = arg.ret;
 
-                fac->_mp_size = ret;
-                _fmpz_demote_val(f);    
-                ret = 1;
-                goto cleanup;
-            }  
-            /************************** STAGE II ***************************/
+    if (ret)
+    {
+        mp_size_t size = arg.fac_size;
 
-            ret = fmpz_factor_ecm_stage_II(fac->_mp_d, B1, B2, P, n, ecm_inf);
+        if (ecm_inf->normbits)
+           mpn_rshift(fac->_mp_d, fac->_mp_d, size, ecm_inf->normbits);
+        MPN_NORM(fac->_mp_d, size);
 
-            if (ret)
-            {
-                /* Found factor after stage II */
-                if (ecm_inf->normbits)
-                   mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-                MPN_NORM(fac->_mp_d, ret);
-                fac->_mp_size = ret;
-                _fmpz_demote_val(f);  
-                ret = 2;
-                goto cleanup;
-            }
-        }
+        fac->_mp_size = size;
+        _fmpz_demote_val(f);
     }
 
-    cleanup:
-
-
     flint_free(ecm_inf->GCD_table);
     for (i = 0; i < mdiff; i++)
         flint_free(ecm_inf->prime_table[i]);
@@ -273,7 +409,6 @@ fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
     fmpz_factor_ecm_clear(ecm_inf);
    
     fmpz_clear(nm8);
-    fmpz_clear(sig);
 
     TMP_END;
 
@@ -23,7 +23,10 @@ fmpz_factor_no_trial(fmpz_factor_t factor, const fmpz_t n)
 {
    int exp, i;
 
-   if (fmpz_is_prime(n))
+   /* cancelled, also during the primality test: leave n unfactored */
+   if (flint_cancelled())
+      _fmpz_factor_append(factor, n, 1);
+   else if (fmpz_is_prime(n) != 0)
       _fmpz_factor_append(factor, n, 1);
    else
    {
@@ -184,7 +184,7 @@ int fmpz_factor_smooth(fmpz_factor_t factor, const fmpz_t n,
         flint_mpn_copyi(data->_mp_d, xd, xsize);
         data->_mp_size = xsize;
 
-        if (proved != -1 && _is_prime(n2, proved))
+        if (proved != -1 && _is_prime(n2, proved) == 1)
         {
             _fmpz_factor_append(factor, n2, 1);
             ret = 1; 
@@ -227,6 +227,9 @@ int fmpz_factor_smooth(fmpz_factor_t factor, const fmpz_t n,
                 /* start with 18-22 bits, advance by 6 bits at a time */
                 for (i = 9 + (bits2 % 3); i <= bits2; i += istride)
                 {
+                    if (flint_cancelled())
+                        break;
+
                     found = fmpz_factor_ecm(f, ecm_tuning[i][2],
                             ecm_tuning[i][1], ecm_tuning[i][1]*100, state, n2);
 
@@ -252,7 +255,7 @@ int fmpz_factor_smooth(fmpz_factor_t factor, const fmpz_t n,
                             break;
                         }
 
-                        if (_is_prime(n2, proved))
+                        if (_is_prime(n2, proved) == 1)
                         {
                             _fmpz_factor_append(factor, n2, 1);
 
@@ -41,6 +41,8 @@ int main(void)
 
             fmpz_mul(primeprod, prime1, prime2);
 
+            flint_set_num_threads(n_randint(state, 4) + 1);
+
             k = fmpz_factor_ecm(fac, i << 2, 2000, 50000, state, primeprod);
 
             if (k == 0)
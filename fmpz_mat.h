@@ -536,6 +536,37 @@ _fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
 FLINT_DLL int fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
         const fmpz_mat_t A, const fmpz_mat_t B);
 
+typedef struct
+{
+    const fmpz_mat_struct * A;
+    nmod_mat_t Ainv;
+    mp_limb_t p;
+    fmpz_t D;
+    mp_limb_t * crt_primes;
+    slong num_primes;
+    nmod_mat_struct * A_mod;
+    fmpz_comb_t comb;
+} fmpz_mat_dixon_struct;
+
+typedef fmpz_mat_dixon_struct fmpz_mat_dixon_t[1];
+
+FLINT_DLL void _fmpz_mat_dixon_init(fmpz_mat_dixon_t S, const fmpz_mat_t A,
+                      const nmod_mat_t Ainv, mp_limb_t p, const fmpz_t D);
+
+FLINT_DLL int fmpz_mat_dixon_init(fmpz_mat_dixon_t S, const fmpz_mat_t A);
+
+FLINT_DLL void fmpz_mat_dixon_clear(fmpz_mat_dixon_t S);
+
+FLINT_DLL void _fmpz_mat_dixon_bound(fmpz_t bound,
+                           const fmpz_mat_dixon_t S, const fmpz_mat_t B);
+
+FLINT_DLL int _fmpz_mat_dixon_lift(fmpz_mat_t x, fmpz_t mod,
+              const fmpz_mat_dixon_t S, const fmpz_mat_t B, const fmpz_t bound,
+              int (* check)(const fmpz_mat_t, const fmpz_t, void *), void * arg);
+
+FLINT_DLL void fmpz_mat_solve_dixon_precomp(fmpz_mat_t X, fmpz_t mod,
+                           const fmpz_mat_dixon_t S, const fmpz_mat_t B);
+
 FLINT_DLL void
 _fmpz_mat_solve_dixon_den(fmpz_mat_t X, fmpz_t den,
                      const fmpz_mat_t A, const fmpz_mat_t B,
@@ -546,6 +577,10 @@ FLINT_DLL int
 fmpz_mat_solve_dixon_den(fmpz_mat_t X, fmpz_t den,
 		                              const fmpz_mat_t A, const fmpz_mat_t B);
 
+FLINT_DLL void
+fmpz_mat_solve_dixon_den_precomp(fmpz_mat_t X, fmpz_t den,
+                           const fmpz_mat_dixon_t S, const fmpz_mat_t B);
+
 FLINT_DLL int
 fmpz_mat_solve_multi_mod_den(fmpz_mat_t X, fmpz_t den,
 	                                  const fmpz_mat_t A, const fmpz_mat_t B);
@@ -590,6 +625,7 @@ FLINT_DLL void fmpz_mat_multi_CRT_ui(fmpz_mat_t mat, nmod_mat_t * const residues
 
 FLINT_DLL void fmpz_mat_hnf(fmpz_mat_t H, const fmpz_mat_t A);
 FLINT_DLL void fmpz_mat_hnf_transform(fmpz_mat_t H, fmpz_mat_t U, const fmpz_mat_t A);
+FLINT_DLL int fmpz_mat_hnf_transform_solve(fmpz_mat_t H, fmpz_mat_t U, const fmpz_mat_t A);
 FLINT_DLL void fmpz_mat_hnf_classical(fmpz_mat_t H, const fmpz_mat_t A);
 FLINT_DLL void fmpz_mat_hnf_xgcd(fmpz_mat_t H, const fmpz_mat_t A);
 FLINT_DLL void fmpz_mat_hnf_minors(fmpz_mat_t H, const fmpz_mat_t A);
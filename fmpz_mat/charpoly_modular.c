@@ -88,6 +88,27 @@ void _fmpz_mat_charpoly_small(fmpz * rop, const fmpz_mat_t op)
     }
 }
 
+/* the characteristic polynomial modulo p */
+static slong _charpoly_image(mp_ptr res, nmod_t mod, void * arg)
+{
+    const fmpz_mat_struct * op = (const fmpz_mat_struct *) arg;
+    nmod_mat_t mat;
+    nmod_poly_t poly;
+    slong n = op->r;
+
+    nmod_mat_init(mat, n, n, mod.n);
+    nmod_poly_init(poly, mod.n);
+
+    fmpz_mat_get_nmod_mat(mat, op);
+    nmod_mat_charpoly(poly, mat);
+    _nmod_vec_set(res, poly->coeffs, n + 1);
+
+    nmod_mat_clear(mat);
+    nmod_poly_clear(poly);
+
+    return n + 1;
+}
+
 void _fmpz_mat_charpoly_modular(fmpz * rop, const fmpz_mat_t op)
 {
     const slong n = op->r;
@@ -112,8 +133,6 @@ void _fmpz_mat_charpoly_modular(fmpz * rop, const fmpz_mat_t op)
         slong pbits  = FLINT_BITS - 1;
         mp_limb_t p = (UWORD(1) << pbits);
 
-        fmpz_t m;
-
         /* Determine the bound in bits */
         {
             slong i, j;
@@ -140,30 +159,8 @@ void _fmpz_mat_charpoly_modular(fmpz * rop, const fmpz_mat_t op)
             bound = ceil( (n / 2.0) * (_log2(n) + 2.0 * t + 1.6669) );
         }
 
-        fmpz_init_set_ui(m, 1);
-
-        for ( ; fmpz_bits(m) < bound; )
-        {
-            nmod_mat_t mat;
-            nmod_poly_t poly;
-
-            p = n_nextprime(p, 0);
-
-            nmod_mat_init(mat, n, n, p);
-            nmod_poly_init(poly, p);
-
-            fmpz_mat_get_nmod_mat(mat, op);
-            nmod_mat_charpoly(poly, mat);
-
-            _fmpz_poly_CRT_ui(rop, rop, n + 1, m, poly->coeffs, n + 1, poly->mod.n, poly->mod.ninv, 1);
-
-            fmpz_mul_ui(m, m, p);
-
-            nmod_mat_clear(mat);
-            nmod_poly_clear(poly);
-        }
-
-        fmpz_clear(m);
+        _fmpz_vec_modular(rop, n + 1, bound, 0, FMPZ_VEC_MODULAR_FIXED_LENGTH,
+                          p, _charpoly_image, NULL, (void *) op);
     }
 }
 
@@ -15,28 +15,42 @@
 #define DEBUG_USE_SMALL_PRIMES 0
 
 
-static mp_limb_t
-next_good_prime(const fmpz_t d, mp_limb_t p)
+typedef struct
 {
-    mp_limb_t r = 0;
+    const fmpz_mat_struct * A;
+    const fmpz * d;
+} _det_arg_struct;
 
-    while (r == 0)
-    {
-        p = n_nextprime(p, 0);
-        r = fmpz_fdiv_ui(d, p);
-    }
+/* x = det(A) / d mod p, skipping the primes dividing d */
+static slong
+_det_image(mp_ptr x, nmod_t mod, void * varg)
+{
+    _det_arg_struct * arg = (_det_arg_struct *) varg;
+    nmod_mat_t Amod;
+    mp_limb_t dmod;
 
-    return p;
-}
+    dmod = fmpz_fdiv_ui(arg->d, mod.n);
+    if (dmod == 0)
+        return -1;
+
+    nmod_mat_init(Amod, arg->A->r, arg->A->c, mod.n);
+    fmpz_mat_get_nmod_mat(Amod, arg->A);
+
+    x[0] = _nmod_mat_det(Amod);
+    x[0] = nmod_mul(x[0], n_invmod(dmod, mod.n), mod);
+
+    nmod_mat_clear(Amod);
 
+    return 1;
+}
 
 void
 fmpz_mat_det_modular_given_divisor(fmpz_t det, const fmpz_mat_t A,
     const fmpz_t d, int proved)
 {
-    fmpz_t bound, prod, stable_prod, x, xnew;
-    mp_limb_t p, xmod;
-    nmod_mat_t Amod;
+    _det_arg_struct arg;
+    fmpz_t bound, x;
+    mp_limb_t p;
     slong n = A->r;
 
     if (n == 0)
@@ -52,62 +66,29 @@ fmpz_mat_det_modular_given_divisor(fmpz_t det, const fmpz_mat_t A,
     }
 
     fmpz_init(bound);
-    fmpz_init(prod);
-    fmpz_init(stable_prod);
     fmpz_init(x);
-    fmpz_init(xnew);
 
     /* Bound x = det(A) / d */
     fmpz_mat_det_bound(bound, A);
     fmpz_mul_ui(bound, bound, UWORD(2));  /* accomodate sign */
     fmpz_cdiv_q(bound, bound, d);
 
-    nmod_mat_init(Amod, n, n, 2);
-    fmpz_zero(x);
-    fmpz_one(prod);
-
 #if DEBUG_USE_SMALL_PRIMES
     p = UWORD(1);
 #else
     p = UWORD(1) << NMOD_MAT_OPTIMAL_MODULUS_BITS;
 #endif
 
-    /* Compute x = det(A) / d */
-    while (fmpz_cmp(prod, bound) <= 0)
-    {
-        p = next_good_prime(d, p);
-        _nmod_mat_set_mod(Amod, p);
-        fmpz_mat_get_nmod_mat(Amod, A);
-
-        /* Compute x = det(A) / d mod p */
-        xmod = _nmod_mat_det(Amod);
-        xmod = n_mulmod2_preinv(xmod,
-            n_invmod(fmpz_fdiv_ui(d, p), p), Amod->mod.n, Amod->mod.ninv);
-
-        fmpz_CRT_ui(xnew, x, prod, xmod, p, 1);
-
-        if (fmpz_equal(xnew, x))
-        {
-            fmpz_mul_ui(stable_prod, stable_prod, p);
-            if (!proved && fmpz_bits(stable_prod) > 100)
-                break;
-        }
-        else
-        {
-            fmpz_set_ui(stable_prod, p);
-        }
-
-        fmpz_mul_ui(prod, prod, p);
-        fmpz_set(x, xnew);
-    }
+    arg.A = A;
+    arg.d = d;
+
+    /* Compute x = det(A) / d, stopping early once 100 bits are stable */
+    _fmpz_vec_modular(x, 1, fmpz_bits(bound) + 1, proved ? 0 : 100,
+                      FMPZ_VEC_MODULAR_FIXED_LENGTH, p, _det_image, NULL, &arg);
 
     /* det(A) = x * d */
     fmpz_mul(det, x, d);
 
-    nmod_mat_clear(Amod);
     fmpz_clear(bound);
-    fmpz_clear(prod);
-    fmpz_clear(stable_prod);
     fmpz_clear(x);
-    fmpz_clear(xnew);
 }
@@ -0,0 +1,507 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz_mat.h"
+#include "thread_support.h"
+
+/* entries of the solution per lifting step before tasks are used */
+#define DIXON_TASK_CUTOFF 1024
+
+/* below this many crt primes, Ay is computed with fmpz_mat_mul */
+#define DIXON_CRT_CUTOFF 3
+
+/* digits summed directly before segments are combined in a tree */
+#define DIXON_LEAF_BITS 4
+
+typedef struct
+{
+    const fmpz_mat_dixon_struct * S;
+    fmpz_mat_struct * x;
+    fmpz_mat_struct * d;
+    nmod_mat_struct * d_mod;
+    const fmpz_mat_struct * Ay;
+    const nmod_mat_struct * Ay_mod;
+    const nmod_mat_struct * y_mod;
+    fmpz_mat_struct * lo;
+    const fmpz_mat_struct * hi;
+    const fmpz * pow;
+    const fmpz_mat_struct * seg;
+    const slong * lg;
+    fmpz * pp;
+    slong top;
+    slong start, stop;
+} _dixon_arg_struct;
+
+typedef struct
+{
+    void (* f)(void *);
+    _dixon_arg_struct * args;
+    slong num;
+} _dixon_tasks_struct;
+
+static void _dixon_spawn(void * varg)
+{
+    _dixon_tasks_struct * T = (_dixon_tasks_struct *) varg;
+    thread_pool_task_group_t G;
+    slong j;
+
+    thread_pool_task_group_init(G);
+
+    for (j = 0; j + 1 < T->num; j++)
+        thread_pool_spawn(G, T->f, T->args + j);
+    T->f(T->args + T->num - 1);
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+}
+
+/* run f on rows 0 to r of the solution, split into tasks if worthwhile */
+static void _dixon_run(void (* f)(void *), _dixon_arg_struct * arg,
+                                                           slong r, slong c)
+{
+    _dixon_tasks_struct T;
+    slong j, num, threads = flint_get_num_threads();
+
+    num = (threads > 1 && r*c >= DIXON_TASK_CUTOFF) ?
+                                              FLINT_MIN(r, 4*threads) : 1;
+
+    if (num <= 1)
+    {
+        arg->start = 0;
+        arg->stop = r;
+        f(arg);
+        return;
+    }
+
+    T.f = f;
+    T.num = num;
+    T.args = flint_malloc(num*sizeof(_dixon_arg_struct));
+
+    for (j = 0; j < num; j++)
+    {
+        T.args[j] = *arg;
+        T.args[j].start = j*r/num;
+        T.args[j].stop = (j + 1)*r/num;
+    }
+
+    flint_run_tasks(_dixon_spawn, &T, threads);
+
+    flint_free(T.args);
+}
+
+static void _dixon_init_crt(fmpz_mat_dixon_t S)
+{
+    slong i, n = S->A->r;
+
+    S->crt_primes = fmpz_mat_dixon_get_crt_primes(&S->num_primes, S->A, S->p);
+
+    if (S->num_primes < DIXON_CRT_CUTOFF)
+    {
+        flint_free(S->crt_primes);
+        S->crt_primes = NULL;
+        S->num_primes = 0;
+        S->A_mod = NULL;
+        return;
+    }
+
+    S->A_mod = flint_malloc(S->num_primes*sizeof(nmod_mat_struct));
+
+    for (i = 0; i < S->num_primes; i++)
+    {
+        nmod_mat_init(S->A_mod + i, n, n, S->crt_primes[i]);
+        fmpz_mat_get_nmod_mat(S->A_mod + i, S->A);
+    }
+
+    fmpz_comb_init(S->comb, S->crt_primes, S->num_primes);
+}
+
+void _fmpz_mat_dixon_init(fmpz_mat_dixon_t S, const fmpz_mat_t A,
+                      const nmod_mat_t Ainv, mp_limb_t p, const fmpz_t D)
+{
+    S->A = A;
+    S->p = p;
+    nmod_mat_init_set(S->Ainv, Ainv);
+    fmpz_init_set(S->D, D);
+
+    _dixon_init_crt(S);
+}
+
+int fmpz_mat_dixon_init(fmpz_mat_dixon_t S, const fmpz_mat_t A)
+{
+    if (!fmpz_mat_is_square(A))
+    {
+        flint_printf("Exception (fmpz_mat_dixon_init). Non-square system matrix.\n");
+        flint_abort();
+    }
+
+    S->A = A;
+    fmpz_init(S->D);
+    fmpz_mat_det_bound(S->D, A);
+    nmod_mat_init(S->Ainv, A->r, A->r, 1);
+
+    S->p = fmpz_mat_find_good_prime_and_invert(S->Ainv, A, S->D);
+
+    if (S->p == 0)
+    {
+        S->crt_primes = NULL;
+        S->num_primes = 0;
+        S->A_mod = NULL;
+        return 0;
+    }
+
+    _dixon_init_crt(S);
+
+    return 1;
+}
+
+void fmpz_mat_dixon_clear(fmpz_mat_dixon_t S)
+{
+    slong i;
+
+    if (S->num_primes != 0)
+    {
+        for (i = 0; i < S->num_primes; i++)
+            nmod_mat_clear(S->A_mod + i);
+
+        flint_free(S->A_mod);
+        flint_free(S->crt_primes);
+        fmpz_comb_clear(S->comb);
+    }
+
+    nmod_mat_clear(S->Ainv);
+    fmpz_clear(S->D);
+}
+
+void _fmpz_mat_dixon_bound(fmpz_t bound, const fmpz_mat_dixon_t S,
+                                                        const fmpz_mat_t B)
+{
+    slong i, j;
+    fmpz_t t, u;
+
+    fmpz_init(t);
+    fmpz_init(u);
+
+    /* N = D times the largest column norm of B, as in fmpz_mat_solve_bound */
+    for (j = 0; j < B->c; j++)
+    {
+        fmpz_zero(u);
+        for (i = 0; i < B->r; i++)
+            fmpz_addmul(u, fmpz_mat_entry(B, i, j), fmpz_mat_entry(B, i, j));
+        if (fmpz_cmp(t, u) < 0)
+            fmpz_set(t, u);
+    }
+
+    fmpz_sqrtrem(t, u, t);
+    if (!fmpz_is_zero(u))
+        fmpz_add_ui(t, t, UWORD(1));
+
+    fmpz_mul(t, t, S->D);
+
+    if (fmpz_cmpabs(t, S->D) < 0)
+        fmpz_mul(bound, S->D, S->D);
+    else
+        fmpz_mul(bound, t, t);
+    fmpz_mul_ui(bound, bound, UWORD(2));  /* signs */
+
+    fmpz_clear(t);
+    fmpz_clear(u);
+}
+
+/* lo = lo + y * pow on rows start to stop */
+static void _dixon_digit_worker(void * varg)
+{
+    _dixon_arg_struct * arg = (_dixon_arg_struct *) varg;
+    slong i, j;
+
+    for (i = arg->start; i < arg->stop; i++)
+        for (j = 0; j < arg->lo->c; j++)
+            fmpz_addmul_ui(fmpz_mat_entry(arg->lo, i, j), arg->pow,
+                                           nmod_mat_entry(arg->y_mod, i, j));
+}
+
+/* lo = lo + hi * pow on rows start to stop */
+static void _dixon_merge_worker(void * varg)
+{
+    _dixon_arg_struct * arg = (_dixon_arg_struct *) varg;
+    slong i, j;
+
+    for (i = arg->start; i < arg->stop; i++)
+        for (j = 0; j < arg->lo->c; j++)
+            fmpz_addmul(fmpz_mat_entry(arg->lo, i, j),
+                              fmpz_mat_entry(arg->hi, i, j), arg->pow);
+}
+
+/* x = seg[0] + p^len[0] (seg[1] + p^len[1] (...)) on rows start to stop */
+static void _dixon_combine_worker(void * varg)
+{
+    _dixon_arg_struct * arg = (_dixon_arg_struct *) varg;
+    const fmpz_mat_struct * seg = arg->seg;
+    fmpz_mat_struct * x = arg->x;
+    slong i, j, k;
+
+    for (i = arg->start; i < arg->stop; i++)
+    {
+        for (j = 0; j < x->c; j++)
+        {
+            fmpz_set(fmpz_mat_entry(x, i, j),
+                                     fmpz_mat_entry(seg + arg->top - 1, i, j));
+
+            for (k = arg->top - 2; k >= 0; k--)
+            {
+                fmpz_mul(fmpz_mat_entry(x, i, j), fmpz_mat_entry(x, i, j),
+                                                       arg->pp + arg->lg[k]);
+                fmpz_add(fmpz_mat_entry(x, i, j), fmpz_mat_entry(x, i, j),
+                                                 fmpz_mat_entry(seg + k, i, j));
+            }
+        }
+    }
+}
+
+/* d = (d - Ay) / p on rows start to stop, with Ay given either as an
+   integer matrix or modulo the crt primes */
+static void _dixon_update_worker(void * varg)
+{
+    _dixon_arg_struct * arg = (_dixon_arg_struct *) varg;
+    const fmpz_mat_dixon_struct * S = arg->S;
+    fmpz_mat_struct * d = arg->d;
+    mp_ptr residues = NULL;
+    fmpz_comb_temp_t temp;
+    fmpz_t t;
+    slong i, j, l;
+
+    if (arg->Ay_mod != NULL)
+    {
+        residues = flint_malloc(S->num_primes*sizeof(mp_limb_t));
+        fmpz_comb_temp_init(temp, S->comb);
+    }
+
+    fmpz_init(t);
+
+    for (i = arg->start; i < arg->stop; i++)
+    {
+        for (j = 0; j < d->c; j++)
+        {
+            if (arg->Ay_mod != NULL)
+            {
+                for (l = 0; l < S->num_primes; l++)
+                    residues[l] = nmod_mat_entry(arg->Ay_mod + l, i, j);
+
+                fmpz_multi_CRT_ui(t, residues, S->comb, temp, 1);
+                fmpz_sub(fmpz_mat_entry(d, i, j), fmpz_mat_entry(d, i, j), t);
+            }
+            else
+            {
+                fmpz_sub(fmpz_mat_entry(d, i, j), fmpz_mat_entry(d, i, j),
+                                                 fmpz_mat_entry(arg->Ay, i, j));
+            }
+
+            fmpz_divexact_ui(fmpz_mat_entry(d, i, j),
+                                              fmpz_mat_entry(d, i, j), S->p);
+            nmod_mat_entry(arg->d_mod, i, j) =
+                                fmpz_fdiv_ui(fmpz_mat_entry(d, i, j), S->p);
+        }
+    }
+
+    fmpz_clear(t);
+
+    if (arg->Ay_mod != NULL)
+    {
+        fmpz_comb_temp_clear(temp);
+        flint_free(residues);
+    }
+}
+
+static void _dixon_update(fmpz_mat_t d, nmod_mat_t d_mod,
+                         const nmod_mat_t y_mod, const fmpz_mat_dixon_t S)
+{
+    _dixon_arg_struct arg;
+    nmod_mat_struct * Ay_mod, y;
+    fmpz_mat_t Ay, yz;
+    slong l;
+
+    arg.S = S;
+    arg.d = d;
+    arg.d_mod = d_mod;
+    arg.Ay_mod = NULL;
+
+    /* with many right hand sides, reducing A each time is cheaper than
+       reconstructing each entry of Ay */
+    if (S->num_primes == 0 || 2*d->c > d->r)
+    {
+        fmpz_mat_init(yz, d->r, d->c);
+        fmpz_mat_init(Ay, d->r, d->c);
+        fmpz_mat_set_nmod_mat_unsigned(yz, y_mod);
+        fmpz_mat_mul(Ay, S->A, yz);
+
+        arg.Ay = Ay;
+        _dixon_run(_dixon_update_worker, &arg, d->r, d->c);
+
+        fmpz_mat_clear(Ay);
+        fmpz_mat_clear(yz);
+        return;
+    }
+
+    /* Ay modulo each crt prime; they are all >= p, so the entries of
+       y can be used without reduction */
+    Ay_mod = flint_malloc(S->num_primes*sizeof(nmod_mat_struct));
+    y = *y_mod;
+
+    for (l = 0; l < S->num_primes; l++)
+    {
+        _nmod_mat_set_mod(&y, S->crt_primes[l]);
+        nmod_mat_init(Ay_mod + l, d->r, d->c, S->crt_primes[l]);
+        nmod_mat_mul(Ay_mod + l, S->A_mod + l, &y);
+    }
+
+    arg.Ay_mod = Ay_mod;
+    _dixon_run(_dixon_update_worker, &arg, d->r, d->c);
+
+    for (l = 0; l < S->num_primes; l++)
+        nmod_mat_clear(Ay_mod + l);
+    flint_free(Ay_mod);
+}
+
+/* ensure pp[k] = p^(2^k) is computed */
+static void _dixon_fit_pp(fmpz * pp, slong * num_pp, slong k)
+{
+    for ( ; *num_pp <= k; (*num_pp)++)
+    {
+        fmpz_init(pp + *num_pp);
+        fmpz_mul(pp + *num_pp, pp + *num_pp - 1, pp + *num_pp - 1);
+    }
+}
+
+/* x = the sum of the top segments, which are all complete but the last */
+static void _dixon_combine(_dixon_arg_struct * arg, slong top, slong * num_pp)
+{
+    if (top >= 2)
+        _dixon_fit_pp(arg->pp, num_pp, arg->lg[0]);
+
+    arg->top = top;
+    _dixon_run(_dixon_combine_worker, arg, arg->x->r, arg->x->c);
+}
+
+int _fmpz_mat_dixon_lift(fmpz_mat_t x, fmpz_t mod, const fmpz_mat_dixon_t S,
+                  const fmpz_mat_t B, const fmpz_t bound,
+                  int (* check)(const fmpz_mat_t, const fmpz_t, void *),
+                                                              void * check_arg)
+{
+    _dixon_arg_struct arg;
+    fmpz_mat_struct seg[FLINT_BITS];
+    slong lg[FLINT_BITS];
+    fmpz pp[FLINT_BITS];
+    fmpz_t pleaf;
+    fmpz_mat_t d;
+    nmod_mat_t d_mod, y_mod;
+    slong i, k, n, cols, nexti, top, num_pp, leaf;
+    int stopped = 0;
+
+    n = S->A->r;
+    cols = B->c;
+
+    fmpz_mat_init_set(d, B);
+    nmod_mat_init(d_mod, n, cols, S->p);
+    nmod_mat_init(y_mod, n, cols, S->p);
+    fmpz_mat_get_nmod_mat(d_mod, d);
+
+    /* The p-adic digits y are summed into leaf segments of
+       2^DIXON_LEAF_BITS digits, which are combined in a binary tree
+       of segments seg[k] of 2^lg[k] digits each, using pp[k] = p^(2^k).
+       This avoids updating the whole solution at every step. */
+    fmpz_init(pleaf);
+    fmpz_init_set_ui(pp + 0, S->p);
+    num_pp = 1;
+    top = 0;
+    leaf = 0;
+
+    arg.S = S;
+    arg.x = x;
+    arg.y_mod = y_mod;
+    arg.seg = seg;
+    arg.lg = lg;
+    arg.pp = pp;
+
+    fmpz_one(mod);
+
+    for (i = 1, nexti = 1; ; i++)
+    {
+        /* y = A^(-1) * d  (mod p) */
+        nmod_mat_mul(y_mod, S->Ainv, d_mod);
+
+        /* x = x + y * p^(i-1)    [= A^(-1) * b mod p^i] */
+        if (leaf == 0)
+        {
+            fmpz_mat_init(seg + top, n, cols);
+            lg[top++] = DIXON_LEAF_BITS;
+            fmpz_one(pleaf);
+        }
+
+        arg.lo = seg + top - 1;
+        arg.pow = pleaf;
+        _dixon_run(_dixon_digit_worker, &arg, n, cols);
+        fmpz_mul_ui(pleaf, pleaf, S->p);
+
+        if (++leaf == WORD(1) << DIXON_LEAF_BITS)
+        {
+            leaf = 0;
+
+            while (top >= 2 && lg[top - 1] == lg[top - 2])
+            {
+                _dixon_fit_pp(pp, &num_pp, lg[top - 1]);
+                arg.lo = seg + top - 2;
+                arg.hi = seg + top - 1;
+                arg.pow = pp + lg[top - 1];
+                _dixon_run(_dixon_merge_worker, &arg, n, cols);
+
+                fmpz_mat_clear(seg + top - 1);
+                top--;
+                lg[top - 1]++;
+            }
+        }
+
+        /* mod = p^i */
+        fmpz_mul_ui(mod, mod, S->p);
+        if (fmpz_cmp(mod, bound) > 0)
+            break;
+
+        if (check != NULL && i == nexti)
+        {
+            nexti = (slong)(i*1.4) + 1; /* iteration of next test */
+
+            _dixon_combine(&arg, top, &num_pp);
+
+            if (check(x, mod, check_arg))
+            {
+                stopped = 1;
+                goto cleanup;
+            }
+        }
+
+        /* d = (d - Ay) / p */
+        _dixon_update(d, d_mod, y_mod, S);
+    }
+
+    _dixon_combine(&arg, top, &num_pp);
+
+cleanup:
+
+    for (k = 0; k < top; k++)
+        fmpz_mat_clear(seg + k);
+    for (k = 0; k < num_pp; k++)
+        fmpz_clear(pp + k);
+    fmpz_clear(pleaf);
+
+    nmod_mat_clear(y_mod);
+    nmod_mat_clear(d_mod);
+    fmpz_mat_clear(d);
+
+    return stopped;
+}
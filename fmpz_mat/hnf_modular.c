@@ -10,27 +10,117 @@
 */
 
 #include "fmpz_mat.h"
+#include "thread_support.h"
 
-void
-fmpz_mat_hnf_modular(fmpz_mat_t H, const fmpz_mat_t A, const fmpz_t D)
+/* columns per task when combining two rows */
+#define HNF_MODULAR_CHUNK 32
+
+typedef struct
+{
+    fmpz_mat_struct * H;
+    slong k, i, j0, j1;
+    const fmpz * u;
+    const fmpz * v;
+    const fmpz * r1d;
+    const fmpz * r2d;
+    const fmpz * R;
+    const fmpz * R2;
+} _hnf_modular_arg_struct;
+
+/*
+   (row k, row i) = (u row k + v row i, r1d row i - r2d row k) mod R on
+   columns j0 to j1, with symmetric remainders
+*/
+static void _combine_rows_worker(void * varg)
+{
+    _hnf_modular_arg_struct * arg = (_hnf_modular_arg_struct *) varg;
+    fmpz_mat_struct * H = arg->H;
+    slong j, k = arg->k, i = arg->i;
+    fmpz_t b;
+
+    fmpz_init(b);
+
+    for (j = arg->j0; j < arg->j1; j++)
+    {
+        fmpz_mul(b, arg->u, fmpz_mat_entry(H, k, j));
+        fmpz_addmul(b, arg->v, fmpz_mat_entry(H, i, j));
+        fmpz_mul(fmpz_mat_entry(H, i, j), arg->r1d,
+                 fmpz_mat_entry(H, i, j));
+        fmpz_submul(fmpz_mat_entry(H, i, j), arg->r2d,
+                    fmpz_mat_entry(H, k, j));
+        fmpz_mod(fmpz_mat_entry(H, i, j), fmpz_mat_entry(H, i, j), arg->R);
+        if (fmpz_cmp(fmpz_mat_entry(H, i, j), arg->R2) > 0)
+            fmpz_sub(fmpz_mat_entry(H, i, j),
+                     fmpz_mat_entry(H, i, j), arg->R);
+        fmpz_mod(fmpz_mat_entry(H, k, j), b, arg->R);
+        if (fmpz_cmp(fmpz_mat_entry(H, k, j), arg->R2) > 0)
+            fmpz_sub(fmpz_mat_entry(H, k, j),
+                     fmpz_mat_entry(H, k, j), arg->R);
+    }
+
+    fmpz_clear(b);
+}
+
+/* reduce the entry of row i in column k with row k */
+static void _reduce_row_worker(void * varg)
+{
+    _hnf_modular_arg_struct * arg = (_hnf_modular_arg_struct *) varg;
+    fmpz_mat_struct * H = arg->H;
+    slong j, k = arg->k, i = arg->i;
+    fmpz_t q;
+
+    fmpz_init(q);
+
+    fmpz_fdiv_q(q, fmpz_mat_entry(H, i, k), fmpz_mat_entry(H, k, k));
+    for (j = k; j < arg->j1; j++)
+    {
+        fmpz_submul(fmpz_mat_entry(H, i, j), q,
+                    fmpz_mat_entry(H, k, j));
+    }
+
+    fmpz_clear(q);
+}
+
+typedef struct
 {
-    slong j, i, k, m, n;
-    fmpz_t R, R2, d, u, v, r1d, r2d, b, q;
+    fmpz_mat_struct * H;
+    const fmpz * D;
+    int threaded;
+} _hnf_modular_struct;
 
-    m = fmpz_mat_nrows(A);
-    n = fmpz_mat_ncols(A);
+static void _hnf_modular(void * varg)
+{
+    _hnf_modular_struct * harg = (_hnf_modular_struct *) varg;
+    fmpz_mat_struct * H = harg->H;
+    slong j, i, k, m, n, num;
+    fmpz_t R, R2, d, u, v, r1d, r2d;
+    _hnf_modular_arg_struct * args;
+    thread_pool_task_group_t G;
 
-    fmpz_init_set(R, D);
+    m = fmpz_mat_nrows(H);
+    n = fmpz_mat_ncols(H);
+
+    fmpz_init_set(R, harg->D);
     fmpz_init(R2);
     fmpz_init(u);
-    fmpz_init(u);
     fmpz_init(v);
     fmpz_init(d);
     fmpz_init(r1d);
     fmpz_init(r2d);
-    fmpz_init(b);
-    fmpz_init(q);
-    fmpz_mat_set(H, A);
+
+    args = flint_malloc(FLINT_MAX(m, n)*sizeof(_hnf_modular_arg_struct));
+    for (i = 0; i < FLINT_MAX(m, n); i++)
+    {
+        args[i].H = H;
+        args[i].u = u;
+        args[i].v = v;
+        args[i].r1d = r1d;
+        args[i].r2d = r2d;
+        args[i].R = R;
+        args[i].R2 = R2;
+    }
+
+    thread_pool_task_group_init(G);
 
     for (k = 0; k != n; k++)
     {
@@ -47,23 +137,23 @@ fmpz_mat_hnf_modular(fmpz_mat_t H, const fmpz_mat_t A, const fmpz_t D)
                       fmpz_mat_entry(H, i, k));
             fmpz_divexact(r1d, fmpz_mat_entry(H, k, k), d);
             fmpz_divexact(r2d, fmpz_mat_entry(H, i, k), d);
-            for (j = k; j < n; j++)
+
+            /* split the columns, each task is independent */
+            num = harg->threaded ? (n - k)/HNF_MODULAR_CHUNK : 1;
+            num = FLINT_MAX(num, 1);
+            for (j = 0; j < num; j++)
             {
-                fmpz_mul(b, u, fmpz_mat_entry(H, k, j));
-                fmpz_addmul(b, v, fmpz_mat_entry(H, i, j));
-                fmpz_mul(fmpz_mat_entry(H, i, j), r1d,
-                         fmpz_mat_entry(H, i, j));
-                fmpz_submul(fmpz_mat_entry(H, i, j), r2d,
-                            fmpz_mat_entry(H, k, j));
-                fmpz_mod(fmpz_mat_entry(H, i, j), fmpz_mat_entry(H, i, j), R);
-                if (fmpz_cmp(fmpz_mat_entry(H, i, j), R2) > 0)
-                    fmpz_sub(fmpz_mat_entry(H, i, j),
-                             fmpz_mat_entry(H, i, j), R);
-                fmpz_mod(fmpz_mat_entry(H, k, j), b, R);
-                if (fmpz_cmp(fmpz_mat_entry(H, k, j), R2) > 0)
-                    fmpz_sub(fmpz_mat_entry(H, k, j),
-                             fmpz_mat_entry(H, k, j), R);
+                args[j].k = k;
+                args[j].i = i;
+                args[j].j0 = k + j*(n - k)/num;
+                args[j].j1 = k + (j + 1)*(n - k)/num;
+
+                if (j + 1 < num)
+                    thread_pool_spawn(G, _combine_rows_worker, args + j);
+                else
+                    _combine_rows_worker(args + j);
             }
+            thread_pool_sync(G);
         }
 
         fmpz_xgcd(d, u, v, fmpz_mat_entry(H, k, k), R);
@@ -75,26 +165,51 @@ fmpz_mat_hnf_modular(fmpz_mat_t H, const fmpz_mat_t A, const fmpz_t D)
         if (fmpz_is_zero(fmpz_mat_entry(H, k, k)))
             fmpz_set(fmpz_mat_entry(H, k, k), R);
 
-        /* reduce higher entries of column k with row k */
+        /* reduce higher entries of column k with row k, independently */
         for (i = k - 1; i >= 0; i--)
         {
-            fmpz_fdiv_q(q, fmpz_mat_entry(H, i, k), fmpz_mat_entry(H, k, k));
-            for (j = k; j < n; j++)
-            {
-                fmpz_submul(fmpz_mat_entry(H, i, j), q,
-                            fmpz_mat_entry(H, k, j));
-            }
+            args[i].k = k;
+            args[i].i = i;
+            args[i].j1 = n;
+
+            if (harg->threaded && i > 0)
+                thread_pool_spawn(G, _reduce_row_worker, args + i);
+            else
+                _reduce_row_worker(args + i);
         }
+        thread_pool_sync(G);
+
         fmpz_divexact(R, R, d);
     }
 
-    fmpz_clear(b);
+    thread_pool_task_group_clear(G);
+    flint_free(args);
+
     fmpz_clear(r2d);
     fmpz_clear(r1d);
-    fmpz_clear(q);
     fmpz_clear(d);
     fmpz_clear(v);
     fmpz_clear(u);
     fmpz_clear(R2);
     fmpz_clear(R);
 }
+
+void
+fmpz_mat_hnf_modular(fmpz_mat_t H, const fmpz_mat_t A, const fmpz_t D)
+{
+    _hnf_modular_struct harg;
+    slong n = fmpz_mat_ncols(A);
+
+    fmpz_mat_set(H, A);
+
+    harg.H = H;
+    harg.D = D;
+    /* each row operation should outweigh the cost of scheduling it */
+    harg.threaded = flint_get_num_threads() > 1 &&
+                        n >= 2*HNF_MODULAR_CHUNK && n*fmpz_size(D) >= 256;
+
+    if (harg.threaded)
+        flint_run_tasks(_hnf_modular, &harg, flint_get_num_threads());
+    else
+        _hnf_modular(&harg);
+}
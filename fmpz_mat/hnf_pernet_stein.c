@@ -20,8 +20,8 @@ add_columns(fmpz_mat_t H, const fmpz_mat_t B, const fmpz_mat_t H1, flint_rand_t
     slong i, j, n, bits;
     fmpz_t den, tmp, one;
     fmpq_t num, alpha;
-    fmpz_mat_t Bu, B1, cols, k;
-    fmpq_mat_t H1_q, cols_q, x;
+    fmpz_mat_t Bu, B1, cols, k, X;
+    fmpq_mat_t x;
 
     n = B->r;
 
@@ -30,8 +30,6 @@ add_columns(fmpz_mat_t H, const fmpz_mat_t B, const fmpz_mat_t H1, flint_rand_t
     fmpz_mat_init(cols, n, B->c - n);
     fmpz_mat_init(k, n, 1);
     fmpq_mat_init(x, n, B->c - n);
-    fmpq_mat_init(cols_q, n, B->c - n);
-    fmpq_mat_init(H1_q, n, n);
 
     for (i = 0; i < n; i++)
         for (j = 0; j < cols->c; j++)
@@ -128,10 +126,17 @@ add_columns(fmpz_mat_t H, const fmpz_mat_t B, const fmpz_mat_t H1, flint_rand_t
     fmpz_clear(one);
     fmpq_clear(alpha);
 
-    /* set cols = H1*x and place in position in H */
-    fmpq_mat_set_fmpz_mat(H1_q, H1);
-    fmpq_mat_mul(cols_q, H1_q, x);
-    fmpq_mat_get_fmpz_mat(cols, cols_q);
+    /*
+       set cols = H1*x and place in position in H, the product is integral
+       so multiply by the numerators over a common denominator
+    */
+    fmpz_mat_init(X, n, B->c - n);
+    fmpz_init(den);
+    fmpq_mat_get_fmpz_mat_matwise(X, den, x);
+    fmpz_mat_mul(cols, H1, X);
+    fmpz_mat_scalar_divexact_fmpz(cols, cols, den);
+    fmpz_clear(den);
+    fmpz_mat_clear(X);
     for (i = 0; i < n; i++)
     {
         for (j = 0; j < n; j++)
@@ -140,9 +145,7 @@ add_columns(fmpz_mat_t H, const fmpz_mat_t B, const fmpz_mat_t H1, flint_rand_t
             fmpz_set(fmpz_mat_entry(H, i, j), fmpz_mat_entry(cols, i, j - n));
     }
 
-    fmpq_mat_clear(H1_q);
     fmpq_mat_clear(x);
-    fmpq_mat_clear(cols_q);
     fmpz_mat_clear(k);
     fmpz_mat_clear(cols);
     fmpz_mat_clear(Bu);
@@ -253,18 +256,88 @@ add_rows(fmpz_mat_t H, slong start_row, slong *pivots, slong num_pivots)
     fmpz_clear(b);
 }
 
+typedef struct
+{
+    const fmpz_mat_struct * B;
+    const fmpz_mat_struct * c;
+    const fmpz_mat_struct * d;
+    const fmpz * u1;
+    const fmpz * u2;
+} _double_det_arg_struct;
+
+/*
+   the determinants of the transposes of B with row c, respectively d,
+   appended, divided by u1, respectively u2, modulo p
+*/
+static slong
+_double_det_image(mp_ptr v, nmod_t mod, void * varg)
+{
+    _double_det_arg_struct * arg = (_double_det_arg_struct *) varg;
+    const fmpz_mat_struct * B = arg->B;
+    slong i, j, n = B->c, * P;
+    mp_limb_t p = mod.n, u1mod, u2mod;
+    nmod_mat_t Btmod;
+
+    u1mod = fmpz_fdiv_ui(arg->u1, p);
+    u2mod = fmpz_fdiv_ui(arg->u2, p);
+    if (u1mod == 0 || u2mod == 0)
+        return -1;
+
+    P = _perm_init(n);
+    nmod_mat_init(Btmod, n, n, p);
+
+    for (i = 0; i < n; i++)
+    {
+        for (j = 0; j < n - 1; j++)
+            nmod_mat_entry(Btmod, i, j) =
+                fmpz_fdiv_ui(fmpz_mat_entry(B, j, i), p);
+        nmod_mat_entry(Btmod, i, n - 1) =
+            fmpz_fdiv_ui(fmpz_mat_entry(arg->c, 0, i), p);
+    }
+    nmod_mat_lu(P, Btmod, 0);
+    v[0] = UWORD(1);
+    for (i = 0; i < n; i++)
+        v[0] = n_mulmod2_preinv(v[0], nmod_mat_entry(Btmod, i, i), p,
+                mod.ninv);
+    if (_perm_parity(P, n) == 1)
+        v[0] = nmod_neg(v[0], mod);
+
+    for (i = 0; i < n; i++)
+    {
+        for (j = 0; j < n - 1; j++)
+            nmod_mat_entry(Btmod, i, j) =
+                fmpz_fdiv_ui(fmpz_mat_entry(B, j, i), p);
+        nmod_mat_entry(Btmod, i, n - 1) =
+            fmpz_fdiv_ui(fmpz_mat_entry(arg->d, 0, i), p);
+    }
+    nmod_mat_lu(P, Btmod, 0);
+    v[1] = UWORD(1);
+    for (i = 0; i < n; i++)
+        v[1] = n_mulmod2_preinv(v[1], nmod_mat_entry(Btmod, i, i), p,
+                mod.ninv);
+    if (_perm_parity(P, n) == 1)
+        v[1] = nmod_neg(v[1], mod);
+
+    v[0] = n_mulmod2_preinv(v[0], n_invmod(u1mod, p), p, mod.ninv);
+    v[1] = n_mulmod2_preinv(v[1], n_invmod(u2mod, p), p, mod.ninv);
+
+    nmod_mat_clear(Btmod);
+    _perm_clear(P);
+
+    return 2;
+}
+
 static void
 double_det(fmpz_t d1, fmpz_t d2, const fmpz_mat_t B, const fmpz_mat_t c,
         const fmpz_mat_t d)
 {
     slong i, j, n;
-    slong *P;
-    mp_limb_t p, u1mod, u2mod, v1mod, v2mod;
-    fmpz_t bound, prod, s1, s2, t, u1, u2, v1, v2;
+    fmpz_t bound, s1, s2, t, u1, u2;
+    fmpz * v;
     fmpz_mat_t dt, Bt;
     fmpq_t tmpq;
     fmpq_mat_t x;
-    nmod_mat_t Btmod;
+    _double_det_arg_struct arg;
 
     n = B->c;
 
@@ -286,14 +359,12 @@ double_det(fmpz_t d1, fmpz_t d2, const fmpz_mat_t B, const fmpz_mat_t c,
     if (!fmpq_is_zero(fmpq_mat_entry(x, n - 1, 0)))
     {
         fmpz_init(bound);
-        fmpz_init(prod);
         fmpz_init(t);
         fmpz_init(s1);
         fmpz_init(s2);
         fmpz_init(u1);
         fmpz_init(u2);
-        fmpz_init(v1);
-        fmpz_init(v2);
+        v = _fmpz_vec_init(2);
 
         /* compute lcm of denominators of vectors x and y */
         fmpq_init(tmpq);
@@ -347,74 +418,28 @@ double_det(fmpz_t d1, fmpz_t d2, const fmpz_mat_t B, const fmpz_mat_t c,
             fmpz_set(bound, s2);
         fmpz_mul_ui(bound, bound, UWORD(2));
 
-        fmpz_one(prod);
-        P = _perm_init(n);
-        nmod_mat_init(Btmod, n, n, 2);
-        p = UWORD(1) << NMOD_MAT_OPTIMAL_MODULUS_BITS;
-        /* compute determinants divided by u1 and u2 */
-        while (fmpz_cmp(prod, bound) <= 0)
-        {
-            p = n_nextprime(p, 0);
-            u1mod = fmpz_fdiv_ui(u1, p);
-            u2mod = fmpz_fdiv_ui(u2, p);
-            if (!(u1mod || u2mod))
-                continue;
-            _nmod_mat_set_mod(Btmod, p);
-            for (i = 0; i < n; i++)
-            {
-                for (j = 0; j < n - 1; j++)
-                    nmod_mat_entry(Btmod, i, j) =
-                        fmpz_fdiv_ui(fmpz_mat_entry(B, j, i), p);
-                nmod_mat_entry(Btmod, i, n - 1) =
-                    fmpz_fdiv_ui(fmpz_mat_entry(c, 0, i), p);
-            }
-            nmod_mat_lu(P, Btmod, 0);
-            v1mod = UWORD(1);
-            for (i = 0; i < n; i++)
-                v1mod = n_mulmod2_preinv(v1mod, nmod_mat_entry(Btmod, i, i), p,
-                        Btmod->mod.ninv);
-            if (_perm_parity(P, n) == 1)
-                v1mod = nmod_neg(v1mod, Btmod->mod);
+        arg.B = B;
+        arg.c = c;
+        arg.d = d;
+        arg.u1 = u1;
+        arg.u2 = u2;
 
-            for (i = 0; i < n; i++)
-            {
-                for (j = 0; j < n - 1; j++)
-                    nmod_mat_entry(Btmod, i, j) =
-                        fmpz_fdiv_ui(fmpz_mat_entry(B, j, i), p);
-                nmod_mat_entry(Btmod, i, n - 1) =
-                    fmpz_fdiv_ui(fmpz_mat_entry(d, 0, i), p);
-            }
-            nmod_mat_lu(P, Btmod, 0);
-            v2mod = UWORD(1);
-            for (i = 0; i < n; i++)
-                v2mod = n_mulmod2_preinv(v2mod, nmod_mat_entry(Btmod, i, i), p,
-                        Btmod->mod.ninv);
-            if (_perm_parity(P, n) == 1)
-                v2mod = nmod_neg(v2mod, Btmod->mod);
-
-            v1mod = n_mulmod2_preinv(v1mod, n_invmod(u1mod, p), p,
-                    Btmod->mod.ninv);
-            v2mod = n_mulmod2_preinv(v2mod, n_invmod(u2mod, p), p,
-                    Btmod->mod.ninv);
-            fmpz_CRT_ui(v1, v1, prod, v1mod, p, 1);
-            fmpz_CRT_ui(v2, v2, prod, v2mod, p, 1);
-            fmpz_mul_ui(prod, prod, p);
-        }
+        /* compute determinants divided by u1 and u2 */
+        _fmpz_vec_modular(v, 2, fmpz_bits(bound) + 1, 0,
+                          FMPZ_VEC_MODULAR_FIXED_LENGTH,
+                          UWORD(1) << NMOD_MAT_OPTIMAL_MODULUS_BITS,
+                          _double_det_image, NULL, &arg);
 
-        fmpz_mul(d1, u1, v1);
-        fmpz_mul(d2, u2, v2);
+        fmpz_mul(d1, u1, v + 0);
+        fmpz_mul(d2, u2, v + 1);
 
         fmpz_clear(bound);
-        fmpz_clear(prod);
         fmpz_clear(s1);
         fmpz_clear(s2);
         fmpz_clear(u1);
         fmpz_clear(u2);
-        fmpz_clear(v1);
-        fmpz_clear(v2);
+        _fmpz_vec_clear(v, 2);
         fmpz_clear(t);
-        _perm_clear(P);
-        nmod_mat_clear(Btmod);
     }
     else                        /* can't use the clever method above so naively compute both dets */
     {
@@ -57,24 +57,22 @@ fmpz_mat_hnf_transform(fmpz_mat_t H, fmpz_mat_t U, const fmpz_mat_t A)
     m = fmpz_mat_nrows(A);
     n = fmpz_mat_ncols(A);
 
-    if (n > m)
-        _fmpz_mat_hnf_transform_naive(H, U, A);
-    else
-    {
-        flint_randinit(state);
-        p = n_randprime(state, NMOD_MAT_OPTIMAL_MODULUS_BITS, 1);
-        nmod_mat_init(Amod, m, n, p);
+    /* the rank modulo p is a lower bound for the rank */
+    flint_randinit(state);
+    p = n_randprime(state, NMOD_MAT_OPTIMAL_MODULUS_BITS, 1);
+    nmod_mat_init(Amod, m, n, p);
 
-        fmpz_mat_get_nmod_mat(Amod, A);
-        r = nmod_mat_rref(Amod);
+    fmpz_mat_get_nmod_mat(Amod, A);
+    r = nmod_mat_rref(Amod);
 
-        nmod_mat_clear(Amod);
+    nmod_mat_clear(Amod);
 
-        flint_randclear(state);
+    flint_randclear(state);
 
-        if (r == n) /* Full column rank */
-            fmpz_mat_hnf_minors_transform(H, U, A);
-        else
-            _fmpz_mat_hnf_transform_naive(H, U, A);
-    }
+    if (r == n && n <= m) /* Full column rank */
+        fmpz_mat_hnf_minors_transform(H, U, A);
+    else if (r == m) /* Full row rank, U is unique */
+        fmpz_mat_hnf_transform_solve(H, U, A);
+    else
+        _fmpz_mat_hnf_transform_naive(H, U, A);
 }
@@ -0,0 +1,92 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz_mat.h"
+
+int
+fmpz_mat_hnf_transform_solve(fmpz_mat_t H, fmpz_mat_t U, const fmpz_mat_t A)
+{
+    slong i, j, m, n, * pivots;
+    fmpz_mat_t At, Ht, X;
+    fmpz_t den;
+
+    if (H == A)
+    {
+        int result;
+
+        fmpz_mat_init_set(At, A);
+        result = fmpz_mat_hnf_transform_solve(H, U, At);
+        fmpz_mat_clear(At);
+
+        return result;
+    }
+
+    m = fmpz_mat_nrows(A);
+    n = fmpz_mat_ncols(A);
+
+    fmpz_mat_hnf(H, A);
+
+    /* with full row rank every row of H has a pivot */
+    pivots = (slong *) flint_malloc(m*sizeof(slong));
+    for (i = 0, j = 0; i < m; i++, j++)
+    {
+        for ( ; j < n && fmpz_is_zero(fmpz_mat_entry(H, i, j)); j++) ;
+        if (j == n)
+        {
+            flint_free(pivots);
+            return 0;
+        }
+        pivots[i] = j;
+    }
+
+    if (m == 0)
+    {
+        flint_free(pivots);
+        return 1;
+    }
+
+    /*
+       U is unique, and restricting U A = H to the pivot columns gives a
+       nonsingular system, which we solve transposed
+    */
+    fmpz_mat_init(At, m, m);
+    fmpz_mat_init(Ht, m, m);
+    fmpz_mat_init(X, m, m);
+    fmpz_init(den);
+
+    for (i = 0; i < m; i++)
+    {
+        for (j = 0; j < m; j++)
+        {
+            fmpz_set(fmpz_mat_entry(At, i, j), fmpz_mat_entry(A, j, pivots[i]));
+            fmpz_set(fmpz_mat_entry(Ht, i, j), fmpz_mat_entry(H, j, pivots[i]));
+        }
+    }
+
+    if (!fmpz_mat_solve(X, den, At, Ht))
+    {
+        flint_printf("Exception (fmpz_mat_hnf_transform_solve). "
+                "Singular pivot columns.\n");
+        flint_abort();
+    }
+
+    for (i = 0; i < m; i++)
+        for (j = 0; j < m; j++)
+            fmpz_divexact(fmpz_mat_entry(U, i, j), fmpz_mat_entry(X, j, i), den);
+
+    flint_free(pivots);
+    fmpz_mat_clear(At);
+    fmpz_mat_clear(Ht);
+    fmpz_mat_clear(X);
+    fmpz_clear(den);
+
+    return 1;
+}
@@ -18,6 +18,7 @@
 #include "fmpz_mat.h"
 #include "nmod_mat.h"
 #include "nmod_poly.h"
+#include "thread_support.h"
 
 #define MINPOLY_M_LOG2E  1.44269504088896340736  /* log2(e) */
 
@@ -108,10 +109,111 @@ void _fmpz_mat_bound_ovals_of_cassini(fmpz_t b, const fmpz_mat_t op)
    fmpz_clear(q);
 }
 
+typedef struct
+{
+    const fmpz_mat_struct * op;
+    ulong * Q;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+} _minpoly_arg_struct;
+
+/* the minimal polynomial modulo p, recording its generators in Q */
+static slong _minpoly_image(mp_ptr res, nmod_t mod, void * varg)
+{
+    _minpoly_arg_struct * arg = (_minpoly_arg_struct *) varg;
+    const fmpz_mat_struct * op = arg->op;
+    slong i, n = op->r, len;
+    nmod_mat_t mat;
+    nmod_poly_t poly;
+    ulong * P;
+
+    P = (ulong *) flint_calloc(n, sizeof(ulong));
+    nmod_mat_init(mat, n, n, mod.n);
+    nmod_poly_init(poly, mod.n);
+
+    fmpz_mat_get_nmod_mat(mat, op);
+    nmod_mat_minpoly_with_gens(poly, mat, P);
+
+    len = poly->length;
+    _nmod_vec_set(res, poly->coeffs, len);
+
+    /*
+       generators of a bad prime only make the final check stricter,
+       so they need not be discarded
+    */
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&arg->mutex);
+#endif
+    for (i = 0; i < n; i++)
+       arg->Q[i] |= P[i];
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&arg->mutex);
+#endif
+
+    nmod_mat_clear(mat);
+    nmod_poly_clear(poly);
+    flint_free(P);
+
+    return len;
+}
+
+/* check f(A)v = 0 for all generators v */
+static int _minpoly_check(const fmpz * rop, slong len,
+                                            const fmpz_t m, void * varg)
+{
+    _minpoly_arg_struct * arg = (_minpoly_arg_struct *) varg;
+    const fmpz_mat_struct * op = arg->op;
+    slong i, j, n = op->r;
+    fmpz_mat_t v1, v2, v3;
+
+    fmpz_mat_init(v1, n, 1);
+    fmpz_mat_init(v2, n, 1);
+    fmpz_mat_init(v3, n, 1);
+
+    for (i = 0; i < n; i++)
+    {
+       if (arg->Q[i] == 1)
+       {
+          fmpz_mat_zero(v1);
+          fmpz_mat_zero(v3);
+
+          fmpz_set_ui(fmpz_mat_entry(v1, i, 0), 1);
+
+          for (j = 0; j < len; j++)
+          {
+             fmpz_mat_scalar_mul_fmpz(v2, v1, rop + j);
+             fmpz_mat_add(v3, v3, v2);
+
+             if (j != len - 1)
+             {
+                fmpz_mat_mul(v2, op, v1);
+                fmpz_mat_swap(v1, v2);
+             }
+          }
+
+          for (j = 0; j < n; j++)
+          {
+             if (!fmpz_is_zero(v3->rows[j] + 0))
+                 break;
+          }
+
+          if (j != n)
+             break;
+       }
+    }
+
+    fmpz_mat_clear(v1);
+    fmpz_mat_clear(v2);
+    fmpz_mat_clear(v3);
+
+    return i == n;
+}
+
 slong _fmpz_mat_minpoly_modular(fmpz * rop, const fmpz_mat_t op)
 {
     const slong n = op->r;
-    slong len = 0, oldlen = 0;
+    slong len = 0;
 
     if (n < 2)
     {
@@ -132,13 +234,9 @@ slong _fmpz_mat_minpoly_modular(fmpz * rop, const fmpz_mat_t op)
         slong bound;
         double b1, b2, b3, bb;
 
-        slong pbits  = FLINT_BITS - 1, i, j;
+        slong pbits  = FLINT_BITS - 1;
         mp_limb_t p = (UWORD(1) << pbits);
-        ulong * P, * Q;
-
-        fmpz_mat_t v1, v2, v3;
-        fmpz * rold;
-        fmpz_t m;
+        _minpoly_arg_struct arg;
 
         if (fmpz_mat_is_zero(op))
         {
@@ -170,131 +268,21 @@ slong _fmpz_mat_minpoly_modular(fmpz * rop, const fmpz_mat_t op)
             fmpz_clear(b);
         }
 
-        P = (ulong *) flint_calloc(n, sizeof(ulong));
-        Q = (ulong *) flint_calloc(n, sizeof(ulong));
-        rold = (fmpz *) _fmpz_vec_init(n + 1);
-        fmpz_mat_init(v1, n, 1);
-        fmpz_mat_init(v2, n, 1);
-        fmpz_mat_init(v3, n, 1);
-
-        fmpz_init_set_ui(m, 1);
-
-        oldlen = 0;
-        len = 0;
-
-        for ( ; fmpz_bits(m) <= bound; )
-        {
-            nmod_mat_t mat;
-            nmod_poly_t poly;
-            
-            p = n_nextprime(p, 0);
-
-            nmod_mat_init(mat, n, n, p);
-            nmod_poly_init(poly, p);
-
-            for (i = 0; i < n; i++)
-               P[i] = 0;
-
-            fmpz_mat_get_nmod_mat(mat, op);
-            nmod_mat_minpoly_with_gens(poly, mat, P);
-
-            len = poly->length;
-
-            if (oldlen != 0 && len > oldlen)
-            {
-               /* all previous primes were bad, discard */
-                           
-               fmpz_one(m);
-               oldlen = len;
-
-               for (i = 0; i < n + 1; i++)
-                  fmpz_zero(rop + i);
-
-               for (i = 0; i < n; i++)
-                  Q[i] = 0;
-            } else if (len < oldlen)
-            {
-               /* this prime was bad, skip */
-
-               nmod_mat_clear(mat);
-               nmod_poly_clear(poly);
-            
-               continue;   
-            }
-
-            for (i = 0; i < n; i++)
-               Q[i] |= P[i];
-
-            _fmpz_poly_CRT_ui(rop, rop, n + 1, m, poly->coeffs, 
-                              poly->length, poly->mod.n, poly->mod.ninv, 1);
-
-            fmpz_mul_ui(m, m, p);
-
-            /* check if stabilised */
-            for (i = 0; i < len; i++)
-            {
-               if (!fmpz_equal(rop + i, rold + i))
-                  break;
-            }
-
-            for (j = 0; j < len; j++)
-               fmpz_set(rold + j, rop + j);
-
-            if (i == len) /* stabilised */
-            {
-               for (i = 0; i < n; i++)
-               {
-                  if (Q[i] == 1)
-                  {
-                     fmpz_mat_zero(v1);
-                     fmpz_mat_zero(v3);
-
-                     fmpz_set_ui(fmpz_mat_entry(v1, i, 0), 1);
-
-                     for (j = 0; j < len; j++)
-                     {
-                        fmpz_mat_scalar_mul_fmpz(v2, v1, rop + j);
-                        fmpz_mat_add(v3, v3, v2);
-
-                        if (j != len - 1)
-                        {
-                           fmpz_mat_mul(v2, op, v1);
-                           fmpz_mat_swap(v1, v2);
-                        }
-                     }
-                  
-                     /* check f(A)v = 0 */
-                     for (j = 0; j < n; j++)
-                     {
-                        if (!fmpz_is_zero(v3->rows[j] + 0))
-                            break;
-                     }
-
-                     if (j != n)
-                        break;
-                  }
-               }
-
-               /* if f(A)v = 0 for all generators v, we are done */
-               if (i == n)
-               {
-                  nmod_mat_clear(mat);
-                  nmod_poly_clear(poly);
-                  break;
-               }
-            }
-
-            nmod_mat_clear(mat);
-            nmod_poly_clear(poly);
-        }
-
-        flint_free(P);
-        flint_free(Q);
-        fmpz_mat_clear(v2);
-        fmpz_mat_clear(v1);
-        fmpz_mat_clear(v3);
-        fmpz_clear(m);
-        _fmpz_vec_clear(rold, n);
+        arg.op = op;
+        arg.Q = (ulong *) flint_calloc(n, sizeof(ulong));
+#if FLINT_USES_PTHREAD
+        pthread_mutex_init(&arg.mutex, NULL);
+#endif
+
+        /* check as soon as a prime leaves the result unchanged */
+        len = _fmpz_vec_modular(rop, n + 1, bound + 1, 1,
+                      FMPZ_VEC_MODULAR_MAX_LENGTH, p, _minpoly_image,
+                      _minpoly_check, &arg);
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_destroy(&arg.mutex);
+#endif
+        flint_free(arg.Q);
     }
 
     return len;
@@ -10,12 +10,137 @@
 */
 
 #include "fmpz_mat.h"
+#include "thread_support.h"
 
-static void _eliminate_col(fmpz_mat_t S, slong i, const fmpz_t mod)
+typedef struct
+{
+    fmpz_mat_struct * S;
+    slong i, start, stop;
+    const fmpz * t;     /* multipliers */
+    const fmpz * mod;
+    int reduce;
+} _snf_arg_struct;
+
+/*
+   Runs f on the ranges of indices of a partition of [start, stop), as
+   independent tasks if num > 1.
+*/
+static void _snf_run(void (* f)(void *), _snf_arg_struct * arg,
+                                         slong start, slong stop, slong num)
+{
+    slong j;
+    _snf_arg_struct * args;
+    thread_pool_task_group_t G;
+
+    num = FLINT_MIN(num, stop - start);
+
+    if (num <= 1)
+    {
+        arg->start = start;
+        arg->stop = stop;
+        f(arg);
+        return;
+    }
+
+    args = flint_malloc(num*sizeof(_snf_arg_struct));
+    thread_pool_task_group_init(G);
+
+    for (j = 0; j < num; j++)
+    {
+        args[j] = *arg;
+        args[j].start = start + j*(stop - start)/num;
+        args[j].stop = start + (j + 1)*(stop - start)/num;
+
+        if (j + 1 < num)
+            thread_pool_spawn(G, f, args + j);
+        else
+            f(args + j);
+    }
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+    flint_free(args);
+}
+
+/* row i += sum t[k - i - 1] row k on the columns start to stop */
+static void _gcd_row_worker(void * varg)
+{
+    _snf_arg_struct * arg = (_snf_arg_struct *) varg;
+    fmpz_mat_struct * S = arg->S;
+    slong j, k, i = arg->i;
+
+    for (k = i + 1; k < S->r; k++)
+        for (j = arg->start; j < arg->stop; j++)
+            fmpz_addmul(fmpz_mat_entry(S, i, j), arg->t + k - i - 1,
+                    fmpz_mat_entry(S, k, j));
+}
+
+/* reduce the rows start to stop with row i, then modulo mod */
+static void _reduce_rows_worker(void * varg)
+{
+    _snf_arg_struct * arg = (_snf_arg_struct *) varg;
+    fmpz_mat_struct * S = arg->S;
+    slong j, k, i = arg->i;
+
+    for (k = arg->start; k < arg->stop; k++)
+    {
+        if (arg->reduce)
+        {
+            for (j = i; j < S->c; j++)
+                fmpz_addmul(fmpz_mat_entry(S, k, j), arg->t + k - i - 1,
+                        fmpz_mat_entry(S, i, j));
+            fmpz_mod(fmpz_mat_entry(S, k, i), fmpz_mat_entry(S, k, i),
+                                                                    arg->mod);
+        }
+        for (j = i + 1; j < S->c; j++)
+            fmpz_fdiv_r(fmpz_mat_entry(S, k, j), fmpz_mat_entry(S, k, j),
+                                                                    arg->mod);
+    }
+}
+
+/* col i += sum t[k - i - 1] col k on the rows start to stop */
+static void _gcd_col_worker(void * varg)
+{
+    _snf_arg_struct * arg = (_snf_arg_struct *) varg;
+    fmpz_mat_struct * S = arg->S;
+    slong j, k, i = arg->i;
+
+    for (j = arg->start; j < arg->stop; j++)
+        for (k = i + 1; k < S->c; k++)
+            fmpz_addmul(fmpz_mat_entry(S, j, i), arg->t + k - i - 1,
+                    fmpz_mat_entry(S, j, k));
+}
+
+/*
+   reduce the columns after i with column i on the rows start to stop,
+   then the rows after i modulo mod
+*/
+static void _reduce_cols_worker(void * varg)
+{
+    _snf_arg_struct * arg = (_snf_arg_struct *) varg;
+    fmpz_mat_struct * S = arg->S;
+    slong j, k, i = arg->i;
+
+    for (j = arg->start; j < arg->stop; j++)
+    {
+        if (arg->reduce)
+            for (k = i + 1; k < S->c; k++)
+                fmpz_addmul(fmpz_mat_entry(S, j, k), arg->t + k - i - 1,
+                        fmpz_mat_entry(S, j, i));
+        if (j > i)
+            for (k = i; k < S->c; k++)
+                fmpz_fdiv_r(fmpz_mat_entry(S, j, k), fmpz_mat_entry(S, j, k),
+                                                                    arg->mod);
+    }
+}
+
+static void _eliminate_col(fmpz_mat_t S, slong i, const fmpz_t mod,
+                                                                   slong num)
 {
     slong j, k, m, n;
     fmpz * t;
     fmpz_t b, g, u, v, r1g, r2g;
+    _snf_arg_struct arg;
 
     m = S->r;
     n = S->c;
@@ -68,34 +193,32 @@ static void _eliminate_col(fmpz_mat_t S, slong i, const fmpz_t mod)
 
     /* set row i to have gcd in col i */
     for (k = i + 1; k < m; k++)
-    {
         fmpz_mod(t + k - i - 1, t + k - i - 1, mod);
-        for (j = i; j < n; j++)
-            fmpz_addmul(fmpz_mat_entry(S, i, j), t + k - i - 1,
-                    fmpz_mat_entry(S, k, j));
-    }
 
-    _fmpz_vec_clear(t, m - i - 1);
+    arg.S = S;
+    arg.i = i;
+    arg.t = t;
+    arg.mod = mod;
+    _snf_run(_gcd_row_worker, &arg, i, n, num);
 
-    /* reduce each row k with row i */
-    if (!fmpz_is_zero(g)) /* if g = 0 then don't need to reduce */
+    /* reduce each row k with row i, if g = 0 then don't need to reduce */
+    arg.reduce = !fmpz_is_zero(g);
+    if (arg.reduce)
     {
         for (k = i + 1; k < m; k++)
         {
-            fmpz_divexact(r1g, fmpz_mat_entry(S, k, i), g);
-            fmpz_neg(r1g, r1g);
-            for (j = i; j < n; j++)
-                fmpz_addmul(fmpz_mat_entry(S, k, j), r1g,
-                        fmpz_mat_entry(S, i, j));
+            fmpz_divexact(t + k - i - 1, fmpz_mat_entry(S, k, i), g);
+            fmpz_neg(t + k - i - 1, t + k - i - 1);
         }
-        for (k = i + 1; k < m; k++)
-            fmpz_mod(fmpz_mat_entry(S, k, i), fmpz_mat_entry(S, k, i), mod);
     }
-    for (j = i; j < m; j++)
-        for (k = i + 1; k < n; k++)
-            fmpz_fdiv_r(fmpz_mat_entry(S, j, k), fmpz_mat_entry(S, j, k), mod);
+    _snf_run(_reduce_rows_worker, &arg, i + 1, m, num);
+
+    for (k = i + 1; k < n; k++)
+        fmpz_fdiv_r(fmpz_mat_entry(S, i, k), fmpz_mat_entry(S, i, k), mod);
     fmpz_gcd(fmpz_mat_entry(S, i, i), fmpz_mat_entry(S, i, i), mod);
 
+    _fmpz_vec_clear(t, m - i - 1);
+
     fmpz_clear(b);
     fmpz_clear(g);
     fmpz_clear(u);
@@ -103,11 +226,13 @@ static void _eliminate_col(fmpz_mat_t S, slong i, const fmpz_t mod)
     fmpz_clear(r2g);
 }
 
-static void _eliminate_row(fmpz_mat_t S, slong i, const fmpz_t mod)
+static void _eliminate_row(fmpz_mat_t S, slong i, const fmpz_t mod,
+                                                                   slong num)
 {
     slong j, k, m, n;
     fmpz * t;
-    fmpz_t b, g, u, v, r1g, r2g, halfmod;
+    fmpz_t b, g, u, v, r1g, r2g;
+    _snf_arg_struct arg;
 
     m = S->r;
     n = S->c;
@@ -123,8 +248,6 @@ static void _eliminate_row(fmpz_mat_t S, slong i, const fmpz_t mod)
     fmpz_init(b);
     fmpz_init(r1g);
     fmpz_init(r2g);
-    fmpz_init(halfmod);
-    fmpz_fdiv_q_2exp(halfmod, mod, 1);
 
     if (!fmpz_is_zero(fmpz_mat_entry(S, i, i)))
     {
@@ -162,76 +285,100 @@ static void _eliminate_row(fmpz_mat_t S, slong i, const fmpz_t mod)
 
     /* reduce col i to have gcd in row i */
     for (k = i + 1; k < n; k++)
-    {
         fmpz_mod(t + k - i - 1, t + k - i - 1, mod);
-        for (j = i; j < m; j++)
-            fmpz_addmul(fmpz_mat_entry(S, j, i), t + k - i - 1,
-                    fmpz_mat_entry(S, j, k));
-    }
 
-    _fmpz_vec_clear(t, n - i - 1);
+    arg.S = S;
+    arg.i = i;
+    arg.t = t;
+    arg.mod = mod;
+    _snf_run(_gcd_col_worker, &arg, i, m, num);
 
-    /* reduce each col k with col i */
-    if (!fmpz_is_zero(g)) /* if g = 0 then don't need to reduce */
+    /* reduce each col k with col i, if g = 0 then don't need to reduce */
+    arg.reduce = !fmpz_is_zero(g);
+    if (arg.reduce)
     {
         for (k = i + 1; k < n; k++)
         {
-            fmpz_divexact(r1g, fmpz_mat_entry(S, i, k), g);
-            fmpz_neg(r1g, r1g);
-            for (j = i; j < m; j++)
-                fmpz_addmul(fmpz_mat_entry(S, j, k), r1g,
-                        fmpz_mat_entry(S, j, i));
+            fmpz_divexact(t + k - i - 1, fmpz_mat_entry(S, i, k), g);
+            fmpz_neg(t + k - i - 1, t + k - i - 1);
         }
     }
-    for (j = i + 1; j < m; j++)
-        for (k = i; k < n; k++)
-            fmpz_fdiv_r(fmpz_mat_entry(S, j, k), fmpz_mat_entry(S, j, k), mod);
+    _snf_run(_reduce_cols_worker, &arg, i, m, num);
+
     fmpz_gcd(fmpz_mat_entry(S, i, i), fmpz_mat_entry(S, i, i), mod);
 
+    _fmpz_vec_clear(t, n - i - 1);
+
     fmpz_clear(b);
     fmpz_clear(g);
     fmpz_clear(u);
     fmpz_clear(r1g);
     fmpz_clear(r2g);
-    fmpz_clear(halfmod);
 }
 
-void fmpz_mat_snf_iliopoulos(fmpz_mat_t S, const fmpz_mat_t A, const fmpz_t mod)
+typedef struct
+{
+    fmpz_mat_struct * S;
+    const fmpz * mod;
+    slong num;
+} _snf_iliopoulos_struct;
+
+static void _snf_iliopoulos(void * varg)
 {
+    _snf_iliopoulos_struct * arg = (_snf_iliopoulos_struct *) varg;
+    fmpz_mat_struct * S = arg->S;
+    const fmpz * mod = arg->mod;
     slong i, k, n;
     int done;
 
-    n = FLINT_MIN(A->c, A->r);
+    n = FLINT_MIN(S->c, S->r);
 
-    fmpz_mat_set(S, A);
-
-    for (i = 0; i < A->r; i++)
-        for (k = 0; k < A->c; k++)
+    for (i = 0; i < S->r; i++)
+        for (k = 0; k < S->c; k++)
             fmpz_mod(fmpz_mat_entry(S, i, k), fmpz_mat_entry(S, i, k), mod);
 
     for (k = 0; k != n; k++)
     {
         do
         {
-            _eliminate_row(S, k, mod);
-            _eliminate_col(S, k, mod);
+            _eliminate_row(S, k, mod, arg->num);
+            _eliminate_col(S, k, mod, arg->num);
             done = 1;
             if (fmpz_is_zero(fmpz_mat_entry(S, k, k)))
             {
-                for (i = k + 1; i < A->c && done; i++)
+                for (i = k + 1; i < S->c && done; i++)
                     done = fmpz_is_zero(fmpz_mat_entry(S, k, i));
             }
             else
             {
-                for (i = k + 1; i < A->c && done; i++)
+                for (i = k + 1; i < S->c && done; i++)
                     done = fmpz_divisible(fmpz_mat_entry(S, k, i),
                             fmpz_mat_entry(S, k, k));
             }
         }
         while (!done);
-        for (i = k + 1; i < A->c; i++)
+        for (i = k + 1; i < S->c; i++)
             fmpz_zero(fmpz_mat_entry(S, k, i));
     }
+}
+
+void fmpz_mat_snf_iliopoulos(fmpz_mat_t S, const fmpz_mat_t A, const fmpz_t mod)
+{
+    _snf_iliopoulos_struct arg;
+    slong n = FLINT_MAX(A->r, A->c);
+
+    fmpz_mat_set(S, A);
+
+    arg.S = S;
+    arg.mod = mod;
+    /* each task should outweigh the cost of scheduling it */
+    arg.num = (flint_get_num_threads() > 1 && n*fmpz_size(mod) >= 256) ?
+                                              4*flint_get_num_threads() : 1;
+
+    if (arg.num > 1)
+        flint_run_tasks(_snf_iliopoulos, &arg, flint_get_num_threads());
+    else
+        _snf_iliopoulos(&arg);
 
     fmpz_mat_snf_diagonal(S, S);
 }
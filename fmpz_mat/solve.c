@@ -20,7 +20,7 @@ fmpz_mat_solve(fmpz_mat_t X, fmpz_t den,
         return fmpz_mat_solve_cramer(X, den, A, B);
     else if (fmpz_mat_nrows(A) <= 15)
         return fmpz_mat_solve_fflu(X, den, A, B);
-    else if (fmpz_mat_ncols(B) == 1)
+    else if (fmpz_mat_ncols(B) < fmpz_mat_nrows(A))
         return fmpz_mat_solve_dixon_den(X, den, A, B);
     else
         return fmpz_mat_solve_multi_mod_den(X, den, A, B);
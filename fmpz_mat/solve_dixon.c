@@ -41,13 +41,10 @@ fmpz_mat_find_good_prime_and_invert(nmod_mat_t Ainv,
     return p;
 }
 
-/* We need to perform several matrix-vector products Ay, and speed them
-   up by using modular multiplication (this is only faster if we
-   precompute the modular matrices). Note: we assume that all
-   primes are >= p. This allows reusing y_mod as the right-hand
-   side without reducing it. */
-
-#define USE_SLOW_MULTIPLICATION 0
+/* The products Ay in the lifting are done modulo several primes,
+   which is only faster because the modular images of A are
+   precomputed. Note: we assume that all primes are >= p. This
+   allows reusing y_mod as the right-hand side without reducing it. */
 
 mp_limb_t * fmpz_mat_dixon_get_crt_primes(slong * num_primes, const fmpz_mat_t A, mp_limb_t p)
 {
@@ -87,31 +84,28 @@ mp_limb_t * fmpz_mat_dixon_get_crt_primes(slong * num_primes, const fmpz_mat_t A
 }
 
 
+static void
+_solve_dixon(fmpz_mat_t X, fmpz_t mod, const fmpz_mat_dixon_t S,
+                                   const fmpz_mat_t B, const fmpz_t bound)
+{
+    fmpz_mat_t x;
+
+    fmpz_mat_init(x, S->A->r, B->c);
+    _fmpz_mat_dixon_lift(x, mod, S, B, bound, NULL, NULL);
+    fmpz_mat_set(X, x);
+    fmpz_mat_clear(x);
+}
+
 void
 _fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
                         const fmpz_mat_t A, const fmpz_mat_t B,
                     const nmod_mat_t Ainv, mp_limb_t p,
                     const fmpz_t N, const fmpz_t D)
 {
-    fmpz_t bound, ppow;
-    fmpz_mat_t x, d, y, Ay;
-    fmpz_t prod;
-    mp_limb_t * crt_primes;
-    nmod_mat_t * A_mod;
-    nmod_mat_t Ay_mod, d_mod, y_mod;
-    slong i, n, cols, num_primes;
-
-    n = A->r;
-    cols = B->c;
+    fmpz_mat_dixon_t S;
+    fmpz_t bound;
 
     fmpz_init(bound);
-    fmpz_init(ppow);
-    fmpz_init(prod);
-
-    fmpz_mat_init(x, n, cols);
-    fmpz_mat_init(y, n, cols);
-    fmpz_mat_init(Ay, n, cols);
-    fmpz_mat_init_set(d, B);
 
     /* Compute bound for the needed modulus. TODO: if one of N and D
        is much smaller than the other, we could use a tighter bound (i.e. 2ND).
@@ -124,92 +118,34 @@ _fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
         fmpz_mul(bound, N, N);
     fmpz_mul_ui(bound, bound, UWORD(2));  /* signs */
 
-    crt_primes = fmpz_mat_dixon_get_crt_primes(&num_primes, A, p);
-    A_mod = (nmod_mat_t *) flint_malloc(sizeof(nmod_mat_t) * num_primes);
-    for (i = 0; i < num_primes; i++)
-    {
-        nmod_mat_init(A_mod[i], n, n, crt_primes[i]);
-        fmpz_mat_get_nmod_mat(A_mod[i], A);
-    }
-
-    nmod_mat_init(Ay_mod, n, cols, UWORD(1));
-    nmod_mat_init(d_mod, n, cols, p);
-    nmod_mat_init(y_mod, n, cols, p);
-
-    fmpz_one(ppow);
-
-    while (fmpz_cmp(ppow, bound) <= 0)
-    {
-        /* y = A^(-1) * d  (mod p) */
-        fmpz_mat_get_nmod_mat(d_mod, d);
-        nmod_mat_mul(y_mod, Ainv, d_mod);
-
-        /* x = x + y * p^i    [= A^(-1) * b mod p^(i+1)] */
-        fmpz_mat_scalar_addmul_nmod_mat_fmpz(x, y_mod, ppow);
-
-        /* ppow = p^(i+1) */
-        fmpz_mul_ui(ppow, ppow, p);
-        if (fmpz_cmp(ppow, bound) > 0)
-            break;
+    _fmpz_mat_dixon_init(S, A, Ainv, p, D);
+    _solve_dixon(X, mod, S, B, bound);
+    fmpz_mat_dixon_clear(S);
 
-        /* d = (d - Ay) / p */
-#if USE_SLOW_MULTIPLICATION
-        fmpz_mat_set_nmod_mat_unsigned(y, y_mod);
-        fmpz_mat_mul(Ay, A, y);
-#else
-        for (i = 0; i < num_primes; i++)
-        {
-            _nmod_mat_set_mod(y_mod, crt_primes[i]);
-            _nmod_mat_set_mod(Ay_mod, crt_primes[i]);
-            nmod_mat_mul(Ay_mod, A_mod[i], y_mod);
-            if (i == 0)
-            {
-                fmpz_mat_set_nmod_mat(Ay, Ay_mod);
-                fmpz_set_ui(prod, crt_primes[0]);
-            }
-            else
-            {
-                fmpz_mat_CRT_ui(Ay, Ay, prod, Ay_mod, 1);
-                fmpz_mul_ui(prod, prod, crt_primes[i]);
-            }
-        }
-#endif
-
-        _nmod_mat_set_mod(y_mod, p);
-        fmpz_mat_sub(d, d, Ay);
-        fmpz_mat_scalar_divexact_ui(d, d, p);
-    }
-
-    fmpz_set(mod, ppow);
-    fmpz_mat_set(X, x);
-
-    nmod_mat_clear(y_mod);
-    nmod_mat_clear(d_mod);
-    nmod_mat_clear(Ay_mod);
+    fmpz_clear(bound);
+}
 
-    for (i = 0; i < num_primes; i++)
-        nmod_mat_clear(A_mod[i]);
+void
+fmpz_mat_solve_dixon_precomp(fmpz_mat_t X, fmpz_t mod,
+                              const fmpz_mat_dixon_t S, const fmpz_mat_t B)
+{
+    fmpz_t bound;
 
-    flint_free(A_mod);
-    flint_free(crt_primes);
+    if (fmpz_mat_is_empty(S->A) || fmpz_mat_is_empty(B))
+        return;
 
+    fmpz_init(bound);
+    _fmpz_mat_dixon_bound(bound, S, B);
+    _solve_dixon(X, mod, S, B, bound);
     fmpz_clear(bound);
-    fmpz_clear(ppow);
-    fmpz_clear(prod);
-
-    fmpz_mat_clear(x);
-    fmpz_mat_clear(y);
-    fmpz_mat_clear(d);
-    fmpz_mat_clear(Ay);
 }
 
 int
 fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
                         const fmpz_mat_t A, const fmpz_mat_t B)
 {
-    nmod_mat_t Ainv;
-    fmpz_t N, D;
-    mp_limb_t p;
+    fmpz_mat_dixon_t S;
+    int success;
 
     if (!fmpz_mat_is_square(A))
     {
@@ -220,18 +156,10 @@ fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
     if (fmpz_mat_is_empty(A) || fmpz_mat_is_empty(B))
         return 1;
 
-    fmpz_init(N);
-    fmpz_init(D);
-    fmpz_mat_solve_bound(N, D, A, B);
-
-    nmod_mat_init(Ainv, A->r, A->r, 1);
-    p = fmpz_mat_find_good_prime_and_invert(Ainv, A, D);
-    if (p != 0)
-        _fmpz_mat_solve_dixon(X, mod, A, B, Ainv, p, N, D);
-
-    nmod_mat_clear(Ainv);
-    fmpz_clear(N);
-    fmpz_clear(D);
+    success = fmpz_mat_dixon_init(S, A);
+    if (success)
+        fmpz_mat_solve_dixon_precomp(X, mod, S, B);
+    fmpz_mat_dixon_clear(S);
 
-    return p != 0;
+    return success;
 }
@@ -28,3 +28,15 @@ fmpz_mat_solve_dixon_den(fmpz_mat_t X, fmpz_t den,
     fmpq_mat_clear(Q);
     return success;
 }
+
+void
+fmpz_mat_solve_dixon_den_precomp(fmpz_mat_t X, fmpz_t den,
+                              const fmpz_mat_dixon_t S, const fmpz_mat_t B)
+{
+    fmpq_mat_t Q;
+
+    fmpq_mat_init(Q, fmpz_mat_nrows(X), fmpz_mat_ncols(X));
+    fmpq_mat_solve_fmpz_mat_dixon_precomp(Q, S, B);
+    fmpq_mat_get_fmpz_mat_matwise(X, den, Q);
+    fmpq_mat_clear(Q);
+}
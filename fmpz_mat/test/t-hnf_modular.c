@@ -15,6 +15,7 @@
 #include "flint.h"
 #include "fmpz.h"
 #include "fmpz_mat.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -108,6 +109,47 @@ main(void)
         fmpz_clear(det);
     }
 
+    /* Larger matrices, split into tasks if there are several threads */
+    for (iter = 0; iter < flint_test_multiplier(); iter++)
+    {
+        fmpz_t det;
+        fmpz_mat_t A, H, H2;
+        slong n;
+
+        n = 64 + n_randint(state, 16);
+
+        fmpz_init(det);
+
+        fmpz_mat_init(A, n, n);
+        fmpz_mat_init(H, n, n);
+        fmpz_mat_init(H2, n, n);
+
+        do {
+            fmpz_mat_randtest(A, state, 3 + n_randint(state, 3));
+            fmpz_mat_det(det, A);
+        } while (fmpz_is_zero(det));
+        fmpz_abs(det, det);
+
+        flint_set_num_threads(1);
+        fmpz_mat_hnf_modular(H, A, det);
+
+        flint_set_num_threads(n_randint(state, 4) + 2);
+        fmpz_mat_hnf_modular(H2, A, det);
+
+        if (!fmpz_mat_equal(H, H2) || !fmpz_mat_is_in_hnf(H))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("threaded hnf should be the same!\n");
+            flint_printf("n = %wd, threads = %wd\n", n, flint_get_num_threads());
+            abort();
+        }
+
+        fmpz_mat_clear(H2);
+        fmpz_mat_clear(H);
+        fmpz_mat_clear(A);
+        fmpz_clear(det);
+    }
+
     FLINT_TEST_CLEANUP(state);
 
     flint_printf("PASS\n");
@@ -15,6 +15,7 @@
 #include "flint.h"
 #include "fmpz.h"
 #include "fmpz_mat.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -95,6 +96,46 @@ main(void)
         fmpz_clear(mod);
     }
 
+    /* Larger entries, split into tasks if there are several threads */
+    for (iter = 0; iter < 5 * flint_test_multiplier(); iter++)
+    {
+        fmpz_mat_t A, S, S2;
+        fmpz_t mod;
+        slong n;
+
+        n = 16 + n_randint(state, 16);
+
+        fmpz_init(mod);
+        fmpz_mat_init(A, n, n);
+        fmpz_mat_init(S, n, n);
+        fmpz_mat_init(S2, n, n);
+
+        do {
+            fmpz_mat_randtest(A, state, 20 + n_randint(state, 40));
+            fmpz_mat_det(mod, A);
+        } while (fmpz_is_zero(mod));
+        fmpz_abs(mod, mod);
+
+        flint_set_num_threads(1);
+        fmpz_mat_snf_iliopoulos(S, A, mod);
+
+        flint_set_num_threads(n_randint(state, 4) + 2);
+        fmpz_mat_snf_iliopoulos(S2, A, mod);
+
+        if (!fmpz_mat_equal(S, S2) || !fmpz_mat_is_in_snf(S))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("threaded snf should be the same!\n");
+            flint_printf("n = %wd, threads = %wd\n", n, flint_get_num_threads());
+            abort();
+        }
+
+        fmpz_mat_clear(S2);
+        fmpz_mat_clear(S);
+        fmpz_mat_clear(A);
+        fmpz_clear(mod);
+    }
+
     FLINT_TEST_CLEANUP(state);
 
     flint_printf("PASS\n");
@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    slong i, j, m, n, bits;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("solve_dixon_precomp....");
+    fflush(stdout);
+
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        fmpz_mat_dixon_t S;
+        fmpz_mat_t A, B, X, X2, AX;
+        fmpz_t mod, mod2, den;
+
+        /* occasionally large entries, for long liftings */
+        m = n_randint(state, 20);
+        if (n_randint(state, 8) == 0)
+        {
+            m = n_randint(state, 4);
+            bits = 1 + n_randint(state, 2000);
+        }
+        else
+            bits = 1 + n_randint(state, 2)*n_randint(state, 100);
+
+        fmpz_mat_init(A, m, m);
+        fmpz_init(mod);
+        fmpz_init(mod2);
+        fmpz_init(den);
+
+        fmpz_mat_randrank(A, state, m, bits);
+        if (n_randint(state, 2))
+            fmpz_mat_randops(A, state, 1 + n_randint(state, 1 + m*m));
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        if (!fmpz_mat_dixon_init(S, A))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("nonsingular matrix reported singular\n");
+            fmpz_mat_print_pretty(A), flint_printf("\n");
+            abort();
+        }
+
+        /* several right hand sides with the same precomputation */
+        for (j = 0; j < 3; j++)
+        {
+            n = n_randint(state, 20);
+
+            fmpz_mat_init(B, m, n);
+            fmpz_mat_init(X, m, n);
+            fmpz_mat_init(X2, m, n);
+            fmpz_mat_init(AX, m, n);
+
+            fmpz_mat_randtest(B, state, 1 + n_randint(state, bits));
+
+            fmpz_mat_solve_dixon_precomp(X, mod, S, B);
+            fmpz_mat_solve_dixon(X2, mod2, A, B);
+
+            if (!fmpz_mat_is_empty(B) &&
+                (!fmpz_mat_equal(X, X2) || !fmpz_equal(mod, mod2)))
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("precomputed and direct solutions differ\n");
+                flint_printf("A:\n"), fmpz_mat_print_pretty(A), flint_printf("\n");
+                flint_printf("B:\n"), fmpz_mat_print_pretty(B), flint_printf("\n");
+                abort();
+            }
+
+            fmpz_mat_mul(AX, A, X);
+            fmpz_mat_sub(AX, AX, B);
+            if (!fmpz_mat_is_empty(B))
+                fmpz_mat_scalar_mod_fmpz(AX, AX, mod);
+
+            if (!fmpz_mat_is_zero(AX))
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("AX != B mod M!\n");
+                flint_printf("A:\n"), fmpz_mat_print_pretty(A), flint_printf("\n");
+                flint_printf("B:\n"), fmpz_mat_print_pretty(B), flint_printf("\n");
+                flint_printf("X:\n"), fmpz_mat_print_pretty(X), flint_printf("\n");
+                flint_printf("M = "), fmpz_print(mod), flint_printf("\n");
+                abort();
+            }
+
+            fmpz_mat_solve_dixon_den_precomp(X, den, S, B);
+
+            fmpz_mat_mul(AX, A, X);
+            fmpz_mat_scalar_mul_fmpz(B, B, den);
+
+            if (!fmpz_mat_equal(AX, B))
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("AX != den B!\n");
+                flint_printf("A:\n"), fmpz_mat_print_pretty(A), flint_printf("\n");
+                flint_printf("X:\n"), fmpz_mat_print_pretty(X), flint_printf("\n");
+                flint_printf("den = "), fmpz_print(den), flint_printf("\n");
+                abort();
+            }
+
+            fmpz_mat_clear(B);
+            fmpz_mat_clear(X);
+            fmpz_mat_clear(X2);
+            fmpz_mat_clear(AX);
+        }
+
+        fmpz_mat_dixon_clear(S);
+        flint_set_num_threads(1);
+
+        /* singular matrices */
+        if (m > 0)
+        {
+            fmpz_mat_randrank(A, state, n_randint(state, m), bits);
+            if (fmpz_mat_dixon_init(S, A))
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("singular matrix reported nonsingular\n");
+                fmpz_mat_print_pretty(A), flint_printf("\n");
+                abort();
+            }
+            fmpz_mat_dixon_clear(S);
+        }
+
+        fmpz_mat_clear(A);
+        fmpz_clear(mod);
+        fmpz_clear(mod2);
+        fmpz_clear(den);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
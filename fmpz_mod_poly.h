@@ -101,6 +101,21 @@ typedef struct
 }
 fmpz_mod_poly_compose_mod_precomp_preinv_arg_t;
 
+/*
+    Transform of a fixed operand poly2 for repeated products with operands
+    of length at most len1. If cached is zero the operand is too short for
+    the transform and the products are computed directly.
+*/
+typedef struct
+{
+    fmpz_poly_mul_precache_t pre;
+    fmpz_poly_t poly2;
+    slong len1;
+    int cached;
+} fmpz_mod_poly_mul_precache_struct;
+
+typedef fmpz_mod_poly_mul_precache_struct fmpz_mod_poly_mul_precache_t[1];
+
 
 /*  Initialisation and memory management *************************************/
 
@@ -467,6 +482,30 @@ FLINT_DLL void fmpz_mod_poly_mullow(fmpz_mod_poly_t res,
                     const fmpz_mod_poly_t poly1, const fmpz_mod_poly_t poly2,
                                             slong n, const fmpz_mod_ctx_t ctx);
 
+FLINT_DLL void fmpz_mod_poly_mul_precache_init(
+               fmpz_mod_poly_mul_precache_t pre, slong len1,
+                     const fmpz_mod_poly_t poly2, const fmpz_mod_ctx_t ctx);
+
+FLINT_DLL void fmpz_mod_poly_mul_precache_clear(
+               fmpz_mod_poly_mul_precache_t pre, const fmpz_mod_ctx_t ctx);
+
+FLINT_DLL void _fmpz_mod_poly_mullow_precache(fmpz * res,
+                         const fmpz * poly1, slong len1,
+           fmpz_mod_poly_mul_precache_t pre, const fmpz_t p, slong n);
+
+FLINT_DLL void fmpz_mod_poly_mullow_precache(fmpz_mod_poly_t res,
+           const fmpz_mod_poly_t poly1, fmpz_mod_poly_mul_precache_t pre,
+                                            slong n, const fmpz_mod_ctx_t ctx);
+
+FMPZ_MOD_POLY_INLINE
+void fmpz_mod_poly_mul_precache(fmpz_mod_poly_t res,
+           const fmpz_mod_poly_t poly1, fmpz_mod_poly_mul_precache_t pre,
+                                                     const fmpz_mod_ctx_t ctx)
+{
+    fmpz_mod_poly_mullow_precache(res, poly1, pre,
+                         poly1->length + pre->poly2->length - 1, ctx);
+}
+
 FLINT_DLL void _fmpz_mod_poly_sqr(fmpz *res, const fmpz *poly, slong len,
                                                                const fmpz_t p);
 
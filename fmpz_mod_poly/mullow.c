@@ -21,7 +21,7 @@ void _fmpz_mod_poly_mullow(fmpz *res, const fmpz *poly1, slong len1,
                                       const fmpz_t p, slong n)
 {
     _fmpz_poly_mullow(res, poly1, len1, poly2, len2, n);
-    _fmpz_vec_scalar_mod_fmpz(res, res, n, p);
+    _fmpz_vec_scalar_mod_fmpz_threaded(res, res, n, p);
 }
 
 void fmpz_mod_poly_mullow(fmpz_mod_poly_t res, const fmpz_mod_poly_t poly1,
@@ -0,0 +1,102 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_poly.h"
+#include "fmpz_mod_poly.h"
+
+void fmpz_mod_poly_mul_precache_init(fmpz_mod_poly_mul_precache_t pre,
+                    slong len1, const fmpz_mod_poly_t poly2,
+                                                     const fmpz_mod_ctx_t ctx)
+{
+    fmpz_poly_init(pre->poly2);
+    fmpz_mod_poly_get_fmpz_poly(pre->poly2, poly2, ctx);
+
+    pre->len1 = len1;
+    pre->cached = (len1 > 2 && poly2->length > 2);
+
+    if (pre->cached)
+        fmpz_poly_mul_SS_precache_init(pre->pre, len1,
+                          fmpz_bits(fmpz_mod_ctx_modulus(ctx)), pre->poly2);
+}
+
+void fmpz_mod_poly_mul_precache_clear(fmpz_mod_poly_mul_precache_t pre,
+                                                     const fmpz_mod_ctx_t ctx)
+{
+    if (pre->cached)
+        fmpz_poly_mul_precache_clear(pre->pre);
+
+    fmpz_poly_clear(pre->poly2);
+}
+
+void _fmpz_mod_poly_mullow_precache(fmpz * res, const fmpz * poly1,
+                       slong len1, fmpz_mod_poly_mul_precache_t pre,
+                                                   const fmpz_t p, slong n)
+{
+    const fmpz * poly2 = pre->poly2->coeffs;
+    slong len2 = pre->poly2->length;
+
+    len1 = FLINT_MIN(len1, n);
+
+    if (pre->cached && len1 > 2 && n > 2 && len1 <= pre->len1)
+    {
+        _fmpz_poly_mullow_SS_precache(res, poly1, len1, pre->pre, n);
+        _fmpz_vec_scalar_mod_fmpz_threaded(res, res, n, p);
+    }
+    else if (len1 >= len2)
+        _fmpz_mod_poly_mullow(res, poly1, len1, poly2, len2, p, n);
+    else
+        _fmpz_mod_poly_mullow(res, poly2, len2, poly1, len1, p, n);
+}
+
+void fmpz_mod_poly_mullow_precache(fmpz_mod_poly_t res,
+               const fmpz_mod_poly_t poly1, fmpz_mod_poly_mul_precache_t pre,
+                                            slong n, const fmpz_mod_ctx_t ctx)
+{
+    const slong len1 = poly1->length;
+    const slong len2 = pre->poly2->length;
+
+    if (len1 == 0 || len2 == 0 || n <= 0)
+    {
+        fmpz_mod_poly_zero(res, ctx);
+        return;
+    }
+
+    n = FLINT_MIN(n, len1 + len2 - 1);
+
+    if (res == poly1)
+    {
+        fmpz * t = _fmpz_vec_init(n);
+
+        _fmpz_mod_poly_mullow_precache(t, poly1->coeffs, len1, pre,
+                                                fmpz_mod_ctx_modulus(ctx), n);
+
+        _fmpz_vec_clear(res->coeffs, res->alloc);
+        res->coeffs = t;
+        res->alloc  = n;
+        res->length = n;
+    }
+    else
+    {
+        fmpz_mod_poly_fit_length(res, n, ctx);
+
+        _fmpz_mod_poly_mullow_precache(res->coeffs, poly1->coeffs, len1, pre,
+                                                fmpz_mod_ctx_modulus(ctx), n);
+
+        _fmpz_mod_poly_set_length(res, n);
+    }
+
+    _fmpz_mod_poly_normalise(res);
+}
@@ -0,0 +1,113 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    fmpz_mod_ctx_t ctx;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mullow_precache....");
+    fflush(stdout);
+
+    fmpz_mod_ctx_init_ui(ctx, 2);
+
+    /* Compare with mullow, several products per precache */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        fmpz_t p;
+        fmpz_mod_poly_t a, b, c, d;
+        fmpz_mod_poly_mul_precache_t pre;
+        slong len1, len2, trunc;
+
+        fmpz_init(p);
+        fmpz_randtest_unsigned(p, state, 2 * FLINT_BITS);
+        fmpz_add_ui(p, p, 2);
+        fmpz_mod_ctx_set_modulus(ctx, p);
+
+        fmpz_mod_poly_init(a, ctx);
+        fmpz_mod_poly_init(b, ctx);
+        fmpz_mod_poly_init(c, ctx);
+        fmpz_mod_poly_init(d, ctx);
+
+        len1 = n_randint(state, 200);
+        len2 = n_randint(state, 200);
+
+        fmpz_mod_poly_randtest(c, state, len2, ctx);
+        fmpz_mod_poly_mul_precache_init(pre, len1, c, ctx);
+
+        for (j = 0; j < 4; j++)
+        {
+            /* occasionally exceed the precached length */
+            fmpz_mod_poly_randtest(b, state,
+                 n_randint(state, 10) == 0 ? 2 * len1 + 1 : len1 + 1, ctx);
+            trunc = n_randint(state, b->length + c->length + 1);
+
+            fmpz_mod_poly_mullow(a, b, c, trunc, ctx);
+
+            if (n_randint(state, 2))
+            {
+                fmpz_mod_poly_mullow_precache(d, b, pre, trunc, ctx);
+            }
+            else
+            {
+                fmpz_mod_poly_set(d, b, ctx);
+                fmpz_mod_poly_mullow_precache(d, d, pre, trunc, ctx);
+            }
+
+            result = (fmpz_mod_poly_equal(a, d, ctx));
+            if (!result)
+            {
+                flint_printf("FAIL (mullow):\n");
+                flint_printf("len1 = %wd, trunc = %wd\n\n", len1, trunc);
+                fmpz_mod_poly_print(a, ctx), flint_printf("\n\n");
+                fmpz_mod_poly_print(d, ctx), flint_printf("\n\n");
+                flint_abort();
+            }
+
+            fmpz_mod_poly_mul(a, b, c, ctx);
+            fmpz_mod_poly_mul_precache(d, b, pre, ctx);
+
+            result = (fmpz_mod_poly_equal(a, d, ctx));
+            if (!result)
+            {
+                flint_printf("FAIL (mul):\n");
+                fmpz_mod_poly_print(a, ctx), flint_printf("\n\n");
+                fmpz_mod_poly_print(d, ctx), flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        fmpz_mod_poly_mul_precache_clear(pre, ctx);
+
+        fmpz_mod_poly_clear(a, ctx);
+        fmpz_mod_poly_clear(b, ctx);
+        fmpz_mod_poly_clear(c, ctx);
+        fmpz_mod_poly_clear(d, ctx);
+        fmpz_clear(p);
+    }
+
+    fmpz_mod_ctx_clear(ctx);
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
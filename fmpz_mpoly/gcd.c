@@ -18,6 +18,9 @@ int fmpz_mpoly_gcd(
     const fmpz_mpoly_t B,
     const fmpz_mpoly_ctx_t ctx)
 {
+    slong module;
+    int success;
+
     if (fmpz_mpoly_is_zero(A, ctx))
     {
         if (fmpz_mpoly_is_zero(B, ctx))
@@ -40,6 +43,10 @@ int fmpz_mpoly_gcd(
         return 1;
     }
 
-    return _fmpz_mpoly_gcd_algo(G, NULL, NULL, A, B, ctx, MPOLY_GCD_USE_ALL);
+    module = _flint_memory_stats_enter("fmpz_mpoly_gcd");
+    success = _fmpz_mpoly_gcd_algo(G, NULL, NULL, A, B, ctx, MPOLY_GCD_USE_ALL);
+    flint_memory_stats_set_module(module);
+
+    return success;
 }
 
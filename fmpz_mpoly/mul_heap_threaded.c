@@ -666,6 +666,9 @@ void _fmpz_mpoly_mul_heap_threaded(
     }
 
     base->nthreads = num_handles + 1;
+    /* inside a scheduler the divisions are shared among all of its threads */
+    if (thread_pool_in_tasks())
+        base->nthreads = FLINT_MAX(base->nthreads, thread_pool_task_workers());
     base->ndivs = base->nthreads*4;  /* number of divisons */
     base->Bcoeff = Bcoeff;
     base->Bexp = Bexp;
@@ -722,23 +725,16 @@ void _fmpz_mpoly_mul_heap_threaded(
 #if FLINT_USES_PTHREAD
     pthread_mutex_init(&base->mutex, NULL);
 #endif
-    for (i = 0; i < num_handles; i++)
+    for (i = 0; i < base->nthreads; i++)
     {
         args[i].idx = i;
         args[i].base = base;
         args[i].divs = divs;
-        thread_pool_wake(global_thread_pool, handles[i], 0,
-                               _fmpz_mpoly_mul_heap_threaded_worker, &args[i]);
-    }
-    i = num_handles;
-    args[i].idx = i;
-    args[i].base = base;
-    args[i].divs = divs;
-    _fmpz_mpoly_mul_heap_threaded_worker(&args[i]);
-    for (i = 0; i < num_handles; i++)
-    {
-        thread_pool_wait(global_thread_pool, handles[i]);
     }
+    thread_pool_run_task_array(global_thread_pool,
+                       (thread_pool_handle *) handles, num_handles,
+                       _fmpz_mpoly_mul_heap_threaded_worker, args,
+                       sizeof(_worker_arg_struct), base->nthreads);
 
     /* calculate and allocate space for final answer */
     i = base->ndivs - 1;
@@ -761,15 +757,10 @@ void _fmpz_mpoly_mul_heap_threaded(
     base->Aexp = Aexp;
 
     /* join answers */
-    for (i = 0; i < num_handles; i++)
-    {
-        thread_pool_wake(global_thread_pool, handles[i], 0, _join_worker, &args[i]);
-    }
-    _join_worker(&args[num_handles]);
-    for (i = 0; i < num_handles; i++)
-    {
-        thread_pool_wait(global_thread_pool, handles[i]);
-    }
+    thread_pool_run_task_array(global_thread_pool,
+                       (thread_pool_handle *) handles, num_handles,
+                       _join_worker, args,
+                       sizeof(_worker_arg_struct), base->nthreads);
 
 #if FLINT_USES_PTHREAD
     pthread_mutex_destroy(&base->mutex);
@@ -929,7 +920,16 @@ void fmpz_mpoly_mul_heap_threaded(
     mpoly_max_fields_fmpz(maxBfields, B->exps, B->length, B->bits, ctx->minfo);
     mpoly_max_fields_fmpz(maxCfields, C->exps, C->length, C->bits, ctx->minfo);
 
-    num_handles = flint_request_threads(&handles, thread_limit);
+    /* nested calls share the threads of the running scheduler */
+    if (thread_pool_in_tasks())
+    {
+        handles = NULL;
+        num_handles = 0;
+    }
+    else
+    {
+        num_handles = flint_request_threads(&handles, thread_limit);
+    }
 
     _fmpz_mpoly_mul_heap_threaded_pool_maxfields(A, B, maxBfields, C, maxCfields,
                                                     ctx, handles, num_handles);
@@ -12,6 +12,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "fmpz_mpoly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    fmpz_mpoly_struct * f, * g, * h;
+    const fmpz_mpoly_ctx_struct * ctx;
+} _mul_arg_struct;
+
+static void _mul_task(void * varg)
+{
+    _mul_arg_struct * arg = (_mul_arg_struct *) varg;
+
+    fmpz_mpoly_mul_heap_threaded(arg->h, arg->f, arg->g, arg->ctx);
+}
 
 int
 main(void)
@@ -217,6 +231,65 @@ main(void)
         fmpz_mpoly_ctx_clear(ctx);
     }
 
+    /* nested inside tasks, sharing the threads of the scheduler */
+    for (i = 0; i < tmul * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_struct f[4], g[4], h[4];
+        _mul_arg_struct args[4];
+        fmpz_mpoly_t k;
+        slong len1, len2;
+        flint_bitcnt_t coeff_bits, exp_bits1, exp_bits2;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 10);
+        fmpz_mpoly_init(k, ctx);
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_mpoly_init(f + j, ctx);
+            fmpz_mpoly_init(g + j, ctx);
+            fmpz_mpoly_init(h + j, ctx);
+
+            len1 = n_randint(state, 300);
+            len2 = n_randint(state, 300);
+            exp_bits1 = n_randint(state, 200) + 2;
+            exp_bits2 = n_randint(state, 200) + 2;
+            coeff_bits = n_randint(state, 200);
+
+            fmpz_mpoly_randtest_bits(f + j, state, len1, coeff_bits, exp_bits1, ctx);
+            fmpz_mpoly_randtest_bits(g + j, state, len2, coeff_bits, exp_bits2, ctx);
+
+            args[j].f = f + j;
+            args[j].g = g + j;
+            args[j].h = h + j;
+            args[j].ctx = ctx;
+        }
+
+        flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+        flint_run_task_array(_mul_task, args, sizeof(_mul_arg_struct), 4);
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_mpoly_assert_canonical(h + j, ctx);
+            fmpz_mpoly_mul_johnson(k, f + j, g + j, ctx);
+
+            if (!fmpz_mpoly_equal(h + j, k, ctx))
+            {
+                printf("FAIL\n");
+                flint_printf("Check nested inside tasks\ni = %wd, j = %wd\n", i ,j);
+                flint_abort();
+            }
+
+            fmpz_mpoly_clear(f + j, ctx);
+            fmpz_mpoly_clear(g + j, ctx);
+            fmpz_mpoly_clear(h + j, ctx);
+        }
+
+        fmpz_mpoly_clear(k, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
@@ -76,6 +76,12 @@ int fmpz_mpoly_factor_irred_wang(
 
 next_alpha:
 
+    if (flint_cancelled())
+    {
+        success = -1;
+        goto cleanup;
+    }
+
     if (!allow_shift)
     {
         success = 0;
@@ -251,6 +257,12 @@ got_alpha:
                                                new_lcs->coeffs + k*r + i, ctx);
         }
 
+        if (flint_cancelled())
+        {
+            success = -1;
+            goto cleanup;
+        }
+
         success = fmpz_mpoly_hlift(k, tfac->coeffs, r, alpha,
                                       k < n ? Aevals + k : newA, tdegs, ctx);
         if (!success)
@@ -317,7 +329,7 @@ cleanup:
     fmpz_poly_clear(Au);
 
 #if FLINT_WANT_ASSERT
-    if (success)
+    if (success > 0)
     {
         fmpz_mpoly_t prod;
         fmpz_mpoly_init(prod, ctx);
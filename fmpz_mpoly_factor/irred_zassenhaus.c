@@ -171,6 +171,12 @@ int fmpz_mpoly_factor_irred_zassenhaus(
 
 next_alpha:
 
+    if (flint_cancelled())
+    {
+        success = 0;
+        goto cleanup;
+    }
+
     tuple_next(alphait, n);
     for (i = 0; i < n; i++)
     {
@@ -742,6 +742,12 @@ int fmpz_mpoly_factor_irred_zippel(
 
 next_alpha:
 
+    if (flint_cancelled())
+    {
+        success = -1;
+        goto cleanup;
+    }
+
     alpha_count++;
     if (alpha_count >= alpha_bits)
     {
@@ -991,6 +997,12 @@ next_zip_prime:
                                                  Alcp->coeffs + k*r + i, ctxp);
         }
 
+        if (flint_cancelled())
+        {
+            success = -1;
+            goto cleanup;
+        }
+
         if (k > 2)
         {
             success = nmod_mpoly_hlift_zippel(k, tfacp->coeffs, r, alphap,
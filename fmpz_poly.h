@@ -42,6 +42,7 @@
 #define FMPZ_POLY_INV_NEWTON_CUTOFF 32
 #define FMPZ_POLY_SQRT_DIVCONQUER_CUTOFF 16
 #define FMPZ_POLY_SQRTREM_DIVCONQUER_CUTOFF 16
+#define FMPZ_POLY_BIT_PACK_CHUNK 4096  /* threaded packing: coeffs per task */
 
 /*  Type definitions *********************************************************/
 
@@ -422,6 +423,15 @@ FLINT_DLL int _fmpz_poly_bit_unpack(fmpz * poly, slong len,
 FLINT_DLL void _fmpz_poly_bit_unpack_unsigned(fmpz * poly, slong len, 
                                        mp_srcptr arr, flint_bitcnt_t bit_size);
 
+FLINT_DLL void _fmpz_poly_bit_pack_threaded(mp_ptr arr, const fmpz * poly,
+                                slong len, flint_bitcnt_t bit_size, int negate);
+
+FLINT_DLL int _fmpz_poly_bit_unpack_threaded(fmpz * poly, slong len,
+                           mp_srcptr arr, flint_bitcnt_t bit_size, int negate);
+
+FLINT_DLL void _fmpz_poly_bit_unpack_unsigned_threaded(fmpz * poly,
+                          slong len, mp_srcptr arr, flint_bitcnt_t bit_size);
+
 FLINT_DLL void fmpz_poly_bit_pack(fmpz_t f, const fmpz_poly_t poly,
         flint_bitcnt_t bit_size);
 
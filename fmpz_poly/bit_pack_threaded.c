@@ -0,0 +1,141 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    mp_ptr arr;
+    const fmpz * poly;
+    slong len;
+    flint_bitcnt_t bits;
+    int negate;
+    int borrow;         /* borrow into the first coefficient */
+    int last;           /* the chunk ends the array */
+}
+_bit_pack_arg_struct;
+
+static void _bit_pack_worker(void * varg)
+{
+    _bit_pack_arg_struct * arg = (_bit_pack_arg_struct *) varg;
+    flint_bitcnt_t bits = 0, b = arg->bits % FLINT_BITS;
+    mp_size_t limbs = 0, l = arg->bits / FLINT_BITS, n;
+    mp_ptr tmp;
+    int borrow = arg->borrow;
+    slong i, len = arg->len;
+
+    if (!arg->last)
+        len--;
+
+    for (i = 0; i < len; i++)
+    {
+        borrow = fmpz_bit_pack(arg->arr + limbs, bits, arg->bits,
+                                        arg->poly + i, arg->negate, borrow);
+        limbs += l;
+        bits += b;
+        if (bits >= FLINT_BITS)
+        {
+            bits -= FLINT_BITS;
+            limbs++;
+        }
+    }
+
+    /*
+        the last field ends at a limb boundary, but fmpz_bit_pack may clear
+        the limb after it, which belongs to the next chunk
+    */
+    if (!arg->last)
+    {
+        n = (bits + arg->bits) / FLINT_BITS;
+        tmp = flint_calloc(n + 1, sizeof(mp_limb_t));
+
+        tmp[0] = arg->arr[limbs];
+        fmpz_bit_pack(tmp, bits, arg->bits, arg->poly + len,
+                                                       arg->negate, borrow);
+        flint_mpn_copyi(arg->arr + limbs, tmp, n);
+
+        flint_free(tmp);
+    }
+}
+
+static void _bit_pack_tasks(void * varg)
+{
+    _bit_pack_arg_struct * arg = (_bit_pack_arg_struct *) varg;
+    _bit_pack_arg_struct * args;
+    slong i, j, chunk, num;
+    int borrow = 0;
+    thread_pool_task_group_t G;
+
+    /* chunks start at a limb boundary, so they write disjoint limbs */
+    chunk = FLINT_BITS/n_gcd(arg->bits, FLINT_BITS);
+    chunk *= (FMPZ_POLY_BIT_PACK_CHUNK + chunk - 1)/chunk;
+    num = (arg->len + chunk - 1)/chunk;
+
+    args = (_bit_pack_arg_struct *)
+                               flint_malloc(num*sizeof(_bit_pack_arg_struct));
+
+    for (i = 0; i < num; i++)
+    {
+        args[i].arr = arg->arr + (i*chunk*arg->bits)/FLINT_BITS;
+        args[i].poly = arg->poly + i*chunk;
+        args[i].len = FLINT_MIN(chunk, arg->len - i*chunk);
+        args[i].bits = arg->bits;
+        args[i].negate = arg->negate;
+        args[i].borrow = borrow;
+        args[i].last = (i + 1 == num);
+
+        /* the borrow out of a chunk is that of its last nonzero coefficient */
+        for (j = args[i].len - 1; j >= 0; j--)
+        {
+            if (!fmpz_is_zero(args[i].poly + j))
+            {
+                borrow = ((fmpz_sgn(args[i].poly + j) ^ arg->negate) < 0);
+                break;
+            }
+        }
+    }
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i + 1 < num; i++)
+        thread_pool_spawn(G, _bit_pack_worker, args + i);
+
+    _bit_pack_worker(args + num - 1);
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    flint_free(args);
+}
+
+void _fmpz_poly_bit_pack_threaded(mp_ptr arr, const fmpz * poly, slong len,
+                                         flint_bitcnt_t bit_size, int negate)
+{
+    _bit_pack_arg_struct arg;
+
+    if (len < 2*FMPZ_POLY_BIT_PACK_CHUNK || flint_get_num_threads() == 1)
+    {
+        _fmpz_poly_bit_pack(arr, poly, len, bit_size, negate);
+        return;
+    }
+
+    arg.arr = arr;
+    arg.poly = poly;
+    arg.len = len;
+    arg.bits = bit_size;
+    arg.negate = negate;
+
+    flint_run_tasks(_bit_pack_tasks, &arg, flint_get_num_threads());
+}
@@ -0,0 +1,146 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    fmpz * poly;
+    slong len;
+    mp_srcptr arr;
+    flint_bitcnt_t bits;
+    int negate;         /* -1, 0, or 1 for unsigned unpacking */
+    int borrow;         /* borrow into the first coefficient */
+}
+_bit_unpack_arg_struct;
+
+static void _bit_unpack_worker(void * varg)
+{
+    _bit_unpack_arg_struct * arg = (_bit_unpack_arg_struct *) varg;
+    flint_bitcnt_t bits = 0, b = arg->bits % FLINT_BITS;
+    mp_size_t limbs = 0, l = arg->bits / FLINT_BITS;
+    int borrow = arg->borrow;
+    slong i;
+
+    if (arg->negate == 1)
+    {
+        _fmpz_poly_bit_unpack_unsigned(arg->poly, arg->len, arg->arr,
+                                                                   arg->bits);
+        return;
+    }
+
+    for (i = 0; i < arg->len; i++)
+    {
+        borrow = fmpz_bit_unpack(arg->poly + i, arg->arr + limbs, bits,
+                                              arg->bits, arg->negate, borrow);
+        limbs += l;
+        bits += b;
+        if (bits >= FLINT_BITS)
+        {
+            bits -= FLINT_BITS;
+            limbs++;
+        }
+    }
+}
+
+/* the borrow out of a field is its top bit */
+static int _bit_unpack_borrow(mp_srcptr arr, slong i, flint_bitcnt_t bits)
+{
+    flint_bitcnt_t pos;
+
+    if (i == 0)
+        return 0;
+
+    pos = i*bits - 1;
+
+    return (arr[pos / FLINT_BITS] >> (pos % FLINT_BITS)) & 1;
+}
+
+static void _bit_unpack_tasks(void * varg)
+{
+    _bit_unpack_arg_struct * arg = (_bit_unpack_arg_struct *) varg;
+    _bit_unpack_arg_struct * args;
+    slong i, chunk, num;
+    thread_pool_task_group_t G;
+
+    /* chunks start at a limb boundary */
+    chunk = FLINT_BITS/n_gcd(arg->bits, FLINT_BITS);
+    chunk *= (FMPZ_POLY_BIT_PACK_CHUNK + chunk - 1)/chunk;
+    num = (arg->len + chunk - 1)/chunk;
+
+    args = (_bit_unpack_arg_struct *)
+                             flint_malloc(num*sizeof(_bit_unpack_arg_struct));
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i < num; i++)
+    {
+        args[i].poly = arg->poly + i*chunk;
+        args[i].len = FLINT_MIN(chunk, arg->len - i*chunk);
+        args[i].arr = arg->arr + (i*chunk*arg->bits)/FLINT_BITS;
+        args[i].bits = arg->bits;
+        args[i].negate = arg->negate;
+        args[i].borrow = _bit_unpack_borrow(arg->arr, i*chunk, arg->bits);
+
+        if (i + 1 < num)
+            thread_pool_spawn(G, _bit_unpack_worker, args + i);
+        else
+            _bit_unpack_worker(args + i);
+    }
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    flint_free(args);
+}
+
+int _fmpz_poly_bit_unpack_threaded(fmpz * poly, slong len, mp_srcptr arr,
+                                         flint_bitcnt_t bit_size, int negate)
+{
+    _bit_unpack_arg_struct arg;
+
+    if (len < 2*FMPZ_POLY_BIT_PACK_CHUNK || flint_get_num_threads() == 1)
+        return _fmpz_poly_bit_unpack(poly, len, arr, bit_size, negate);
+
+    arg.poly = poly;
+    arg.len = len;
+    arg.arr = arr;
+    arg.bits = bit_size;
+    arg.negate = negate;
+
+    flint_run_tasks(_bit_unpack_tasks, &arg, flint_get_num_threads());
+
+    return _bit_unpack_borrow(arr, len, bit_size);
+}
+
+void _fmpz_poly_bit_unpack_unsigned_threaded(fmpz * poly, slong len,
+                                       mp_srcptr arr, flint_bitcnt_t bit_size)
+{
+    _bit_unpack_arg_struct arg;
+
+    if (len < 2*FMPZ_POLY_BIT_PACK_CHUNK || flint_get_num_threads() == 1)
+    {
+        _fmpz_poly_bit_unpack_unsigned(poly, len, arr, bit_size);
+        return;
+    }
+
+    arg.poly = poly;
+    arg.len = len;
+    arg.arr = arr;
+    arg.bits = bit_size;
+    arg.negate = 1;
+
+    flint_run_tasks(_bit_unpack_tasks, &arg, flint_get_num_threads());
+}
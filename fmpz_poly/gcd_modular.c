@@ -14,20 +14,121 @@
 #include "fmpz.h"
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
-#include "mpn_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
 
 
+typedef struct
+{
+    const fmpz * A;
+    slong len1;
+    const fmpz * B;
+    slong len2;
+    const fmpz * g;
+    const fmpz * l;
+    int g_pm1;
+    flint_bitcnt_t bits_small;
+    flint_bitcnt_t curr_bits;
+} _gcd_arg_struct;
+
+/*
+   the gcd modulo p scaled to have leading coefficient g, unless p
+   divides the leading coefficients
+*/
+static slong _gcd_image(mp_ptr h, nmod_t mod, void * varg)
+{
+    _gcd_arg_struct * arg = (_gcd_arg_struct *) varg;
+    mp_ptr a, b;
+    mp_limb_t h_inv, g_mod;
+    slong hlen;
+
+    if (fmpz_fdiv_ui(arg->l, mod.n) == 0)
+        return -1;
+
+    /* reduce polynomials modulo p */
+    a = _nmod_vec_init(arg->len1);
+    b = _nmod_vec_init(arg->len2);
+    _fmpz_vec_get_nmod_vec(a, arg->A, arg->len1, mod);
+    _fmpz_vec_get_nmod_vec(b, arg->B, arg->len2, mod);
+
+    /* compute gcd over Z/pZ */
+    hlen = _nmod_poly_gcd(h, a, arg->len1, b, arg->len2, mod);
+
+    /* scale new polynomial mod p appropriately */
+    if (arg->g_pm1) _nmod_poly_make_monic(h, h, hlen, mod);
+    else
+    {
+        h_inv = n_invmod(h[hlen - 1], mod.n);
+        g_mod = fmpz_fdiv_ui(arg->g, mod.n);
+        h_inv = n_mulmod2_preinv(h_inv, g_mod, mod.n, mod.ninv);
+        _nmod_vec_scalar_mul_nmod(h, h, hlen, h_inv, mod);
+    }
+
+    _nmod_vec_clear(a);
+    _nmod_vec_clear(b);
+
+    return hlen;
+}
+
+/* divide by content and correct sign of leading term */
+static void _gcd_primitive(fmpz * res, slong len)
+{
+    fmpz_t hc;
+
+    fmpz_init(hc);
+    _fmpz_vec_content(hc, res, len);
+
+    if (fmpz_sgn(res + len - 1) < 0)
+        fmpz_neg(hc, hc);
+
+    _fmpz_vec_scalar_divexact_fmpz(res, res, len, hc);
+    fmpz_clear(hc);
+}
+
+/* are we done? */
+static int _gcd_check(const fmpz * res, slong hlen,
+                                        const fmpz_t modulus, void * varg)
+{
+    _gcd_arg_struct * arg = (_gcd_arg_struct *) varg;
+    flint_bitcnt_t new_bits;
+    fmpz * G, * Q;
+    int done = 0;
+
+    if (hlen == 1) /* gcd is 1 */
+        return 1;
+
+    new_bits = FLINT_ABS(_fmpz_vec_max_bits(res, hlen));
+
+    if (new_bits == arg->curr_bits || fmpz_bits(modulus) >= arg->bits_small)
+    {
+        G = _fmpz_vec_init(hlen);
+        Q = _fmpz_vec_init(arg->len1);
+
+        _fmpz_vec_set(G, res, hlen);
+        if (!arg->g_pm1)
+            _gcd_primitive(G, hlen);
+
+        done = _fmpz_poly_divides(Q, arg->B, arg->len2, G, hlen) &&
+               _fmpz_poly_divides(Q, arg->A, arg->len1, G, hlen);
+
+        _fmpz_vec_clear(G, hlen);
+        _fmpz_vec_clear(Q, arg->len1);
+    }
+
+    arg->curr_bits = new_bits;
+
+    return done;
+}
+
 void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1, 
                                         const fmpz * poly2, slong len2)
 {
-    flint_bitcnt_t bits1, bits2, nb1, nb2, bits_small, pbits, curr_bits = 0, new_bits;   
-    fmpz_t ac, bc, hc, d, g, l, eval_A, eval_B, eval_GCD, modulus;
-    fmpz * A, * B, * Q, * lead_A, * lead_B;
-    mp_ptr a, b, h;
-    mp_limb_t p, h_inv, g_mod;
-    nmod_t mod;
-    slong i, n, n0, unlucky, hlen, bound;
-    int g_pm1;
+    flint_bitcnt_t bits1, bits2, nb1, nb2, bits_small;   
+    fmpz_t ac, bc, d, g, l, eval_A, eval_B, eval_GCD;
+    fmpz * A, * B, * lead_A, * lead_B;
+    mp_limb_t p;
+    slong i, n0, hlen, bound;
+    _gcd_arg_struct arg;
 
     fmpz_init(ac);
     fmpz_init(bc);
@@ -86,8 +187,6 @@ void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1,
     fmpz_init(g);
     fmpz_gcd(g, lead_A, lead_B);
     fmpz_mul(l, lead_A, lead_B);
-
-    g_pm1 = fmpz_is_pm1(g);
    
     /* evaluate -A at -1 */
     fmpz_init(eval_A);
@@ -118,169 +217,37 @@ void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1,
     fmpz_clear(eval_B);
 
     /* set size of first prime */
-    pbits = FLINT_BITS - 1;
-    p = (UWORD(1)<<pbits);
-
-    fmpz_init(modulus);
-    fmpz_init(hc);
-
-    Q = _fmpz_vec_init(len1);
-
-    /* make space for polynomials mod p */
-    a = _nmod_vec_init(len1);
-    b = _nmod_vec_init(len2);
-    h = _nmod_vec_init(len2);
+    p = (UWORD(1)<<(FLINT_BITS - 1));
 
-    /* zero entire output */
-    _fmpz_vec_zero(res, len2);
-
-    n = len2; 
-    /* current bound on length of result 
+    /* 
       the bound we use is from section 6 of 
        http://cs.nyu.edu/~yap/book/alge/ftpSite/l4.ps.gz 
     */
     n0 = len1 - 1;
-    bound = (n0 + 3)*FLINT_MAX(nb1, nb2) + (n0 + 1); /* initialise bound */
-    unlucky = 0;
-
-    for (;;)
-    {
-        /* get new prime and initialise modulus */
-        p = n_nextprime(p, 0);
-        if (fmpz_fdiv_ui(l, p) == 0)
-        {
-            unlucky += pbits;
-            continue;
-        }
-        nmod_init(&mod, p);
-
-        /* reduce polynomials modulo p */
-        _fmpz_vec_get_nmod_vec(a, A, len1, mod);
-        _fmpz_vec_get_nmod_vec(b, B, len2, mod);
-
-        /* compute gcd over Z/pZ */
-        hlen = _nmod_poly_gcd(h, a, len1, b, len2, mod);
-
-        if (hlen == 1) /* gcd is 1 */
-        {
-            fmpz_one(res);
-            _fmpz_vec_zero(res + 1, len2 - 1);
-            break; 
-        }
-
-        if (hlen > n + 1) /* discard this prime */
-        {
-            unlucky += pbits;
-            continue;
-        }
+    bound = (n0 + 3)*FLINT_MAX(nb1, nb2) + (n0 + 1);
+
+    arg.A = A;
+    arg.len1 = len1;
+    arg.B = B;
+    arg.len2 = len2;
+    arg.g = g;
+    arg.l = l;
+    arg.g_pm1 = fmpz_is_pm1(g);
+    arg.bits_small = bits_small;
+    arg.curr_bits = 0;
+
+    /* primes giving a longer gcd are unlucky and get discarded */
+    hlen = _fmpz_vec_modular(res, len2, bound, 0,
+                      FMPZ_VEC_MODULAR_MIN_LENGTH, p, _gcd_image,
+                      _gcd_check, &arg);
+
+    if (hlen == 1) /* gcd is 1 */
+        fmpz_one(res);
+    else if (!arg.g_pm1)
+        _gcd_primitive(res, hlen);
 
-        /* scale new polynomial mod p appropriately */
-        if (g_pm1) _nmod_poly_make_monic(h, h, hlen, mod);
-        else
-        {
-            h_inv = n_invmod(h[hlen - 1], mod.n);
-            g_mod = fmpz_fdiv_ui(g, mod.n);
-            h_inv = n_mulmod2_preinv(h_inv, g_mod, mod.n, mod.ninv);
-            _nmod_vec_scalar_mul_nmod(h, h, hlen, h_inv, mod);
-        }
-
-        if (hlen <= n) /* we have a new bound on size of result */
-        {
-            unlucky += fmpz_bits(modulus);
-            _fmpz_vec_set_nmod_vec(res, h, hlen, mod);
-            _fmpz_vec_zero(res + hlen, len2 - hlen);
-
-            if (g_pm1)
-            {
-                /* are we done? */
-                if (_fmpz_poly_divides(Q, B, len2, res, hlen) &&
-                    _fmpz_poly_divides(Q, A, len1, res, hlen))
-                break;
-            }
-            else
-            {
-                if (pbits + unlucky >= bound) /* if we reach the bound with one prime */
-                { 
-                    _fmpz_vec_content(hc, res, hlen);
-
-                   /* divide by content */
-                   _fmpz_vec_scalar_divexact_fmpz(res, res, hlen, hc);
-                   break;
-                }
-
-                if (pbits >= bits_small) /* if one prime is already big enough to check */
-                {
-                    /* divide by content */
-                    _fmpz_vec_content(hc, res, hlen);
-
-                    /* correct sign of leading term */
-                    if (fmpz_sgn(res + hlen - 1) < 0)
-                        fmpz_neg(hc, hc);
-
-                    _fmpz_vec_scalar_divexact_fmpz(res, res, hlen, hc);
-
-                    /* are we done? */
-                    if (_fmpz_poly_divides(Q, B, len2, res, hlen) &&
-                        _fmpz_poly_divides(Q, A, len1, res, hlen))
-                        break;
-
-                    /* no, so multiply by content again */
-                    _fmpz_vec_scalar_mul_fmpz(res, res, hlen, hc);
-                }
-            }
-
-            curr_bits = FLINT_ABS(_fmpz_vec_max_bits(res, hlen));
-            fmpz_set_ui(modulus, p);
-            n = hlen - 1; /* if we reach this we have a new bound on length of result */
-            continue;
-        }
-
-        _fmpz_poly_CRT_ui(res, res, hlen, modulus, h, hlen, mod.n, mod.ninv, 1);
-        fmpz_mul_ui(modulus, modulus, mod.n);
-
-        new_bits = _fmpz_vec_max_bits(res, hlen);
-        new_bits = FLINT_ABS(new_bits);
-
-        if (new_bits == curr_bits || fmpz_bits(modulus) >= bits_small)
-        {
-            if (!g_pm1)
-            {
-                _fmpz_vec_content(hc, res, hlen);
-
-                /* correct sign of leading term */
-                if (fmpz_sgn(res + hlen - 1) < 0)
-                    fmpz_neg(hc, hc);
-
-                /* divide by content */
-                _fmpz_vec_scalar_divexact_fmpz(res, res, hlen, hc);      
-            }
-
-            if (fmpz_bits(modulus) + unlucky >= bound)
-                break;
-
-            /* are we done? */
-            if (_fmpz_poly_divides(Q, B, len2, res, hlen) &&
-                _fmpz_poly_divides(Q, A, len1, res, hlen))
-                break;
-
-            if (!g_pm1) 
-            {            
-                /* no, so multiply by content again */
-                _fmpz_vec_scalar_mul_fmpz(res, res, hlen, hc);
-            }
-        }
-
-        curr_bits = new_bits;
-    }
-
-    fmpz_clear(modulus);
     fmpz_clear(g); 
     fmpz_clear(l); 
-    fmpz_clear(hc);
-
-    _nmod_vec_clear(a);
-    _nmod_vec_clear(b);
-    _nmod_vec_clear(h); 
 
     /* finally multiply by content */
     _fmpz_vec_scalar_mul_fmpz(res, res, hlen, d);
@@ -288,7 +255,6 @@ void _fmpz_poly_gcd_modular(fmpz * res, const fmpz * poly1, slong len1,
     fmpz_clear(d);
     _fmpz_vec_clear(A, len1);
     _fmpz_vec_clear(B, len2);
-    _fmpz_vec_clear(Q, len1);
 }
 
 void
@@ -71,14 +71,14 @@ _fmpz_poly_mul_KS(fmpz * res, const fmpz * poly1, slong len1,
     {
         arr1 = (mp_limb_t *) flint_calloc(limbs1, sizeof(mp_limb_t));
         arr2 = arr1;
-        _fmpz_poly_bit_pack(arr1, poly1, len1, bits, neg1);
+        _fmpz_poly_bit_pack_threaded(arr1, poly1, len1, bits, neg1);
     }
     else
     {
         arr1 = (mp_limb_t *) flint_calloc(limbs1 + limbs2, sizeof(mp_limb_t));
         arr2 = arr1 + limbs1;
-        _fmpz_poly_bit_pack(arr1, poly1, len1, bits, neg1);
-        _fmpz_poly_bit_pack(arr2, poly2, len2, bits, neg2);
+        _fmpz_poly_bit_pack_threaded(arr1, poly1, len1, bits, neg1);
+        _fmpz_poly_bit_pack_threaded(arr2, poly2, len2, bits, neg2);
     }
 
     arr3 = (mp_limb_t *) flint_malloc((limbs1 + limbs2) * sizeof(mp_limb_t));
@@ -104,9 +104,11 @@ _fmpz_poly_mul_KS(fmpz * res, const fmpz * poly1, slong len1,
     }
 
     if (sign)
-        _fmpz_poly_bit_unpack(res, len1 + len2 - 1, arr3, bits, neg1 ^ neg2);
+        _fmpz_poly_bit_unpack_threaded(res, len1 + len2 - 1, arr3, bits,
+                                                               neg1 ^ neg2);
     else
-        _fmpz_poly_bit_unpack_unsigned(res, len1 + len2 - 1, arr3, bits);
+        _fmpz_poly_bit_unpack_unsigned_threaded(res, len1 + len2 - 1,
+                                                                 arr3, bits);
 
     if ((len1 < in1_len) | (len2 < in2_len))
         _fmpz_vec_zero(res + (len1 + len2 - 1), (in1_len - len1) + (in2_len - len2));
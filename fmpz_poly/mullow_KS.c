@@ -78,14 +78,14 @@ _fmpz_poly_mullow_KS(fmpz * res, const fmpz * poly1, slong len1,
     {
         arr1 = (mp_ptr) flint_calloc(limbs1, sizeof(mp_limb_t));
         arr2 = arr1;
-        _fmpz_poly_bit_pack(arr1, poly1, len1, bits, neg1);
+        _fmpz_poly_bit_pack_threaded(arr1, poly1, len1, bits, neg1);
     }
     else
     {
         arr1 = (mp_ptr) flint_calloc(limbs1 + limbs2, sizeof(mp_limb_t));
         arr2 = arr1 + limbs1;
-        _fmpz_poly_bit_pack(arr1, poly1, len1, bits, neg1);
-        _fmpz_poly_bit_pack(arr2, poly2, len2, bits, neg2);
+        _fmpz_poly_bit_pack_threaded(arr1, poly1, len1, bits, neg1);
+        _fmpz_poly_bit_pack_threaded(arr2, poly2, len2, bits, neg2);
     }
 
     arr3 = (mp_ptr) flint_malloc((limbs1 + limbs2) * sizeof(mp_limb_t));
@@ -111,9 +111,9 @@ _fmpz_poly_mullow_KS(fmpz * res, const fmpz * poly1, slong len1,
     }
     
     if (sign)
-        _fmpz_poly_bit_unpack(res, n, arr3, bits, neg1 ^ neg2);
+        _fmpz_poly_bit_unpack_threaded(res, n, arr3, bits, neg1 ^ neg2);
     else
-        _fmpz_poly_bit_unpack_unsigned(res, n, arr3, bits);
+        _fmpz_poly_bit_unpack_unsigned_threaded(res, n, arr3, bits);
 
     flint_free(arr1);
     flint_free(arr3);
@@ -14,21 +14,51 @@
 #include "fmpz.h"
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
-#include "mpn_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
 
 
+typedef struct
+{
+    const fmpz * A;
+    slong len1;
+    const fmpz * B;
+    slong len2;
+    const fmpz * l;
+} _resultant_arg_struct;
+
+/* the resultant modulo p, unless p divides the leading coefficients */
+static slong _resultant_image(mp_ptr res, nmod_t mod, void * varg)
+{
+    _resultant_arg_struct * arg = (_resultant_arg_struct *) varg;
+    mp_ptr a, b;
+
+    if (fmpz_fdiv_ui(arg->l, mod.n) == 0)
+        return -1;
+
+    /* reduce polynomials modulo p */
+    a = _nmod_vec_init(arg->len1);
+    b = _nmod_vec_init(arg->len2);
+    _fmpz_vec_get_nmod_vec(a, arg->A, arg->len1, mod);
+    _fmpz_vec_get_nmod_vec(b, arg->B, arg->len2, mod);
+
+    /* compute resultant over Z/pZ */
+    res[0] = _nmod_poly_resultant(a, arg->len1, b, arg->len2, mod);
+
+    _nmod_vec_clear(a);
+    _nmod_vec_clear(b);
+
+    return 1;
+}
+
 void _fmpz_poly_resultant_modular(fmpz_t res, const fmpz * poly1, slong len1, 
                                         const fmpz * poly2, slong len2)
 {
-    flint_bitcnt_t bits1, bits2, bound, pbits, curr_bits = 0; 
-    slong i, num_primes;
-    fmpz_comb_t comb;
-    fmpz_comb_temp_t comb_temp;
-    fmpz_t ac, bc, l, modulus;
+    flint_bitcnt_t bits1, bits2, bound;
+    fmpz_t ac, bc, l;
     fmpz * A, * B, * lead_A, * lead_B;
-    mp_ptr a, b, rarr, parr;
     mp_limb_t p;
-    nmod_t mod;
+    _resultant_arg_struct arg;
     
     /* special case, one of the polys is a constant */
     if (len2 == 1) /* if len1 == 1 then so does len2 */
@@ -59,8 +89,7 @@ void _fmpz_poly_resultant_modular(fmpz_t res, const fmpz * poly1, slong len1,
     fmpz_mul(l, lead_A, lead_B);
 
     /* set size of first prime */
-    pbits = FLINT_BITS - 1;
-    p = (UWORD(1)<<pbits);
+    p = (UWORD(1)<<(FLINT_BITS - 1));
 
     /* get bound on size of resultant */
     bits1 = FLINT_ABS(_fmpz_vec_max_bits(A, len1)); 
@@ -71,54 +100,15 @@ void _fmpz_poly_resultant_modular(fmpz_t res, const fmpz * poly1, slong len1,
 
     /* Upper bound Hadamard bound */
     bound += (len1 - 1)*bits2 + (len2 - 1)*bits1;
-    
-    num_primes = (bound + pbits - 1)/pbits;
-
-    parr = _nmod_vec_init(num_primes);
-    rarr = _nmod_vec_init(num_primes);
-
-    fmpz_init(modulus);
-    fmpz_set_ui(modulus, 1);
-    fmpz_zero(res);
-
-    /* make space for polynomials mod p */
-    a = _nmod_vec_init(len1);
-    b = _nmod_vec_init(len2);
-    
-    for (i = 0; curr_bits < bound; )
-    {
-        /* get new prime and initialise modulus */
-        p = n_nextprime(p, 0);
-        if (fmpz_fdiv_ui(l, p) == 0)
-            continue;
-        
-        curr_bits += pbits;
-
-        nmod_init(&mod, p);
-
-        /* reduce polynomials modulo p */
-        _fmpz_vec_get_nmod_vec(a, A, len1, mod);
-        _fmpz_vec_get_nmod_vec(b, B, len2, mod);
-
-        /* compute resultant over Z/pZ */
-        parr[i] = p;
-        rarr[i++] = _nmod_poly_resultant(a, len1, b, len2, mod);
-    }
 
-    fmpz_comb_init(comb, parr, num_primes);
-    fmpz_comb_temp_init(comb_temp, comb);
-    
-    fmpz_multi_CRT_ui(res, rarr, comb, comb_temp, 1);
-        
-    fmpz_clear(modulus);
-    fmpz_comb_temp_clear(comb_temp);
-    fmpz_comb_clear(comb);
-        
-    _nmod_vec_clear(a);
-    _nmod_vec_clear(b);
+    arg.A = A;
+    arg.len1 = len1;
+    arg.B = B;
+    arg.len2 = len2;
+    arg.l = l;
 
-    _nmod_vec_clear(parr);
-    _nmod_vec_clear(rarr);
+    _fmpz_vec_modular(res, 1, bound + 1, 0, FMPZ_VEC_MODULAR_FIXED_LENGTH,
+                                         p, _resultant_image, NULL, &arg);
     
     /* finally multiply by powers of content */
     if (!fmpz_is_one(ac))
@@ -50,16 +50,17 @@ _fmpz_poly_sqr_KS(fmpz *rop, const fmpz *op, slong len)
 
     arr = (mp_limb_t *) flint_calloc(limbs, sizeof(mp_limb_t));
 
-    _fmpz_poly_bit_pack(arr, op, len, bits, neg);
+    _fmpz_poly_bit_pack_threaded(arr, op, len, bits, neg);
 
     arr3 = (mp_limb_t *) flint_malloc((2 * limbs) * sizeof(mp_limb_t));
 
     mpn_sqr(arr3, arr, limbs);
 
     if (sign)
-        _fmpz_poly_bit_unpack(rop, 2 * len - 1, arr3, bits, 0);
+        _fmpz_poly_bit_unpack_threaded(rop, 2 * len - 1, arr3, bits, 0);
     else
-        _fmpz_poly_bit_unpack_unsigned(rop, 2 * len - 1, arr3, bits);
+        _fmpz_poly_bit_unpack_unsigned_threaded(rop, 2 * len - 1,
+                                                                 arr3, bits);
 
     if (len < in_len)
         _fmpz_vec_zero(rop + (2 * len - 1), 2 * (in_len - len));
@@ -55,14 +55,14 @@ void _fmpz_poly_sqrlow_KS(fmpz * res, const fmpz * poly, slong len, slong n)
     arr_in  = flint_calloc(limbs, sizeof(mp_limb_t));
     arr_out = flint_malloc((2 * limbs) * sizeof(mp_limb_t));
 
-    _fmpz_poly_bit_pack(arr_in, poly, len, bits, neg);
+    _fmpz_poly_bit_pack_threaded(arr_in, poly, len, bits, neg);
 
     mpn_sqr(arr_out, arr_in, limbs);
 
     if (sign)
-        _fmpz_poly_bit_unpack(res, n, arr_out, bits, 0);
+        _fmpz_poly_bit_unpack_threaded(res, n, arr_out, bits, 0);
     else
-        _fmpz_poly_bit_unpack_unsigned(res, n, arr_out, bits);
+        _fmpz_poly_bit_unpack_unsigned_threaded(res, n, arr_out, bits);
 
     flint_free(arr_in);
     flint_free(arr_out);
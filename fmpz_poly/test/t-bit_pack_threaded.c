@@ -0,0 +1,133 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    int i, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("bit_pack_threaded/bit_unpack_threaded....");
+    fflush(stdout);
+
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        fmpz_poly_t a, b, c;
+        slong j, k, length, limbs;
+        flint_bitcnt_t bits;
+        mp_ptr arr1, arr2;
+        int negate, unsign, borrow1, borrow2;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        fmpz_poly_init(a);
+        fmpz_poly_init(b);
+        fmpz_poly_init(c);
+
+        unsign = n_randint(state, 2);
+        length = n_randint(state, 30000) + 1;
+        bits = n_randint(state, 200) + 2;
+
+        /* -1 bit to handle signs */
+        if (unsign)
+            fmpz_poly_randtest_unsigned(a, state, length, bits - 1);
+        else
+            fmpz_poly_randtest(a, state, length, bits - 1);
+
+        /* runs of zeros, across which the borrow has to be carried */
+        for (k = n_randint(state, 4); k > 0 && a->length > 0; k--)
+        {
+            slong start = n_randint(state, a->length);
+            slong len = n_randint(state, a->length - start);
+
+            for (j = start; j < start + len; j++)
+                fmpz_zero(a->coeffs + j);
+        }
+
+        _fmpz_poly_normalise(a);
+
+        if (a->length == 0)
+            fmpz_poly_set_ui(a, 1);
+
+        length = a->length;
+        negate = (fmpz_sgn(a->coeffs + length - 1) < 0) ? -1 : 0;
+
+        /* the last field may clear the limb after the array */
+        limbs = (length * bits - 1) / FLINT_BITS + 2;
+        arr1 = (mp_ptr) flint_calloc(limbs, sizeof(mp_limb_t));
+        arr2 = (mp_ptr) flint_calloc(limbs, sizeof(mp_limb_t));
+
+        _fmpz_poly_bit_pack(arr1, a->coeffs, length, bits, negate);
+        _fmpz_poly_bit_pack_threaded(arr2, a->coeffs, length, bits, negate);
+
+        result = (mpn_cmp(arr1, arr2, limbs) == 0);
+        if (!result)
+        {
+            flint_printf("FAIL (pack):\n");
+            flint_printf("len = %wd, bits = %wu, threads = %wd\n",
+                                  length, bits, flint_get_num_threads());
+            abort();
+        }
+
+        fmpz_poly_fit_length(b, length);
+        fmpz_poly_fit_length(c, length);
+
+        if (unsign)
+        {
+            _fmpz_poly_bit_unpack_unsigned(b->coeffs, length, arr1, bits);
+            _fmpz_poly_bit_unpack_unsigned_threaded(c->coeffs, length,
+                                                                  arr2, bits);
+            borrow1 = borrow2 = 0;
+        }
+        else
+        {
+            borrow1 = _fmpz_poly_bit_unpack(b->coeffs, length, arr1, bits,
+                                                                      negate);
+            borrow2 = _fmpz_poly_bit_unpack_threaded(c->coeffs, length, arr2,
+                                                                bits, negate);
+        }
+
+        _fmpz_poly_set_length(b, length);
+        _fmpz_poly_set_length(c, length);
+
+        result = (borrow1 == borrow2 && fmpz_poly_equal(a, b)
+                                     && fmpz_poly_equal(b, c));
+        if (!result)
+        {
+            flint_printf("FAIL (unpack):\n");
+            flint_printf("len = %wd, bits = %wu, threads = %wd, "
+                         "unsigned = %d\n",
+                         length, bits, flint_get_num_threads(), unsign);
+            flint_printf("borrow1 = %d, borrow2 = %d\n", borrow1, borrow2);
+            abort();
+        }
+
+        flint_free(arr1);
+        flint_free(arr2);
+        fmpz_poly_clear(a);
+        fmpz_poly_clear(b);
+        fmpz_poly_clear(c);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -228,8 +228,33 @@ FLINT_DLL void _fmpz_vec_prod(fmpz_t res, const fmpz * vec, slong len);
 
 FLINT_DLL void _fmpz_vec_scalar_mod_fmpz(fmpz *res, const fmpz *vec, slong len, const fmpz_t p);
 
+FLINT_DLL void _fmpz_vec_scalar_mod_fmpz_threaded(fmpz *res, const fmpz *vec,
+                                                  slong len, const fmpz_t p);
+
 FLINT_DLL void _fmpz_vec_scalar_smod_fmpz(fmpz *res, const fmpz *vec, slong len, const fmpz_t p);
 
+/*  Multimodular reconstruction  *********************************************/
+
+#define FMPZ_VEC_MODULAR_FIXED_LENGTH 0
+#define FMPZ_VEC_MODULAR_MIN_LENGTH 1
+#define FMPZ_VEC_MODULAR_MAX_LENGTH 2
+
+/*
+    Sets {res, len} to the image modulo mod.n and returns its length, or
+    returns -1 if the prime is to be skipped. May run concurrently.
+*/
+typedef slong (* fmpz_vec_modular_image_func)(mp_ptr res, nmod_t mod,
+                                                                  void * arg);
+
+/* Returns whether the candidate {res, len} modulo modulus is the result */
+typedef int (* fmpz_vec_modular_check_func)(const fmpz * res, slong len,
+                                           const fmpz_t modulus, void * arg);
+
+FLINT_DLL slong _fmpz_vec_modular(fmpz * res, slong len,
+           flint_bitcnt_t bound, flint_bitcnt_t stable_bits, int mode,
+           mp_limb_t p, fmpz_vec_modular_image_func image,
+           fmpz_vec_modular_check_func check, void * arg);
+
 /*  Gaussian content  ********************************************************/
 
 FLINT_DLL void _fmpz_vec_content(fmpz_t res, const fmpz * vec, slong len);
@@ -0,0 +1,273 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    mp_ptr res;
+    nmod_t mod;
+    slong len;
+    fmpz_vec_modular_image_func image;
+    void * arg;
+} _image_arg_struct;
+
+static void _image_worker(void * varg)
+{
+    _image_arg_struct * arg = (_image_arg_struct *) varg;
+
+    arg->len = arg->image(arg->res, arg->mod, arg->arg);
+}
+
+typedef struct
+{
+    _image_arg_struct * args;
+    slong num;
+} _batch_arg_struct;
+
+static void _batch_tasks(void * varg)
+{
+    _batch_arg_struct * arg = (_batch_arg_struct *) varg;
+    slong i;
+    thread_pool_task_group_t G;
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i + 1 < arg->num; i++)
+        thread_pool_spawn(G, _image_worker, arg->args + i);
+    _image_worker(arg->args + arg->num - 1);
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+}
+
+/*
+    Combines the images {R + i*len, rlen} modulo the num primes P[i] into
+    {res, rlen} modulo M, and updates M. Returns whether res has changed.
+*/
+static int
+_combine(fmpz * res, fmpz_t M, mp_srcptr R, mp_srcptr P, slong num,
+                                                       slong len, slong rlen)
+{
+    slong i, j;
+    int changed = 0;
+    fmpz_t r, Q, MQ, c;
+    mp_ptr v;
+
+    fmpz_init(r);
+    fmpz_init(Q);
+    fmpz_init(MQ);
+    fmpz_init(c);
+
+    if (num == 1)
+    {
+        fmpz_set_ui(Q, P[0]);
+        fmpz_mul_ui(MQ, M, P[0]);
+
+        for (j = 0; j < rlen; j++)
+        {
+            if (fmpz_is_one(M))
+                fmpz_set_ui_smod(r, R[j], P[0]);
+            else
+                fmpz_CRT_ui(r, res + j, M, R[j], P[0], 1);
+
+            changed |= !fmpz_equal(r, res + j);
+            fmpz_swap(r, res + j);
+        }
+    }
+    else
+    {
+        fmpz_comb_t comb;
+        fmpz_comb_temp_t temp;
+
+        fmpz_comb_init(comb, P, num);
+        fmpz_comb_temp_init(temp, comb);
+
+        fmpz_one(Q);
+        for (i = 0; i < num; i++)
+            fmpz_mul_ui(Q, Q, P[i]);
+        fmpz_mul(MQ, M, Q);
+
+        if (!fmpz_is_one(M))
+        {
+            fmpz_mod(c, M, Q);
+            fmpz_invmod(c, c, Q);
+        }
+
+        v = flint_malloc(num*sizeof(mp_limb_t));
+
+        for (j = 0; j < rlen; j++)
+        {
+            for (i = 0; i < num; i++)
+                v[i] = R[i*len + j];
+
+            if (fmpz_is_one(M))
+            {
+                fmpz_multi_CRT_ui(r, v, comb, temp, 1);
+            }
+            else
+            {
+                fmpz_multi_CRT_ui(r, v, comb, temp, 0);
+                _fmpz_CRT(r, res + j, M, r, Q, MQ, c, 1);
+            }
+
+            changed |= !fmpz_equal(r, res + j);
+            fmpz_swap(r, res + j);
+        }
+
+        flint_free(v);
+        fmpz_comb_temp_clear(temp);
+        fmpz_comb_clear(comb);
+    }
+
+    fmpz_swap(M, MQ);
+
+    fmpz_clear(r);
+    fmpz_clear(Q);
+    fmpz_clear(MQ);
+    fmpz_clear(c);
+
+    return changed;
+}
+
+slong
+_fmpz_vec_modular(fmpz * res, slong len,
+           flint_bitcnt_t bound, flint_bitcnt_t stable_bits, int mode,
+           mp_limb_t p, fmpz_vec_modular_image_func image,
+           fmpz_vec_modular_check_func check, void * arg)
+{
+    slong i, j, num, rlen, batch, alloc = 0;
+    flint_bitcnt_t stable = 0, pbits;
+    _image_arg_struct * args = NULL;
+    _batch_arg_struct barg;
+    mp_ptr R = NULL, P = NULL;
+    fmpz_t M;
+    int changed, first;
+
+    fmpz_init_set_ui(M, 1);
+    _fmpz_vec_zero(res, len);
+    rlen = (mode == FMPZ_VEC_MODULAR_FIXED_LENGTH) ? len : -1;
+
+    /* at least one good image is needed, even for a tiny bound */
+    while (fmpz_is_one(M) || fmpz_bits(M) < bound)
+    {
+        /* do not overshoot the bound by more than necessary */
+        pbits = FLINT_BIT_COUNT(p);
+        batch = (bound - fmpz_bits(M) + pbits - 1)/pbits;
+        batch = FLINT_MAX(batch, 1);
+
+        /*
+            Without early termination all primes up to the bound are
+            combined at once. Otherwise the batches grow with the number
+            of primes used so far, so that the combination costs only a
+            logarithmic number of subproduct trees and at most about
+            twice the images needed are computed.
+        */
+        if (stable_bits != 0 || check != NULL)
+            batch = FLINT_MIN(batch, FLINT_MAX(flint_get_num_threads(),
+                                        (slong) (fmpz_bits(M)/pbits)));
+
+        if (batch > alloc)
+        {
+            alloc = FLINT_MAX(batch, 2*alloc);
+            args = flint_realloc(args, alloc*sizeof(_image_arg_struct));
+            R = flint_realloc(R, alloc*len*sizeof(mp_limb_t));
+            P = flint_realloc(P, alloc*sizeof(mp_limb_t));
+        }
+
+        for (i = 0; i < batch; i++)
+        {
+            p = n_nextprime(p, 0);
+            nmod_init(&args[i].mod, p);
+            args[i].res = R + i*len;
+            args[i].image = image;
+            args[i].arg = arg;
+        }
+
+        if (batch == 1)
+        {
+            _image_worker(args);
+        }
+        else
+        {
+            barg.args = args;
+            barg.num = batch;
+            flint_run_tasks(_batch_tasks, &barg, batch);
+        }
+
+        /* keep the images of the best length, in order */
+        for (i = 0, num = 0; i < batch; i++)
+        {
+            slong l = args[i].len;
+
+            if (l < 0)
+                continue;
+
+            if (mode == FMPZ_VEC_MODULAR_FIXED_LENGTH)
+            {
+                if (l != len)
+                    continue;
+            }
+            else if (rlen < 0 ||
+                (mode == FMPZ_VEC_MODULAR_MIN_LENGTH && l < rlen) ||
+                (mode == FMPZ_VEC_MODULAR_MAX_LENGTH && l > rlen))
+            {
+                /* all previous primes were bad */
+                rlen = l;
+                num = 0;
+                fmpz_one(M);
+                _fmpz_vec_zero(res, len);
+                stable = 0;
+            }
+            else if (l != rlen)
+            {
+                continue;
+            }
+
+            if (num != i)
+                for (j = 0; j < l; j++)
+                    R[num*len + j] = R[i*len + j];
+            P[num++] = args[i].mod.n;
+        }
+
+        if (num == 0)
+            continue;
+
+        first = fmpz_is_one(M);
+        changed = _combine(res, M, R, P, num, len, rlen) || first;
+
+        if (changed)
+            stable = 0;
+        else
+            for (i = 0; i < num; i++)
+                stable += FLINT_BIT_COUNT(P[i]);
+
+        /* stop early once the result is stable or passes the check */
+        if (stable_bits != 0 && stable >= stable_bits &&
+                                  (check == NULL || check(res, rlen, M, arg)))
+            break;
+
+        if (stable_bits == 0 && check != NULL && check(res, rlen, M, arg))
+            break;
+    }
+
+    fmpz_clear(M);
+    flint_free(args);
+    flint_free(R);
+    flint_free(P);
+
+    return rlen;
+}
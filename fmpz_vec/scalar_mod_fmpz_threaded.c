@@ -0,0 +1,85 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "thread_support.h"
+
+/* entries reduced per task */
+#define SCALAR_MOD_CHUNK 256
+
+typedef struct
+{
+    fmpz * res;
+    const fmpz * vec;
+    slong len;
+    const fmpz * p;
+} _scalar_mod_arg_struct;
+
+static void _scalar_mod_worker(void * varg)
+{
+    _scalar_mod_arg_struct * arg = (_scalar_mod_arg_struct *) varg;
+
+    _fmpz_vec_scalar_mod_fmpz(arg->res, arg->vec, arg->len, arg->p);
+}
+
+static void _scalar_mod_tasks(void * varg)
+{
+    _scalar_mod_arg_struct * arg = (_scalar_mod_arg_struct *) varg;
+    _scalar_mod_arg_struct * args;
+    slong i, num;
+    thread_pool_task_group_t G;
+
+    num = (arg->len + SCALAR_MOD_CHUNK - 1)/SCALAR_MOD_CHUNK;
+
+    args = (_scalar_mod_arg_struct *)
+                             flint_malloc(num*sizeof(_scalar_mod_arg_struct));
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i < num; i++)
+    {
+        args[i].res = arg->res + i*SCALAR_MOD_CHUNK;
+        args[i].vec = arg->vec + i*SCALAR_MOD_CHUNK;
+        args[i].len = FLINT_MIN(SCALAR_MOD_CHUNK, arg->len - i*SCALAR_MOD_CHUNK);
+        args[i].p = arg->p;
+
+        if (i + 1 < num)
+            thread_pool_spawn(G, _scalar_mod_worker, args + i);
+        else
+            _scalar_mod_worker(args + i);
+    }
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    flint_free(args);
+}
+
+void _fmpz_vec_scalar_mod_fmpz_threaded(fmpz *res, const fmpz *vec,
+                                                  slong len, const fmpz_t p)
+{
+    _scalar_mod_arg_struct arg;
+
+    arg.res = res;
+    arg.vec = vec;
+    arg.len = len;
+    arg.p = p;
+
+    /* each task should outweigh the cost of scheduling it */
+    if (len < 2*SCALAR_MOD_CHUNK || len*fmpz_size(p) < 8192 ||
+                                                flint_get_num_threads() == 1)
+        _scalar_mod_worker(&arg);
+    else
+        flint_run_tasks(_scalar_mod_tasks, &arg, flint_get_num_threads());
+}
@@ -0,0 +1,161 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    const fmpz * a;
+    slong len;
+    int unlucky;
+    mp_limb_t last_unlucky;
+} test_arg_struct;
+
+/*
+   images of a, where if unlucky is set some primes are skipped and the
+   first few give an image one coefficient too long
+*/
+static slong test_image(mp_ptr res, nmod_t mod, void * varg)
+{
+    test_arg_struct * arg = (test_arg_struct *) varg;
+    slong len = arg->len;
+
+    if (arg->unlucky && mod.n % 5 == 1)
+        return -1;
+
+    _fmpz_vec_get_nmod_vec(res, arg->a, len, mod);
+
+    if (arg->unlucky && mod.n <= arg->last_unlucky)
+    {
+        res[len] = 1;
+        len++;
+    }
+
+    return len;
+}
+
+static int test_check(const fmpz * res, slong len,
+                                         const fmpz_t modulus, void * varg)
+{
+    test_arg_struct * arg = (test_arg_struct *) varg;
+
+    return len == arg->len && _fmpz_vec_equal(res, arg->a, len);
+}
+
+int
+main(void)
+{
+    int i, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("modular....");
+    fflush(stdout);
+
+    /* Reconstruct a vector from enough primes */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz * a, * b;
+        slong len = n_randint(state, 20) + 1, rlen;
+        flint_bitcnt_t bits = n_randint(state, 1000) + 1, bound;
+        mp_limb_t p = n_randtest_bits(state, n_randint(state, FLINT_BITS - 1) + 2);
+        test_arg_struct arg;
+        int mode;
+        slong j, num_unlucky;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len + 1);
+        _fmpz_vec_randtest(a, state, len, bits);
+        bits = FLINT_ABS(_fmpz_vec_max_bits(a, len));
+
+        arg.a = a;
+        arg.len = len;
+        arg.unlucky = n_randint(state, 2);
+        mode = arg.unlucky ? FMPZ_VEC_MODULAR_MIN_LENGTH :
+                             FMPZ_VEC_MODULAR_FIXED_LENGTH;
+
+        /* the unlucky primes alone must not reach the bound */
+        num_unlucky = n_randint(state, 5);
+        arg.last_unlucky = p;
+        for (j = 0; j < num_unlucky; j++)
+            arg.last_unlucky = n_nextprime(arg.last_unlucky, 0);
+        bound = bits + 2 + (arg.unlucky ? num_unlucky*FLINT_BITS : 0);
+
+        rlen = _fmpz_vec_modular(b, arg.unlucky ? len + 1 : len, bound, 0,
+                                 mode, p, test_image, NULL, &arg);
+
+        result = (rlen == len && _fmpz_vec_equal(a, b, len));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("len = %wd, rlen = %wd, bits = %wu, p = %wu, "
+                 "unlucky = %d, threads = %wd\n", len, rlen, bits, p,
+                 arg.unlucky, flint_get_num_threads());
+            abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len + 1);
+    }
+
+    /* Early termination once the result is stable or passes the check */
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz * a, * b;
+        slong len = n_randint(state, 20) + 1, rlen;
+        flint_bitcnt_t bits = n_randint(state, 1000) + 1;
+        mp_limb_t p = UWORD(1) << (FLINT_BITS - 1);
+        test_arg_struct arg;
+        int use_check = n_randint(state, 2);
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        _fmpz_vec_randtest(a, state, len, bits);
+
+        arg.a = a;
+        arg.len = len;
+        arg.unlucky = 0;
+
+        /* the bound is far too large to be reached */
+        rlen = _fmpz_vec_modular(b, len, 1000000,
+                         use_check ? 0 : 2*FLINT_BITS,
+                         FMPZ_VEC_MODULAR_FIXED_LENGTH, p, test_image,
+                         use_check ? test_check : NULL, &arg);
+
+        result = (rlen == len && _fmpz_vec_equal(a, b, len));
+        if (!result)
+        {
+            flint_printf("FAIL (early termination):\n");
+            flint_printf("len = %wd, rlen = %wd, use_check = %d, "
+                 "threads = %wd\n", len, rlen, use_check,
+                 flint_get_num_threads());
+            abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
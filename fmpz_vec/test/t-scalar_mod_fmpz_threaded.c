@@ -0,0 +1,79 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    int i, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("scalar_mod_fmpz_threaded....");
+    fflush(stdout);
+
+    /* Compare with the single threaded version, with and without aliasing */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        fmpz_t p;
+        fmpz *a, *b, *c;
+        slong len = n_randint(state, 3000);
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        fmpz_init(p);
+        fmpz_randtest_unsigned(p, state, 2000);
+        fmpz_add_ui(p, p, 1);
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        c = _fmpz_vec_init(len);
+        _fmpz_vec_randtest(a, state, len, 4000);
+
+        _fmpz_vec_scalar_mod_fmpz(b, a, len, p);
+
+        if (n_randint(state, 2))
+        {
+            _fmpz_vec_scalar_mod_fmpz_threaded(c, a, len, p);
+        }
+        else
+        {
+            _fmpz_vec_set(c, a, len);
+            _fmpz_vec_scalar_mod_fmpz_threaded(c, c, len, p);
+        }
+
+        result = (_fmpz_vec_equal(b, c, len));
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("len = %wd, threads = %wd\n", len,
+                                                    flint_get_num_threads());
+            abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+        _fmpz_vec_clear(c, len);
+        fmpz_clear(p);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -24,6 +24,7 @@
 
 #include "nmod_poly.h"
 #include "nmod_mat.h"
+#include "gf2_poly.h"
 #include "ulong_extras.h"
 
 /* Data types and context ****************************************************/
@@ -49,10 +50,18 @@ typedef struct
     nmod_poly_t modulus;
     nmod_poly_t inv;
 
+    /* bit packed modulus and inverse, used in characteristic two */
+    int is_gf2;
+    gf2_poly_t gf2_modulus;
+    gf2_poly_t gf2_inv;
+
     char *var;
 }
 fq_nmod_ctx_struct;
 
+/* Degree from which arithmetic over GF(2) uses the packed modulus */
+#define FQ_NMOD_GF2_CUTOFF 16
+
 typedef fq_nmod_ctx_struct fq_nmod_ctx_t[1];
 
 FLINT_DLL void fq_nmod_ctx_init(fq_nmod_ctx_t ctx,
@@ -272,6 +281,18 @@ FLINT_DLL void fq_nmod_pow(fq_nmod_t rop, const fq_nmod_t op1,
 FLINT_DLL void fq_nmod_pow_ui(fq_nmod_t rop,
                   const fq_nmod_t op1, const ulong e, const fq_nmod_ctx_t ctx);
 
+FLINT_DLL void _fq_nmod_gf2_mul(fq_nmod_t rop,
+            const fq_nmod_t op1, const fq_nmod_t op2, const fq_nmod_ctx_t ctx);
+
+FLINT_DLL void _fq_nmod_gf2_sqr(fq_nmod_t rop,
+                                  const fq_nmod_t op, const fq_nmod_ctx_t ctx);
+
+FLINT_DLL void _fq_nmod_gf2_inv(mp_limb_t *rop, const mp_limb_t *op,
+                                        slong len, const fq_nmod_ctx_t ctx);
+
+FLINT_DLL void _fq_nmod_gf2_pow(mp_limb_t *rop, const mp_limb_t *op,
+                           slong len, const fmpz_t e, const fq_nmod_ctx_t ctx);
+
 /* Roots ********************************************************************/
 
 FLINT_DLL int fq_nmod_sqrt(fq_nmod_t rop, const fq_nmod_t op,
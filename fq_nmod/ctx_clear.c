@@ -17,6 +17,8 @@ void fq_nmod_ctx_clear(fq_nmod_ctx_t ctx)
 {
     nmod_poly_clear(ctx->modulus);
     nmod_poly_clear(ctx->inv);
+    gf2_poly_clear(ctx->gf2_modulus);
+    gf2_poly_clear(ctx->gf2_inv);
     fmpz_clear(fq_nmod_ctx_prime(ctx));
     _nmod_vec_clear(ctx->a);
     flint_free(ctx->j);
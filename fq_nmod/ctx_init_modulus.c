@@ -75,6 +75,22 @@ fq_nmod_ctx_init_modulus(fq_nmod_ctx_t ctx, const nmod_poly_t modulus,
     nmod_poly_reverse(ctx->inv, ctx->modulus, ctx->modulus->length);
     nmod_poly_inv_series_newton(ctx->inv, ctx->inv, ctx->modulus->length);
 
+    /* Over GF(2) and in large degree, use bit packed arithmetic */
+    ctx->is_gf2 = (ctx->mod.n == 2 &&
+                   modulus->length - 1 >= FQ_NMOD_GF2_CUTOFF);
+
+    gf2_poly_init(ctx->gf2_modulus);
+    gf2_poly_init(ctx->gf2_inv);
+
+    if (ctx->is_gf2)
+    {
+        gf2_poly_set_nmod_poly(ctx->gf2_modulus, ctx->modulus);
+        gf2_poly_reverse(ctx->gf2_inv, ctx->gf2_modulus,
+                                       ctx->gf2_modulus->length);
+        gf2_poly_inv_series(ctx->gf2_inv, ctx->gf2_inv,
+                                       ctx->gf2_modulus->length);
+    }
+
     ctx->is_conway = 0;
 }
 
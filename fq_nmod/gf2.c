@@ -0,0 +1,104 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fq_nmod.h"
+
+/*
+    Arithmetic in GF(2^d) for contexts with is_gf2 set: the operands are
+    packed into gf2_poly_t's and reduced using the precomputed inverse
+    of the reversed modulus.
+*/
+
+static void
+_gf2_set_vec(gf2_poly_t res, const mp_limb_t * op, slong len)
+{
+    gf2_poly_fit_length(res, len);
+    _gf2_poly_pack(res->coeffs, op, len);
+    _gf2_poly_normalise(res, GF2_POLY_LIMBS(len));
+}
+
+/* sets {rop, n} to the coefficients of op, which has length at most n */
+static void
+_gf2_get_vec(mp_limb_t * rop, slong n, const gf2_poly_t op)
+{
+    _gf2_poly_unpack(rop, op->coeffs, op->length);
+    _nmod_vec_zero(rop + op->length, n - op->length);
+}
+
+void
+_fq_nmod_gf2_mul(fq_nmod_t rop, const fq_nmod_t op1, const fq_nmod_t op2,
+                                                      const fq_nmod_ctx_t ctx)
+{
+    gf2_poly_t a, b;
+
+    gf2_poly_init(a);
+    gf2_poly_init(b);
+
+    _gf2_set_vec(a, op1->coeffs, op1->length);
+    _gf2_set_vec(b, op2->coeffs, op2->length);
+    gf2_poly_mulmod_preinv(a, a, b, ctx->gf2_modulus, ctx->gf2_inv);
+
+    nmod_poly_fit_length(rop, a->length);
+    _gf2_poly_unpack(rop->coeffs, a->coeffs, a->length);
+    _nmod_poly_set_length(rop, a->length);
+
+    gf2_poly_clear(a);
+    gf2_poly_clear(b);
+}
+
+void
+_fq_nmod_gf2_sqr(fq_nmod_t rop, const fq_nmod_t op, const fq_nmod_ctx_t ctx)
+{
+    gf2_poly_t a;
+
+    gf2_poly_init(a);
+
+    _gf2_set_vec(a, op->coeffs, op->length);
+    gf2_poly_sqrmod_preinv(a, a, ctx->gf2_modulus, ctx->gf2_inv);
+
+    nmod_poly_fit_length(rop, a->length);
+    _gf2_poly_unpack(rop->coeffs, a->coeffs, a->length);
+    _nmod_poly_set_length(rop, a->length);
+
+    gf2_poly_clear(a);
+}
+
+/* sets {rop, d} to the inverse of {op, len}, which must be invertible */
+void
+_fq_nmod_gf2_inv(mp_limb_t * rop, const mp_limb_t * op, slong len,
+                                                      const fq_nmod_ctx_t ctx)
+{
+    gf2_poly_t a;
+
+    gf2_poly_init(a);
+
+    _gf2_set_vec(a, op, len);
+    gf2_poly_invmod(a, a, ctx->gf2_modulus);
+    _gf2_get_vec(rop, fq_nmod_ctx_degree(ctx), a);
+
+    gf2_poly_clear(a);
+}
+
+/* sets {rop, 2d - 1} to {op, len}^e, as _fq_nmod_pow */
+void
+_fq_nmod_gf2_pow(mp_limb_t * rop, const mp_limb_t * op, slong len,
+                                       const fmpz_t e, const fq_nmod_ctx_t ctx)
+{
+    gf2_poly_t a;
+
+    gf2_poly_init(a);
+
+    _gf2_set_vec(a, op, len);
+    gf2_poly_powmod_fmpz_preinv(a, a, e, ctx->gf2_modulus, ctx->gf2_inv);
+    _gf2_get_vec(rop, 2*fq_nmod_ctx_degree(ctx) - 1, a);
+
+    gf2_poly_clear(a);
+}
@@ -23,6 +23,10 @@ void _fq_nmod_inv(mp_limb_t *rop, const mp_limb_t *op, slong len,
         rop[0] = n_invmod(op[0], ctx->mod.n);
         _nmod_vec_zero(rop + 1, d - 1);
     }
+    else if (ctx->is_gf2)
+    {
+        _fq_nmod_gf2_inv(rop, op, len, ctx);
+    }
     else
     {
         _nmod_poly_invmod(rop, op, len, ctx->modulus->coeffs, d + 1, ctx->mod);
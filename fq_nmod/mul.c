@@ -15,6 +15,12 @@
 
 void fq_nmod_mul(fq_nmod_t rop, const fq_nmod_t op1, const fq_nmod_t op2, const fq_nmod_ctx_t ctx)
 {
+    if (ctx->is_gf2)
+    {
+        _fq_nmod_gf2_mul(rop, op1, op2, ctx);
+        return;
+    }
+
     nmod_poly_mul(rop, op1, op2);
 
     fq_nmod_reduce(rop, ctx);
@@ -27,6 +27,10 @@ void _fq_nmod_pow(mp_limb_t *rop, const mp_limb_t *op, slong len, const fmpz_t e
         _nmod_vec_set(rop, op, len);
         _nmod_vec_zero(rop + len, 2 * d - 1 - len);
     }
+    else if (ctx->is_gf2)
+    {
+        _fq_nmod_gf2_pow(rop, op, len, e, ctx);
+    }
     else
     {
         ulong bit;
@@ -13,6 +13,12 @@
 
 void fq_nmod_sqr(fq_nmod_t rop, const fq_nmod_t op, const fq_nmod_ctx_t ctx)
 {
+    if (ctx->is_gf2)
+    {
+        _fq_nmod_gf2_sqr(rop, op, ctx);
+        return;
+    }
+
     nmod_poly_mul(rop, op, op);
 
     fq_nmod_reduce(rop, ctx);
@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "fq_nmod.h"
+
+/* arithmetic in GF(2^d) against nmod_poly arithmetic modulo the modulus */
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("gf2....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 100 * flint_test_multiplier(); iter++)
+    {
+        fq_nmod_ctx_t ctx;
+        fq_nmod_t a, b, c;
+        nmod_poly_t r;
+        fmpz_t p, e;
+        slong d;
+
+        fmpz_init_set_ui(p, 2);
+        fmpz_init(e);
+
+        d = 1 + n_randint(state, 8*FQ_NMOD_GF2_CUTOFF);
+        fq_nmod_ctx_init(ctx, p, d, "a");
+
+        fq_nmod_init(a, ctx);
+        fq_nmod_init(b, ctx);
+        fq_nmod_init(c, ctx);
+        nmod_poly_init(r, 2);
+
+        fq_nmod_randtest(a, state, ctx);
+        fq_nmod_randtest(b, state, ctx);
+
+        fq_nmod_mul(c, a, b, ctx);
+        nmod_poly_mulmod(r, a, b, fq_nmod_ctx_modulus(ctx));
+
+        if (!nmod_poly_equal(c, r))
+        {
+            flint_printf("FAIL: mul, d = %wd\n", d);
+            abort();
+        }
+
+        fq_nmod_sqr(c, a, ctx);
+        nmod_poly_mulmod(r, a, a, fq_nmod_ctx_modulus(ctx));
+
+        if (!nmod_poly_equal(c, r))
+        {
+            flint_printf("FAIL: sqr, d = %wd\n", d);
+            abort();
+        }
+
+        fmpz_randtest_unsigned(e, state, 200);
+        fq_nmod_pow(c, a, e, ctx);
+        nmod_poly_powmod_fmpz_binexp(r, a, e, fq_nmod_ctx_modulus(ctx));
+
+        if (!nmod_poly_equal(c, r))
+        {
+            flint_printf("FAIL: pow, d = %wd\n", d);
+            abort();
+        }
+
+        if (!fq_nmod_is_zero(a, ctx))
+        {
+            fq_nmod_inv(b, a, ctx);
+            fq_nmod_mul(c, a, b, ctx);
+
+            if (!fq_nmod_is_one(c, ctx))
+            {
+                flint_printf("FAIL: inv, d = %wd\n", d);
+                abort();
+            }
+        }
+
+        fq_nmod_clear(a, ctx);
+        fq_nmod_clear(b, ctx);
+        fq_nmod_clear(c, ctx);
+        nmod_poly_clear(r);
+        fq_nmod_ctx_clear(ctx);
+        fmpz_clear(p);
+        fmpz_clear(e);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
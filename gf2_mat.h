@@ -0,0 +1,193 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef GF2_MAT_H
+#define GF2_MAT_H
+
+#ifdef GF2_MAT_INLINES_C
+#define GF2_MAT_INLINE FLINT_DLL
+#else
+#define GF2_MAT_INLINE static __inline__
+#endif
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <stdlib.h>
+#undef ulong
+#include <gmp.h>
+#define ulong mp_limb_t
+
+#include "flint.h"
+#include "longlong.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "thread_support.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/*
+    Dense matrices over GF(2), packed FLINT_BITS entries to a limb. Entry
+    (i, j) is bit j % FLINT_BITS of rows[i][j / FLINT_BITS]. Each row
+    occupies stride limbs and the unused high bits of the last limb of
+    every row are always zero.
+*/
+typedef struct
+{
+    mp_ptr entries;
+    slong r;
+    slong c;
+    slong stride;
+    mp_ptr * rows;
+}
+gf2_mat_struct;
+
+typedef gf2_mat_struct gf2_mat_t[1];
+
+#define GF2_MAT_STRIDE(c) (((c) + FLINT_BITS - 1) / FLINT_BITS)
+
+GF2_MAT_INLINE
+slong gf2_mat_nrows(const gf2_mat_t A)
+{
+   return A->r;
+}
+
+GF2_MAT_INLINE
+slong gf2_mat_ncols(const gf2_mat_t A)
+{
+   return A->c;
+}
+
+GF2_MAT_INLINE
+int gf2_mat_is_empty(const gf2_mat_t A)
+{
+    return (A->r == 0) || (A->c == 0);
+}
+
+GF2_MAT_INLINE
+ulong gf2_mat_get_entry(const gf2_mat_t A, slong i, slong j)
+{
+    return (A->rows[i][j / FLINT_BITS] >> (j % FLINT_BITS)) & 1;
+}
+
+GF2_MAT_INLINE
+void gf2_mat_set_entry(gf2_mat_t A, slong i, slong j, ulong x)
+{
+    mp_limb_t b = UWORD(1) << (j % FLINT_BITS);
+
+    if (x & 1)
+        A->rows[i][j / FLINT_BITS] |= b;
+    else
+        A->rows[i][j / FLINT_BITS] &= ~b;
+}
+
+GF2_MAT_INLINE
+void gf2_mat_swap(gf2_mat_t A, gf2_mat_t B)
+{
+    gf2_mat_struct t = *A;
+    *A = *B;
+    *B = t;
+}
+
+GF2_MAT_INLINE
+void gf2_mat_swap_rows(gf2_mat_t A, slong i, slong j)
+{
+    if (i != j)
+    {
+        mp_ptr t = A->rows[i];
+        A->rows[i] = A->rows[j];
+        A->rows[j] = t;
+    }
+}
+
+/* Memory management */
+
+FLINT_DLL void gf2_mat_init(gf2_mat_t A, slong r, slong c);
+
+FLINT_DLL void gf2_mat_init_set(gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_clear(gf2_mat_t A);
+
+/* Basic assignment and comparison */
+
+FLINT_DLL void gf2_mat_set(gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_zero(gf2_mat_t A);
+
+FLINT_DLL void gf2_mat_one(gf2_mat_t A);
+
+FLINT_DLL int gf2_mat_equal(const gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL int gf2_mat_is_zero(const gf2_mat_t A);
+
+FLINT_DLL void gf2_mat_randtest(gf2_mat_t A, flint_rand_t state);
+
+FLINT_DLL void gf2_mat_set_nmod_mat(gf2_mat_t A, const nmod_mat_t B);
+
+FLINT_DLL void gf2_mat_get_nmod_mat(nmod_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_print_pretty(const gf2_mat_t A);
+
+/* Row operations */
+
+FLINT_DLL void _gf2_mat_row_add(mp_ptr res, mp_srcptr vec1,
+                                                 mp_srcptr vec2, slong len);
+
+FLINT_DLL void _gf2_mat_row_add_many(mp_ptr res, mp_srcptr * vecs,
+                                                      slong num, slong len);
+
+/* Transpose and addition */
+
+FLINT_DLL void _gf2_mat_transpose_64(mp_ptr a);
+
+FLINT_DLL void gf2_mat_transpose(gf2_mat_t B, const gf2_mat_t A);
+
+FLINT_DLL void gf2_mat_add(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+/* Multiplication */
+
+FLINT_DLL void gf2_mat_mul_classical(gf2_mat_t C,
+                                        const gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_mul_m4ri(gf2_mat_t C,
+                                        const gf2_mat_t A, const gf2_mat_t B);
+
+FLINT_DLL void gf2_mat_mul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+/* Elimination */
+
+FLINT_DLL slong gf2_mat_rref(gf2_mat_t A);
+
+FLINT_DLL slong gf2_mat_rank(const gf2_mat_t A);
+
+FLINT_DLL slong gf2_mat_nullspace(gf2_mat_t X, const gf2_mat_t A);
+
+/* Tuning parameters *********************************************************/
+
+/* Rows of A above which multiplication uses the M4RI tables */
+#define GF2_MAT_MUL_M4RI_CUTOFF 192
+
+/* Limbs of C covered by the tables of one M4RI tile */
+#define GF2_MAT_MUL_M4RI_BLOCK 32
+
+/* Rows of C per M4RI tile when the columns alone do not give enough tiles */
+#define GF2_MAT_MUL_M4RI_MIN_ROWS 2048
+
+/* Limbs per elimination step above which rows are reduced in parallel */
+#define GF2_MAT_RREF_THREADED_CUTOFF 65536
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
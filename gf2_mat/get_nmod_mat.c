@@ -0,0 +1,35 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+void
+gf2_mat_get_nmod_mat(nmod_mat_t A, const gf2_mat_t B)
+{
+    slong i, j, k;
+
+    for (i = 0; i < B->r; i++)
+    {
+        mp_ptr a = A->rows[i];
+
+        for (j = 0; j < B->stride; j++)
+        {
+            mp_limb_t w = B->rows[i][j];
+            slong len = FLINT_MIN(FLINT_BITS, B->c - j*FLINT_BITS);
+
+            for (k = 0; k < len; k++)
+                a[j*FLINT_BITS + k] = (w >> k) & 1;
+        }
+    }
+}
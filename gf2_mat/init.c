@@ -0,0 +1,46 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+void
+gf2_mat_init(gf2_mat_t A, slong r, slong c)
+{
+    slong i, stride = GF2_MAT_STRIDE(c);
+
+    if (r != 0)
+        A->rows = (mp_ptr *) flint_malloc(r*sizeof(mp_ptr));
+    else
+        A->rows = NULL;
+
+    if (r != 0 && c != 0)
+    {
+        A->entries = (mp_ptr) flint_calloc(flint_mul_sizes(r, stride),
+                                                          sizeof(mp_limb_t));
+
+        for (i = 0; i < r; i++)
+            A->rows[i] = A->entries + i*stride;
+    }
+    else
+    {
+        A->entries = NULL;
+
+        for (i = 0; i < r; i++)
+            A->rows[i] = NULL;
+    }
+
+    A->r = r;
+    A->c = c;
+    A->stride = stride;
+}
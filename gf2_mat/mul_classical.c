@@ -0,0 +1,60 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+/* row i of C is the sum of the rows of B selected by row i of A */
+void
+gf2_mat_mul_classical(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    slong i, j, num;
+    unsigned int b;
+    mp_limb_t w;
+    mp_srcptr vecs[8];
+
+    if (C == A || C == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, A->r, B->c);
+        gf2_mat_mul_classical(T, A, B);
+        gf2_mat_swap(C, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    if (C->c == 0)
+        return;
+
+    for (i = 0; i < A->r; i++)
+    {
+        flint_mpn_zero(C->rows[i], C->stride);
+
+        for (j = 0, num = 0; j < A->stride; j++)
+        {
+            for (w = A->rows[i][j]; w != 0; w &= w - 1)
+            {
+                count_trailing_zeros(b, w);
+                vecs[num++] = B->rows[j*FLINT_BITS + b];
+
+                if (num == 8)
+                {
+                    _gf2_mat_row_add_many(C->rows[i], vecs, num, C->stride);
+                    num = 0;
+                }
+            }
+        }
+
+        _gf2_mat_row_add_many(C->rows[i], vecs, num, C->stride);
+    }
+}
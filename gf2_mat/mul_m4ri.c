@@ -0,0 +1,207 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+#include "thread_pool.h"
+
+/*
+    Method of the four Russians: for each limb of A, the rows of B it
+    selects are split into groups of eight and all 256 sums of each group
+    are tabulated (one addition per table entry), so that a limb of A
+    costs at most FLINT_BITS / 8 row additions instead of FLINT_BITS.
+
+    C is cut into tiles of GF2_MAT_MUL_M4RI_BLOCK limbs per row so that the
+    tables stay in cache. Every tile builds its own tables, so the tiles
+    are independent and are handed out to the threads from a counter.
+*/
+
+#define TABLES (FLINT_BITS / 8)
+
+typedef struct
+{
+    mp_ptr * C;
+    mp_ptr const * A;
+    mp_ptr const * B;
+    slong m, k, stride;
+    slong tile_rows;
+    slong tiles_n;              /* tiles per row of tiles */
+    slong num_tiles;
+    volatile slong * next_tile;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+}
+_mul_m4ri_arg_t;
+
+static void
+_gf2_mat_mul_m4ri_worker(void * varg)
+{
+    _mul_m4ri_arg_t * arg = (_mul_m4ri_arg_t *) varg;
+    mp_ptr T;
+    mp_srcptr vecs[TABLES];
+    slong tile, i0, w0, mc, wb, kl, kc, t, nb, i, j, num;
+    unsigned int b;
+
+    T = flint_malloc(TABLES*256*GF2_MAT_MUL_M4RI_BLOCK*sizeof(mp_limb_t));
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        tile = *arg->next_tile;
+        *arg->next_tile = tile + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (tile >= arg->num_tiles)
+            break;
+
+        i0 = (tile / arg->tiles_n)*arg->tile_rows;
+        w0 = (tile % arg->tiles_n)*GF2_MAT_MUL_M4RI_BLOCK;
+        mc = FLINT_MIN(arg->tile_rows, arg->m - i0);
+        wb = FLINT_MIN(GF2_MAT_MUL_M4RI_BLOCK, arg->stride - w0);
+
+        for (i = 0; i < mc; i++)
+            flint_mpn_zero(arg->C[i0 + i] + w0, wb);
+
+        for (kl = 0; kl*FLINT_BITS < arg->k; kl++)
+        {
+            kc = FLINT_MIN(FLINT_BITS, arg->k - kl*FLINT_BITS);
+
+            /* table t holds the sums of rows kl*FLINT_BITS + 8t + (0 .. 7) */
+            for (t = 0; 8*t < kc; t++)
+            {
+                mp_ptr Tt = T + t*256*wb;
+                mp_ptr const * Bt = arg->B + kl*FLINT_BITS + 8*t;
+
+                nb = FLINT_MIN(8, kc - 8*t);
+
+                flint_mpn_zero(Tt, wb);
+
+                for (j = 1; j < (WORD(1) << nb); j++)
+                {
+                    count_trailing_zeros(b, (mp_limb_t) j);
+                    _gf2_mat_row_add(Tt + j*wb, Tt + (j & (j - 1))*wb,
+                                                            Bt[b] + w0, wb);
+                }
+            }
+
+            for (i = i0; i < i0 + mc; i++)
+            {
+                mp_limb_t a = arg->A[i][kl];
+
+                if (a == 0)
+                    continue;
+
+                for (t = 0, num = 0; a != 0; t++, a >>= 8)
+                {
+                    if (a & 255)
+                        vecs[num++] = T + (t*256 + (a & 255))*wb;
+                }
+
+                _gf2_mat_row_add_many(arg->C[i] + w0, vecs, num, wb);
+            }
+        }
+    }
+
+    flint_free(T);
+}
+
+void
+gf2_mat_mul_m4ri(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    _mul_m4ri_arg_t * args;
+    thread_pool_handle * threads;
+    slong i, num_threads, tiles_m, tiles_n;
+    volatile slong next_tile = 0;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    if (C == A || C == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, A->r, B->c);
+        gf2_mat_mul_m4ri(T, A, B);
+        gf2_mat_swap(C, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    if (A->r == 0 || B->c == 0)
+        return;
+
+    if (A->c == 0)
+    {
+        gf2_mat_zero(C);
+        return;
+    }
+
+    tiles_n = (C->stride + GF2_MAT_MUL_M4RI_BLOCK - 1)/GF2_MAT_MUL_M4RI_BLOCK;
+    tiles_m = 1;
+
+    /* split the rows too if there are not enough tiles to go round */
+    num_threads = flint_get_num_threads();
+    if (num_threads > 1 && tiles_n < 2*num_threads)
+    {
+        tiles_m = (2*num_threads + tiles_n - 1)/tiles_n;
+        tiles_m = FLINT_MIN(tiles_m, A->r / GF2_MAT_MUL_M4RI_MIN_ROWS);
+        tiles_m = FLINT_MAX(tiles_m, 1);
+    }
+
+    num_threads = flint_request_threads(&threads,
+                                FLINT_MIN(num_threads, tiles_m*tiles_n));
+
+    args = flint_malloc((num_threads + 1)*sizeof(_mul_m4ri_arg_t));
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].C = C->rows;
+        args[i].A = A->rows;
+        args[i].B = B->rows;
+        args[i].m = A->r;
+        args[i].k = A->c;
+        args[i].stride = C->stride;
+        args[i].tile_rows = (A->r + tiles_m - 1)/tiles_m;
+        args[i].tiles_n = tiles_n;
+        args[i].num_tiles = tiles_m*tiles_n;
+        args[i].next_tile = &next_tile;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+    }
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                       _gf2_mat_mul_m4ri_worker, &args[i]);
+
+    _gf2_mat_mul_m4ri_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+    flint_give_back_threads(threads, num_threads);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_free(args);
+}
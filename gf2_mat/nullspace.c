@@ -0,0 +1,95 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+slong
+gf2_mat_nullspace(gf2_mat_t X, const gf2_mat_t A)
+{
+    slong i, j, k, n, rank, nullity;
+    slong * nonpivot_index;
+    slong * pivots;
+    mp_ptr nonpivot_mask;
+    unsigned int b;
+    gf2_mat_t T;
+
+    n = A->c;
+
+    gf2_mat_zero(X);
+
+    if (n == 0)
+        return 0;
+
+    gf2_mat_init_set(T, A);
+    rank = gf2_mat_rref(T);
+    nullity = n - rank;
+
+    pivots = flint_malloc(sizeof(slong)*(rank + 1));
+    nonpivot_index = flint_malloc(sizeof(slong)*n);
+    nonpivot_mask = flint_calloc(A->stride, sizeof(mp_limb_t));
+
+    /* the leading entries of the rows of T are the pivots */
+    for (i = j = k = 0; i < rank; i++)
+    {
+        while (!gf2_mat_get_entry(T, i, j))
+        {
+            nonpivot_index[j] = k++;
+            j++;
+        }
+        nonpivot_index[j] = -1;
+        pivots[i] = j++;
+    }
+    for ( ; j < n; j++)
+        nonpivot_index[j] = k++;
+
+    for (j = 0; j < n; j++)
+        if (nonpivot_index[j] >= 0)
+            nonpivot_mask[j / FLINT_BITS] |= UWORD(1) << (j % FLINT_BITS);
+
+    /* basis vector k has a one in the k-th nonpivot column c and, in the
+       pivot column of row i of T, the entry of that row in column c */
+    for (j = 0; j < A->stride; j++)
+    {
+        mp_limb_t w;
+
+        for (w = nonpivot_mask[j]; w != 0; w &= w - 1)
+        {
+            count_trailing_zeros(b, w);
+            k = nonpivot_index[j*FLINT_BITS + b];
+            gf2_mat_set_entry(X, j*FLINT_BITS + b, k, 1);
+        }
+    }
+
+    for (i = 0; i < rank; i++)
+    {
+        for (j = 0; j < A->stride; j++)
+        {
+            mp_limb_t w;
+
+            for (w = T->rows[i][j] & nonpivot_mask[j]; w != 0; w &= w - 1)
+            {
+                count_trailing_zeros(b, w);
+                k = nonpivot_index[j*FLINT_BITS + b];
+                gf2_mat_set_entry(X, pivots[i], k, 1);
+            }
+        }
+    }
+
+    flint_free(pivots);
+    flint_free(nonpivot_index);
+    flint_free(nonpivot_mask);
+    gf2_mat_clear(T);
+
+    return nullity;
+}
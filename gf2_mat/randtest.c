@@ -0,0 +1,44 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+#include "ulong_extras.h"
+
+void
+gf2_mat_randtest(gf2_mat_t A, flint_rand_t state)
+{
+    slong i, j;
+    mp_limb_t mask;
+
+    if (A->c == 0)
+        return;
+
+    mask = (A->c % FLINT_BITS == 0) ? ~UWORD(0)
+                                 : (UWORD(1) << (A->c % FLINT_BITS)) - 1;
+
+    /* mix dense and sparse rows */
+    for (i = 0; i < A->r; i++)
+    {
+        for (j = 0; j < A->stride; j++)
+        {
+            if (n_randint(state, 4) == 0)
+                A->rows[i][j] = n_randtest(state);
+            else
+                A->rows[i][j] = n_randlimb(state);
+        }
+
+        A->rows[i][A->stride - 1] &= mask;
+    }
+}
@@ -0,0 +1,219 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+#if FLINT_NMOD_VEC_X86
+
+#include <immintrin.h>
+
+#define AVX2_FN __attribute__((target("avx2")))
+#define AVX512_FN __attribute__((target("avx512f")))
+
+static AVX2_FN void
+_row_add_avx2(mp_ptr res, mp_srcptr vec1, mp_srcptr vec2, slong len)
+{
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+        _mm256_storeu_si256((__m256i *) (res + i), _mm256_xor_si256(a, b));
+    }
+
+    for ( ; i < len; i++)
+        res[i] = vec1[i] ^ vec2[i];
+}
+
+static AVX2_FN void
+_row_add_many_avx2(mp_ptr res, mp_srcptr * vecs, slong num, slong len)
+{
+    slong i, j;
+
+    /* four accumulators, so that the loads of different rows overlap */
+    for (i = 0; i + 16 <= len; i += 16)
+    {
+        __m256i a0 = _mm256_loadu_si256((const __m256i *) (res + i + 0));
+        __m256i a1 = _mm256_loadu_si256((const __m256i *) (res + i + 4));
+        __m256i a2 = _mm256_loadu_si256((const __m256i *) (res + i + 8));
+        __m256i a3 = _mm256_loadu_si256((const __m256i *) (res + i + 12));
+
+        for (j = 0; j < num; j++)
+        {
+            mp_srcptr v = vecs[j] + i;
+
+            a0 = _mm256_xor_si256(a0,
+                            _mm256_loadu_si256((const __m256i *) (v + 0)));
+            a1 = _mm256_xor_si256(a1,
+                            _mm256_loadu_si256((const __m256i *) (v + 4)));
+            a2 = _mm256_xor_si256(a2,
+                            _mm256_loadu_si256((const __m256i *) (v + 8)));
+            a3 = _mm256_xor_si256(a3,
+                            _mm256_loadu_si256((const __m256i *) (v + 12)));
+        }
+
+        _mm256_storeu_si256((__m256i *) (res + i + 0), a0);
+        _mm256_storeu_si256((__m256i *) (res + i + 4), a1);
+        _mm256_storeu_si256((__m256i *) (res + i + 8), a2);
+        _mm256_storeu_si256((__m256i *) (res + i + 12), a3);
+    }
+
+    for ( ; i + 4 <= len; i += 4)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (res + i));
+
+        for (j = 0; j < num; j++)
+            a = _mm256_xor_si256(a,
+                        _mm256_loadu_si256((const __m256i *) (vecs[j] + i)));
+
+        _mm256_storeu_si256((__m256i *) (res + i), a);
+    }
+
+    for ( ; i < len; i++)
+        for (j = 0; j < num; j++)
+            res[i] ^= vecs[j][i];
+}
+
+static AVX512_FN void
+_row_add_avx512(mp_ptr res, mp_srcptr vec1, mp_srcptr vec2, slong len)
+{
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        __m512i a = _mm512_loadu_si512((const void *) (vec1 + i));
+        __m512i b = _mm512_loadu_si512((const void *) (vec2 + i));
+        _mm512_storeu_si512((void *) (res + i), _mm512_xor_si512(a, b));
+    }
+
+    for ( ; i < len; i++)
+        res[i] = vec1[i] ^ vec2[i];
+}
+
+static AVX512_FN void
+_row_add_many_avx512(mp_ptr res, mp_srcptr * vecs, slong num, slong len)
+{
+    slong i, j;
+
+    for (i = 0; i + 32 <= len; i += 32)
+    {
+        __m512i a0 = _mm512_loadu_si512((const void *) (res + i + 0));
+        __m512i a1 = _mm512_loadu_si512((const void *) (res + i + 8));
+        __m512i a2 = _mm512_loadu_si512((const void *) (res + i + 16));
+        __m512i a3 = _mm512_loadu_si512((const void *) (res + i + 24));
+
+        for (j = 0; j < num; j++)
+        {
+            mp_srcptr v = vecs[j] + i;
+
+            a0 = _mm512_xor_si512(a0, _mm512_loadu_si512((const void *) (v + 0)));
+            a1 = _mm512_xor_si512(a1, _mm512_loadu_si512((const void *) (v + 8)));
+            a2 = _mm512_xor_si512(a2, _mm512_loadu_si512((const void *) (v + 16)));
+            a3 = _mm512_xor_si512(a3, _mm512_loadu_si512((const void *) (v + 24)));
+        }
+
+        _mm512_storeu_si512((void *) (res + i + 0), a0);
+        _mm512_storeu_si512((void *) (res + i + 8), a1);
+        _mm512_storeu_si512((void *) (res + i + 16), a2);
+        _mm512_storeu_si512((void *) (res + i + 24), a3);
+    }
+
+    for ( ; i + 8 <= len; i += 8)
+    {
+        __m512i a = _mm512_loadu_si512((const void *) (res + i));
+
+        for (j = 0; j < num; j++)
+            a = _mm512_xor_si512(a,
+                              _mm512_loadu_si512((const void *) (vecs[j] + i)));
+
+        _mm512_storeu_si512((void *) (res + i), a);
+    }
+
+    for ( ; i < len; i++)
+        for (j = 0; j < num; j++)
+            res[i] ^= vecs[j][i];
+}
+
+#endif
+
+void
+_gf2_mat_row_add(mp_ptr res, mp_srcptr vec1, mp_srcptr vec2, slong len)
+{
+    slong i;
+
+#if FLINT_NMOD_VEC_X86
+    if (len >= 8)
+    {
+        int simd = _nmod_vec_simd_level();
+
+        if (simd == NMOD_VEC_SIMD_AVX512)
+        {
+            _row_add_avx512(res, vec1, vec2, len);
+            return;
+        }
+        else if (simd == NMOD_VEC_SIMD_AVX2)
+        {
+            _row_add_avx2(res, vec1, vec2, len);
+            return;
+        }
+    }
+#endif
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        res[i + 0] = vec1[i + 0] ^ vec2[i + 0];
+        res[i + 1] = vec1[i + 1] ^ vec2[i + 1];
+        res[i + 2] = vec1[i + 2] ^ vec2[i + 2];
+        res[i + 3] = vec1[i + 3] ^ vec2[i + 3];
+    }
+
+    for ( ; i < len; i++)
+        res[i] = vec1[i] ^ vec2[i];
+}
+
+/* res += vecs[0] + ... + vecs[num - 1], making one pass over res */
+void
+_gf2_mat_row_add_many(mp_ptr res, mp_srcptr * vecs, slong num, slong len)
+{
+    slong i, j;
+
+#if FLINT_NMOD_VEC_X86
+    if (len >= 4)
+    {
+        int simd = _nmod_vec_simd_level();
+
+        if (simd == NMOD_VEC_SIMD_AVX512 && len >= 8)
+        {
+            _row_add_many_avx512(res, vecs, num, len);
+            return;
+        }
+        else if (simd != NMOD_VEC_SIMD_NONE)
+        {
+            _row_add_many_avx2(res, vecs, num, len);
+            return;
+        }
+    }
+#endif
+
+    for (i = 0; i < len; i++)
+    {
+        mp_limb_t t = res[i];
+
+        for (j = 0; j < num; j++)
+            t ^= vecs[j][i];
+
+        res[i] = t;
+    }
+}
@@ -0,0 +1,205 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+#include "thread_pool.h"
+
+/*
+    Gauss-Jordan elimination with the method of the four Russians. Up to
+    RREF_PIVOTS pivots are found at a time; a candidate row is only reduced
+    by the pivots of the current step when it is looked at. The pivot rows
+    are then reduced against each other and all sums of groups of eight of
+    them are tabulated, so that every other row is cleared in the pivot
+    columns with one table lookup per group.
+*/
+
+#define RREF_PIVOTS 16
+#define RREF_TABLES (RREF_PIVOTS / 8)
+
+#define BIT(row, j) (((row)[(j) / FLINT_BITS] >> ((j) % FLINT_BITS)) & 1)
+
+typedef struct
+{
+    mp_ptr * rows;
+    slong start;
+    slong stop;
+    slong skip_start;           /* rows skip_start, ..., skip_stop - 1 */
+    slong skip_stop;            /* are the pivot rows */
+    mp_srcptr T;
+    const slong * pc;
+    slong npiv;
+    slong w0;
+    slong len;
+}
+_rref_arg_t;
+
+static void
+_gf2_mat_rref_reduce_rows(void * varg)
+{
+    _rref_arg_t * arg = (_rref_arg_t *) varg;
+    mp_srcptr vecs[RREF_TABLES];
+    slong i, j, t, num;
+
+    for (i = arg->start; i < arg->stop; i++)
+    {
+        mp_ptr row = arg->rows[i];
+
+        if (i >= arg->skip_start && i < arg->skip_stop)
+            continue;
+
+        for (t = 0, num = 0; 8*t < arg->npiv; t++)
+        {
+            slong s = 0;
+
+            for (j = 8*t; j < FLINT_MIN(8*t + 8, arg->npiv); j++)
+                s |= BIT(row, arg->pc[j]) << (j - 8*t);
+
+            if (s != 0)
+                vecs[num++] = arg->T + (t*256 + s)*arg->len;
+        }
+
+        if (num != 0)
+            _gf2_mat_row_add_many(row + arg->w0, vecs, num, arg->len);
+    }
+}
+
+slong
+gf2_mat_rref(gf2_mat_t A)
+{
+    slong m, n, rank, col, npiv, w0, len, i, j, t, nb;
+    slong pc[RREF_PIVOTS];
+    unsigned int b;
+    mp_ptr T;
+    mp_ptr * rows;
+
+    m = A->r;
+    n = A->c;
+    rows = A->rows;
+
+    if (m == 0 || n == 0)
+        return 0;
+
+    T = flint_malloc(RREF_TABLES*256*A->stride*sizeof(mp_limb_t));
+
+    rank = 0;
+    col = 0;
+
+    while (rank < m && col < n)
+    {
+        /* the rows from rank onwards vanish in the columns before col */
+        w0 = col / FLINT_BITS;
+        len = A->stride - w0;
+
+        /* find the pivots of this step */
+        npiv = 0;
+        while (npiv < RREF_PIVOTS && col < n && rank + npiv < m)
+        {
+            for (i = rank + npiv; i < m; i++)
+            {
+                mp_ptr row = rows[i];
+
+                for (j = 0; j < npiv; j++)
+                    if (BIT(row, pc[j]))
+                        _gf2_mat_row_add(row + w0, row + w0,
+                                                  rows[rank + j] + w0, len);
+
+                if (BIT(row, col))
+                    break;
+            }
+
+            if (i < m)
+            {
+                gf2_mat_swap_rows(A, i, rank + npiv);
+                pc[npiv++] = col;
+            }
+
+            col++;
+        }
+
+        if (npiv == 0)
+            break;
+
+        /* every pivot row vanishes in the earlier pivot columns; now clear
+           the later ones as well */
+        for (j = npiv - 1; j > 0; j--)
+            for (i = 0; i < j; i++)
+                if (BIT(rows[rank + i], pc[j]))
+                    _gf2_mat_row_add(rows[rank + i] + w0, rows[rank + i] + w0,
+                                                      rows[rank + j] + w0, len);
+
+        for (t = 0; 8*t < npiv; t++)
+        {
+            mp_ptr Tt = T + t*256*len;
+
+            nb = FLINT_MIN(8, npiv - 8*t);
+
+            flint_mpn_zero(Tt, len);
+
+            for (j = 1; j < (WORD(1) << nb); j++)
+            {
+                count_trailing_zeros(b, (mp_limb_t) j);
+                _gf2_mat_row_add(Tt + j*len, Tt + (j & (j - 1))*len,
+                                               rows[rank + 8*t + b] + w0, len);
+            }
+        }
+
+        {
+            _rref_arg_t * args;
+            thread_pool_handle * threads;
+            slong num_threads, chunk;
+
+            num_threads = 0;
+            if ((m - npiv)*len >= GF2_MAT_RREF_THREADED_CUTOFF)
+                num_threads = flint_request_threads(&threads,
+                                  FLINT_MIN(flint_get_num_threads(), m / 64));
+
+            args = flint_malloc((num_threads + 1)*sizeof(_rref_arg_t));
+            chunk = (m + num_threads)/(num_threads + 1);
+
+            for (i = 0; i <= num_threads; i++)
+            {
+                args[i].rows = rows;
+                args[i].start = FLINT_MIN(i*chunk, m);
+                args[i].stop = FLINT_MIN((i + 1)*chunk, m);
+                args[i].skip_start = rank;
+                args[i].skip_stop = rank + npiv;
+                args[i].T = T;
+                args[i].pc = pc;
+                args[i].npiv = npiv;
+                args[i].w0 = w0;
+                args[i].len = len;
+            }
+
+            for (i = 0; i < num_threads; i++)
+                thread_pool_wake(global_thread_pool, threads[i], 0,
+                                       _gf2_mat_rref_reduce_rows, &args[i]);
+
+            _gf2_mat_rref_reduce_rows(&args[num_threads]);
+
+            for (i = 0; i < num_threads; i++)
+                thread_pool_wait(global_thread_pool, threads[i]);
+
+            if (num_threads != 0)
+                flint_give_back_threads(threads, num_threads);
+
+            flint_free(args);
+        }
+
+        rank += npiv;
+    }
+
+    flint_free(T);
+
+    return rank;
+}
@@ -0,0 +1,27 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+void
+gf2_mat_set(gf2_mat_t A, const gf2_mat_t B)
+{
+    slong i;
+
+    if (A == B || B->c == 0)
+        return;
+
+    for (i = 0; i < B->r; i++)
+        flint_mpn_copyi(A->rows[i], B->rows[i], B->stride);
+}
@@ -0,0 +1,100 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("nullspace....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 500 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, X, Y, Z;
+        slong m, n, r, rank, nullity;
+
+        m = n_randint(state, 200);
+        n = n_randint(state, 200);
+        r = n_randint(state, FLINT_MIN(m, n) + 1);
+
+        gf2_mat_init(A, m, n);
+        gf2_mat_init(X, n, n);
+
+        {
+            gf2_mat_t U, V;
+            gf2_mat_init(U, m, r);
+            gf2_mat_init(V, r, n);
+            gf2_mat_randtest(U, state);
+            gf2_mat_randtest(V, state);
+            gf2_mat_mul(A, U, V);
+            gf2_mat_clear(U);
+            gf2_mat_clear(V);
+        }
+
+        gf2_mat_randtest(X, state);
+
+        rank = gf2_mat_rank(A);
+        nullity = gf2_mat_nullspace(X, A);
+
+        if (nullity + rank != n || gf2_mat_rank(X) != nullity)
+        {
+            flint_printf("FAIL: wrong nullity\n");
+            flint_printf("m = %wd, n = %wd, rank = %wd, nullity = %wd\n",
+                                                     m, n, rank, nullity);
+            abort();
+        }
+
+        gf2_mat_init(Y, m, n);
+        gf2_mat_mul(Y, A, X);
+
+        if (!gf2_mat_is_zero(Y))
+        {
+            flint_printf("FAIL: A * X != 0\n");
+            abort();
+        }
+
+        /* the unused columns are zero */
+        gf2_mat_init(Z, n, n);
+        gf2_mat_transpose(Z, X);
+        for (r = nullity; r < n; r++)
+        {
+            slong j;
+            for (j = 0; j < Z->stride; j++)
+            {
+                if (Z->rows[r][j] != 0)
+                {
+                    flint_printf("FAIL: extra columns\n");
+                    abort();
+                }
+            }
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(X);
+        gf2_mat_clear(Y);
+        gf2_mat_clear(Z);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+#include "perm.h"
+
+/* the rows of A are in reduced row echelon form */
+static int
+check_rref(const gf2_mat_t A, slong rank)
+{
+    slong i, j, k, prev = -1;
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (j = 0; j < A->c && !gf2_mat_get_entry(A, i, j); j++) ;
+
+        if (i >= rank)
+        {
+            if (j != A->c)
+                return 0;
+            continue;
+        }
+
+        if (j == A->c || j <= prev)
+            return 0;
+
+        prev = j;
+
+        for (k = 0; k < A->r; k++)
+            if (k != i && gf2_mat_get_entry(A, k, j))
+                return 0;
+    }
+
+    return 1;
+}
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("rref....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 300 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, B;
+        nmod_mat_t M, N;
+        slong m, n, r, rank1, rank2, * pnp, * P;
+
+        m = n_randint(state, 250);
+        n = n_randint(state, 250);
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        gf2_mat_init(A, m, n);
+        nmod_mat_init(M, m, n, 2);
+        nmod_mat_init(N, m, n, 2);
+
+        /* random matrices of deficient rank */
+        r = n_randint(state, FLINT_MIN(m, n) + 1);
+        {
+            gf2_mat_t X, Y;
+            gf2_mat_init(X, m, r);
+            gf2_mat_init(Y, r, n);
+            gf2_mat_randtest(X, state);
+            gf2_mat_randtest(Y, state);
+            gf2_mat_mul(A, X, Y);
+            gf2_mat_clear(X);
+            gf2_mat_clear(Y);
+        }
+
+        if (n_randint(state, 4) == 0)
+            gf2_mat_randtest(A, state);
+
+        gf2_mat_get_nmod_mat(M, A);
+
+        pnp = flint_malloc(sizeof(slong)*FLINT_MAX(n, 1));
+        P = flint_malloc(sizeof(slong)*FLINT_MAX(m, 1));
+        rank1 = (m == 0 || n == 0) ? 0 : _nmod_mat_rref(M, pnp, P);
+        flint_free(pnp);
+        flint_free(P);
+
+        if (gf2_mat_rank(A) != rank1)
+        {
+            flint_printf("FAIL: rank\n");
+            abort();
+        }
+
+        gf2_mat_init_set(B, A);
+        rank2 = gf2_mat_rref(B);
+        gf2_mat_get_nmod_mat(N, B);
+
+        if (rank1 != rank2 || !nmod_mat_equal(M, N) || !check_rref(B, rank2))
+        {
+            flint_printf("FAIL: rref\n");
+            flint_printf("m = %wd, n = %wd, rank1 = %wd, rank2 = %wd\n",
+                                                      m, n, rank1, rank2);
+            abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        nmod_mat_clear(M);
+        nmod_mat_clear(N);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("transpose....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        gf2_mat_t A, B;
+        nmod_mat_t M, N, P;
+        slong r, c;
+
+        r = n_randint(state, 200);
+        c = n_randint(state, 200);
+
+        gf2_mat_init(A, r, c);
+        gf2_mat_init(B, c, r);
+        nmod_mat_init(M, r, c, 2);
+        nmod_mat_init(N, c, r, 2);
+        nmod_mat_init(P, c, r, 2);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_transpose(B, A);
+
+        gf2_mat_get_nmod_mat(M, A);
+        gf2_mat_get_nmod_mat(N, B);
+        nmod_mat_transpose(P, M);
+
+        if (!nmod_mat_equal(N, P))
+        {
+            flint_printf("FAIL: transpose\n");
+            abort();
+        }
+
+        /* aliasing */
+        gf2_mat_transpose(B, B);
+
+        if (!gf2_mat_equal(A, B))
+        {
+            flint_printf("FAIL: aliasing\n");
+            abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        nmod_mat_clear(M);
+        nmod_mat_clear(N);
+        nmod_mat_clear(P);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
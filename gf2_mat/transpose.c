@@ -0,0 +1,73 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+/* transposes the FLINT_BITS x FLINT_BITS block with rows a[0], a[1], ... */
+void
+_gf2_mat_transpose_64(mp_ptr a)
+{
+    slong j, k;
+    mp_limb_t m, t;
+
+    m = (UWORD(1) << (FLINT_BITS / 2)) - 1;
+
+    for (j = FLINT_BITS / 2; j != 0; j = j >> 1, m = m ^ (m << j))
+    {
+        for (k = 0; k < FLINT_BITS; k = ((k + j + 1) & ~j))
+        {
+            t = ((a[k] >> j) ^ a[k + j]) & m;
+            a[k] ^= t << j;
+            a[k + j] ^= t;
+        }
+    }
+}
+
+void
+gf2_mat_transpose(gf2_mat_t B, const gf2_mat_t A)
+{
+    slong i, I, J, len;
+    mp_limb_t t[FLINT_BITS];
+
+    if (B == A)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, A->c, A->r);
+        gf2_mat_transpose(T, A);
+        gf2_mat_swap(B, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    if (A->r == 0 || A->c == 0)
+        return;
+
+    for (I = 0; I < B->stride; I++)
+    {
+        len = FLINT_MIN(FLINT_BITS, A->r - I*FLINT_BITS);
+
+        for (J = 0; J < A->stride; J++)
+        {
+            for (i = 0; i < len; i++)
+                t[i] = A->rows[I*FLINT_BITS + i][J];
+            for ( ; i < FLINT_BITS; i++)
+                t[i] = 0;
+
+            _gf2_mat_transpose_64(t);
+
+            for (i = 0; i < FLINT_BITS && J*FLINT_BITS + i < B->r; i++)
+                B->rows[J*FLINT_BITS + i][I] = t[i];
+        }
+    }
+}
@@ -0,0 +1,241 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef GF2_POLY_H
+#define GF2_POLY_H
+
+#ifdef GF2_POLY_INLINES_C
+#define GF2_POLY_INLINE FLINT_DLL
+#else
+#define GF2_POLY_INLINE static __inline__
+#endif
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <stdio.h>
+#undef ulong
+#include <gmp.h>
+#define ulong mp_limb_t
+
+#include "flint.h"
+#include "longlong.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "nmod_poly.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/*
+    Polynomials over GF(2), packed FLINT_BITS coefficients to a limb: the
+    coefficient of x^i is bit i % FLINT_BITS of coeffs[i / FLINT_BITS].
+    The polynomial is normalised, i.e. the coefficient of x^(length - 1)
+    is one, and the bits of the last used limb beyond length are zero.
+    The allocation alloc is counted in limbs.
+*/
+typedef struct
+{
+    mp_ptr coeffs;
+    slong alloc;
+    slong length;
+}
+gf2_poly_struct;
+
+typedef gf2_poly_struct gf2_poly_t[1];
+
+#define GF2_POLY_LIMBS(len) (((len) + FLINT_BITS - 1) / FLINT_BITS)
+
+/* Memory management *********************************************************/
+
+FLINT_DLL void gf2_poly_init(gf2_poly_t poly);
+
+FLINT_DLL void gf2_poly_init2(gf2_poly_t poly, slong len);
+
+FLINT_DLL void gf2_poly_clear(gf2_poly_t poly);
+
+FLINT_DLL void gf2_poly_fit_length(gf2_poly_t poly, slong len);
+
+/* sets the length from the first n limbs, which must hold the coefficients */
+FLINT_DLL void _gf2_poly_normalise(gf2_poly_t poly, slong n);
+
+/* Basic properties and assignment *******************************************/
+
+GF2_POLY_INLINE
+slong gf2_poly_length(const gf2_poly_t poly)
+{
+    return poly->length;
+}
+
+GF2_POLY_INLINE
+slong gf2_poly_degree(const gf2_poly_t poly)
+{
+    return poly->length - 1;
+}
+
+GF2_POLY_INLINE
+int gf2_poly_is_zero(const gf2_poly_t poly)
+{
+    return poly->length == 0;
+}
+
+GF2_POLY_INLINE
+int gf2_poly_is_one(const gf2_poly_t poly)
+{
+    return poly->length == 1;
+}
+
+GF2_POLY_INLINE
+void gf2_poly_zero(gf2_poly_t poly)
+{
+    poly->length = 0;
+}
+
+GF2_POLY_INLINE
+void gf2_poly_one(gf2_poly_t poly)
+{
+    gf2_poly_fit_length(poly, 1);
+    poly->coeffs[0] = 1;
+    poly->length = 1;
+}
+
+GF2_POLY_INLINE
+void gf2_poly_swap(gf2_poly_t poly1, gf2_poly_t poly2)
+{
+    gf2_poly_struct t = *poly1;
+    *poly1 = *poly2;
+    *poly2 = t;
+}
+
+GF2_POLY_INLINE
+ulong gf2_poly_get_coeff_ui(const gf2_poly_t poly, slong j)
+{
+    if (j >= poly->length)
+        return 0;
+
+    return (poly->coeffs[j / FLINT_BITS] >> (j % FLINT_BITS)) & 1;
+}
+
+FLINT_DLL void gf2_poly_set_coeff_ui(gf2_poly_t poly, slong j, ulong c);
+
+FLINT_DLL void gf2_poly_set(gf2_poly_t res, const gf2_poly_t poly);
+
+FLINT_DLL int gf2_poly_equal(const gf2_poly_t poly1, const gf2_poly_t poly2);
+
+FLINT_DLL void gf2_poly_randtest(gf2_poly_t poly, flint_rand_t state,
+                                                                   slong len);
+
+FLINT_DLL void gf2_poly_set_nmod_poly(gf2_poly_t res, const nmod_poly_t poly);
+
+FLINT_DLL void gf2_poly_get_nmod_poly(nmod_poly_t res, const gf2_poly_t poly);
+
+FLINT_DLL void _gf2_poly_pack(mp_ptr res, mp_srcptr coeffs, slong len);
+
+FLINT_DLL void _gf2_poly_unpack(mp_ptr res, mp_srcptr poly, slong len);
+
+FLINT_DLL void gf2_poly_print(const gf2_poly_t poly);
+
+/* Addition and shifting *****************************************************/
+
+FLINT_DLL void gf2_poly_add(gf2_poly_t res,
+                            const gf2_poly_t poly1, const gf2_poly_t poly2);
+
+FLINT_DLL void gf2_poly_shift_left(gf2_poly_t res,
+                                            const gf2_poly_t poly, slong n);
+
+FLINT_DLL void gf2_poly_shift_right(gf2_poly_t res,
+                                            const gf2_poly_t poly, slong n);
+
+FLINT_DLL void gf2_poly_truncate(gf2_poly_t poly, slong n);
+
+FLINT_DLL void _gf2_poly_reverse(mp_ptr res, mp_srcptr poly, slong n);
+
+FLINT_DLL void gf2_poly_reverse(gf2_poly_t res,
+                                            const gf2_poly_t poly, slong n);
+
+/* Multiplication ************************************************************/
+
+FLINT_DLL void _gf2_poly_mul_classical(mp_ptr res,
+                           mp_srcptr poly1, slong n1, mp_srcptr poly2, slong n2);
+
+FLINT_DLL void _gf2_poly_mul_karatsuba(mp_ptr res,
+                           mp_srcptr poly1, slong n1, mp_srcptr poly2, slong n2);
+
+FLINT_DLL void _gf2_poly_mul(mp_ptr res,
+                           mp_srcptr poly1, slong n1, mp_srcptr poly2, slong n2);
+
+FLINT_DLL void gf2_poly_mul_classical(gf2_poly_t res,
+                            const gf2_poly_t poly1, const gf2_poly_t poly2);
+
+FLINT_DLL void gf2_poly_mul(gf2_poly_t res,
+                            const gf2_poly_t poly1, const gf2_poly_t poly2);
+
+FLINT_DLL void gf2_poly_mullow(gf2_poly_t res,
+                   const gf2_poly_t poly1, const gf2_poly_t poly2, slong n);
+
+FLINT_DLL void _gf2_poly_sqr(mp_ptr res, mp_srcptr poly, slong n);
+
+FLINT_DLL void gf2_poly_sqr(gf2_poly_t res, const gf2_poly_t poly);
+
+/* Division ******************************************************************/
+
+FLINT_DLL void gf2_poly_divrem_basecase(gf2_poly_t Q, gf2_poly_t R,
+                                  const gf2_poly_t A, const gf2_poly_t B);
+
+FLINT_DLL void gf2_poly_inv_series(gf2_poly_t Qinv,
+                                              const gf2_poly_t Q, slong n);
+
+FLINT_DLL void gf2_poly_divrem_newton_preinv(gf2_poly_t Q, gf2_poly_t R,
+             const gf2_poly_t A, const gf2_poly_t B, const gf2_poly_t Binv);
+
+FLINT_DLL void gf2_poly_divrem(gf2_poly_t Q, gf2_poly_t R,
+                                  const gf2_poly_t A, const gf2_poly_t B);
+
+FLINT_DLL void gf2_poly_rem(gf2_poly_t R,
+                                  const gf2_poly_t A, const gf2_poly_t B);
+
+/* Modular arithmetic ********************************************************/
+
+FLINT_DLL void gf2_poly_mulmod_preinv(gf2_poly_t res,
+             const gf2_poly_t poly1, const gf2_poly_t poly2,
+             const gf2_poly_t f, const gf2_poly_t finv);
+
+FLINT_DLL void gf2_poly_sqrmod_preinv(gf2_poly_t res, const gf2_poly_t poly,
+                                 const gf2_poly_t f, const gf2_poly_t finv);
+
+FLINT_DLL void gf2_poly_powmod_fmpz_preinv(gf2_poly_t res,
+             const gf2_poly_t poly, const fmpz_t e,
+             const gf2_poly_t f, const gf2_poly_t finv);
+
+/* GCD ***********************************************************************/
+
+FLINT_DLL void gf2_poly_gcd(gf2_poly_t G,
+                                  const gf2_poly_t A, const gf2_poly_t B);
+
+FLINT_DLL void gf2_poly_xgcd(gf2_poly_t G, gf2_poly_t S, gf2_poly_t T,
+                                  const gf2_poly_t A, const gf2_poly_t B);
+
+FLINT_DLL int gf2_poly_invmod(gf2_poly_t res,
+                                  const gf2_poly_t A, const gf2_poly_t f);
+
+/* Tuning parameters *********************************************************/
+
+/* Limbs from which multiplication uses Karatsuba */
+#define GF2_POLY_KARATSUBA_CUTOFF 32
+
+/* Quotient and divisor lengths (in coefficients) for Newton division */
+#define GF2_POLY_DIVREM_NEWTON_CUTOFF 256
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
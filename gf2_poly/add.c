@@ -0,0 +1,45 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_add(gf2_poly_t res, const gf2_poly_t poly1, const gf2_poly_t poly2)
+{
+    slong i, n1, n2;
+
+    if (poly1->length < poly2->length)
+    {
+        const gf2_poly_struct * t = poly1;
+        poly1 = poly2;
+        poly2 = t;
+    }
+
+    n1 = GF2_POLY_LIMBS(poly1->length);
+    n2 = GF2_POLY_LIMBS(poly2->length);
+
+    gf2_poly_fit_length(res, poly1->length);
+
+    for (i = 0; i < n2; i++)
+        res->coeffs[i] = poly1->coeffs[i] ^ poly2->coeffs[i];
+
+    if (res != poly1)
+        for ( ; i < n1; i++)
+            res->coeffs[i] = poly1->coeffs[i];
+
+    if (poly1->length == poly2->length)
+        _gf2_poly_normalise(res, n1);
+    else
+        res->length = poly1->length;
+}
@@ -0,0 +1,44 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_divrem(gf2_poly_t Q, gf2_poly_t R,
+                                    const gf2_poly_t A, const gf2_poly_t B)
+{
+    slong lenA = A->length, lenB = B->length;
+
+    if (lenB == 0)
+    {
+        flint_printf("Exception (gf2_poly_divrem). Division by zero.\n");
+        flint_abort();
+    }
+
+    if (lenA - lenB + 1 < GF2_POLY_DIVREM_NEWTON_CUTOFF ||
+        lenB < GF2_POLY_DIVREM_NEWTON_CUTOFF)
+    {
+        gf2_poly_divrem_basecase(Q, R, A, B);
+    }
+    else
+    {
+        gf2_poly_t Binv;
+
+        gf2_poly_init(Binv);
+        gf2_poly_reverse(Binv, B, lenB);
+        gf2_poly_inv_series(Binv, Binv, lenA - lenB + 1);
+        gf2_poly_divrem_newton_preinv(Q, R, A, B, Binv);
+        gf2_poly_clear(Binv);
+    }
+}
@@ -0,0 +1,86 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_divrem_basecase(gf2_poly_t Q, gf2_poly_t R,
+                                    const gf2_poly_t A, const gf2_poly_t B)
+{
+    slong lenA = A->length, lenB = B->length, lenQ, nA, nB, i, j, s, w;
+    mp_ptr r, q, sh;
+
+    if (lenB == 0)
+    {
+        flint_printf("Exception (gf2_poly_divrem_basecase). Division by zero.\n");
+        flint_abort();
+    }
+
+    if (lenA < lenB)
+    {
+        gf2_poly_set(R, A);
+        gf2_poly_zero(Q);
+        return;
+    }
+
+    lenQ = lenA - lenB + 1;
+    nA = GF2_POLY_LIMBS(lenA);
+    nB = GF2_POLY_LIMBS(lenB);
+
+    r = flint_malloc((nA + 1)*sizeof(mp_limb_t));
+    q = flint_calloc(GF2_POLY_LIMBS(lenQ), sizeof(mp_limb_t));
+
+    /* the FLINT_BITS shifts of B, each on nB + 1 limbs */
+    sh = flint_malloc(FLINT_BITS*(nB + 1)*sizeof(mp_limb_t));
+
+    flint_mpn_copyi(sh, B->coeffs, nB);
+    sh[nB] = 0;
+    for (s = 1; s < FLINT_BITS; s++)
+        sh[s*(nB + 1) + nB] = mpn_lshift(sh + s*(nB + 1), B->coeffs, nB, s);
+
+    flint_mpn_copyi(r, A->coeffs, nA);
+    r[nA] = 0;
+
+    for (i = lenQ - 1; i >= 0; i--)
+    {
+        /* the coefficient of x^(i + lenB - 1) of the remainder */
+        j = i + lenB - 1;
+
+        if ((r[j / FLINT_BITS] >> (j % FLINT_BITS)) & 1)
+        {
+            mp_srcptr b;
+
+            q[i / FLINT_BITS] |= UWORD(1) << (i % FLINT_BITS);
+
+            s = i % FLINT_BITS;
+            w = i / FLINT_BITS;
+            b = sh + s*(nB + 1);
+
+            for (j = 0; j <= nB && w + j <= nA; j++)
+                r[w + j] ^= b[j];
+        }
+    }
+
+    gf2_poly_fit_length(Q, lenQ);
+    flint_mpn_copyi(Q->coeffs, q, GF2_POLY_LIMBS(lenQ));
+    Q->length = lenQ;
+
+    gf2_poly_fit_length(R, nB*FLINT_BITS);
+    flint_mpn_copyi(R->coeffs, r, FLINT_MIN(nA, nB));
+    _gf2_poly_normalise(R, FLINT_MIN(nA, nB));
+
+    flint_free(r);
+    flint_free(q);
+    flint_free(sh);
+}
@@ -0,0 +1,60 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_divrem_newton_preinv(gf2_poly_t Q, gf2_poly_t R,
+             const gf2_poly_t A, const gf2_poly_t B, const gf2_poly_t Binv)
+{
+    slong lenA = A->length, lenB = B->length, lenQ;
+    gf2_poly_t q, r, t;
+
+    if (lenB == 0)
+    {
+        flint_printf("Exception (gf2_poly_divrem_newton_preinv). Division by zero.\n");
+        flint_abort();
+    }
+
+    if (lenA < lenB)
+    {
+        gf2_poly_set(R, A);
+        gf2_poly_zero(Q);
+        return;
+    }
+
+    lenQ = lenA - lenB + 1;
+
+    gf2_poly_init(q);
+    gf2_poly_init(r);
+    gf2_poly_init(t);
+
+    /* rev(Q) = rev(A) / rev(B) mod x^lenQ */
+    gf2_poly_shift_right(t, A, lenB - 1);
+    gf2_poly_reverse(t, t, lenQ);
+    gf2_poly_mullow(q, t, Binv, lenQ);
+    gf2_poly_reverse(q, q, lenQ);
+
+    /* R = A - QB, only the low lenB - 1 terms are nonzero */
+    gf2_poly_mullow(r, q, B, lenB - 1);
+    gf2_poly_set(t, A);
+    gf2_poly_truncate(t, lenB - 1);
+    gf2_poly_add(R, t, r);
+
+    gf2_poly_swap(Q, q);
+
+    gf2_poly_clear(q);
+    gf2_poly_clear(r);
+    gf2_poly_clear(t);
+}
@@ -0,0 +1,25 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+int
+gf2_poly_equal(const gf2_poly_t poly1, const gf2_poly_t poly2)
+{
+    if (poly1->length != poly2->length)
+        return 0;
+
+    return mpn_cmp(poly1->coeffs, poly2->coeffs,
+                                          GF2_POLY_LIMBS(poly1->length)) == 0;
+}
@@ -0,0 +1,33 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_fit_length(gf2_poly_t poly, slong len)
+{
+    slong n = GF2_POLY_LIMBS(len);
+
+    if (n > poly->alloc)
+    {
+        n = FLINT_MAX(n, 2*poly->alloc);
+
+        if (poly->coeffs == NULL)
+            poly->coeffs = (mp_ptr) flint_malloc(n*sizeof(mp_limb_t));
+        else
+            poly->coeffs = (mp_ptr) flint_realloc(poly->coeffs,
+                                                         n*sizeof(mp_limb_t));
+        poly->alloc = n;
+    }
+}
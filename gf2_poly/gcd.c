@@ -0,0 +1,41 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_gcd(gf2_poly_t G, const gf2_poly_t A, const gf2_poly_t B)
+{
+    gf2_poly_t a, b, r;
+
+    gf2_poly_init(a);
+    gf2_poly_init(b);
+    gf2_poly_init(r);
+
+    gf2_poly_set(a, A);
+    gf2_poly_set(b, B);
+
+    while (b->length != 0)
+    {
+        gf2_poly_rem(r, a, b);
+        gf2_poly_swap(a, b);
+        gf2_poly_swap(b, r);
+    }
+
+    gf2_poly_swap(G, a);
+
+    gf2_poly_clear(a);
+    gf2_poly_clear(b);
+    gf2_poly_clear(r);
+}
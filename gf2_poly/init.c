@@ -0,0 +1,32 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_init(gf2_poly_t poly)
+{
+    poly->coeffs = NULL;
+    poly->alloc = 0;
+    poly->length = 0;
+}
+
+void
+gf2_poly_init2(gf2_poly_t poly, slong len)
+{
+    poly->alloc = GF2_POLY_LIMBS(len);
+    poly->coeffs = (poly->alloc != 0) ?
+                   (mp_ptr) flint_malloc(poly->alloc*sizeof(mp_limb_t)) : NULL;
+    poly->length = 0;
+}
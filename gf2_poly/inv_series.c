@@ -0,0 +1,58 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_inv_series(gf2_poly_t Qinv, const gf2_poly_t Q, slong n)
+{
+    slong a[FLINT_BITS], i, m;
+    gf2_poly_t g, t;
+
+    if (Q->length == 0 || (Q->coeffs[0] & 1) == 0)
+    {
+        flint_printf("Exception (gf2_poly_inv_series). Constant term is zero.\n");
+        flint_abort();
+    }
+
+    if (n <= 0)
+    {
+        gf2_poly_zero(Qinv);
+        return;
+    }
+
+    gf2_poly_init(g);
+    gf2_poly_init(t);
+
+    /* the inverse is 1 modulo x */
+    gf2_poly_one(g);
+
+    a[i = 0] = n;
+    while (n > 1)
+        a[++i] = (n = (n + 1)/2);
+
+    /* g <- g (2 - Q g) = Q g^2 mod x^m, in characteristic two */
+    for (i--; i >= 0; i--)
+    {
+        m = a[i];
+        gf2_poly_sqr(t, g);
+        gf2_poly_truncate(t, m);
+        gf2_poly_mullow(g, t, Q, m);
+    }
+
+    gf2_poly_swap(Qinv, g);
+
+    gf2_poly_clear(g);
+    gf2_poly_clear(t);
+}
@@ -0,0 +1,47 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+int
+gf2_poly_invmod(gf2_poly_t res, const gf2_poly_t A, const gf2_poly_t f)
+{
+    gf2_poly_t G, S, T, a;
+    int ok;
+
+    if (f->length < 2)
+    {
+        flint_printf("Exception (gf2_poly_invmod). lenB < 2.\n");
+        flint_abort();
+    }
+
+    gf2_poly_init(G);
+    gf2_poly_init(S);
+    gf2_poly_init(T);
+    gf2_poly_init(a);
+
+    gf2_poly_rem(a, A, f);
+    gf2_poly_xgcd(G, S, T, a, f);
+
+    ok = gf2_poly_is_one(G);
+    if (ok)
+        gf2_poly_swap(res, S);
+
+    gf2_poly_clear(G);
+    gf2_poly_clear(S);
+    gf2_poly_clear(T);
+    gf2_poly_clear(a);
+
+    return ok;
+}
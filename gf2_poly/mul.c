@@ -0,0 +1,94 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+_gf2_poly_mul(mp_ptr res, mp_srcptr poly1, slong n1,
+                          mp_srcptr poly2, slong n2)
+{
+    slong i, j, len;
+    mp_ptr t;
+
+    if (n1 < n2)
+    {
+        mp_srcptr p = poly1;
+        slong m = n1;
+        poly1 = poly2;
+        poly2 = p;
+        n1 = n2;
+        n2 = m;
+    }
+
+    if (n2 < GF2_POLY_KARATSUBA_CUTOFF)
+    {
+        _gf2_poly_mul_classical(res, poly1, n1, poly2, n2);
+        return;
+    }
+
+    if (n1 == n2)
+    {
+        _gf2_poly_mul_karatsuba(res, poly1, n1, poly2, n2);
+        return;
+    }
+
+    /* cut the longer operand into blocks of the length of the shorter */
+    t = flint_malloc(2*n2*sizeof(mp_limb_t));
+    flint_mpn_zero(res, n1 + n2);
+
+    for (i = 0; i < n1; i += n2)
+    {
+        len = FLINT_MIN(n2, n1 - i);
+        _gf2_poly_mul(t, poly2, n2, poly1 + i, len);
+
+        for (j = 0; j < n2 + len; j++)
+            res[i + j] ^= t[j];
+    }
+
+    flint_free(t);
+}
+
+void
+gf2_poly_mul(gf2_poly_t res, const gf2_poly_t poly1, const gf2_poly_t poly2)
+{
+    slong n1, n2;
+
+    if (poly1->length == 0 || poly2->length == 0)
+    {
+        gf2_poly_zero(res);
+        return;
+    }
+
+    if (res == poly1 || res == poly2)
+    {
+        gf2_poly_t t;
+        gf2_poly_init(t);
+        gf2_poly_mul(t, poly1, poly2);
+        gf2_poly_swap(res, t);
+        gf2_poly_clear(t);
+        return;
+    }
+
+    n1 = GF2_POLY_LIMBS(poly1->length);
+    n2 = GF2_POLY_LIMBS(poly2->length);
+
+    gf2_poly_fit_length(res, (n1 + n2)*FLINT_BITS);
+
+    if (poly1 == poly2)
+        _gf2_poly_sqr(res->coeffs, poly1->coeffs, n1);
+    else
+        _gf2_poly_mul(res->coeffs, poly1->coeffs, n1, poly2->coeffs, n2);
+
+    res->length = poly1->length + poly2->length - 1;
+}
@@ -0,0 +1,164 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+#if FLINT_NMOD_VEC_X86
+
+#include <immintrin.h>
+
+#define PCLMUL_FN __attribute__((target("pclmul")))
+
+/* product scanning, so that each limb of res is written once */
+static PCLMUL_FN void
+_mul_classical_pclmul(mp_ptr res, mp_srcptr poly1, slong n1,
+                                  mp_srcptr poly2, slong n2)
+{
+    slong i, k, lo, hi;
+    __m128i acc = _mm_setzero_si128();
+
+    for (k = 0; k < n1 + n2 - 1; k++)
+    {
+        lo = FLINT_MAX(0, k - n2 + 1);
+        hi = FLINT_MIN(k, n1 - 1);
+
+        for (i = lo; i <= hi; i++)
+            acc = _mm_xor_si128(acc, _mm_clmulepi64_si128(
+                        _mm_cvtsi64_si128(poly1[i]),
+                        _mm_cvtsi64_si128(poly2[k - i]), 0x00));
+
+        res[k] = _mm_cvtsi128_si64(acc);
+        acc = _mm_srli_si128(acc, 8);
+    }
+
+    res[n1 + n2 - 1] = _mm_cvtsi128_si64(acc);
+}
+
+static int _gf2_poly_pclmul = -1;
+
+#endif
+
+/* carry-less product of two limbs, using a table of the multiples of the
+   low FLINT_BITS - 3 bits of b by four bit polynomials */
+static void
+_clmul_generic(mp_limb_t * hi, mp_limb_t * lo, mp_limb_t a, mp_limb_t b)
+{
+    mp_limb_t u[16], b0, h, l, t;
+    int i;
+
+    b0 = b & ((UWORD(1) << (FLINT_BITS - 3)) - 1);
+
+    u[0] = 0;
+    u[1] = b0;
+    for (i = 2; i < 16; i += 2)
+    {
+        u[i] = u[i / 2] << 1;
+        u[i + 1] = u[i] ^ b0;
+    }
+
+    l = u[a & 15];
+    h = 0;
+
+    for (i = 4; i < FLINT_BITS; i += 4)
+    {
+        t = u[(a >> i) & 15];
+        l ^= t << i;
+        h ^= t >> (FLINT_BITS - i);
+    }
+
+    for (i = FLINT_BITS - 3; i < FLINT_BITS; i++)
+    {
+        if ((b >> i) & 1)
+        {
+            l ^= a << i;
+            h ^= a >> (FLINT_BITS - i);
+        }
+    }
+
+    *hi = h;
+    *lo = l;
+}
+
+void
+_gf2_poly_mul_classical(mp_ptr res, mp_srcptr poly1, slong n1,
+                                    mp_srcptr poly2, slong n2)
+{
+    slong i, k, lo, hi;
+    mp_limb_t a0, a1, p0, p1;
+
+#if FLINT_NMOD_VEC_X86
+    if (_gf2_poly_pclmul < 0)
+    {
+        __builtin_cpu_init();
+        _gf2_poly_pclmul = __builtin_cpu_supports("pclmul");
+    }
+
+    if (_gf2_poly_pclmul)
+    {
+        _mul_classical_pclmul(res, poly1, n1, poly2, n2);
+        return;
+    }
+#endif
+
+    a0 = a1 = 0;
+
+    for (k = 0; k < n1 + n2 - 1; k++)
+    {
+        lo = FLINT_MAX(0, k - n2 + 1);
+        hi = FLINT_MIN(k, n1 - 1);
+
+        for (i = lo; i <= hi; i++)
+        {
+            _clmul_generic(&p1, &p0, poly1[i], poly2[k - i]);
+            a0 ^= p0;
+            a1 ^= p1;
+        }
+
+        res[k] = a0;
+        a0 = a1;
+        a1 = 0;
+    }
+
+    res[n1 + n2 - 1] = a0;
+}
+
+void
+gf2_poly_mul_classical(gf2_poly_t res,
+                         const gf2_poly_t poly1, const gf2_poly_t poly2)
+{
+    slong n1, n2;
+
+    if (poly1->length == 0 || poly2->length == 0)
+    {
+        gf2_poly_zero(res);
+        return;
+    }
+
+    if (res == poly1 || res == poly2)
+    {
+        gf2_poly_t t;
+        gf2_poly_init(t);
+        gf2_poly_mul_classical(t, poly1, poly2);
+        gf2_poly_swap(res, t);
+        gf2_poly_clear(t);
+        return;
+    }
+
+    n1 = GF2_POLY_LIMBS(poly1->length);
+    n2 = GF2_POLY_LIMBS(poly2->length);
+
+    gf2_poly_fit_length(res, (n1 + n2)*FLINT_BITS);
+    _gf2_poly_mul_classical(res->coeffs, poly1->coeffs, n1, poly2->coeffs, n2);
+    res->length = poly1->length + poly2->length - 1;
+}
@@ -0,0 +1,65 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+/*
+    Balanced Karatsuba on limbs: with a = a0 + x^h a1 and b = b0 + x^h b1,
+    ab = P0 + x^h (P0 + P1 + P2) + x^(2h) P2, where P0 = a0 b0,
+    P2 = a1 b1 and P1 = (a0 + a1)(b0 + b1). Requires n1 = n2.
+*/
+void
+_gf2_poly_mul_karatsuba(mp_ptr res, mp_srcptr poly1, slong n1,
+                                    mp_srcptr poly2, slong n2)
+{
+    slong i, h, l, n = n1;
+    mp_ptr s1, s2, p1;
+
+    if (n < 2)
+    {
+        _gf2_poly_mul_classical(res, poly1, n1, poly2, n2);
+        return;
+    }
+
+    h = (n + 1)/2;
+    l = n - h;
+
+    s1 = flint_malloc(4*h*sizeof(mp_limb_t));
+    s2 = s1 + h;
+    p1 = s2 + h;
+
+    for (i = 0; i < l; i++)
+    {
+        s1[i] = poly1[i] ^ poly1[h + i];
+        s2[i] = poly2[i] ^ poly2[h + i];
+    }
+    for ( ; i < h; i++)
+    {
+        s1[i] = poly1[i];
+        s2[i] = poly2[i];
+    }
+
+    _gf2_poly_mul(res, poly1, h, poly2, h);
+    _gf2_poly_mul(res + 2*h, poly1 + h, l, poly2 + h, l);
+    _gf2_poly_mul(p1, s1, h, s2, h);
+
+    for (i = 0; i < 2*h; i++)
+        p1[i] ^= res[i];
+    for (i = 0; i < 2*l; i++)
+        p1[i] ^= res[2*h + i];
+    for (i = 0; i < 2*h; i++)
+        res[h + i] ^= p1[i];
+
+    flint_free(s1);
+}
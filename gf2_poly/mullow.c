@@ -0,0 +1,53 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_mullow(gf2_poly_t res, const gf2_poly_t poly1,
+                                const gf2_poly_t poly2, slong n)
+{
+    slong n1, n2, m;
+
+    if (poly1->length == 0 || poly2->length == 0 || n <= 0)
+    {
+        gf2_poly_zero(res);
+        return;
+    }
+
+    if (res == poly1 || res == poly2)
+    {
+        gf2_poly_t t;
+        gf2_poly_init(t);
+        gf2_poly_mullow(t, poly1, poly2, n);
+        gf2_poly_swap(res, t);
+        gf2_poly_clear(t);
+        return;
+    }
+
+    /* only the limbs below x^n of the operands contribute */
+    m = GF2_POLY_LIMBS(n);
+    n1 = FLINT_MIN(GF2_POLY_LIMBS(poly1->length), m);
+    n2 = FLINT_MIN(GF2_POLY_LIMBS(poly2->length), m);
+
+    gf2_poly_fit_length(res, (n1 + n2)*FLINT_BITS);
+
+    if (poly1 == poly2)
+        _gf2_poly_sqr(res->coeffs, poly1->coeffs, n1);
+    else
+        _gf2_poly_mul(res->coeffs, poly1->coeffs, n1, poly2->coeffs, n2);
+
+    _gf2_poly_normalise(res, n1 + n2);
+    gf2_poly_truncate(res, n);
+}
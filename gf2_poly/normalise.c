@@ -0,0 +1,27 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+_gf2_poly_normalise(gf2_poly_t poly, slong n)
+{
+    while (n > 0 && poly->coeffs[n - 1] == 0)
+        n--;
+
+    if (n == 0)
+        poly->length = 0;
+    else
+        poly->length = (n - 1)*FLINT_BITS + FLINT_BIT_COUNT(poly->coeffs[n - 1]);
+}
@@ -0,0 +1,41 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+_gf2_poly_pack(mp_ptr res, mp_srcptr coeffs, slong len)
+{
+    slong i, j;
+
+    for (i = 0; i < GF2_POLY_LIMBS(len); i++)
+    {
+        mp_limb_t w = 0;
+        slong l = FLINT_MIN(FLINT_BITS, len - i*FLINT_BITS);
+
+        for (j = 0; j < l; j++)
+            w |= (coeffs[i*FLINT_BITS + j] & 1) << j;
+
+        res[i] = w;
+    }
+}
+
+void
+_gf2_poly_unpack(mp_ptr res, mp_srcptr poly, slong len)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+        res[i] = (poly[i / FLINT_BITS] >> (i % FLINT_BITS)) & 1;
+}
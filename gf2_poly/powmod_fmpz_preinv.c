@@ -0,0 +1,61 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_powmod_fmpz_preinv(gf2_poly_t res,
+             const gf2_poly_t poly, const fmpz_t e,
+             const gf2_poly_t f, const gf2_poly_t finv)
+{
+    slong i;
+    gf2_poly_t x, t;
+
+    if (fmpz_sgn(e) < 0)
+    {
+        flint_printf("Exception (gf2_poly_powmod_fmpz_preinv). Negative exponent.\n");
+        flint_abort();
+    }
+
+    gf2_poly_init(x);
+    gf2_poly_init(t);
+
+    /* the base is reduced first, the preinverse covers lengths < 2 len(f) */
+    gf2_poly_rem(x, poly, f);
+
+    if (fmpz_is_zero(e))
+    {
+        gf2_poly_one(t);
+        if (f->length == 1)
+            gf2_poly_zero(t);
+    }
+    else
+    {
+        gf2_poly_set(t, x);
+
+        for (i = fmpz_bits(e) - 2; i >= 0; i--)
+        {
+            gf2_poly_sqrmod_preinv(t, t, f, finv);
+
+            if (fmpz_tstbit(e, i))
+                gf2_poly_mulmod_preinv(t, t, x, f, finv);
+        }
+    }
+
+    gf2_poly_swap(res, t);
+
+    gf2_poly_clear(x);
+    gf2_poly_clear(t);
+}
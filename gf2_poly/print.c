@@ -0,0 +1,30 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_print(const gf2_poly_t poly)
+{
+    slong i;
+
+    flint_printf("%wd 2", poly->length);
+
+    if (poly->length != 0)
+        flint_printf(" ");
+
+    for (i = 0; i < poly->length; i++)
+        flint_printf(" %wu", gf2_poly_get_coeff_ui(poly, i));
+}
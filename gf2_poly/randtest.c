@@ -0,0 +1,32 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_randtest(gf2_poly_t poly, flint_rand_t state, slong len)
+{
+    slong i, n = GF2_POLY_LIMBS(len);
+
+    gf2_poly_fit_length(poly, len);
+
+    for (i = 0; i < n; i++)
+        poly->coeffs[i] = n_randint(state, 4) ? n_randlimb(state)
+                                              : n_randtest(state);
+
+    if (len % FLINT_BITS != 0)
+        poly->coeffs[n - 1] &= (UWORD(1) << (len % FLINT_BITS)) - 1;
+
+    _gf2_poly_normalise(poly, n);
+}
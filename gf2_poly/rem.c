@@ -0,0 +1,25 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_rem(gf2_poly_t R, const gf2_poly_t A, const gf2_poly_t B)
+{
+    gf2_poly_t Q;
+
+    gf2_poly_init(Q);
+    gf2_poly_divrem(Q, R, A, B);
+    gf2_poly_clear(Q);
+}
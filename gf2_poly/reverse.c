@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+static mp_limb_t
+_revbin_limb(mp_limb_t x)
+{
+    mp_limb_t m = ~UWORD(0);
+    int s;
+
+    for (s = FLINT_BITS / 2; s > 0; s >>= 1)
+    {
+        m ^= m << s;
+        x = ((x >> s) & m) | ((x << s) & ~m);
+    }
+
+    return x;
+}
+
+/* {res, ceil(n / FLINT_BITS)} is the reversal of the first n coefficients
+   of {poly, ceil(n / FLINT_BITS)}, whose higher bits must be zero */
+void
+_gf2_poly_reverse(mp_ptr res, mp_srcptr poly, slong n)
+{
+    slong i, m = GF2_POLY_LIMBS(n);
+    int s = m*FLINT_BITS - n;
+
+    for (i = 0; i < m / 2; i++)
+    {
+        mp_limb_t t = poly[i];
+        res[i] = _revbin_limb(poly[m - 1 - i]);
+        res[m - 1 - i] = _revbin_limb(t);
+    }
+
+    if (m % 2 == 1)
+        res[m / 2] = _revbin_limb(poly[m / 2]);
+
+    if (s != 0)
+        mpn_rshift(res, res, m, s);
+}
+
+void
+gf2_poly_reverse(gf2_poly_t res, const gf2_poly_t poly, slong n)
+{
+    slong m = GF2_POLY_LIMBS(n), k;
+    mp_ptr t;
+
+    if (n <= 0)
+    {
+        gf2_poly_zero(res);
+        return;
+    }
+
+    t = flint_calloc(m, sizeof(mp_limb_t));
+    k = FLINT_MIN(m, GF2_POLY_LIMBS(poly->length));
+    flint_mpn_copyi(t, poly->coeffs, k);
+    if (n % FLINT_BITS != 0)
+        t[m - 1] &= (UWORD(1) << (n % FLINT_BITS)) - 1;
+
+    gf2_poly_fit_length(res, n);
+    _gf2_poly_reverse(res->coeffs, t, n);
+    _gf2_poly_normalise(res, m);
+
+    flint_free(t);
+}
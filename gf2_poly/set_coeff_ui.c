@@ -0,0 +1,41 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_set_coeff_ui(gf2_poly_t poly, slong j, ulong c)
+{
+    slong n = GF2_POLY_LIMBS(poly->length);
+    mp_limb_t b = UWORD(1) << (j % FLINT_BITS);
+
+    if (c & 1)
+    {
+        if (j >= poly->length)
+        {
+            gf2_poly_fit_length(poly, j + 1);
+            flint_mpn_zero(poly->coeffs + n, GF2_POLY_LIMBS(j + 1) - n);
+            poly->length = j + 1;
+        }
+
+        poly->coeffs[j / FLINT_BITS] |= b;
+    }
+    else if (j < poly->length)
+    {
+        poly->coeffs[j / FLINT_BITS] &= ~b;
+
+        if (j == poly->length - 1)
+            _gf2_poly_normalise(poly, n);
+    }
+}
@@ -0,0 +1,23 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_set_nmod_poly(gf2_poly_t res, const nmod_poly_t poly)
+{
+    gf2_poly_fit_length(res, poly->length);
+    _gf2_poly_pack(res->coeffs, poly->coeffs, poly->length);
+    _gf2_poly_normalise(res, GF2_POLY_LIMBS(poly->length));
+}
@@ -0,0 +1,40 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_shift_right(gf2_poly_t res, const gf2_poly_t poly, slong n)
+{
+    slong len = poly->length, m, q, r;
+
+    if (n >= len)
+    {
+        gf2_poly_zero(res);
+        return;
+    }
+
+    m = GF2_POLY_LIMBS(len);
+    q = n / FLINT_BITS;
+    r = n % FLINT_BITS;
+
+    gf2_poly_fit_length(res, (m - q)*FLINT_BITS);
+
+    if (r == 0)
+        flint_mpn_copyi(res->coeffs, poly->coeffs + q, m - q);
+    else
+        mpn_rshift(res->coeffs, poly->coeffs + q, m - q, r);
+
+    res->length = len - n;
+}
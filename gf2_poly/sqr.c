@@ -0,0 +1,64 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+/* spreads the low FLINT_BITS / 2 bits of x to the even positions */
+static mp_limb_t
+_spread(mp_limb_t x)
+{
+#if FLINT64
+    x = (x | (x << 16)) & UWORD(0x0000FFFF0000FFFF);
+    x = (x | (x << 8)) & UWORD(0x00FF00FF00FF00FF);
+    x = (x | (x << 4)) & UWORD(0x0F0F0F0F0F0F0F0F);
+    x = (x | (x << 2)) & UWORD(0x3333333333333333);
+    x = (x | (x << 1)) & UWORD(0x5555555555555555);
+#else
+    x = (x | (x << 8)) & UWORD(0x00FF00FF);
+    x = (x | (x << 4)) & UWORD(0x0F0F0F0F);
+    x = (x | (x << 2)) & UWORD(0x33333333);
+    x = (x | (x << 1)) & UWORD(0x55555555);
+#endif
+    return x;
+}
+
+/* squaring is linear in characteristic two: the coefficients are spread */
+void
+_gf2_poly_sqr(mp_ptr res, mp_srcptr poly, slong n)
+{
+    slong i;
+
+    for (i = n - 1; i >= 0; i--)
+    {
+        mp_limb_t t = poly[i];
+        res[2*i + 1] = _spread(t >> (FLINT_BITS / 2));
+        res[2*i] = _spread(t & ((UWORD(1) << (FLINT_BITS / 2)) - 1));
+    }
+}
+
+void
+gf2_poly_sqr(gf2_poly_t res, const gf2_poly_t poly)
+{
+    slong n = GF2_POLY_LIMBS(poly->length);
+
+    if (poly->length == 0)
+    {
+        gf2_poly_zero(res);
+        return;
+    }
+
+    gf2_poly_fit_length(res, 2*n*FLINT_BITS);
+    _gf2_poly_sqr(res->coeffs, poly->coeffs, n);
+    res->length = 2*poly->length - 1;
+}
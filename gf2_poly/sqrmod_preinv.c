@@ -0,0 +1,31 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_sqrmod_preinv(gf2_poly_t res, const gf2_poly_t poly,
+                                    const gf2_poly_t f, const gf2_poly_t finv)
+{
+    gf2_poly_t t, q;
+
+    gf2_poly_init(t);
+    gf2_poly_init(q);
+
+    gf2_poly_sqr(t, poly);
+    gf2_poly_divrem_newton_preinv(q, res, t, f, finv);
+
+    gf2_poly_clear(t);
+    gf2_poly_clear(q);
+}
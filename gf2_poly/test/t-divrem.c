@@ -0,0 +1,126 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "gf2_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("divrem....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 2000 * flint_test_multiplier(); iter++)
+    {
+        gf2_poly_t a, b, binv, q, r, q2, r2;
+        nmod_poly_t A, B, Q, R, T;
+        slong lenA, lenB;
+
+        gf2_poly_init(a);
+        gf2_poly_init(b);
+        gf2_poly_init(binv);
+        gf2_poly_init(q);
+        gf2_poly_init(r);
+        gf2_poly_init(q2);
+        gf2_poly_init(r2);
+        nmod_poly_init(A, 2);
+        nmod_poly_init(B, 2);
+        nmod_poly_init(Q, 2);
+        nmod_poly_init(R, 2);
+        nmod_poly_init(T, 2);
+
+        if (n_randint(state, 20) == 0)
+        {
+            lenA = n_randint(state, 10000);
+            lenB = 1 + n_randint(state, 6000);
+        }
+        else
+        {
+            lenA = n_randint(state, 600);
+            lenB = 1 + n_randint(state, 300);
+        }
+
+        gf2_poly_randtest(a, state, lenA);
+        do {
+            gf2_poly_randtest(b, state, lenB);
+        } while (gf2_poly_is_zero(b));
+
+        gf2_poly_get_nmod_poly(A, a);
+        gf2_poly_get_nmod_poly(B, b);
+
+        gf2_poly_divrem(q, r, a, b);
+        nmod_poly_divrem(Q, R, A, B);
+
+        gf2_poly_get_nmod_poly(T, q);
+        if (!nmod_poly_equal(Q, T))
+        {
+            flint_printf("FAIL: quotient\n");
+            flint_printf("lenA = %wd, lenB = %wd\n", lenA, lenB);
+            abort();
+        }
+
+        gf2_poly_get_nmod_poly(T, r);
+        if (!nmod_poly_equal(R, T))
+        {
+            flint_printf("FAIL: remainder\n");
+            flint_printf("lenA = %wd, lenB = %wd\n", lenA, lenB);
+            abort();
+        }
+
+        gf2_poly_reverse(binv, b, b->length);
+        gf2_poly_inv_series(binv, binv, FLINT_MAX(1, a->length - b->length + 1));
+        gf2_poly_divrem_newton_preinv(q2, r2, a, b, binv);
+
+        if (!gf2_poly_equal(q, q2) || !gf2_poly_equal(r, r2))
+        {
+            flint_printf("FAIL: divrem_newton_preinv\n");
+            flint_printf("lenA = %wd, lenB = %wd\n", lenA, lenB);
+            abort();
+        }
+
+        /* aliasing */
+        gf2_poly_set(r2, a);
+        gf2_poly_set(q2, b);
+        gf2_poly_divrem(q2, r2, r2, q2);
+
+        if (!gf2_poly_equal(q, q2) || !gf2_poly_equal(r, r2))
+        {
+            flint_printf("FAIL: aliasing\n");
+            abort();
+        }
+
+        gf2_poly_clear(a);
+        gf2_poly_clear(b);
+        gf2_poly_clear(binv);
+        gf2_poly_clear(q);
+        gf2_poly_clear(r);
+        gf2_poly_clear(q2);
+        gf2_poly_clear(r2);
+        nmod_poly_clear(A);
+        nmod_poly_clear(B);
+        nmod_poly_clear(Q);
+        nmod_poly_clear(R);
+        nmod_poly_clear(T);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "gf2_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 2000 * flint_test_multiplier(); iter++)
+    {
+        gf2_poly_t a, b, c, d;
+        nmod_poly_t A, B, C, D;
+        slong len1, len2, n;
+
+        gf2_poly_init(a);
+        gf2_poly_init(b);
+        gf2_poly_init(c);
+        gf2_poly_init(d);
+        nmod_poly_init(A, 2);
+        nmod_poly_init(B, 2);
+        nmod_poly_init(C, 2);
+        nmod_poly_init(D, 2);
+
+        if (n_randint(state, 10) == 0)
+        {
+            len1 = n_randint(state, 6000);
+            len2 = n_randint(state, 6000);
+        }
+        else
+        {
+            len1 = n_randint(state, 400);
+            len2 = n_randint(state, 400);
+        }
+
+        gf2_poly_randtest(a, state, len1);
+        gf2_poly_randtest(b, state, len2);
+        gf2_poly_get_nmod_poly(A, a);
+        gf2_poly_get_nmod_poly(B, b);
+
+        gf2_poly_mul(c, a, b);
+        nmod_poly_mul(C, A, B);
+        gf2_poly_get_nmod_poly(D, c);
+
+        if (!nmod_poly_equal(C, D))
+        {
+            flint_printf("FAIL: mul\n");
+            flint_printf("len1 = %wd, len2 = %wd\n", len1, len2);
+            abort();
+        }
+
+        gf2_poly_mul_classical(d, a, b);
+
+        if (!gf2_poly_equal(c, d))
+        {
+            flint_printf("FAIL: mul_classical\n");
+            abort();
+        }
+
+        n = n_randint(state, len1 + len2 + 1);
+        gf2_poly_mullow(d, a, b, n);
+        gf2_poly_truncate(c, n);
+
+        if (!gf2_poly_equal(c, d))
+        {
+            flint_printf("FAIL: mullow\n");
+            flint_printf("len1 = %wd, len2 = %wd, n = %wd\n", len1, len2, n);
+            abort();
+        }
+
+        /* aliasing */
+        gf2_poly_mul(c, a, b);
+        gf2_poly_mul(a, a, b);
+        gf2_poly_mul(d, b, b);
+        gf2_poly_mul(b, b, b);
+
+        if (!gf2_poly_equal(a, c) || !gf2_poly_equal(b, d))
+        {
+            flint_printf("FAIL: aliasing\n");
+            abort();
+        }
+
+        gf2_poly_clear(a);
+        gf2_poly_clear(b);
+        gf2_poly_clear(c);
+        gf2_poly_clear(d);
+        nmod_poly_clear(A);
+        nmod_poly_clear(B);
+        nmod_poly_clear(C);
+        nmod_poly_clear(D);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "nmod_poly.h"
+#include "gf2_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("powmod_fmpz_preinv....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 500 * flint_test_multiplier(); iter++)
+    {
+        gf2_poly_t a, f, finv, r;
+        nmod_poly_t A, F, R, S;
+        fmpz_t e;
+
+        gf2_poly_init(a);
+        gf2_poly_init(f);
+        gf2_poly_init(finv);
+        gf2_poly_init(r);
+        nmod_poly_init(A, 2);
+        nmod_poly_init(F, 2);
+        nmod_poly_init(R, 2);
+        nmod_poly_init(S, 2);
+        fmpz_init(e);
+
+        do {
+            gf2_poly_randtest(f, state, 1 + n_randint(state, 400));
+        } while (gf2_poly_is_zero(f));
+        gf2_poly_randtest(a, state, n_randint(state, 800));
+        fmpz_randtest_unsigned(e, state, 100);
+
+        gf2_poly_reverse(finv, f, f->length);
+        gf2_poly_inv_series(finv, finv, f->length);
+
+        gf2_poly_powmod_fmpz_preinv(r, a, e, f, finv);
+
+        gf2_poly_get_nmod_poly(A, a);
+        gf2_poly_get_nmod_poly(F, f);
+        nmod_poly_rem(A, A, F);
+        nmod_poly_powmod_fmpz_binexp(R, A, e, F);
+        gf2_poly_get_nmod_poly(S, r);
+
+        if (!nmod_poly_equal(R, S))
+        {
+            flint_printf("FAIL: powmod_fmpz_preinv\n");
+            abort();
+        }
+
+        gf2_poly_clear(a);
+        gf2_poly_clear(f);
+        gf2_poly_clear(finv);
+        gf2_poly_clear(r);
+        nmod_poly_clear(A);
+        nmod_poly_clear(F);
+        nmod_poly_clear(R);
+        nmod_poly_clear(S);
+        fmpz_clear(e);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
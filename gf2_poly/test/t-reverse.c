@@ -0,0 +1,100 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "gf2_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("reverse....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 2000 * flint_test_multiplier(); iter++)
+    {
+        gf2_poly_t a, b;
+        nmod_poly_t A, B, C;
+        slong len, n;
+
+        gf2_poly_init(a);
+        gf2_poly_init(b);
+        nmod_poly_init(A, 2);
+        nmod_poly_init(B, 2);
+        nmod_poly_init(C, 2);
+
+        len = n_randint(state, 500);
+        n = n_randint(state, 500);
+
+        gf2_poly_randtest(a, state, len);
+        gf2_poly_get_nmod_poly(A, a);
+
+        gf2_poly_reverse(b, a, n);
+        nmod_poly_reverse(B, A, n);
+        gf2_poly_get_nmod_poly(C, b);
+
+        if (!nmod_poly_equal(B, C))
+        {
+            flint_printf("FAIL: reverse\n");
+            flint_printf("len = %wd, n = %wd\n", len, n);
+            abort();
+        }
+
+        gf2_poly_shift_left(b, a, n);
+        nmod_poly_shift_left(B, A, n);
+        _nmod_poly_normalise(B);
+        gf2_poly_get_nmod_poly(C, b);
+
+        if (!nmod_poly_equal(B, C))
+        {
+            flint_printf("FAIL: shift_left\n");
+            abort();
+        }
+
+        gf2_poly_shift_right(b, a, n);
+        nmod_poly_shift_right(B, A, n);
+        gf2_poly_get_nmod_poly(C, b);
+
+        if (!nmod_poly_equal(B, C))
+        {
+            flint_printf("FAIL: shift_right\n");
+            abort();
+        }
+
+        /* aliasing */
+        gf2_poly_reverse(b, a, n);
+        gf2_poly_reverse(a, a, n);
+
+        if (!gf2_poly_equal(a, b))
+        {
+            flint_printf("FAIL: aliasing\n");
+            abort();
+        }
+
+        gf2_poly_clear(a);
+        gf2_poly_clear(b);
+        nmod_poly_clear(A);
+        nmod_poly_clear(B);
+        nmod_poly_clear(C);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
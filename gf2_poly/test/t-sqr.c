@@ -0,0 +1,66 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "gf2_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("sqr....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        gf2_poly_t a, b, c;
+
+        gf2_poly_init(a);
+        gf2_poly_init(b);
+        gf2_poly_init(c);
+
+        gf2_poly_randtest(a, state, n_randint(state, 2000));
+
+        gf2_poly_sqr(b, a);
+        gf2_poly_mul_classical(c, a, a);
+
+        if (!gf2_poly_equal(b, c))
+        {
+            flint_printf("FAIL: sqr\n");
+            abort();
+        }
+
+        /* aliasing */
+        gf2_poly_sqr(a, a);
+
+        if (!gf2_poly_equal(a, b))
+        {
+            flint_printf("FAIL: aliasing\n");
+            abort();
+        }
+
+        gf2_poly_clear(a);
+        gf2_poly_clear(b);
+        gf2_poly_clear(c);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "gf2_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("xgcd....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        gf2_poly_t a, b, g, s, t, u, v;
+        nmod_poly_t A, B, G, H;
+
+        gf2_poly_init(a);
+        gf2_poly_init(b);
+        gf2_poly_init(g);
+        gf2_poly_init(s);
+        gf2_poly_init(t);
+        gf2_poly_init(u);
+        gf2_poly_init(v);
+        nmod_poly_init(A, 2);
+        nmod_poly_init(B, 2);
+        nmod_poly_init(G, 2);
+        nmod_poly_init(H, 2);
+
+        gf2_poly_randtest(a, state, n_randint(state, 500));
+        gf2_poly_randtest(b, state, n_randint(state, 500));
+        gf2_poly_randtest(u, state, n_randint(state, 200));
+        gf2_poly_mul(a, a, u);
+        gf2_poly_mul(b, b, u);
+
+        gf2_poly_get_nmod_poly(A, a);
+        gf2_poly_get_nmod_poly(B, b);
+
+        gf2_poly_gcd(g, a, b);
+        nmod_poly_gcd(G, A, B);
+        gf2_poly_get_nmod_poly(H, g);
+
+        if (!nmod_poly_equal(G, H))
+        {
+            flint_printf("FAIL: gcd\n");
+            abort();
+        }
+
+        gf2_poly_xgcd(u, s, t, a, b);
+        gf2_poly_mul(s, s, a);
+        gf2_poly_mul(t, t, b);
+        gf2_poly_add(v, s, t);
+
+        if (!gf2_poly_equal(u, g) || !gf2_poly_equal(v, g))
+        {
+            flint_printf("FAIL: xgcd\n");
+            abort();
+        }
+
+        if (b->length >= 2)
+        {
+            int ok = gf2_poly_invmod(s, a, b);
+
+            if (ok != gf2_poly_is_one(g))
+            {
+                flint_printf("FAIL: invmod (existence)\n");
+                abort();
+            }
+
+            if (ok)
+            {
+                gf2_poly_mul(t, s, a);
+                gf2_poly_rem(t, t, b);
+
+                if (!gf2_poly_is_one(t) || s->length >= b->length)
+                {
+                    flint_printf("FAIL: invmod\n");
+                    abort();
+                }
+            }
+        }
+
+        gf2_poly_clear(a);
+        gf2_poly_clear(b);
+        gf2_poly_clear(g);
+        gf2_poly_clear(s);
+        gf2_poly_clear(t);
+        gf2_poly_clear(u);
+        gf2_poly_clear(v);
+        nmod_poly_clear(A);
+        nmod_poly_clear(B);
+        nmod_poly_clear(G);
+        nmod_poly_clear(H);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,28 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+void
+gf2_poly_truncate(gf2_poly_t poly, slong n)
+{
+    if (n < poly->length)
+    {
+        if (n % FLINT_BITS != 0)
+            poly->coeffs[n / FLINT_BITS] &=
+                                       (UWORD(1) << (n % FLINT_BITS)) - 1;
+
+        _gf2_poly_normalise(poly, GF2_POLY_LIMBS(n));
+    }
+}
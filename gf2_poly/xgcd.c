@@ -0,0 +1,69 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "gf2_poly.h"
+
+/* G = S A + T B, with len(S) < len(B) and len(T) < len(A) when G != A, B */
+void
+gf2_poly_xgcd(gf2_poly_t G, gf2_poly_t S, gf2_poly_t T,
+                                    const gf2_poly_t A, const gf2_poly_t B)
+{
+    gf2_poly_t a, b, q, r, s0, s1, t0, t1, u;
+
+    gf2_poly_init(a);
+    gf2_poly_init(b);
+    gf2_poly_init(q);
+    gf2_poly_init(r);
+    gf2_poly_init(s0);
+    gf2_poly_init(s1);
+    gf2_poly_init(t0);
+    gf2_poly_init(t1);
+    gf2_poly_init(u);
+
+    gf2_poly_set(a, A);
+    gf2_poly_set(b, B);
+    gf2_poly_one(s0);
+    gf2_poly_one(t1);
+
+    while (b->length != 0)
+    {
+        gf2_poly_divrem(q, r, a, b);
+        gf2_poly_swap(a, b);
+        gf2_poly_swap(b, r);
+
+        gf2_poly_mul(u, q, s1);
+        gf2_poly_add(u, u, s0);
+        gf2_poly_swap(s0, s1);
+        gf2_poly_swap(s1, u);
+
+        gf2_poly_mul(u, q, t1);
+        gf2_poly_add(u, u, t0);
+        gf2_poly_swap(t0, t1);
+        gf2_poly_swap(t1, u);
+    }
+
+    gf2_poly_swap(G, a);
+    gf2_poly_swap(S, s0);
+    gf2_poly_swap(T, t0);
+
+    gf2_poly_clear(a);
+    gf2_poly_clear(b);
+    gf2_poly_clear(q);
+    gf2_poly_clear(r);
+    gf2_poly_clear(s0);
+    gf2_poly_clear(s1);
+    gf2_poly_clear(t0);
+    gf2_poly_clear(t1);
+    gf2_poly_clear(u);
+}
@@ -14,6 +14,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "flint.h"
 #include "thread_pool.h"
 
@@ -53,6 +54,609 @@ static void flint_memory_error(size_t size)
     flint_abort();
 }
 
+/* allocation statistics *****************************************************/
+
+/*
+    While statistics are enabled, every block returned by flint_malloc,
+    flint_calloc and flint_realloc is recorded in a hash table together
+    with its size, the thread which allocated it and the module which was
+    current on that thread. The table is split into shards with their own
+    locks so that threads rarely contend. Blocks allocated while
+    statistics were disabled are not in the table and are ignored when
+    they are freed.
+
+    The counters of a thread are kept in a heap allocated structure which
+    is never freed, since blocks allocated by a thread may be freed after
+    it has exited. The memory for the statistics themselves is obtained
+    from malloc directly so that it is not counted.
+*/
+
+#define FLINT_MEMORY_STATS_SHARDS 64
+
+#define FLINT_MEMORY_STATS_MAX_MODULES 64
+
+#if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)) && FLINT_USES_PTHREAD
+#define STATS_ADD(x, v) __atomic_add_fetch(&(x), (v), __ATOMIC_RELAXED)
+#else
+#define STATS_ADD(x, v) ((x) += (v))
+#endif
+
+typedef struct _flint_memory_counter_struct
+{
+    flint_memory_stats_struct stats;
+    struct _flint_memory_counter_struct * next;
+} _flint_memory_counter_struct;
+
+typedef struct
+{
+    void * ptr;             /* NULL if the slot is empty */
+    size_t size;
+    _flint_memory_counter_struct * thread;
+    slong module;
+} _flint_memory_entry_struct;
+
+typedef struct
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t lock;
+#endif
+    _flint_memory_entry_struct * entries;
+    slong alloc;            /* a power of two, or zero */
+    slong num;
+} _flint_memory_shard_struct;
+
+static volatile int _flint_memory_stats_on = 0;
+
+/* number of blocks in the table, frees only search it if nonzero */
+static volatile slong _flint_memory_num_tracked = 0;
+
+static _flint_memory_shard_struct
+                          _flint_memory_shards[FLINT_MEMORY_STATS_SHARDS];
+
+static _flint_memory_counter_struct * _flint_memory_threads = NULL;
+
+static _flint_memory_counter_struct _flint_memory_global;
+
+static _flint_memory_counter_struct
+                        _flint_memory_modules[FLINT_MEMORY_STATS_MAX_MODULES];
+static char * _flint_memory_module_names[FLINT_MEMORY_STATS_MAX_MODULES];
+static slong _flint_memory_num_modules = 1;
+
+#if FLINT_USES_PTHREAD
+static pthread_mutex_t _flint_memory_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t _flint_memory_shards_initialised = PTHREAD_ONCE_INIT;
+
+static void _flint_memory_shards_init(void)
+{
+    slong i;
+
+    for (i = 0; i < FLINT_MEMORY_STATS_SHARDS; i++)
+        pthread_mutex_init(&_flint_memory_shards[i].lock, NULL);
+}
+#endif
+
+FLINT_TLS_PREFIX _flint_memory_counter_struct * _flint_memory_thread = NULL;
+FLINT_TLS_PREFIX slong _flint_memory_module = 0;
+
+/* the blocks of a thread with a memory limit are always recorded */
+FLINT_TLS_PREFIX slong _flint_memory_limit = 0;
+
+/* bytes held by the thread through GMP while the GMP functions are ours */
+FLINT_TLS_PREFIX slong _flint_memory_gmp_live = 0;
+
+#define MEMORY_TRACKED (_flint_memory_stats_on || _flint_memory_limit != 0)
+
+static _flint_memory_counter_struct * _flint_memory_get_thread(void)
+{
+    _flint_memory_counter_struct * c = _flint_memory_thread;
+
+    if (c == NULL)
+    {
+        c = calloc(1, sizeof(_flint_memory_counter_struct));
+
+        if (c == NULL)
+            flint_memory_error(sizeof(_flint_memory_counter_struct));
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&_flint_memory_stats_lock);
+#endif
+        c->next = _flint_memory_threads;
+        _flint_memory_threads = c;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&_flint_memory_stats_lock);
+#endif
+
+        _flint_memory_thread = c;
+    }
+
+    return c;
+}
+
+static ulong _flint_memory_hash(const void * ptr)
+{
+    ulong h = (ulong) ptr;
+
+#if FLINT64
+    h = (h >> 4) * UWORD(0x9E3779B97F4A7C15);
+#else
+    h = (h >> 3) * UWORD(0x9E3779B9);
+#endif
+
+    return h ^ (h >> (FLINT_BITS/2));
+}
+
+static void _flint_memory_charge(_flint_memory_counter_struct * c,
+                             slong bytes, int allocs, int reallocs, int frees)
+{
+    slong live = STATS_ADD(c->stats.live, bytes);
+
+    if (allocs)
+        STATS_ADD(c->stats.allocs, 1);
+    if (reallocs)
+        STATS_ADD(c->stats.reallocs, 1);
+    if (frees)
+        STATS_ADD(c->stats.frees, 1);
+    if (bytes > 0)
+        STATS_ADD(c->stats.total, (ulong) bytes);
+
+    /* racy, but only allocations raise the high water mark */
+    if (live > c->stats.peak)
+        c->stats.peak = live;
+}
+
+static void _flint_memory_charge_entry(const _flint_memory_entry_struct * e,
+                             slong bytes, int allocs, int reallocs, int frees)
+{
+    _flint_memory_charge(e->thread, bytes, allocs, reallocs, frees);
+    _flint_memory_charge(_flint_memory_modules + e->module,
+                                               bytes, allocs, reallocs, frees);
+    _flint_memory_charge(&_flint_memory_global,
+                                               bytes, allocs, reallocs, frees);
+}
+
+static void _flint_memory_insert(_flint_memory_shard_struct * S,
+                                            const _flint_memory_entry_struct * e)
+{
+    ulong mask, i;
+
+    if (2*(S->num + 1) > S->alloc)
+    {
+        _flint_memory_entry_struct * old = S->entries;
+        slong j, old_alloc = S->alloc;
+
+        S->alloc = FLINT_MAX(64, 2*old_alloc);
+        S->entries = calloc(S->alloc, sizeof(_flint_memory_entry_struct));
+
+        if (S->entries == NULL)
+            flint_memory_error(S->alloc*sizeof(_flint_memory_entry_struct));
+
+        STATS_ADD(_flint_memory_num_tracked, -S->num);
+        S->num = 0;
+
+        for (j = 0; j < old_alloc; j++)
+            if (old[j].ptr != NULL)
+                _flint_memory_insert(S, old + j);
+
+        free(old);
+    }
+
+    mask = S->alloc - 1;
+
+    for (i = _flint_memory_hash(e->ptr) & mask; S->entries[i].ptr != NULL;
+                                                           i = (i + 1) & mask)
+        ;
+
+    S->entries[i] = *e;
+    S->num++;
+    STATS_ADD(_flint_memory_num_tracked, 1);
+}
+
+/* remove ptr from S, returns 0 if it was not there */
+static int _flint_memory_remove(_flint_memory_shard_struct * S,
+                            const void * ptr, _flint_memory_entry_struct * e)
+{
+    ulong mask, i, j, k;
+
+    if (S->alloc == 0)
+        return 0;
+
+    mask = S->alloc - 1;
+
+    for (i = _flint_memory_hash(ptr) & mask; S->entries[i].ptr != ptr;
+                                                           i = (i + 1) & mask)
+        if (S->entries[i].ptr == NULL)
+            return 0;
+
+    *e = S->entries[i];
+    S->num--;
+    STATS_ADD(_flint_memory_num_tracked, -1);
+
+    /* shift back the entries of the cluster following i */
+    for (j = (i + 1) & mask; S->entries[j].ptr != NULL; j = (j + 1) & mask)
+    {
+        k = _flint_memory_hash(S->entries[j].ptr) & mask;
+
+        if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j)))
+        {
+            S->entries[i] = S->entries[j];
+            i = j;
+        }
+    }
+
+    S->entries[i].ptr = NULL;
+
+    return 1;
+}
+
+static _flint_memory_shard_struct * _flint_memory_shard(const void * ptr)
+{
+    return _flint_memory_shards + (_flint_memory_hash(ptr) >> (FLINT_BITS - 6));
+}
+
+static void _flint_memory_record(void * ptr, size_t size,
+                                              _flint_memory_entry_struct * e)
+{
+    _flint_memory_shard_struct * S = _flint_memory_shard(ptr);
+
+    e->ptr = ptr;
+    e->size = size;
+    e->thread = _flint_memory_get_thread();
+    e->module = _flint_memory_module;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&S->lock);
+#endif
+    _flint_memory_insert(S, e);
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&S->lock);
+#endif
+}
+
+static int _flint_memory_forget(void * ptr, _flint_memory_entry_struct * e)
+{
+    _flint_memory_shard_struct * S = _flint_memory_shard(ptr);
+    int found;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&S->lock);
+#endif
+    found = _flint_memory_remove(S, ptr, e);
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&S->lock);
+#endif
+
+    return found;
+}
+
+static int _flint_memory_lookup(const void * ptr,
+                                              _flint_memory_entry_struct * e)
+{
+    _flint_memory_shard_struct * S = _flint_memory_shard(ptr);
+    ulong mask, i;
+    int found = 0;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&S->lock);
+#endif
+
+    if (S->alloc != 0)
+    {
+        mask = S->alloc - 1;
+
+        for (i = _flint_memory_hash(ptr) & mask; S->entries[i].ptr != NULL;
+                                                          i = (i + 1) & mask)
+        {
+            if (S->entries[i].ptr == ptr)
+            {
+                *e = S->entries[i];
+                found = 1;
+                break;
+            }
+        }
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&S->lock);
+#endif
+
+    return found;
+}
+
+static void _flint_memory_stats_alloc(void * ptr, size_t size)
+{
+    _flint_memory_entry_struct e;
+
+    _flint_memory_record(ptr, size, &e);
+    _flint_memory_charge_entry(&e, size, 1, 0, 0);
+}
+
+static void _flint_memory_stats_free(void * ptr)
+{
+    _flint_memory_entry_struct e;
+
+    if (_flint_memory_forget(ptr, &e))
+        _flint_memory_charge_entry(&e, -(slong) e.size, 0, 0, 1);
+}
+
+/* old is the entry of the previous block, or NULL if it was not tracked */
+static void _flint_memory_stats_realloc(void * ptr, size_t size,
+                                     const _flint_memory_entry_struct * old)
+{
+    _flint_memory_entry_struct e;
+
+    _flint_memory_record(ptr, size, &e);
+
+    if (old != NULL)
+    {
+        /* the block is charged to the reallocating thread from now on */
+        _flint_memory_charge_entry(old, -(slong) old->size, 0, 0, 0);
+        _flint_memory_charge_entry(&e, size, 0, 1, 0);
+    }
+    else
+        _flint_memory_charge_entry(&e, size, 1, 0, 0);
+}
+
+/*
+    aborts if the calling thread would have more than its limit allocated;
+    printing the message needs memory, so the limit is lifted meanwhile and
+    is in force again when the abort handler runs
+*/
+static void _flint_memory_check_limit(slong bytes)
+{
+    _flint_memory_counter_struct * c = _flint_memory_get_thread();
+    slong limit = _flint_memory_limit;
+
+    if (bytes > 0 && c->stats.live + _flint_memory_gmp_live + bytes > limit)
+    {
+        _flint_memory_limit = 0;
+        flint_printf("Exception (FLINT memory_manager). "
+                     "Memory limit of %wd bytes exceeded.\n", limit);
+        fflush(stdout);
+        _flint_memory_limit = limit;
+        flint_abort();
+    }
+}
+
+/*
+    While any thread has a memory limit, the GMP memory functions are
+    replaced by ones which count the bytes each thread holds through GMP
+    towards its limit and pass the calls on to the functions installed
+    before. GMP supplies the size of a block when it is freed, so the
+    blocks need not be recorded; a block freed by another thread than the
+    one which allocated it is credited to the freeing thread, whose count
+    is never made negative.
+*/
+
+static void * (* _flint_gmp_alloc)(size_t);
+static void * (* _flint_gmp_realloc)(void *, size_t, size_t);
+static void (* _flint_gmp_free)(void *, size_t);
+
+static int _flint_gmp_installed = 0;
+static slong _flint_memory_num_limited = 0;
+
+static void _flint_memory_gmp_charge(slong bytes)
+{
+    _flint_memory_gmp_live = FLINT_MAX(_flint_memory_gmp_live + bytes, 0);
+}
+
+static void * _flint_gmp_alloc_func(size_t size)
+{
+    void * ptr;
+
+    if (_flint_memory_limit != 0)
+        _flint_memory_check_limit(size);
+
+    ptr = _flint_gmp_alloc(size);
+    _flint_memory_gmp_charge(size);
+
+    return ptr;
+}
+
+static void * _flint_gmp_realloc_func(void * ptr, size_t old_size,
+                                                              size_t new_size)
+{
+    if (_flint_memory_limit != 0)
+        _flint_memory_check_limit((slong) new_size - (slong) old_size);
+
+    ptr = _flint_gmp_realloc(ptr, old_size, new_size);
+    _flint_memory_gmp_charge((slong) new_size - (slong) old_size);
+
+    return ptr;
+}
+
+static void _flint_gmp_free_func(void * ptr, size_t size)
+{
+    _flint_gmp_free(ptr, size);
+    _flint_memory_gmp_charge(-(slong) size);
+}
+
+/*
+    counts the threads with a limit, installing our GMP functions for the
+    first one and removing them after the last one unless other functions
+    were installed on top of ours, which may pass requests on to them
+*/
+static void _flint_memory_gmp_hook(slong delta)
+{
+    void * (* alloc_func)(size_t);
+    void * (* realloc_func)(void *, size_t, size_t);
+    void (* free_func)(void *, size_t);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&_flint_memory_stats_lock);
+#endif
+
+    _flint_memory_num_limited += delta;
+
+    if (_flint_memory_num_limited != 0 && !_flint_gmp_installed)
+    {
+        mp_get_memory_functions(&_flint_gmp_alloc, &_flint_gmp_realloc,
+                                                            &_flint_gmp_free);
+        mp_set_memory_functions(_flint_gmp_alloc_func,
+                                 _flint_gmp_realloc_func, _flint_gmp_free_func);
+        _flint_gmp_installed = 1;
+    }
+    else if (_flint_memory_num_limited == 0 && _flint_gmp_installed)
+    {
+        mp_get_memory_functions(&alloc_func, &realloc_func, &free_func);
+
+        if (alloc_func == _flint_gmp_alloc_func)
+        {
+            mp_set_memory_functions(_flint_gmp_alloc, _flint_gmp_realloc,
+                                                             _flint_gmp_free);
+            _flint_gmp_installed = 0;
+        }
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&_flint_memory_stats_lock);
+#endif
+}
+
+void flint_set_memory_limit(slong bytes)
+{
+#if FLINT_USES_PTHREAD
+    pthread_once(&_flint_memory_shards_initialised, _flint_memory_shards_init);
+#endif
+
+    bytes = FLINT_MAX(bytes, 0);
+
+    if ((bytes != 0) != (_flint_memory_limit != 0))
+        _flint_memory_gmp_hook(bytes != 0 ? 1 : -1);
+
+    _flint_memory_limit = bytes;
+}
+
+slong flint_get_memory_limit(void)
+{
+    return _flint_memory_limit;
+}
+
+void flint_memory_stats_enable(int enable)
+{
+#if FLINT_USES_PTHREAD
+    pthread_once(&_flint_memory_shards_initialised, _flint_memory_shards_init);
+#endif
+
+    _flint_memory_stats_on = (enable != 0);
+}
+
+int flint_memory_stats_enabled(void)
+{
+    return _flint_memory_stats_on;
+}
+
+void flint_memory_stats_get(flint_memory_stats_t stats)
+{
+    *stats = _flint_memory_get_thread()->stats;
+}
+
+void flint_memory_stats_get_total(flint_memory_stats_t stats)
+{
+    *stats = _flint_memory_global.stats;
+}
+
+void flint_memory_stats_reset(void)
+{
+    _flint_memory_counter_struct * c = _flint_memory_get_thread();
+
+    c->stats.allocs = c->stats.reallocs = c->stats.frees = 0;
+    c->stats.total = 0;
+    c->stats.peak = c->stats.live;
+}
+
+slong flint_memory_stats_module(const char * name)
+{
+    slong i;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&_flint_memory_stats_lock);
+#endif
+
+    for (i = 1; i < _flint_memory_num_modules; i++)
+        if (strcmp(_flint_memory_module_names[i], name) == 0)
+            break;
+
+    if (i == _flint_memory_num_modules)
+    {
+        if (i == FLINT_MEMORY_STATS_MAX_MODULES)
+            i = 0;
+        else
+        {
+            _flint_memory_module_names[i] = malloc(strlen(name) + 1);
+
+            if (_flint_memory_module_names[i] == NULL)
+                flint_memory_error(strlen(name) + 1);
+
+            strcpy(_flint_memory_module_names[i], name);
+            _flint_memory_num_modules++;
+        }
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&_flint_memory_stats_lock);
+#endif
+
+    return i;
+}
+
+static void _flint_memory_check_module(slong module, const char * fn)
+{
+    if (module < 0 || module >= _flint_memory_num_modules)
+    {
+        flint_printf("Exception (%s). Invalid module %wd.\n", fn, module);
+        flint_abort();
+    }
+}
+
+slong flint_memory_stats_set_module(slong module)
+{
+    slong prev = _flint_memory_module;
+
+    _flint_memory_check_module(module, "flint_memory_stats_set_module");
+
+    _flint_memory_module = module;
+
+    return prev;
+}
+
+/*
+    Tag the allocations of a FLINT entry point with the module name, unless
+    statistics are disabled or the caller has already set a module. Returns
+    the module to restore with flint_memory_stats_set_module.
+*/
+slong _flint_memory_stats_enter(const char * name)
+{
+    slong prev = _flint_memory_module;
+
+    if (_flint_memory_stats_on && prev == 0)
+        _flint_memory_module = flint_memory_stats_module(name);
+
+    return prev;
+}
+
+slong _flint_memory_stats_current_module(void)
+{
+    return _flint_memory_module;
+}
+
+void flint_memory_stats_get_module(flint_memory_stats_t stats, slong module)
+{
+    _flint_memory_check_module(module, "flint_memory_stats_get_module");
+
+    *stats = _flint_memory_modules[module].stats;
+}
+
+void flint_memory_stats_reset_module(slong module)
+{
+    flint_memory_stats_struct * s = &_flint_memory_modules[module].stats;
+
+    _flint_memory_check_module(module, "flint_memory_stats_reset_module");
+
+    s->allocs = s->reallocs = s->frees = 0;
+    s->total = 0;
+    s->peak = s->live;
+}
+
 void __flint_set_memory_functions(void *(*alloc_func) (size_t),
                              void *(*calloc_func) (size_t, size_t),
                              void *(*realloc_func) (void *, size_t),
@@ -88,11 +692,19 @@ void * _flint_malloc(size_t size)
 
 FLINT_WARN_UNUSED void * flint_malloc(size_t size)
 {
-   void * ptr = (*__flint_allocate_func)(size);
+   void * ptr;
+
+   if (_flint_memory_limit != 0)
+        _flint_memory_check_limit(size);
+
+   ptr = (*__flint_allocate_func)(size);
 
    if (ptr == NULL)
         flint_memory_error(size);
 
+   if (MEMORY_TRACKED)
+        _flint_memory_stats_alloc(ptr, size);
+
    return ptr;
 }
 
@@ -113,6 +725,24 @@ void * _flint_realloc(void * ptr, size_t size)
 FLINT_WARN_UNUSED void * flint_realloc(void * ptr, size_t size)
 {
     void * ptr2;
+    _flint_memory_entry_struct old;
+    int found = 0;
+
+    if (_flint_memory_limit != 0)
+    {
+        slong old_size = 0;
+
+        if (ptr && _flint_memory_num_tracked != 0 &&
+                   _flint_memory_lookup(ptr, &old) &&
+                   old.thread == _flint_memory_get_thread())
+            old_size = old.size;
+
+        _flint_memory_check_limit((slong) size - old_size);
+    }
+
+    /* forget ptr first, its address may be reused as soon as it is freed */
+    if (ptr && _flint_memory_num_tracked != 0)
+        found = _flint_memory_forget(ptr, &old);
   
     if (ptr)
       ptr2 = (*__flint_reallocate_func)(ptr, size);
@@ -122,6 +752,11 @@ FLINT_WARN_UNUSED void * flint_realloc(void * ptr, size_t size)
     if (ptr2 == NULL)
         flint_memory_error(size);
 
+    if (MEMORY_TRACKED)
+        _flint_memory_stats_realloc(ptr2, size, found ? &old : NULL);
+    else if (found)
+        _flint_memory_charge_entry(&old, -(slong) old.size, 0, 0, 1);
+
     return ptr2;
 }
 
@@ -142,11 +777,17 @@ FLINT_WARN_UNUSED void * flint_calloc(size_t num, size_t size)
 {
    void * ptr;
 
+    if (_flint_memory_limit != 0)
+        _flint_memory_check_limit(num*size);
+
     ptr = (*__flint_callocate_func)(num, size);
 
     if (ptr == NULL)
         flint_memory_error(size);
 
+    if (MEMORY_TRACKED)
+        _flint_memory_stats_alloc(ptr, num*size);
+
     return ptr;
 }
 
@@ -159,6 +800,9 @@ void _flint_free(void * ptr)
 
 void flint_free(void * ptr)
 {
+   if (ptr && _flint_memory_num_tracked != 0)
+        _flint_memory_stats_free(ptr);
+
    (*__flint_free_func)(ptr);
 }
 
@@ -195,6 +839,8 @@ void flint_register_cleanup_function(flint_cleanup_function_t cleanup_function)
 
 void _fmpz_cleanup();
 
+void n_cleanup_primes(void);
+
 void _flint_cleanup()
 {
     size_t i;
@@ -233,5 +879,6 @@ void flint_cleanup_master()
         thread_pool_clear(global_thread_pool);
         global_thread_pool_initialized = 0;
     }
+    n_cleanup_primes();
     _flint_cleanup();
 }
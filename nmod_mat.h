@@ -200,6 +200,8 @@ _nmod_mat_mul_classical_threaded_pool_op(nmod_mat_t D, const nmod_mat_t C,
 
 FLINT_DLL void nmod_mat_mul_classical_threaded(nmod_mat_t C,
 		                       const nmod_mat_t A, const nmod_mat_t B);
+FLINT_DLL void nmod_mat_mul_blocked(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B);
+
 FLINT_DLL void nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B);
 
 FLINT_DLL void _nmod_mat_mul_classical_op(nmod_mat_t D, const nmod_mat_t C,
@@ -328,16 +330,20 @@ FLINT_DLL void nmod_mat_apply_permutation(nmod_mat_t A, slong * P, slong n);
 FLINT_DLL void nmod_mat_solve_tril(nmod_mat_t X, const nmod_mat_t L, const nmod_mat_t B, int unit);
 FLINT_DLL void nmod_mat_solve_tril_recursive(nmod_mat_t X, const nmod_mat_t L, const nmod_mat_t B, int unit);
 FLINT_DLL void nmod_mat_solve_tril_classical(nmod_mat_t X, const nmod_mat_t L, const nmod_mat_t B, int unit);
+FLINT_DLL void nmod_mat_solve_tril_threaded(nmod_mat_t X, const nmod_mat_t L, const nmod_mat_t B, int unit);
 
 FLINT_DLL void nmod_mat_solve_triu(nmod_mat_t X, const nmod_mat_t U, const nmod_mat_t B, int unit);
 FLINT_DLL void nmod_mat_solve_triu_recursive(nmod_mat_t X, const nmod_mat_t U, const nmod_mat_t B, int unit);
 FLINT_DLL void nmod_mat_solve_triu_classical(nmod_mat_t X, const nmod_mat_t U, const nmod_mat_t B, int unit);
+FLINT_DLL void nmod_mat_solve_triu_threaded(nmod_mat_t X, const nmod_mat_t U, const nmod_mat_t B, int unit);
 
 /* LU decomposition */
 
 FLINT_DLL slong nmod_mat_lu(slong * P, nmod_mat_t A, int rank_check);
 FLINT_DLL slong nmod_mat_lu_classical(slong * P, nmod_mat_t A, int rank_check);
 FLINT_DLL slong nmod_mat_lu_recursive(slong * P, nmod_mat_t A, int rank_check);
+FLINT_DLL slong _nmod_mat_lu_tiled(slong * P, nmod_mat_t A, int rank_check, slong nb);
+FLINT_DLL slong nmod_mat_lu_tiled(slong * P, nmod_mat_t A, int rank_check);
 
 /* Nonsingular solving */
 
@@ -398,6 +404,13 @@ FLINT_DLL void nmod_mat_similarity(nmod_mat_t M, slong r, ulong d);
 /* Cutoff between classical and recursive LU decomposition */
 #define NMOD_MAT_LU_RECURSIVE_CUTOFF 4
 
+/* Cutoff and panel width for the task parallel LU decomposition */
+#define NMOD_MAT_LU_TILED_CUTOFF 256
+#define NMOD_MAT_LU_TILED_BLOCK 128
+
+/* Dimension from which matrices modulo 2 are converted to gf2_mat */
+#define NMOD_MAT_GF2_CUTOFF 16
+
 /*
    Suggested initial modulus size for multimodular algorithms. This should
    be chosen so that we get the most number of bits per cycle
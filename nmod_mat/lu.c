@@ -15,9 +15,16 @@
 #include "ulong_extras.h"
 #include "nmod_vec.h"
 #include "nmod_mat.h"
+#include "thread_support.h"
 
 slong 
 nmod_mat_lu(slong * P, nmod_mat_t A, int rank_check)
 {
+    if (flint_get_num_threads() > 1 && !thread_pool_in_tasks() &&
+        FLINT_MIN(A->r, A->c) >= NMOD_MAT_LU_TILED_CUTOFF)
+    {
+        return nmod_mat_lu_tiled(P, A, rank_check);
+    }
+
     return nmod_mat_lu_recursive(P, A, rank_check);
 }
@@ -0,0 +1,316 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "thread_support.h"
+
+static void
+_apply_permutation(slong * AP, nmod_mat_t A, slong * P,
+    slong n, slong offset)
+{
+    if (n != 0)
+    {
+        mp_ptr * Atmp;
+        slong * APtmp;
+        slong i;
+
+        Atmp = flint_malloc(sizeof(mp_ptr) * n);
+        APtmp = flint_malloc(sizeof(slong) * n);
+
+        for (i = 0; i < n; i++) Atmp[i] = A->rows[P[i] + offset];
+        for (i = 0; i < n; i++) A->rows[i + offset] = Atmp[i];
+
+        for (i = 0; i < n; i++) APtmp[i] = AP[P[i] + offset];
+        for (i = 0; i < n; i++) AP[i + offset] = APtmp[i];
+
+        flint_free(Atmp);
+        flint_free(APtmp);
+    }
+}
+
+/* D -= A*B, using whichever multiplication suits the block */
+static void
+_nmod_mat_submul_block(nmod_mat_t D, const nmod_mat_t A, const nmod_mat_t B)
+{
+    nmod_mat_t T;
+
+    nmod_mat_init(T, A->r, B->c, A->mod.n);
+    nmod_mat_mul(T, A, B);
+    nmod_mat_sub(D, D, T);
+    nmod_mat_clear(T);
+}
+
+typedef struct
+{
+    nmod_mat_struct * A;
+    slong r;            /* rank before the panel */
+    slong r1;           /* rank of the panel */
+    slong c0;           /* first column to update */
+    slong c1;           /* end of the columns to update */
+    slong rows;         /* row block size of the Schur complement update */
+} _lu_update_arg_struct;
+
+typedef struct
+{
+    nmod_mat_struct * A;
+    nmod_mat_struct * L;
+    nmod_mat_struct * U;
+} _lu_submul_arg_struct;
+
+static void
+_lu_submul_worker(void * varg)
+{
+    _lu_submul_arg_struct * arg = (_lu_submul_arg_struct *) varg;
+
+    _nmod_mat_submul_block(arg->A, arg->L, arg->U);
+}
+
+/*
+    Apply the panel with L in columns [r, r + r1) to the columns [c0, c1):
+    the top r1 rows are solved against the unit triangular block, and the
+    rows below get the Schur complement update, split into row blocks.
+*/
+static void
+_lu_update_worker(void * varg)
+{
+    _lu_update_arg_struct * arg = (_lu_update_arg_struct *) varg;
+    nmod_mat_struct * A = arg->A;
+    slong r = arg->r, r1 = arg->r1, m = A->r;
+    slong i, num;
+    nmod_mat_t L11, U12;
+    nmod_mat_struct * L21, * A22;
+    _lu_submul_arg_struct * args;
+    thread_pool_task_group_t G;
+
+    nmod_mat_window_init(L11, A, r, r, r + r1, r + r1);
+    nmod_mat_window_init(U12, A, r, arg->c0, r + r1, arg->c1);
+
+    nmod_mat_solve_tril(U12, L11, U12, 1);
+
+    num = (m - r - r1 + arg->rows - 1)/arg->rows;
+
+    if (num > 0)
+    {
+        L21 = flint_malloc(num*sizeof(nmod_mat_struct));
+        A22 = flint_malloc(num*sizeof(nmod_mat_struct));
+        args = flint_malloc(num*sizeof(_lu_submul_arg_struct));
+
+        thread_pool_task_group_init(G);
+
+        for (i = 0; i < num; i++)
+        {
+            slong start = r + r1 + i*arg->rows;
+            slong stop = FLINT_MIN(m, start + arg->rows);
+
+            nmod_mat_window_init(L21 + i, A, start, r, stop, r + r1);
+            nmod_mat_window_init(A22 + i, A, start, arg->c0, stop, arg->c1);
+
+            args[i].A = A22 + i;
+            args[i].L = L21 + i;
+            args[i].U = U12;
+
+            if (i + 1 < num)
+                thread_pool_spawn(G, _lu_submul_worker, args + i);
+            else
+                _lu_submul_worker(args + i);
+        }
+
+        thread_pool_sync(G);
+        thread_pool_task_group_clear(G);
+
+        for (i = 0; i < num; i++)
+        {
+            nmod_mat_window_clear(L21 + i);
+            nmod_mat_window_clear(A22 + i);
+        }
+
+        flint_free(L21);
+        flint_free(A22);
+        flint_free(args);
+    }
+
+    nmod_mat_window_clear(L11);
+    nmod_mat_window_clear(U12);
+}
+
+typedef struct
+{
+    slong * P;
+    nmod_mat_struct * A;
+    int rank_check;
+    slong nb;
+    slong rank;
+} _lu_tiled_arg_struct;
+
+/* factor the panel A[r:m, c0:c1], leaving its permutation in P1 */
+static slong
+_lu_panel(slong * P1, nmod_mat_t A, slong r, slong c0, slong c1,
+                                                               int rank_check)
+{
+    nmod_mat_t W;
+    slong r1;
+
+    nmod_mat_window_init(W, A, r, c0, A->r, c1);
+    r1 = nmod_mat_lu_recursive(P1, W, rank_check);
+    nmod_mat_window_clear(W);
+
+    return r1;
+}
+
+static void
+_lu_tiled_worker(void * varg)
+{
+    _lu_tiled_arg_struct * arg = (_lu_tiled_arg_struct *) varg;
+    nmod_mat_struct * A = arg->A;
+    slong * P = arg->P;
+    slong m = A->r, n = A->c, nb = arg->nb;
+    slong i, j, r, r1, c0, c1, c2, num;
+    slong * P1, * P2, * T;
+    _lu_update_arg_struct * args;
+    thread_pool_task_group_t G;
+
+    for (i = 0; i < m; i++)
+        P[i] = i;
+
+    P1 = flint_malloc(sizeof(slong) * m);
+    P2 = flint_malloc(sizeof(slong) * m);
+    args = flint_malloc(sizeof(_lu_update_arg_struct)*((n + nb - 1)/nb));
+
+    thread_pool_task_group_init(G);
+
+    r = 0;
+    c0 = 0;
+    c1 = FLINT_MIN(n, nb);
+    r1 = _lu_panel(P1, A, r, c0, c1, arg->rank_check);
+
+    while (1)
+    {
+        if (arg->rank_check && r1 < FLINT_MIN(c1 - c0, m - r))
+        {
+            r = 0;
+            break;
+        }
+
+        _apply_permutation(P, A, P1, m - r, r);
+
+        /* Compress L */
+        if (r != c0)
+        {
+            for (i = 0; i < m - r; i++)
+            {
+                mp_ptr row = A->rows[r + i];
+                for (j = 0; j < FLINT_MIN(i, r1); j++)
+                {
+                    row[r + j] = row[c0 + j];
+                    row[c0 + j] = 0;
+                }
+            }
+        }
+
+        if (c1 == n)
+        {
+            r += r1;
+            break;
+        }
+
+        c2 = FLINT_MIN(n, c1 + nb);
+
+        /*
+            Look-ahead: bring the next panel up to date first, then factor
+            it while the other workers update the remaining columns.
+        */
+        num = 0;
+        if (r1 != 0)
+        {
+            for (j = c1; j < n; j += nb)
+            {
+                args[num].A = A;
+                args[num].r = r;
+                args[num].r1 = r1;
+                args[num].c0 = j;
+                args[num].c1 = FLINT_MIN(n, j + nb);
+                args[num].rows = 4*nb;
+                num++;
+            }
+
+            _lu_update_worker(args + 0);
+
+            for (j = 1; j < num; j++)
+                thread_pool_spawn(G, _lu_update_worker, args + j);
+        }
+
+        r += r1;
+
+        if (r == m)
+        {
+            thread_pool_sync(G);
+            break;
+        }
+
+        r1 = _lu_panel(P2, A, r, c1, c2, arg->rank_check);
+
+        thread_pool_sync(G);
+
+        T = P1;
+        P1 = P2;
+        P2 = T;
+        c0 = c1;
+        c1 = c2;
+    }
+
+    thread_pool_task_group_clear(G);
+
+    flint_free(P1);
+    flint_free(P2);
+    flint_free(args);
+
+    if (arg->rank_check && r < FLINT_MIN(m, n))
+        r = 0;
+
+    arg->rank = r;
+}
+
+slong
+_nmod_mat_lu_tiled(slong * P, nmod_mat_t A, int rank_check, slong nb)
+{
+    _lu_tiled_arg_struct arg;
+
+    if (A->r == 0 || A->c == 0)
+    {
+        slong i;
+
+        for (i = 0; i < A->r; i++)
+            P[i] = i;
+
+        return 0;
+    }
+
+    arg.P = P;
+    arg.A = A;
+    arg.rank_check = rank_check;
+    arg.nb = FLINT_MAX(nb, 1);
+    arg.rank = 0;
+
+    flint_run_tasks(_lu_tiled_worker, &arg, flint_get_num_threads());
+
+    return arg.rank;
+}
+
+slong
+nmod_mat_lu_tiled(slong * P, nmod_mat_t A, int rank_check)
+{
+    return _nmod_mat_lu_tiled(P, A, rank_check, NMOD_MAT_LU_TILED_BLOCK);
+}
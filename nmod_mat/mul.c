@@ -17,11 +17,16 @@
 #include "nmod_mat.h"
 #include "nmod_vec.h"
 #include "thread_support.h"
+#include "gf2_mat.h"
 
 #if FLINT_USES_BLAS
 #include "cblas.h"
 #endif
 
+/* below this dimension packing the operands does not pay off */
+#define NMOD_MAT_MUL_BLOCKED_CUTOFF(n) \
+    ((FLINT_BITS == 32 || (n) <= (UWORD(1) << (FLINT_BITS / 2))) ? 48 : 100)
+
 void
 nmod_mat_mul(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
 {
@@ -32,6 +37,25 @@ nmod_mat_mul(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
     slong cutoff;
     slong flint_num_threads = flint_get_num_threads();
 
+    if (A->mod.n == 2 && min_dim >= NMOD_MAT_GF2_CUTOFF)
+    {
+        gf2_mat_t A2, B2, C2;
+
+        gf2_mat_init(A2, m, k);
+        gf2_mat_init(B2, k, n);
+        gf2_mat_init(C2, m, n);
+
+        gf2_mat_set_nmod_mat(A2, A);
+        gf2_mat_set_nmod_mat(B2, B);
+        gf2_mat_mul(C2, A2, B2);
+        gf2_mat_get_nmod_mat(C, C2);
+
+        gf2_mat_clear(A2);
+        gf2_mat_clear(B2);
+        gf2_mat_clear(C2);
+        return;
+    }
+
 #if FLINT_USES_BLAS
     /*
         tuning is based on several assumptions:
@@ -85,9 +109,16 @@ nmod_mat_mul(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
         cutoff = 200;
 
     if (flint_num_threads > 1)
-	    nmod_mat_mul_classical_threaded(C, A, B);
-    else if (min_dim < cutoff)
+    {
+        if (min_dim >= NMOD_MAT_MUL_BLOCKED_CUTOFF(C->mod.n))
+            nmod_mat_mul_blocked(C, A, B);
+        else
+            nmod_mat_mul_classical_threaded(C, A, B);
+    }
+    else if (min_dim < NMOD_MAT_MUL_BLOCKED_CUTOFF(C->mod.n))
         nmod_mat_mul_classical(C, A, B);
+    else if (min_dim < cutoff)
+        nmod_mat_mul_blocked(C, A, B);
     else
         nmod_mat_mul_strassen(C, A, B);
 }
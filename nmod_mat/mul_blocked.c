@@ -0,0 +1,439 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_vec.h"
+#include "thread_support.h"
+
+#if FLINT_NMOD_VEC_X86
+#include <immintrin.h>
+#endif
+
+/*
+    Cache blocked multiplication in the style of GotoBLAS. C is cut into
+    tiles of MC x NC entries which are handed out to the threads. For each
+    tile and each slice of KC columns of A, the slice of A is packed into
+    panels of MR rows and the slice of B into panels of NR columns, stored
+    so that the micro-kernel reads both sequentially, and the micro-kernel
+    accumulates an MR x NR block of C from a pair of panels in registers.
+    Reduction is delayed until the end of a slice: the kernels keep the sums
+    of the full products, in three limbs in general and in one or two limbs
+    with the SIMD kernels for moduli up to 2^32.
+*/
+
+#define MUL_BLOCKED_MR 4
+#define MUL_BLOCKED_NR 8
+#define MUL_BLOCKED_KC 256
+#define MUL_BLOCKED_MC 64
+#define MUL_BLOCKED_NC 256
+
+/* sums of products of an MR x NR block, three limbs per entry */
+typedef mp_limb_t _acc_t[MUL_BLOCKED_MR*MUL_BLOCKED_NR*3];
+
+static void
+_kernel_generic(mp_limb_t * acc, mp_srcptr Ap, mp_srcptr Bp, slong kc)
+{
+    slong l, r, c;
+
+    /* 2 x 2 blocks of entries with their sums in registers */
+    for (r = 0; r < MUL_BLOCKED_MR; r += 2)
+    {
+        for (c = 0; c < MUL_BLOCKED_NR; c += 2)
+        {
+            mp_limb_t s00[3] = {0, 0, 0}, s01[3] = {0, 0, 0};
+            mp_limb_t s10[3] = {0, 0, 0}, s11[3] = {0, 0, 0};
+            mp_limb_t hi, lo, * s;
+
+            for (l = 0; l < kc; l++)
+            {
+                mp_limb_t a0 = Ap[l*MUL_BLOCKED_MR + r];
+                mp_limb_t a1 = Ap[l*MUL_BLOCKED_MR + r + 1];
+                mp_limb_t b0 = Bp[l*MUL_BLOCKED_NR + c];
+                mp_limb_t b1 = Bp[l*MUL_BLOCKED_NR + c + 1];
+
+                umul_ppmm(hi, lo, a0, b0);
+                add_sssaaaaaa(s00[2], s00[1], s00[0],
+                              s00[2], s00[1], s00[0], 0, hi, lo);
+                umul_ppmm(hi, lo, a0, b1);
+                add_sssaaaaaa(s01[2], s01[1], s01[0],
+                              s01[2], s01[1], s01[0], 0, hi, lo);
+                umul_ppmm(hi, lo, a1, b0);
+                add_sssaaaaaa(s10[2], s10[1], s10[0],
+                              s10[2], s10[1], s10[0], 0, hi, lo);
+                umul_ppmm(hi, lo, a1, b1);
+                add_sssaaaaaa(s11[2], s11[1], s11[0],
+                              s11[2], s11[1], s11[0], 0, hi, lo);
+            }
+
+            s = acc + 3*(r*MUL_BLOCKED_NR + c);
+            s[0] = s00[0]; s[1] = s00[1]; s[2] = s00[2];
+            s[3] = s01[0]; s[4] = s01[1]; s[5] = s01[2];
+            s = acc + 3*((r + 1)*MUL_BLOCKED_NR + c);
+            s[0] = s10[0]; s[1] = s10[1]; s[2] = s10[2];
+            s[3] = s11[0]; s[4] = s11[1]; s[5] = s11[2];
+        }
+    }
+}
+
+#if FLINT_NMOD_VEC_X86
+
+/*
+    For entries below 2^32 the products fit in a limb. If all kc of them
+    fit in a limb they are summed directly, otherwise the low and high
+    halves are summed separately.
+*/
+
+static void
+_acc_from_halves(mp_limb_t * s, mp_limb_t lo, mp_limb_t hi)
+{
+    mp_limb_t s1 = 0, s0 = lo;
+
+    add_ssaaaa(s1, s0, s1, s0, hi >> 32, hi << 32);
+    s[0] = s0;
+    s[1] = s1;
+    s[2] = 0;
+}
+
+static __attribute__((target("avx2"))) void
+_kernel_avx2(mp_limb_t * acc, mp_srcptr Ap, mp_srcptr Bp, slong kc, int split)
+{
+    const __m256i lo32 = _mm256_set1_epi64x(0xffffffff);
+    __m256i lo[MUL_BLOCKED_MR][2], hi[MUL_BLOCKED_MR][2];
+    mp_limb_t t[4], u[4];
+    slong l, r, c, h;
+
+    for (r = 0; r < MUL_BLOCKED_MR; r++)
+        for (h = 0; h < 2; h++)
+            lo[r][h] = hi[r][h] = _mm256_setzero_si256();
+
+    if (split)
+    {
+        for (l = 0; l < kc; l++)
+        {
+            __m256i b0 = _mm256_loadu_si256((const __m256i *) (Bp + 8*l));
+            __m256i b1 = _mm256_loadu_si256((const __m256i *) (Bp + 8*l + 4));
+
+            for (r = 0; r < MUL_BLOCKED_MR; r++)
+            {
+                __m256i a = _mm256_set1_epi64x(Ap[MUL_BLOCKED_MR*l + r]);
+                __m256i p0 = _mm256_mul_epu32(a, b0);
+                __m256i p1 = _mm256_mul_epu32(a, b1);
+
+                lo[r][0] = _mm256_add_epi64(lo[r][0], _mm256_and_si256(p0, lo32));
+                hi[r][0] = _mm256_add_epi64(hi[r][0], _mm256_srli_epi64(p0, 32));
+                lo[r][1] = _mm256_add_epi64(lo[r][1], _mm256_and_si256(p1, lo32));
+                hi[r][1] = _mm256_add_epi64(hi[r][1], _mm256_srli_epi64(p1, 32));
+            }
+        }
+    }
+    else
+    {
+        for (l = 0; l < kc; l++)
+        {
+            __m256i b0 = _mm256_loadu_si256((const __m256i *) (Bp + 8*l));
+            __m256i b1 = _mm256_loadu_si256((const __m256i *) (Bp + 8*l + 4));
+
+            for (r = 0; r < MUL_BLOCKED_MR; r++)
+            {
+                __m256i a = _mm256_set1_epi64x(Ap[MUL_BLOCKED_MR*l + r]);
+
+                lo[r][0] = _mm256_add_epi64(lo[r][0], _mm256_mul_epu32(a, b0));
+                lo[r][1] = _mm256_add_epi64(lo[r][1], _mm256_mul_epu32(a, b1));
+            }
+        }
+    }
+
+    for (r = 0; r < MUL_BLOCKED_MR; r++)
+    {
+        for (h = 0; h < 2; h++)
+        {
+            _mm256_storeu_si256((__m256i *) t, lo[r][h]);
+            _mm256_storeu_si256((__m256i *) u, hi[r][h]);
+
+            for (c = 0; c < 4; c++)
+                _acc_from_halves(acc + 3*(r*MUL_BLOCKED_NR + 4*h + c),
+                                                                 t[c], u[c]);
+        }
+    }
+}
+
+static __attribute__((target("avx512f"))) void
+_kernel_avx512(mp_limb_t * acc, mp_srcptr Ap, mp_srcptr Bp, slong kc, int split)
+{
+    const __m512i lo32 = _mm512_set1_epi64(0xffffffff);
+    __m512i lo[MUL_BLOCKED_MR], hi[MUL_BLOCKED_MR];
+    mp_limb_t t[8], u[8];
+    slong l, r, c;
+
+    for (r = 0; r < MUL_BLOCKED_MR; r++)
+        lo[r] = hi[r] = _mm512_setzero_si512();
+
+    if (split)
+    {
+        for (l = 0; l < kc; l++)
+        {
+            __m512i b = _mm512_loadu_si512((const void *) (Bp + 8*l));
+
+            for (r = 0; r < MUL_BLOCKED_MR; r++)
+            {
+                __m512i p = _mm512_mul_epu32(
+                             _mm512_set1_epi64(Ap[MUL_BLOCKED_MR*l + r]), b);
+
+                lo[r] = _mm512_add_epi64(lo[r], _mm512_and_si512(p, lo32));
+                hi[r] = _mm512_add_epi64(hi[r], _mm512_srli_epi64(p, 32));
+            }
+        }
+    }
+    else
+    {
+        for (l = 0; l < kc; l++)
+        {
+            __m512i b = _mm512_loadu_si512((const void *) (Bp + 8*l));
+
+            for (r = 0; r < MUL_BLOCKED_MR; r++)
+                lo[r] = _mm512_add_epi64(lo[r], _mm512_mul_epu32(
+                            _mm512_set1_epi64(Ap[MUL_BLOCKED_MR*l + r]), b));
+        }
+    }
+
+    for (r = 0; r < MUL_BLOCKED_MR; r++)
+    {
+        _mm512_storeu_si512((void *) t, lo[r]);
+        _mm512_storeu_si512((void *) u, hi[r]);
+
+        for (c = 0; c < 8; c++)
+            _acc_from_halves(acc + 3*(r*MUL_BLOCKED_NR + c), t[c], u[c]);
+    }
+}
+
+#endif
+
+typedef struct
+{
+    mp_ptr * C;
+    mp_ptr const * A;
+    mp_ptr const * B;
+    slong m, k, n;
+    slong tiles_n;              /* tiles per row of tiles */
+    slong num_tiles;
+    volatile slong * next_tile;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t * mutex;
+#endif
+    nmod_t mod;
+    int simd;
+}
+_mul_blocked_arg_t;
+
+static void
+_nmod_mat_mul_blocked_worker(void * varg)
+{
+    _mul_blocked_arg_t * arg = (_mul_blocked_arg_t *) varg;
+    const nmod_t mod = arg->mod;
+    mp_ptr Ap, Bp;
+    _acc_t acc;
+    slong tile, i0, j0, mc, nc, kk, kc, ip, jp, l, r, c, i;
+    int split = 1;
+
+    Ap = flint_malloc(MUL_BLOCKED_MC*MUL_BLOCKED_KC*sizeof(mp_limb_t));
+    Bp = flint_malloc(MUL_BLOCKED_NC*MUL_BLOCKED_KC*sizeof(mp_limb_t));
+
+    if (arg->simd)
+    {
+        /* can KC products be summed in one limb? */
+        mp_limb_t hi, lo;
+        umul_ppmm(hi, lo, mod.n - 1, mod.n - 1);
+        umul_ppmm(hi, lo, lo, MUL_BLOCKED_KC);
+        split = (hi != 0);
+    }
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(arg->mutex);
+#endif
+        tile = *arg->next_tile;
+        *arg->next_tile = tile + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(arg->mutex);
+#endif
+
+        if (tile >= arg->num_tiles)
+            break;
+
+        i0 = (tile / arg->tiles_n)*MUL_BLOCKED_MC;
+        j0 = (tile % arg->tiles_n)*MUL_BLOCKED_NC;
+        mc = FLINT_MIN(MUL_BLOCKED_MC, arg->m - i0);
+        nc = FLINT_MIN(MUL_BLOCKED_NC, arg->n - j0);
+
+        for (i = 0; i < mc; i++)
+            _nmod_vec_zero(arg->C[i0 + i] + j0, nc);
+
+        for (kk = 0; kk < arg->k; kk += kc)
+        {
+            kc = FLINT_MIN(MUL_BLOCKED_KC, arg->k - kk);
+
+            /* pack A[i0 .. i0 + mc, kk .. kk + kc] into row panels */
+            for (ip = 0; ip < mc; ip += MUL_BLOCKED_MR)
+            {
+                mp_ptr P = Ap + ip*kc;
+
+                for (r = 0; r < MUL_BLOCKED_MR; r++)
+                {
+                    if (ip + r < mc)
+                    {
+                        mp_srcptr row = arg->A[i0 + ip + r] + kk;
+                        for (l = 0; l < kc; l++)
+                            P[l*MUL_BLOCKED_MR + r] = row[l];
+                    }
+                    else
+                    {
+                        for (l = 0; l < kc; l++)
+                            P[l*MUL_BLOCKED_MR + r] = 0;
+                    }
+                }
+            }
+
+            /* pack B[kk .. kk + kc, j0 .. j0 + nc] into column panels */
+            for (jp = 0; jp < nc; jp += MUL_BLOCKED_NR)
+            {
+                mp_ptr P = Bp + jp*kc;
+                slong w = FLINT_MIN(MUL_BLOCKED_NR, nc - jp);
+
+                for (l = 0; l < kc; l++)
+                {
+                    mp_srcptr row = arg->B[kk + l] + j0 + jp;
+
+                    for (c = 0; c < w; c++)
+                        P[l*MUL_BLOCKED_NR + c] = row[c];
+                    for ( ; c < MUL_BLOCKED_NR; c++)
+                        P[l*MUL_BLOCKED_NR + c] = 0;
+                }
+            }
+
+            for (ip = 0; ip < mc; ip += MUL_BLOCKED_MR)
+            {
+                for (jp = 0; jp < nc; jp += MUL_BLOCKED_NR)
+                {
+#if FLINT_NMOD_VEC_X86
+                    if (arg->simd == NMOD_VEC_SIMD_AVX512)
+                        _kernel_avx512(acc, Ap + ip*kc, Bp + jp*kc, kc, split);
+                    else if (arg->simd == NMOD_VEC_SIMD_AVX2)
+                        _kernel_avx2(acc, Ap + ip*kc, Bp + jp*kc, kc, split);
+                    else
+#endif
+                        _kernel_generic(acc, Ap + ip*kc, Bp + jp*kc, kc);
+
+                    for (r = 0; r < MUL_BLOCKED_MR && ip + r < mc; r++)
+                    {
+                        mp_ptr row = arg->C[i0 + ip + r] + j0 + jp;
+
+                        for (c = 0; c < MUL_BLOCKED_NR && jp + c < nc; c++)
+                        {
+                            mp_limb_t * s = acc + 3*(r*MUL_BLOCKED_NR + c);
+                            mp_limb_t t;
+
+                            NMOD_RED(t, s[2], mod);
+                            NMOD_RED3(t, t, s[1], s[0], mod);
+                            row[c] = nmod_add(row[c], t, mod);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    flint_free(Ap);
+    flint_free(Bp);
+
+}
+
+void
+nmod_mat_mul_blocked(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
+{
+    _mul_blocked_arg_t * args;
+    thread_pool_handle * threads;
+    slong i, num_threads, tiles_m, tiles_n;
+    volatile slong next_tile = 0;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+
+    if (C == A || C == B)
+    {
+        nmod_mat_t T;
+        nmod_mat_init(T, A->r, B->c, A->mod.n);
+        nmod_mat_mul_blocked(T, A, B);
+        nmod_mat_swap_entrywise(C, T);
+        nmod_mat_clear(T);
+        return;
+    }
+
+    if (A->r == 0 || B->c == 0)
+        return;
+
+    if (A->c == 0)
+    {
+        nmod_mat_zero(C);
+        return;
+    }
+
+    tiles_m = (A->r + MUL_BLOCKED_MC - 1)/MUL_BLOCKED_MC;
+    tiles_n = (B->c + MUL_BLOCKED_NC - 1)/MUL_BLOCKED_NC;
+
+    num_threads = flint_request_threads(&threads,
+                         FLINT_MIN(flint_get_num_threads(), tiles_m*tiles_n));
+
+    args = flint_malloc((num_threads + 1)*sizeof(_mul_blocked_arg_t));
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&mutex, NULL);
+#endif
+
+    for (i = 0; i <= num_threads; i++)
+    {
+        args[i].C = C->rows;
+        args[i].A = A->rows;
+        args[i].B = B->rows;
+        args[i].m = A->r;
+        args[i].k = A->c;
+        args[i].n = B->c;
+        args[i].tiles_n = tiles_n;
+        args[i].num_tiles = tiles_m*tiles_n;
+        args[i].next_tile = &next_tile;
+#if FLINT_USES_PTHREAD
+        args[i].mutex = &mutex;
+#endif
+        args[i].mod = A->mod;
+        args[i].simd = (A->mod.n <= (UWORD(1) << (FLINT_BITS / 2))) ?
+                                     _nmod_vec_simd_level() : NMOD_VEC_SIMD_NONE;
+    }
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wake(global_thread_pool, threads[i], 0,
+                                   _nmod_mat_mul_blocked_worker, &args[i]);
+
+    _nmod_mat_mul_blocked_worker(&args[num_threads]);
+
+    for (i = 0; i < num_threads; i++)
+        thread_pool_wait(global_thread_pool, threads[i]);
+
+    flint_give_back_threads(threads, num_threads);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&mutex);
+#endif
+
+    flint_free(args);
+}
@@ -13,6 +13,7 @@
 #include <gmp.h>
 #include "flint.h"
 #include "nmod_mat.h"
+#include "gf2_mat.h"
 
 slong
 nmod_mat_nullspace(nmod_mat_t X, const nmod_mat_t A)
@@ -26,6 +27,21 @@ nmod_mat_nullspace(nmod_mat_t X, const nmod_mat_t A)
     m = A->r;
     n = A->c;
 
+    if (A->mod.n == 2 && FLINT_MIN(m, n) >= NMOD_MAT_GF2_CUTOFF)
+    {
+        gf2_mat_t A2, X2;
+
+        gf2_mat_init(A2, m, n);
+        gf2_mat_init(X2, X->r, X->c);
+        gf2_mat_set_nmod_mat(A2, A);
+        nullity = gf2_mat_nullspace(X2, A2);
+        gf2_mat_get_nmod_mat(X, X2);
+        gf2_mat_clear(A2);
+        gf2_mat_clear(X2);
+
+        return nullity;
+    }
+
     p = flint_malloc(sizeof(slong) * FLINT_MAX(m, n));
 
     nmod_mat_init_set(tmp, A);
@@ -14,6 +14,7 @@
 #include "flint.h"
 #include "nmod_mat.h"
 #include "perm.h"
+#include "gf2_mat.h"
 
 slong
 _nmod_mat_rref(nmod_mat_t A, slong * pivots_nonpivots, slong * P)
@@ -113,6 +114,19 @@ nmod_mat_rref(nmod_mat_t A)
     if (nmod_mat_is_empty(A))
         return 0;
 
+    if (A->mod.n == 2 && FLINT_MIN(A->r, A->c) >= NMOD_MAT_GF2_CUTOFF)
+    {
+        gf2_mat_t B;
+
+        gf2_mat_init(B, A->r, A->c);
+        gf2_mat_set_nmod_mat(B, A);
+        rank = gf2_mat_rref(B);
+        gf2_mat_get_nmod_mat(A, B);
+        gf2_mat_clear(B);
+
+        return rank;
+    }
+
     if (A->r == 1)
     {
         mp_limb_t c, cinv;
@@ -0,0 +1,102 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    nmod_mat_struct * X;
+    const nmod_mat_struct * U;
+    const nmod_mat_struct * B;
+    int unit;
+} _solve_triu_arg_struct;
+
+static void
+_solve_triu_worker(void * varg)
+{
+    _solve_triu_arg_struct * arg = (_solve_triu_arg_struct *) varg;
+
+    nmod_mat_solve_triu(arg->X, arg->U, arg->B, arg->unit);
+}
+
+/* the columns of B are independent right hand sides */
+static void
+_solve_triu_tasks(void * varg)
+{
+    _solve_triu_arg_struct * arg = (_solve_triu_arg_struct *) varg;
+    _solve_triu_arg_struct * args;
+    nmod_mat_struct * X, * B;
+    slong i, m, chunk, num;
+    thread_pool_task_group_t G;
+
+    m = arg->B->c;
+    chunk = (m + 4*flint_get_num_threads() - 1)/(4*flint_get_num_threads());
+    chunk = FLINT_MAX(chunk, NMOD_MAT_SOLVE_TRI_COLS_CUTOFF);
+    num = (m + chunk - 1)/chunk;
+
+    args = flint_malloc(num*sizeof(_solve_triu_arg_struct));
+    X = flint_malloc(num*sizeof(nmod_mat_struct));
+    B = flint_malloc(num*sizeof(nmod_mat_struct));
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i < num; i++)
+    {
+        slong stop = FLINT_MIN(m, (i + 1)*chunk);
+
+        nmod_mat_window_init(X + i, arg->X, 0, i*chunk, arg->X->r, stop);
+        nmod_mat_window_init(B + i, arg->B, 0, i*chunk, arg->B->r, stop);
+
+        args[i].X = X + i;
+        args[i].U = arg->U;
+        args[i].B = B + i;
+        args[i].unit = arg->unit;
+
+        if (i + 1 < num)
+            thread_pool_spawn(G, _solve_triu_worker, args + i);
+        else
+            _solve_triu_worker(args + i);
+    }
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    for (i = 0; i < num; i++)
+    {
+        nmod_mat_window_clear(X + i);
+        nmod_mat_window_clear(B + i);
+    }
+
+    flint_free(args);
+    flint_free(X);
+    flint_free(B);
+}
+
+void
+nmod_mat_solve_triu_threaded(nmod_mat_t X, const nmod_mat_t U,
+                                                const nmod_mat_t B, int unit)
+{
+    _solve_triu_arg_struct arg;
+
+    if (B->r == 0 || B->c == 0)
+        return;
+
+    arg.X = X;
+    arg.U = U;
+    arg.B = B;
+    arg.unit = unit;
+
+    flint_run_tasks(_solve_triu_tasks, &arg, flint_get_num_threads());
+}
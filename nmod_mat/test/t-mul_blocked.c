@@ -0,0 +1,114 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_vec.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_blocked....");
+    fflush(stdout);
+
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        nmod_mat_t A, B, C, D;
+        mp_limb_t mod;
+        slong m, k, n, bound;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+        _nmod_vec_set_simd_level(n_randint(state, 3));
+
+        /* now and then cross the blocking parameters */
+        bound = n_randint(state, 10) == 0 ? 300 : 40;
+        m = n_randint(state, bound);
+        k = n_randint(state, bound);
+        n = n_randint(state, bound);
+
+        switch (n_randint(state, 5))
+        {
+            case 0:
+                mod = n_randtest_not_zero(state);
+                break;
+            case 1:
+                mod = UWORD_MAX/2 + 1 - n_randbits(state, 4);
+                break;
+            case 2:
+                mod = UWORD_MAX - n_randbits(state, 4);
+                break;
+            case 3:
+                mod = (UWORD(1) << (FLINT_BITS / 2)) - n_randint(state, 3);
+                break;
+            default:
+                mod = n_randint(state, UWORD(1) << (FLINT_BITS / 2)) + 1;
+        }
+
+        nmod_mat_init(A, m, k, mod);
+        nmod_mat_init(B, k, n, mod);
+        nmod_mat_init(C, m, n, mod);
+        nmod_mat_init(D, m, n, mod);
+
+        if (n_randint(state, 2))
+            nmod_mat_randtest(A, state);
+        else
+            nmod_mat_randfull(A, state);
+
+        if (n_randint(state, 2))
+            nmod_mat_randtest(B, state);
+        else
+            nmod_mat_randfull(B, state);
+
+        nmod_mat_randtest(C, state);  /* make sure noise in the output is ok */
+
+        nmod_mat_mul_blocked(C, A, B);
+        nmod_mat_mul_classical(D, A, B);
+
+        if (!nmod_mat_equal(C, D))
+        {
+            flint_printf("FAIL: results not equal\n");
+            flint_printf("m = %wd, k = %wd, n = %wd, mod = %wu\n", m, k, n, mod);
+            abort();
+        }
+
+        /* aliasing */
+        if (m == k && k == n)
+        {
+            nmod_mat_mul_blocked(A, A, B);
+
+            if (!nmod_mat_equal(A, D))
+            {
+                flint_printf("FAIL: aliasing\n");
+                abort();
+            }
+        }
+
+        nmod_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_mat_clear(C);
+        nmod_mat_clear(D);
+    }
+
+    _nmod_vec_set_simd_level(NMOD_VEC_SIMD_AVX512);
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -47,6 +47,9 @@
 #define NMOD_POLY_GCD_CUTOFF  340       /* GCD:  Euclidean -> HGCD          */
 #define NMOD_POLY_SMALL_GCD_CUTOFF 200  /* GCD (small n): Euclidean -> HGCD */
 
+#define NMOD_POLY_BIT_PACK_CHUNK 16384  /* threaded packing: coeffs per task */
+#define NMOD_POLY_KS_THREADED_CUTOFF 32768  /* KS: limbs before threaded FFT  */
+
 NMOD_POLY_INLINE
 slong NMOD_DIVREM_BC_ITCH(slong lenA, slong lenB, nmod_t mod)
 {
@@ -516,11 +519,81 @@ FLINT_DLL void _nmod_poly_bit_pack(mp_ptr res, mp_srcptr poly,
 FLINT_DLL void _nmod_poly_bit_unpack(mp_ptr res, slong len, 
                                   mp_srcptr mpn, flint_bitcnt_t bits, nmod_t mod);
 
+FLINT_DLL void _nmod_poly_bit_pack_threaded(mp_ptr res, mp_srcptr poly,
+                                                 slong len, flint_bitcnt_t bits);
+
+FLINT_DLL void _nmod_poly_bit_unpack_threaded(mp_ptr res, slong len,
+                                  mp_srcptr mpn, flint_bitcnt_t bits, nmod_t mod);
+
 FLINT_DLL void nmod_poly_bit_pack(fmpz_t f, const nmod_poly_t poly,
                    flint_bitcnt_t bit_size);
 
 FLINT_DLL void nmod_poly_bit_unpack(nmod_poly_t poly, const fmpz_t f, flint_bitcnt_t bit_size);
 
+/* Number theoretic transforms  **********************************************/
+
+/*
+    Transforms of length 2^depth over a prime p < 2^62 with 2^depth | p - 1.
+    The table w holds w[h + j] = r_{2h}^j for 0 <= j < h and each power of
+    two h < 2^depth, where r_{2h} is a fixed primitive (2h)-th root of unity,
+    so that each layer of the transform reads its twiddles contiguously. The
+    roots are chosen consistently, so the tables for a smaller depth are a
+    prefix of those for a larger depth.
+*/
+typedef struct
+{
+    nmod_t mod;
+    flint_bitcnt_t depth;
+    mp_srcptr w;
+    mp_srcptr wpre;             /* Shoup precomputations of w */
+    mp_limb_t scale;            /* 2^-depth mod p */
+    mp_limb_t scalepre;
+    mp_ptr alloc;               /* tables owned by this struct, or NULL */
+} nmod_poly_ntt_struct;
+
+typedef nmod_poly_ntt_struct nmod_poly_ntt_t[1];
+
+#define NMOD_POLY_NTT_MAX_PRIMES 3
+#define NMOD_POLY_NTT_MAX_DEPTH 40
+#define NMOD_POLY_NTT_PRIME_BITS 61     /* each prime exceeds 2^61 */
+
+FLINT_DLL extern const mp_limb_t _nmod_poly_ntt_primes[NMOD_POLY_NTT_MAX_PRIMES];
+
+/* _nmod_poly_ntt_tables[i][d] holds the roots of depth d for prime i */
+FLINT_DLL extern FLINT_TLS_PREFIX mp_ptr
+     _nmod_poly_ntt_tables[NMOD_POLY_NTT_MAX_PRIMES][NMOD_POLY_NTT_MAX_DEPTH + 1];
+FLINT_DLL extern FLINT_TLS_PREFIX mp_ptr
+ _nmod_poly_ntt_tables_pre[NMOD_POLY_NTT_MAX_PRIMES][NMOD_POLY_NTT_MAX_DEPTH + 1];
+FLINT_DLL extern FLINT_TLS_PREFIX int
+                        _nmod_poly_ntt_tables_used[NMOD_POLY_NTT_MAX_PRIMES];
+
+FLINT_DLL int _nmod_poly_ntt_init(nmod_poly_ntt_t F, mp_limb_t p,
+                                                        flint_bitcnt_t depth);
+
+FLINT_DLL void _nmod_poly_ntt_init_prime(nmod_poly_ntt_t F, slong i,
+                                                        flint_bitcnt_t depth);
+
+FLINT_DLL void _nmod_poly_ntt_clear(nmod_poly_ntt_t F);
+
+FLINT_DLL void _nmod_poly_ntt_cleanup(void);
+
+FLINT_DLL void _nmod_poly_ntt(mp_ptr a, slong len, const nmod_poly_ntt_t F);
+
+FLINT_DLL void _nmod_poly_intt(mp_ptr a, const nmod_poly_ntt_t F);
+
+FLINT_DLL void _nmod_poly_ntt_mul_pointwise(mp_ptr a, mp_srcptr b,
+                                                     const nmod_poly_ntt_t F);
+
+FLINT_DLL slong _nmod_poly_ntt_num_primes(slong len1, slong len2, nmod_t mod);
+
+FLINT_DLL int _nmod_poly_ntt_profitable(slong len1, slong len2, nmod_t mod);
+
+FLINT_DLL int _nmod_poly_ntt_direct(nmod_poly_ntt_t F, nmod_t mod,
+                                                        flint_bitcnt_t depth);
+
+FLINT_DLL void _nmod_poly_ntt_crt(mp_ptr res, mp_srcptr * r, slong len,
+                                                 slong num_primes, nmod_t mod);
+
 /* Multiplication  ***********************************************************/
 
 FLINT_DLL void _nmod_poly_mul_classical(mp_ptr res, mp_srcptr poly1, slong len1, 
@@ -565,6 +638,56 @@ FLINT_DLL void _nmod_poly_mullow_KS(mp_ptr out, mp_srcptr in1, slong len1,
 FLINT_DLL void nmod_poly_mullow_KS(nmod_poly_t res, const nmod_poly_t poly1, 
                              const nmod_poly_t poly2, flint_bitcnt_t bits, slong n);
 
+FLINT_DLL void _nmod_poly_mullow_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                             mp_srcptr poly2, slong len2, slong n, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mullow_NTT(nmod_poly_t res, const nmod_poly_t poly1,
+                                         const nmod_poly_t poly2, slong n);
+
+FLINT_DLL void _nmod_poly_mul_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                                     mp_srcptr poly2, slong len2, nmod_t mod);
+
+FLINT_DLL void nmod_poly_mul_NTT(nmod_poly_t res,
+                             const nmod_poly_t poly1, const nmod_poly_t poly2);
+
+/*
+    Transforms of a fixed operand poly2 for products with operands of length
+    at most len1. If num_primes is zero the modulus is a transform prime and
+    F[0] is used, if it is negative the NTT is not used at all.
+*/
+typedef struct
+{
+    nmod_t mod;
+    slong len1;
+    slong len2;
+    flint_bitcnt_t depth;
+    slong num_primes;
+    nmod_poly_ntt_struct F[NMOD_POLY_NTT_MAX_PRIMES];
+    mp_ptr b;
+    nmod_poly_t poly2;
+} nmod_poly_mul_precache_struct;
+
+typedef nmod_poly_mul_precache_struct nmod_poly_mul_precache_t[1];
+
+FLINT_DLL void nmod_poly_mul_precache_init(nmod_poly_mul_precache_t pre,
+                                        slong len1, const nmod_poly_t poly2);
+
+FLINT_DLL void nmod_poly_mul_precache_clear(nmod_poly_mul_precache_t pre);
+
+FLINT_DLL void _nmod_poly_mullow_precache(mp_ptr res, mp_srcptr poly1,
+                     slong len1, const nmod_poly_mul_precache_t pre, slong n);
+
+FLINT_DLL void nmod_poly_mullow_precache(nmod_poly_t res,
+       const nmod_poly_t poly1, const nmod_poly_mul_precache_t pre, slong n);
+
+NMOD_POLY_INLINE
+void nmod_poly_mul_precache(nmod_poly_t res, const nmod_poly_t poly1,
+                                          const nmod_poly_mul_precache_t pre)
+{
+    nmod_poly_mullow_precache(res, poly1, pre,
+                                      poly1->length + pre->len2 - 1);
+}
+
 FLINT_DLL void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1, 
                                        mp_srcptr poly2, slong len2, nmod_t mod);
 
@@ -0,0 +1,82 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    mp_ptr res;
+    mp_srcptr poly;
+    slong len;
+    flint_bitcnt_t bits;
+} _bit_pack_arg_struct;
+
+static void _bit_pack_worker(void * varg)
+{
+    _bit_pack_arg_struct * arg = (_bit_pack_arg_struct *) varg;
+
+    _nmod_poly_bit_pack(arg->res, arg->poly, arg->len, arg->bits);
+}
+
+static void _bit_pack_tasks(void * varg)
+{
+    _bit_pack_arg_struct * arg = (_bit_pack_arg_struct *) varg;
+    _bit_pack_arg_struct * args;
+    slong i, chunk, num;
+    thread_pool_task_group_t G;
+
+    /* chunks start at a limb boundary, so they write disjoint limbs */
+    chunk = FLINT_BITS/n_gcd(arg->bits, FLINT_BITS);
+    chunk *= (NMOD_POLY_BIT_PACK_CHUNK + chunk - 1)/chunk;
+    num = (arg->len + chunk - 1)/chunk;
+
+    args = (_bit_pack_arg_struct *)
+                               flint_malloc(num*sizeof(_bit_pack_arg_struct));
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i < num; i++)
+    {
+        args[i].res = arg->res + (i*chunk*arg->bits)/FLINT_BITS;
+        args[i].poly = arg->poly + i*chunk;
+        args[i].len = FLINT_MIN(chunk, arg->len - i*chunk);
+        args[i].bits = arg->bits;
+
+        if (i + 1 < num)
+            thread_pool_spawn(G, _bit_pack_worker, args + i);
+        else
+            _bit_pack_worker(args + i);
+    }
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    flint_free(args);
+}
+
+void _nmod_poly_bit_pack_threaded(mp_ptr res, mp_srcptr poly, slong len,
+                                                          flint_bitcnt_t bits)
+{
+    _bit_pack_arg_struct arg;
+
+    arg.res = res;
+    arg.poly = poly;
+    arg.len = len;
+    arg.bits = bits;
+
+    if (len < 2*NMOD_POLY_BIT_PACK_CHUNK || flint_get_num_threads() == 1)
+        _bit_pack_worker(&arg);
+    else
+        flint_run_tasks(_bit_pack_tasks, &arg, flint_get_num_threads());
+}
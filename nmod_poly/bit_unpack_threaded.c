@@ -0,0 +1,85 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    mp_ptr res;
+    slong len;
+    mp_srcptr mpn;
+    flint_bitcnt_t bits;
+    nmod_t mod;
+} _bit_unpack_arg_struct;
+
+static void _bit_unpack_worker(void * varg)
+{
+    _bit_unpack_arg_struct * arg = (_bit_unpack_arg_struct *) varg;
+
+    _nmod_poly_bit_unpack(arg->res, arg->len, arg->mpn, arg->bits, arg->mod);
+}
+
+static void _bit_unpack_tasks(void * varg)
+{
+    _bit_unpack_arg_struct * arg = (_bit_unpack_arg_struct *) varg;
+    _bit_unpack_arg_struct * args;
+    slong i, chunk, num;
+    thread_pool_task_group_t G;
+
+    /* chunks start at a limb boundary */
+    chunk = FLINT_BITS/n_gcd(arg->bits, FLINT_BITS);
+    chunk *= (NMOD_POLY_BIT_PACK_CHUNK + chunk - 1)/chunk;
+    num = (arg->len + chunk - 1)/chunk;
+
+    args = (_bit_unpack_arg_struct *)
+                             flint_malloc(num*sizeof(_bit_unpack_arg_struct));
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i < num; i++)
+    {
+        args[i].res = arg->res + i*chunk;
+        args[i].len = FLINT_MIN(chunk, arg->len - i*chunk);
+        args[i].mpn = arg->mpn + (i*chunk*arg->bits)/FLINT_BITS;
+        args[i].bits = arg->bits;
+        args[i].mod = arg->mod;
+
+        if (i + 1 < num)
+            thread_pool_spawn(G, _bit_unpack_worker, args + i);
+        else
+            _bit_unpack_worker(args + i);
+    }
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    flint_free(args);
+}
+
+void _nmod_poly_bit_unpack_threaded(mp_ptr res, slong len, mp_srcptr mpn,
+                                              flint_bitcnt_t bits, nmod_t mod)
+{
+    _bit_unpack_arg_struct arg;
+
+    arg.res = res;
+    arg.len = len;
+    arg.mpn = mpn;
+    arg.bits = bits;
+    arg.mod = mod;
+
+    if (len < 2*NMOD_POLY_BIT_PACK_CHUNK || flint_get_num_threads() == 1)
+        _bit_unpack_worker(&arg);
+    else
+        flint_run_tasks(_bit_unpack_tasks, &arg, flint_get_num_threads());
+}
@@ -32,6 +32,10 @@ void _nmod_poly_mul(mp_ptr res, mp_srcptr poly1, slong len1,
 
     if (3 * cutoff_len < 2 * FLINT_MAX(bits, 10))
         _nmod_poly_mul_classical(res, poly1, len1, poly2, len2, mod);
+#if FLINT64
+    else if (_nmod_poly_ntt_profitable(len1, len2, mod))
+        _nmod_poly_mul_NTT(res, poly1, len1, poly2, len2, mod);
+#endif
     else if (cutoff_len * bits < 800)
         _nmod_poly_mul_KS(res, poly1, len1, poly2, len2, 0, mod);
     else if (cutoff_len * (bits + 1) * (bits + 1) < 100000)
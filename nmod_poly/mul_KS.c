@@ -15,6 +15,7 @@
 #include "flint.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
+#include "fft.h"
 
 void
 _nmod_poly_mul_KS(mp_ptr out, mp_srcptr in1, slong len1,
@@ -54,16 +55,19 @@ _nmod_poly_mul_KS(mp_ptr out, mp_srcptr in1, slong len1,
     mpn1 = tmp + limbs1 + limbs2;
     mpn2 = squaring ? mpn1 : (mpn1 + limbs1);
 
-    _nmod_poly_bit_pack(mpn1, in1, len1, bits);
+    _nmod_poly_bit_pack_threaded(mpn1, in1, len1, bits);
     if (!squaring)
-        _nmod_poly_bit_pack(mpn2, in2, len2, bits);
+        _nmod_poly_bit_pack_threaded(mpn2, in2, len2, bits);
 
-    if (squaring)
+    /* the FLINT FFT is threaded, the GMP multiplication is not */
+    if (limbs2 >= NMOD_POLY_KS_THREADED_CUTOFF && flint_get_num_threads() > 1)
+        flint_mpn_mul_fft_main(res, mpn1, limbs1, mpn2, limbs2);
+    else if (squaring)
         mpn_sqr(res, mpn1, limbs1);
     else
         mpn_mul(res, mpn1, limbs1, mpn2, limbs2);
 
-    _nmod_poly_bit_unpack(out, len_out, res, bits, mod);
+    _nmod_poly_bit_unpack_threaded(out, len_out, res, bits, mod);
 
     TMP_END;
 }
@@ -34,6 +34,10 @@ void _nmod_poly_mullow(mp_ptr res, mp_srcptr poly1, slong len1,
 
     if (n < 10 + bits * bits / 10)
         _nmod_poly_mullow_classical(res, poly1, len1, poly2, len2, n, mod);
+#if FLINT64
+    else if (_nmod_poly_ntt_profitable(len1, len2, mod))
+        _nmod_poly_mullow_NTT(res, poly1, len1, poly2, len2, n, mod);
+#endif
     else
         _nmod_poly_mullow_KS(res, poly1, len1, poly2, len2, 0, n, mod);
 }
@@ -0,0 +1,284 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "thread_support.h"
+
+/* products of at least this depth are split into tasks */
+#define NTT_MULLOW_TASK_DEPTH 15
+
+/* CRT is done in tasks of this many coefficients */
+#define NTT_MULLOW_CRT_CHUNK (WORD(1) << 13)
+
+/* load poly into a, reduced modulo the transform prime */
+static void _ntt_load(mp_ptr a, mp_srcptr poly, slong len,
+                                          nmod_t mod, const nmod_poly_ntt_t F)
+{
+    slong i;
+
+    if (mod.n <= F->mod.n)
+        flint_mpn_copyi(a, poly, len);
+    else
+        for (i = 0; i < len; i++)
+            NMOD_RED(a[i], poly[i], F->mod);
+}
+
+typedef struct
+{
+    mp_ptr a;
+    mp_srcptr poly;
+    slong len;
+    nmod_t mod;
+    const nmod_poly_ntt_struct * F;
+} _ntt_transform_arg_struct;
+
+static void _ntt_transform_worker(void * varg)
+{
+    _ntt_transform_arg_struct * arg = (_ntt_transform_arg_struct *) varg;
+
+    _ntt_load(arg->a, arg->poly, arg->len, arg->mod, arg->F);
+    _nmod_poly_ntt(arg->a, arg->len, arg->F);
+}
+
+typedef struct
+{
+    mp_ptr a;
+    mp_srcptr poly1;
+    slong len1;
+    mp_srcptr poly2;
+    slong len2;
+    int squaring;
+    nmod_t mod;
+    const nmod_poly_ntt_struct * F;
+} _ntt_product_arg_struct;
+
+/* a = poly1*poly2 modulo the transform prime and x^N - 1 */
+static void _ntt_product_worker(void * varg)
+{
+    _ntt_product_arg_struct * arg = (_ntt_product_arg_struct *) varg;
+    _ntt_transform_arg_struct targ;
+    thread_pool_task_group_t G;
+    const nmod_poly_ntt_struct * F = arg->F;
+    mp_ptr b;
+
+    if (arg->squaring)
+    {
+        _ntt_load(arg->a, arg->poly1, arg->len1, arg->mod, F);
+        _nmod_poly_ntt(arg->a, arg->len1, F);
+        _nmod_poly_ntt_mul_pointwise(arg->a, arg->a, F);
+    }
+    else
+    {
+        b = _nmod_vec_init(WORD(1) << F->depth);
+
+        targ.a = b;
+        targ.poly = arg->poly2;
+        targ.len = arg->len2;
+        targ.mod = arg->mod;
+        targ.F = F;
+
+        thread_pool_task_group_init(G);
+        thread_pool_spawn(G, _ntt_transform_worker, &targ);
+
+        _ntt_load(arg->a, arg->poly1, arg->len1, arg->mod, F);
+        _nmod_poly_ntt(arg->a, arg->len1, F);
+
+        thread_pool_sync(G);
+        thread_pool_task_group_clear(G);
+
+        _nmod_poly_ntt_mul_pointwise(arg->a, b, F);
+
+        _nmod_vec_clear(b);
+    }
+
+    _nmod_poly_intt(arg->a, F);
+}
+
+typedef struct
+{
+    mp_ptr res;
+    mp_srcptr r[NMOD_POLY_NTT_MAX_PRIMES];
+    slong len;
+    slong num_primes;
+    nmod_t mod;
+} _ntt_crt_arg_struct;
+
+static void _ntt_crt_worker(void * varg)
+{
+    _ntt_crt_arg_struct * arg = (_ntt_crt_arg_struct *) varg;
+
+    _nmod_poly_ntt_crt(arg->res, arg->r, arg->len, arg->num_primes, arg->mod);
+}
+
+typedef struct
+{
+    mp_ptr res;
+    mp_srcptr poly1;
+    slong len1;
+    mp_srcptr poly2;
+    slong len2;
+    slong n;
+    nmod_t mod;
+    slong num_primes;
+    flint_bitcnt_t depth;
+} _ntt_mullow_arg_struct;
+
+static void _ntt_mullow_worker(void * varg)
+{
+    _ntt_mullow_arg_struct * arg = (_ntt_mullow_arg_struct *) varg;
+    slong i, j, n = arg->n, N, num_primes = arg->num_primes, num_chunks;
+    int squaring;
+    mp_ptr t;
+    nmod_poly_ntt_t F[NMOD_POLY_NTT_MAX_PRIMES];
+    _ntt_product_arg_struct pargs[NMOD_POLY_NTT_MAX_PRIMES];
+    _ntt_crt_arg_struct * cargs;
+    thread_pool_task_group_t G;
+
+    N = WORD(1) << arg->depth;
+    squaring = (arg->poly1 == arg->poly2 && arg->len1 == arg->len2);
+
+    /* multiply directly when the modulus is a suitable prime */
+    if (_nmod_poly_ntt_direct(F[0], arg->mod, arg->depth))
+        num_primes = 0;
+    else
+        for (i = 0; i < num_primes; i++)
+            _nmod_poly_ntt_init_prime(F[i], i, arg->depth);
+
+    t = _nmod_vec_init(FLINT_MAX(num_primes, 1)*N);
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i < FLINT_MAX(num_primes, 1); i++)
+    {
+        pargs[i].a = t + i*N;
+        pargs[i].poly1 = arg->poly1;
+        pargs[i].len1 = arg->len1;
+        pargs[i].poly2 = arg->poly2;
+        pargs[i].len2 = arg->len2;
+        pargs[i].squaring = squaring;
+        pargs[i].mod = arg->mod;
+        pargs[i].F = F[i];
+
+        if (i + 1 < num_primes)
+            thread_pool_spawn(G, _ntt_product_worker, pargs + i);
+        else
+            _ntt_product_worker(pargs + i);
+    }
+
+    thread_pool_sync(G);
+
+    if (num_primes == 0)
+    {
+        flint_mpn_copyi(arg->res, t, n);
+        _nmod_poly_ntt_clear(F[0]);
+    }
+    else
+    {
+        num_chunks = (n + NTT_MULLOW_CRT_CHUNK - 1)/NTT_MULLOW_CRT_CHUNK;
+        cargs = (_ntt_crt_arg_struct *)
+                         flint_malloc(num_chunks*sizeof(_ntt_crt_arg_struct));
+
+        for (j = 0; j < num_chunks; j++)
+        {
+            slong start = j*NTT_MULLOW_CRT_CHUNK;
+
+            cargs[j].res = arg->res + start;
+            for (i = 0; i < num_primes; i++)
+                cargs[j].r[i] = t + i*N + start;
+            cargs[j].len = FLINT_MIN(n - start, NTT_MULLOW_CRT_CHUNK);
+            cargs[j].num_primes = num_primes;
+            cargs[j].mod = arg->mod;
+
+            if (j + 1 < num_chunks)
+                thread_pool_spawn(G, _ntt_crt_worker, cargs + j);
+            else
+                _ntt_crt_worker(cargs + j);
+        }
+
+        thread_pool_sync(G);
+
+        flint_free(cargs);
+
+        for (i = 0; i < num_primes; i++)
+            _nmod_poly_ntt_clear(F[i]);
+    }
+
+    thread_pool_task_group_clear(G);
+
+    _nmod_vec_clear(t);
+}
+
+void _nmod_poly_mullow_NTT(mp_ptr res, mp_srcptr poly1, slong len1,
+                              mp_srcptr poly2, slong len2, slong n, nmod_t mod)
+{
+    _ntt_mullow_arg_struct arg;
+
+    len1 = FLINT_MIN(len1, n);
+    len2 = FLINT_MIN(len2, n);
+
+    arg.res = res;
+    arg.poly1 = poly1;
+    arg.len1 = len1;
+    arg.poly2 = poly2;
+    arg.len2 = len2;
+    arg.n = n;
+    arg.mod = mod;
+    arg.depth = FLINT_CLOG2(len1 + len2 - 1);
+    arg.num_primes = _nmod_poly_ntt_num_primes(len1, len2, mod);
+
+    if (arg.depth > NMOD_POLY_NTT_MAX_DEPTH || arg.num_primes == 0)
+    {
+        _nmod_poly_mullow_KS(res, poly1, len1, poly2, len2, 0, n, mod);
+        return;
+    }
+
+    if (arg.depth >= NTT_MULLOW_TASK_DEPTH && flint_get_num_threads() > 1)
+        flint_run_tasks(_ntt_mullow_worker, &arg, flint_get_num_threads());
+    else
+        _ntt_mullow_worker(&arg);
+}
+
+void nmod_poly_mullow_NTT(nmod_poly_t res, const nmod_poly_t poly1,
+                                          const nmod_poly_t poly2, slong n)
+{
+    slong len_out;
+
+    if ((poly1->length == 0) || (poly2->length == 0) || n == 0)
+    {
+        nmod_poly_zero(res);
+        return;
+    }
+
+    len_out = poly1->length + poly2->length - 1;
+    if (n > len_out)
+        n = len_out;
+
+    if (res == poly1 || res == poly2)
+    {
+        nmod_poly_t temp;
+        nmod_poly_init2_preinv(temp, poly1->mod.n, poly1->mod.ninv, n);
+        _nmod_poly_mullow_NTT(temp->coeffs, poly1->coeffs, poly1->length,
+                              poly2->coeffs, poly2->length, n, poly1->mod);
+        nmod_poly_swap(res, temp);
+        nmod_poly_clear(temp);
+    }
+    else
+    {
+        nmod_poly_fit_length(res, n);
+        _nmod_poly_mullow_NTT(res->coeffs, poly1->coeffs, poly1->length,
+                              poly2->coeffs, poly2->length, n, poly1->mod);
+    }
+
+    res->length = n;
+    _nmod_poly_normalise(res);
+}
@@ -0,0 +1,225 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "thread_support.h"
+
+/* products of at least this depth are split into tasks */
+#define PRECACHE_TASK_DEPTH 15
+
+/* load poly into a, reduced modulo the transform prime */
+static void _ntt_load(mp_ptr a, mp_srcptr poly, slong len,
+                                   nmod_t mod, const nmod_poly_ntt_struct * F)
+{
+    slong i;
+
+    if (mod.n <= F->mod.n)
+        flint_mpn_copyi(a, poly, len);
+    else
+        for (i = 0; i < len; i++)
+            NMOD_RED(a[i], poly[i], F->mod);
+}
+
+void nmod_poly_mul_precache_init(nmod_poly_mul_precache_t pre,
+                                         slong len1, const nmod_poly_t poly2)
+{
+    slong i, N, num_primes;
+    mp_ptr b;
+
+    pre->mod = poly2->mod;
+    pre->len1 = len1;
+    pre->len2 = poly2->length;
+    pre->num_primes = -1;
+    pre->b = NULL;
+
+    nmod_poly_init_preinv(pre->poly2, poly2->mod.n, poly2->mod.ninv);
+    nmod_poly_set(pre->poly2, poly2);
+
+    if (len1 <= 0 || pre->len2 == 0)
+        return;
+
+    pre->depth = FLINT_CLOG2(len1 + pre->len2 - 1);
+    num_primes = _nmod_poly_ntt_num_primes(len1, pre->len2, pre->mod);
+
+    if (pre->depth > NMOD_POLY_NTT_MAX_DEPTH || num_primes == 0)
+        return;
+
+    if (_nmod_poly_ntt_direct(pre->F, pre->mod, pre->depth))
+        num_primes = 0;
+    else
+        for (i = 0; i < num_primes; i++)
+            _nmod_poly_ntt_init(pre->F + i, _nmod_poly_ntt_primes[i],
+                                                                  pre->depth);
+
+    pre->num_primes = num_primes;
+
+    N = WORD(1) << pre->depth;
+    pre->b = _nmod_vec_init(FLINT_MAX(num_primes, 1)*N);
+
+    for (i = 0; i < FLINT_MAX(num_primes, 1); i++)
+    {
+        b = pre->b + i*N;
+        _ntt_load(b, poly2->coeffs, pre->len2, pre->mod, pre->F + i);
+        _nmod_poly_ntt(b, pre->len2, pre->F + i);
+    }
+}
+
+void nmod_poly_mul_precache_clear(nmod_poly_mul_precache_t pre)
+{
+    slong i;
+
+    if (pre->num_primes >= 0)
+    {
+        for (i = 0; i < FLINT_MAX(pre->num_primes, 1); i++)
+            _nmod_poly_ntt_clear(pre->F + i);
+
+        _nmod_vec_clear(pre->b);
+    }
+
+    nmod_poly_clear(pre->poly2);
+}
+
+typedef struct
+{
+    mp_ptr a;
+    mp_srcptr poly1;
+    slong len1;
+    mp_srcptr b;
+    nmod_t mod;
+    const nmod_poly_ntt_struct * F;
+} _precache_product_arg_struct;
+
+static void _precache_product_worker(void * varg)
+{
+    _precache_product_arg_struct * arg = (_precache_product_arg_struct *) varg;
+
+    _ntt_load(arg->a, arg->poly1, arg->len1, arg->mod, arg->F);
+    _nmod_poly_ntt(arg->a, arg->len1, arg->F);
+    _nmod_poly_ntt_mul_pointwise(arg->a, arg->b, arg->F);
+    _nmod_poly_intt(arg->a, arg->F);
+}
+
+typedef struct
+{
+    mp_ptr res;
+    mp_srcptr poly1;
+    slong len1;
+    const nmod_poly_mul_precache_struct * pre;
+    slong n;
+} _mullow_precache_arg_struct;
+
+static void _mullow_precache_worker(void * varg)
+{
+    _mullow_precache_arg_struct * arg = (_mullow_precache_arg_struct *) varg;
+    const nmod_poly_mul_precache_struct * pre = arg->pre;
+    slong i, N, num = FLINT_MAX(pre->num_primes, 1);
+    _precache_product_arg_struct pargs[NMOD_POLY_NTT_MAX_PRIMES];
+    mp_srcptr r[NMOD_POLY_NTT_MAX_PRIMES];
+    thread_pool_task_group_t G;
+    mp_ptr t;
+
+    N = WORD(1) << pre->depth;
+    t = _nmod_vec_init(num*N);
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i < num; i++)
+    {
+        pargs[i].a = t + i*N;
+        pargs[i].poly1 = arg->poly1;
+        pargs[i].len1 = arg->len1;
+        pargs[i].b = pre->b + i*N;
+        pargs[i].mod = pre->mod;
+        pargs[i].F = pre->F + i;
+        r[i] = t + i*N;
+
+        if (i + 1 < num)
+            thread_pool_spawn(G, _precache_product_worker, pargs + i);
+        else
+            _precache_product_worker(pargs + i);
+    }
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    if (pre->num_primes == 0)
+        flint_mpn_copyi(arg->res, t, arg->n);
+    else
+        _nmod_poly_ntt_crt(arg->res, r, arg->n, pre->num_primes, pre->mod);
+
+    _nmod_vec_clear(t);
+}
+
+void _nmod_poly_mullow_precache(mp_ptr res, mp_srcptr poly1, slong len1,
+                              const nmod_poly_mul_precache_t pre, slong n)
+{
+    _mullow_precache_arg_struct arg;
+
+    /* the transforms cannot be used for this product */
+    if (pre->num_primes < 0 || len1 > pre->len1)
+    {
+        if (len1 >= pre->len2)
+            _nmod_poly_mullow(res, poly1, len1, pre->poly2->coeffs,
+                                                pre->len2, n, pre->mod);
+        else
+            _nmod_poly_mullow(res, pre->poly2->coeffs, pre->len2,
+                                                poly1, len1, n, pre->mod);
+        return;
+    }
+
+    arg.res = res;
+    arg.poly1 = poly1;
+    arg.len1 = FLINT_MIN(len1, n);
+    arg.pre = pre;
+    arg.n = n;
+
+    if (pre->depth >= PRECACHE_TASK_DEPTH && flint_get_num_threads() > 1)
+        flint_run_tasks(_mullow_precache_worker, &arg, flint_get_num_threads());
+    else
+        _mullow_precache_worker(&arg);
+}
+
+void nmod_poly_mullow_precache(nmod_poly_t res, const nmod_poly_t poly1,
+                                const nmod_poly_mul_precache_t pre, slong n)
+{
+    slong len_out;
+
+    if (poly1->length == 0 || pre->len2 == 0 || n <= 0)
+    {
+        nmod_poly_zero(res);
+        return;
+    }
+
+    len_out = poly1->length + pre->len2 - 1;
+    if (n > len_out)
+        n = len_out;
+
+    if (res == poly1)
+    {
+        nmod_poly_t temp;
+        nmod_poly_init2_preinv(temp, pre->mod.n, pre->mod.ninv, n);
+        _nmod_poly_mullow_precache(temp->coeffs, poly1->coeffs,
+                                                   poly1->length, pre, n);
+        nmod_poly_swap(res, temp);
+        nmod_poly_clear(temp);
+    }
+    else
+    {
+        nmod_poly_fit_length(res, n);
+        _nmod_poly_mullow_precache(res->coeffs, poly1->coeffs,
+                                                   poly1->length, pre, n);
+    }
+
+    res->length = n;
+    _nmod_poly_normalise(res);
+}
@@ -0,0 +1,413 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "thread_pool.h"
+
+/*
+    The butterflies follow Harvey, "Faster arithmetic for number-theoretic
+    transforms": twiddles are applied with Shoup's method and values are
+    only reduced lazily, staying in [0, 2p) in the forward transform and in
+    [0, 4p) in the inverse transform. This requires 4p < 2^FLINT_BITS.
+
+    The inverse transform uses r_{2h}^-j = -r_{2h}^(h - j), so that it can
+    share the tables of the forward transform.
+*/
+
+/* transforms of at most this depth are done layer by layer in cache */
+#define NTT_BLOCK_DEPTH 11
+
+/*
+    Inside a task scheduler, transforms of at least this depth run their
+    halves as separate tasks and long loops are split into tasks of
+    NTT_TASK_CHUNK entries.
+*/
+#define NTT_TASK_DEPTH 15
+#define NTT_TASK_CHUNK (WORD(1) << 13)
+
+/* returns w*t mod p in [0, 2p) for any t */
+static __inline__ mp_limb_t _shoup_lazy(mp_limb_t w, mp_limb_t wpre,
+                                                     mp_limb_t t, mp_limb_t p)
+{
+    mp_limb_t q, lo;
+    umul_ppmm(q, lo, wpre, t);
+    return w*t - q*p;
+}
+
+/* a loop over the range [start, stop) that may be split into tasks */
+typedef void (* _ntt_range_fxn)(mp_ptr a, mp_srcptr b, slong h, slong len,
+                         slong start, slong stop, const nmod_poly_ntt_struct * F);
+
+typedef struct
+{
+    _ntt_range_fxn fxn;
+    mp_ptr a;
+    mp_srcptr b;
+    slong h;
+    slong len;
+    slong start;
+    slong stop;
+    const nmod_poly_ntt_struct * F;
+} _ntt_range_arg_struct;
+
+static void _ntt_range_worker(void * varg)
+{
+    _ntt_range_arg_struct * arg = (_ntt_range_arg_struct *) varg;
+
+    arg->fxn(arg->a, arg->b, arg->h, arg->len, arg->start, arg->stop, arg->F);
+}
+
+static void _ntt_range(_ntt_range_fxn fxn, mp_ptr a, mp_srcptr b, slong h,
+                         slong len, slong stop, const nmod_poly_ntt_struct * F)
+{
+    slong i, num;
+    _ntt_range_arg_struct * args;
+    thread_pool_task_group_t G;
+
+    if (stop <= NTT_TASK_CHUNK || !thread_pool_in_tasks())
+    {
+        fxn(a, b, h, len, 0, stop, F);
+        return;
+    }
+
+    num = (stop + NTT_TASK_CHUNK - 1)/NTT_TASK_CHUNK;
+    args = (_ntt_range_arg_struct *)
+                                flint_malloc(num*sizeof(_ntt_range_arg_struct));
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i < num; i++)
+    {
+        args[i].fxn = fxn;
+        args[i].a = a;
+        args[i].b = b;
+        args[i].h = h;
+        args[i].len = len;
+        args[i].start = i*NTT_TASK_CHUNK;
+        args[i].stop = FLINT_MIN(stop, (i + 1)*NTT_TASK_CHUNK);
+        args[i].F = F;
+
+        if (i + 1 < num)
+            thread_pool_spawn(G, _ntt_range_worker, args + i);
+        else
+            _ntt_range_worker(args + i);
+    }
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    flint_free(args);
+}
+
+/*
+    Gentleman-Sande butterflies j in [start, stop) of one layer of half
+    length h over the block a[0, 2h), where only a[0, len) may be nonzero.
+    Inputs and outputs are in [0, 2p).
+*/
+static void _ntt_layer(mp_ptr a, mp_srcptr FLINT_UNUSED(b), slong h, slong len,
+                         slong start, slong stop, const nmod_poly_ntt_struct * F)
+{
+    slong j;
+    mp_limb_t p = F->mod.n, p2 = 2*F->mod.n, x, y, t;
+    mp_srcptr w = F->w + h, wpre = F->wpre + h;
+
+    for (j = start; j < stop && j + h < len; j++)
+    {
+        x = a[j];
+        y = a[j + h];
+        t = x + y;
+        if (t >= p2)
+            t -= p2;
+        a[j] = t;
+        a[j + h] = _shoup_lazy(w[j], wpre[j], x - y + p2, p);
+    }
+
+    /* upper half is zero */
+    for ( ; j < stop; j++)
+        a[j + h] = _shoup_lazy(w[j], wpre[j], a[j], p);
+}
+
+static void _ntt_basecase(mp_ptr a, flint_bitcnt_t k, const nmod_poly_ntt_t F)
+{
+    slong s, j, h, N = WORD(1) << k;
+    mp_limb_t p = F->mod.n, p2 = 2*F->mod.n, x, y, t;
+    mp_srcptr w, wpre;
+
+    for (h = N/2; h > 1; h /= 2)
+    {
+        w = F->w + h;
+        wpre = F->wpre + h;
+
+        for (s = 0; s < N; s += 2*h)
+        {
+            for (j = 0; j < h; j++)
+            {
+                x = a[s + j];
+                y = a[s + j + h];
+                t = x + y;
+                if (t >= p2)
+                    t -= p2;
+                a[s + j] = t;
+                a[s + j + h] = _shoup_lazy(w[j], wpre[j], x - y + p2, p);
+            }
+        }
+    }
+
+    /* last layer has trivial twiddles */
+    if (N > 1)
+    {
+        for (s = 0; s < N; s += 2)
+        {
+            x = a[s];
+            y = a[s + 1];
+            t = x + y;
+            if (t >= p2)
+                t -= p2;
+            a[s] = t;
+            t = x - y + p2;
+            if (t >= p2)
+                t -= p2;
+            a[s + 1] = t;
+        }
+    }
+}
+
+typedef struct
+{
+    mp_ptr a;
+    flint_bitcnt_t k;
+    slong len;
+    const nmod_poly_ntt_struct * F;
+} _ntt_recursive_arg_struct;
+
+static void _ntt_recursive(mp_ptr a, flint_bitcnt_t k, slong len,
+                                                      const nmod_poly_ntt_t F);
+
+static void _ntt_recursive_worker(void * varg)
+{
+    _ntt_recursive_arg_struct * arg = (_ntt_recursive_arg_struct *) varg;
+
+    _ntt_recursive(arg->a, arg->k, arg->len, arg->F);
+}
+
+static void _ntt_recursive(mp_ptr a, flint_bitcnt_t k, slong len,
+                                                      const nmod_poly_ntt_t F)
+{
+    slong h;
+
+    if (len <= 0 || k == 0)
+        return;
+
+    h = WORD(1) << (k - 1);
+
+    if (len == 2*h && k <= NTT_BLOCK_DEPTH)
+    {
+        _ntt_basecase(a, k, F);
+        return;
+    }
+
+    _ntt_range(_ntt_layer, a, NULL, h, len, FLINT_MIN(len, h), F);
+
+    len = FLINT_MIN(len, h);
+
+    if (k >= NTT_TASK_DEPTH && thread_pool_in_tasks())
+    {
+        _ntt_recursive_arg_struct arg;
+        thread_pool_task_group_t G;
+
+        arg.a = a + h;
+        arg.k = k - 1;
+        arg.len = len;
+        arg.F = F;
+
+        thread_pool_task_group_init(G);
+        thread_pool_spawn(G, _ntt_recursive_worker, &arg);
+        _ntt_recursive(a, k - 1, len, F);
+        thread_pool_sync(G);
+        thread_pool_task_group_clear(G);
+    }
+    else
+    {
+        _ntt_recursive(a, k - 1, len, F);
+        _ntt_recursive(a + h, k - 1, len, F);
+    }
+}
+
+/*
+    Forward transform of a[0, len) zero padded to length 2^depth. The output
+    is in bit reversed order with entries in [0, 2p). The inputs must be
+    reduced mod p.
+*/
+void _nmod_poly_ntt(mp_ptr a, slong len, const nmod_poly_ntt_t F)
+{
+    slong N = WORD(1) << F->depth;
+
+    FLINT_ASSERT(len <= N);
+
+    flint_mpn_zero(a + len, N - len);
+
+    if (len == 0)
+        return;
+
+    _ntt_recursive(a, F->depth, len, F);
+}
+
+/*
+    Cooley-Tukey butterflies j in [start, stop) of one layer of half length
+    h over the block a[0, 2h); inputs and outputs are in [0, 4p).
+*/
+static void _intt_layer(mp_ptr a, mp_srcptr FLINT_UNUSED(b), slong h,
+                   slong FLINT_UNUSED(len), slong start, slong stop,
+                                             const nmod_poly_ntt_struct * F)
+{
+    slong j;
+    mp_limb_t p = F->mod.n, p2 = 2*F->mod.n, x, t;
+    mp_srcptr w = F->w + 2*h, wpre = F->wpre + 2*h;
+
+    j = start;
+
+    if (j == 0)
+    {
+        x = a[0];
+        if (x >= p2)
+            x -= p2;
+        t = a[h];
+        if (t >= p2)
+            t -= p2;
+        a[0] = x + t;
+        a[h] = x - t + p2;
+        j++;
+    }
+
+    for ( ; j < stop; j++)
+    {
+        x = a[j];
+        if (x >= p2)
+            x -= p2;
+        t = _shoup_lazy(w[-j], wpre[-j], a[j + h], p);
+        a[j] = x - t + p2;
+        a[j + h] = x + t;
+    }
+}
+
+static void _intt_basecase(mp_ptr a, flint_bitcnt_t k, const nmod_poly_ntt_t F)
+{
+    slong s, h, N = WORD(1) << k;
+
+    for (h = 1; h < N; h *= 2)
+        for (s = 0; s < N; s += 2*h)
+            _intt_layer(a + s, NULL, h, 2*h, 0, h, F);
+}
+
+static void _intt_recursive(mp_ptr a, flint_bitcnt_t k, const nmod_poly_ntt_t F);
+
+static void _intt_recursive_worker(void * varg)
+{
+    _ntt_recursive_arg_struct * arg = (_ntt_recursive_arg_struct *) varg;
+
+    _intt_recursive(arg->a, arg->k, arg->F);
+}
+
+static void _intt_recursive(mp_ptr a, flint_bitcnt_t k, const nmod_poly_ntt_t F)
+{
+    slong h;
+
+    if (k <= NTT_BLOCK_DEPTH)
+    {
+        _intt_basecase(a, k, F);
+        return;
+    }
+
+    h = WORD(1) << (k - 1);
+
+    if (k >= NTT_TASK_DEPTH && thread_pool_in_tasks())
+    {
+        _ntt_recursive_arg_struct arg;
+        thread_pool_task_group_t G;
+
+        arg.a = a + h;
+        arg.k = k - 1;
+        arg.len = h;
+        arg.F = F;
+
+        thread_pool_task_group_init(G);
+        thread_pool_spawn(G, _intt_recursive_worker, &arg);
+        _intt_recursive(a, k - 1, F);
+        thread_pool_sync(G);
+        thread_pool_task_group_clear(G);
+    }
+    else
+    {
+        _intt_recursive(a, k - 1, F);
+        _intt_recursive(a + h, k - 1, F);
+    }
+
+    _ntt_range(_intt_layer, a, NULL, h, 2*h, h, F);
+}
+
+/* reduce a[start, stop) from [0, 4p) to [0, p) */
+static void _intt_reduce(mp_ptr a, mp_srcptr FLINT_UNUSED(b),
+             slong FLINT_UNUSED(h), slong FLINT_UNUSED(len), slong start,
+                               slong stop, const nmod_poly_ntt_struct * F)
+{
+    slong i;
+    mp_limb_t p = F->mod.n, p2 = 2*F->mod.n, x;
+
+    for (i = start; i < stop; i++)
+    {
+        x = a[i];
+        if (x >= p2)
+            x -= p2;
+        if (x >= p)
+            x -= p;
+        a[i] = x;
+    }
+}
+
+/*
+    Inverse transform without the scaling by 2^-depth (which is applied by
+    _nmod_poly_ntt_mul_pointwise). The input is in bit reversed order with
+    entries in [0, 4p); the output is in natural order and reduced mod p.
+*/
+void _nmod_poly_intt(mp_ptr a, const nmod_poly_ntt_t F)
+{
+    slong N = WORD(1) << F->depth;
+
+    _intt_recursive(a, F->depth, F);
+
+    _ntt_range(_intt_reduce, a, NULL, 0, N, N, F);
+}
+
+/* a[start, stop) = a*b/2^depth, inputs in [0, 2p), output in [0, 2p) */
+static void _ntt_pointwise(mp_ptr a, mp_srcptr b, slong FLINT_UNUSED(h),
+             slong FLINT_UNUSED(len), slong start, slong stop,
+                                             const nmod_poly_ntt_struct * F)
+{
+    slong i;
+    mp_limb_t p = F->mod.n, t;
+
+    for (i = start; i < stop; i++)
+    {
+        t = nmod_mul(a[i], b[i], F->mod);
+        a[i] = _shoup_lazy(F->scale, F->scalepre, t, p);
+    }
+}
+
+void _nmod_poly_ntt_mul_pointwise(mp_ptr a, mp_srcptr b,
+                                                      const nmod_poly_ntt_t F)
+{
+    slong N = WORD(1) << F->depth;
+
+    _ntt_range(_ntt_pointwise, a, b, 0, N, N, F);
+}
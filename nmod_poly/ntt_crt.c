@@ -0,0 +1,162 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+/*
+    Primes p = c*2^40 + 1 just below 2^62, in decreasing order. All of them
+    exceed 2^61 and support transforms of length up to 2^40.
+*/
+#if FLINT64
+const mp_limb_t _nmod_poly_ntt_primes[NMOD_POLY_NTT_MAX_PRIMES] = {
+    UWORD(0x3fffc00000000001), UWORD(0x3fffbe0000000001),
+    UWORD(0x3fff840000000001)};
+#else
+const mp_limb_t _nmod_poly_ntt_primes[NMOD_POLY_NTT_MAX_PRIMES] = {0, 0, 0};
+#endif
+
+/*
+    Return the number of primes needed to recover the coefficients of the
+    product of polynomials of length len1 and len2 over Z/nZ from their
+    images, or 0 if this would need more than NMOD_POLY_NTT_MAX_PRIMES.
+*/
+slong _nmod_poly_ntt_num_primes(slong len1, slong len2, nmod_t mod)
+{
+    flint_bitcnt_t bits;
+    slong k;
+
+#if FLINT64
+    bits = 2*FLINT_BIT_COUNT(mod.n - 1)
+                            + FLINT_BIT_COUNT(FLINT_MIN(len1, len2));
+    k = (bits + NMOD_POLY_NTT_PRIME_BITS - 1)/NMOD_POLY_NTT_PRIME_BITS;
+    k = FLINT_MAX(k, WORD(1));
+
+    return k <= NMOD_POLY_NTT_MAX_PRIMES ? k : 0;
+#else
+    return 0;
+#endif
+}
+
+/*
+    Return whether multiplication by the NTT is expected to be faster than
+    Kronecker substitution for polynomials of length len1 >= len2. With c
+    the length used by _nmod_poly_mul to pick between the Kronecker
+    variants, b the bits of the product coefficients and N the transform
+    length, the NTT is used when
+
+       log2(c) + 16 b/(61 k) - 7 N/(len1 + len2) >= 15,
+
+    that is, it gains with the length and with how well the coefficients
+    fill the k primes of 61 bits, and loses with the zero padding of the
+    transforms. The weights were fitted to timings of both methods for
+    balanced products with moduli of 8 to 64 bits and lengths 400 to
+    250000.
+*/
+int _nmod_poly_ntt_profitable(slong len1, slong len2, nmod_t mod)
+{
+    slong c, k, b, N;
+
+    k = _nmod_poly_ntt_num_primes(len1, len2, mod);
+
+    if (k == 0 || FLINT_CLOG2(len1 + len2 - 1) > NMOD_POLY_NTT_MAX_DEPTH)
+        return 0;
+
+    c = FLINT_MIN(len1, 2*len2);
+    b = 2*FLINT_BIT_COUNT(mod.n - 1) + FLINT_BIT_COUNT(len2);
+    N = WORD(1) << FLINT_CLOG2(len1 + len2 - 1);
+
+    return 61*k*(len1 + len2)*(FLINT_BIT_COUNT(c) - WORD(15))
+                                 + 16*b*(len1 + len2) >= 427*k*N;
+}
+
+/*
+    If the modulus is itself a prime supporting transforms of length
+    2^depth, initialise F for it and return 1. Otherwise return 0.
+*/
+int _nmod_poly_ntt_direct(nmod_poly_ntt_t F, nmod_t mod, flint_bitcnt_t depth)
+{
+    flint_bitcnt_t val;
+
+    if (mod.n < 3 || mod.n >= (UWORD(1) << (FLINT_BITS - 2)))
+        return 0;
+
+    count_trailing_zeros(val, mod.n - 1);
+    if (val < depth || !n_is_prime(mod.n))
+        return 0;
+
+    return _nmod_poly_ntt_init(F, mod.n, depth);
+}
+
+/*
+    Set res[i] to the integer with residues r[j][i] modulo the first
+    num_primes of the primes above, reduced modulo mod.n.
+*/
+void _nmod_poly_ntt_crt(mp_ptr res, mp_srcptr * r, slong len,
+                                                 slong num_primes, nmod_t mod)
+{
+    slong i;
+    mp_limb_t t, u, x, y, c12, c123, p1n, p12n, p1p3;
+    nmod_t mod2, mod3;
+
+    if (num_primes == 1)
+    {
+        for (i = 0; i < len; i++)
+            NMOD_RED(res[i], r[0][i], mod);
+        return;
+    }
+
+    nmod_init(&mod2, _nmod_poly_ntt_primes[1]);
+    c12 = n_invmod(_nmod_poly_ntt_primes[0] % mod2.n, mod2.n);
+    NMOD_RED(p1n, _nmod_poly_ntt_primes[0], mod);
+
+    if (num_primes == 2)
+    {
+        for (i = 0; i < len; i++)
+        {
+            NMOD_RED(u, r[0][i], mod2);
+            t = nmod_mul(nmod_sub(r[1][i], u, mod2), c12, mod2);
+
+            NMOD_RED(x, r[0][i], mod);
+            NMOD_RED(t, t, mod);
+            res[i] = nmod_add(x, nmod_mul(p1n, t, mod), mod);
+        }
+        return;
+    }
+
+    FLINT_ASSERT(num_primes == 3);
+
+    nmod_init(&mod3, _nmod_poly_ntt_primes[2]);
+    p1p3 = _nmod_poly_ntt_primes[0] % mod3.n;
+    c123 = n_invmod(nmod_mul(p1p3, _nmod_poly_ntt_primes[1] % mod3.n, mod3),
+                                                                      mod3.n);
+    p12n = nmod_mul(p1n, _nmod_poly_ntt_primes[1] % mod.n, mod);
+
+    for (i = 0; i < len; i++)
+    {
+        /* r[0] + p1*t is the value mod p1*p2 */
+        NMOD_RED(u, r[0][i], mod2);
+        t = nmod_mul(nmod_sub(r[1][i], u, mod2), c12, mod2);
+
+        /* lift to p1*p2*p3 */
+        NMOD_RED(u, r[0][i], mod3);
+        y = nmod_add(u, nmod_mul(p1p3, t, mod3), mod3);
+        u = nmod_mul(nmod_sub(r[2][i], y, mod3), c123, mod3);
+
+        NMOD_RED(x, r[0][i], mod);
+        NMOD_RED(t, t, mod);
+        NMOD_RED(u, u, mod);
+        x = nmod_add(x, nmod_mul(p1n, t, mod), mod);
+        res[i] = nmod_add(x, nmod_mul(p12n, u, mod), mod);
+    }
+}
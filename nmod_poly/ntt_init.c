@@ -0,0 +1,221 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+#if FLINT_REENTRANT && !FLINT_USES_TLS
+#include <pthread.h>
+
+static pthread_once_t ntt_tables_initialised = PTHREAD_ONCE_INIT;
+pthread_mutex_t ntt_tables_lock;
+
+void _nmod_poly_ntt_tables_init()
+{
+   pthread_mutex_init(&ntt_tables_lock, NULL);
+}
+#endif
+
+FLINT_TLS_PREFIX mp_ptr
+      _nmod_poly_ntt_tables[NMOD_POLY_NTT_MAX_PRIMES][NMOD_POLY_NTT_MAX_DEPTH + 1];
+FLINT_TLS_PREFIX mp_ptr
+  _nmod_poly_ntt_tables_pre[NMOD_POLY_NTT_MAX_PRIMES][NMOD_POLY_NTT_MAX_DEPTH + 1];
+FLINT_TLS_PREFIX int _nmod_poly_ntt_tables_used[NMOD_POLY_NTT_MAX_PRIMES];
+
+/* the cached tables are never smaller than this */
+#define NTT_MIN_CACHE_DEPTH 12
+
+/*
+    Return a root of unity of order 2^val modulo p, where 2^val is the
+    largest power of two dividing p - 1. The smallest suitable generator
+    is used so that the same root is found every time.
+*/
+static mp_limb_t _ntt_root(flint_bitcnt_t * val, nmod_t mod)
+{
+    mp_limb_t g, r, v;
+    flint_bitcnt_t i;
+
+    count_trailing_zeros(*val, mod.n - 1);
+
+    for (g = 2; ; g++)
+    {
+        r = nmod_pow_ui(g, (mod.n - 1) >> *val, mod);
+        v = r;
+        for (i = 1; i < *val; i++)
+            v = nmod_mul(v, v, mod);
+        if (v == mod.n - 1)
+            return r;
+    }
+}
+
+/*
+    Fill in layers 2^old_depth <= h < 2^depth of the tables w and wpre,
+    each of which has space for 2^depth entries.
+*/
+static void _ntt_fill_tables(mp_ptr w, mp_ptr wpre, flint_bitcnt_t old_depth,
+                                           flint_bitcnt_t depth, nmod_t mod)
+{
+    slong h, j, top;
+    flint_bitcnt_t val, i;
+    mp_limb_t r;
+
+    if (depth == 0)
+        return;
+
+    if (old_depth == 0)
+    {
+        w[0] = wpre[0] = 0;     /* unused */
+        old_depth = 1;
+    }
+
+    /* primitive root of order 2^depth */
+    r = _ntt_root(&val, mod);
+    for (i = depth; i < val; i++)
+        r = nmod_mul(r, r, mod);
+
+    top = WORD(1) << (depth - 1);
+
+    w[top] = 1;
+    for (j = 1; j < top; j++)
+        w[top + j] = nmod_mul(w[top + j - 1], r, mod);
+
+    for (j = 0; j < top; j++)
+        wpre[top + j] = n_mulmod_precomp_shoup(w[top + j], mod.n);
+
+    /* lower layers use the even powers of the layer above */
+    for (h = top/2; h >= (WORD(1) << (old_depth - 1)) && h > 0; h /= 2)
+    {
+        for (j = 0; j < h; j++)
+        {
+            w[h + j] = w[2*h + 2*j];
+            wpre[h + j] = wpre[2*h + 2*j];
+        }
+    }
+}
+
+static void _ntt_set_scale(nmod_poly_ntt_t F)
+{
+    F->scale = nmod_inv(nmod_pow_ui(2, F->depth, F->mod), F->mod);
+    F->scalepre = n_mulmod_precomp_shoup(F->scale, F->mod.n);
+}
+
+int _nmod_poly_ntt_init(nmod_poly_ntt_t F, mp_limb_t p, flint_bitcnt_t depth)
+{
+    slong N = WORD(1) << depth;
+    flint_bitcnt_t val;
+
+    FLINT_ASSERT(p < (UWORD(1) << (FLINT_BITS - 2)));
+
+    count_trailing_zeros(val, p - 1);
+    if (val < depth)
+        return 0;
+
+    nmod_init(&F->mod, p);
+    F->depth = depth;
+    F->alloc = _nmod_vec_init(2*N);
+    _ntt_fill_tables(F->alloc, F->alloc + N, 0, depth, F->mod);
+    F->w = F->alloc;
+    F->wpre = F->alloc + N;
+    _ntt_set_scale(F);
+
+    return 1;
+}
+
+void _nmod_poly_ntt_init_prime(nmod_poly_ntt_t F, slong i, flint_bitcnt_t depth)
+{
+    int m, used;
+    slong oldN;
+    mp_ptr t, tpre;
+
+    FLINT_ASSERT(depth <= NMOD_POLY_NTT_MAX_DEPTH);
+
+    nmod_init(&F->mod, _nmod_poly_ntt_primes[i]);
+
+#if FLINT_REENTRANT && !FLINT_USES_TLS
+    pthread_once(&ntt_tables_initialised, _nmod_poly_ntt_tables_init);
+    pthread_mutex_lock(&ntt_tables_lock);
+#endif
+
+    used = _nmod_poly_ntt_tables_used[i];
+
+    if (depth >= used)
+    {
+        if (_nmod_poly_ntt_tables_used[0] == 0 &&
+            _nmod_poly_ntt_tables_used[1] == 0 &&
+            _nmod_poly_ntt_tables_used[2] == 0)
+        {
+            flint_register_cleanup_function(_nmod_poly_ntt_cleanup);
+        }
+
+        m = FLINT_MAX(depth, NTT_MIN_CACHE_DEPTH);
+        t = _nmod_vec_init(WORD(1) << m);
+        tpre = _nmod_vec_init(WORD(1) << m);
+
+        /* tables for smaller depths are a prefix of the new ones */
+        if (used > 0)
+        {
+            oldN = WORD(1) << (used - 1);
+            flint_mpn_copyi(t, _nmod_poly_ntt_tables[i][used - 1], oldN);
+            flint_mpn_copyi(tpre, _nmod_poly_ntt_tables_pre[i][used - 1], oldN);
+        }
+
+        _ntt_fill_tables(t, tpre, used > 0 ? used - 1 : 0, m, F->mod);
+
+        /* old tables stay valid for anyone still using them */
+        for ( ; used <= m; used++)
+        {
+            _nmod_poly_ntt_tables[i][used] = t;
+            _nmod_poly_ntt_tables_pre[i][used] = tpre;
+        }
+
+        _nmod_poly_ntt_tables_used[i] = used;
+    }
+
+    F->w = _nmod_poly_ntt_tables[i][depth];
+    F->wpre = _nmod_poly_ntt_tables_pre[i][depth];
+
+#if FLINT_REENTRANT && !FLINT_USES_TLS
+    pthread_mutex_unlock(&ntt_tables_lock);
+#endif
+
+    F->depth = depth;
+    F->alloc = NULL;
+    _ntt_set_scale(F);
+}
+
+void _nmod_poly_ntt_clear(nmod_poly_ntt_t F)
+{
+    if (F->alloc != NULL)
+        _nmod_vec_clear(F->alloc);
+}
+
+void _nmod_poly_ntt_cleanup(void)
+{
+    slong i;
+    int d;
+
+    for (i = 0; i < NMOD_POLY_NTT_MAX_PRIMES; i++)
+    {
+        for (d = 0; d < _nmod_poly_ntt_tables_used[i]; d++)
+        {
+            if (d < _nmod_poly_ntt_tables_used[i] - 1 &&
+                  _nmod_poly_ntt_tables[i][d] == _nmod_poly_ntt_tables[i][d + 1])
+                continue;
+
+            _nmod_vec_clear(_nmod_poly_ntt_tables[i][d]);
+            _nmod_vec_clear(_nmod_poly_ntt_tables_pre[i][d]);
+        }
+
+        _nmod_poly_ntt_tables_used[i] = 0;
+    }
+}
@@ -16,6 +16,7 @@
 #include "nmod_vec.h"
 #include "nmod_poly.h"
 #include "ulong_extras.h"
+#include "thread_support.h"
 
 int
 main(void)
@@ -116,6 +117,46 @@ main(void)
         nmod_poly_clear(c);
     }
 
+#if FLINT_USES_PTHREAD && (FLINT_USES_TLS || FLINT_REENTRANT)
+    /* Check large products with several threads */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a1, a2, b, c;
+        mp_limb_t n = n_randtest_not_zero(state);
+
+        nmod_poly_init(a1, n);
+        nmod_poly_init(a2, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_randtest(b, state, 10000 + n_randint(state, 30000));
+        if (n_randint(state, 4) == 0)
+            nmod_poly_set(c, b);
+        else
+            nmod_poly_randtest(c, state, 10000 + n_randint(state, 30000));
+
+        flint_set_num_threads(1);
+        nmod_poly_mul_KS(a1, b, c, 0);
+
+        flint_set_num_threads(n_randint(state, 5) + 2);
+        nmod_poly_mul_KS(a2, b, c, 0);
+
+        result = (nmod_poly_equal(a1, a2));
+        if (!result)
+        {
+            flint_printf("FAIL (threaded):\n");
+            flint_printf("n = %wu, threads = %wd\n", n, flint_get_num_threads());
+            abort();
+        }
+
+        nmod_poly_clear(a1);
+        nmod_poly_clear(a2);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    flint_set_num_threads(1);
+#endif
+
     FLINT_TEST_CLEANUP(state);
     
     flint_printf("PASS\n");
@@ -0,0 +1,122 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mullow_precache....");
+    fflush(stdout);
+
+    /* Compare with mullow, with and without aliasing */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a1, a2, b, c;
+        nmod_poly_mul_precache_t pre;
+        mp_limb_t n;
+        slong len1, trunc, maxlen;
+
+        if (n_randint(state, 4) == 0)
+            n = UWORD(998244353);
+        else
+            n = n_randtest_not_zero(state);
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        nmod_poly_init(a1, n);
+        nmod_poly_init(a2, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+
+        /* occasionally large enough to be split into tasks */
+        maxlen = (i % 20 == 0) ? 20000 : 2000;
+
+        nmod_poly_randtest(c, state, n_randint(state, maxlen));
+        len1 = n_randint(state, maxlen);
+
+        nmod_poly_mul_precache_init(pre, len1, c);
+
+        /* the operand is copied */
+        nmod_poly_zero(c);
+        nmod_poly_set(c, pre->poly2);
+
+        for (j = 0; j < 4; j++)
+        {
+            if (j == 3)
+                nmod_poly_randtest(b, state, len1 + n_randint(state, 100));
+            else
+                nmod_poly_randtest(b, state, n_randint(state, len1 + 1));
+
+            trunc = n_randint(state, b->length + c->length + 1);
+
+            nmod_poly_mullow(a1, b, c, trunc);
+
+            if (n_randint(state, 2))
+            {
+                nmod_poly_mullow_precache(a2, b, pre, trunc);
+            }
+            else
+            {
+                nmod_poly_set(a2, b);
+                nmod_poly_mullow_precache(a2, a2, pre, trunc);
+            }
+
+            result = (nmod_poly_equal(a1, a2));
+            if (!result)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("n = %wu, len1 = %wd, trunc = %wd\n",
+                                                          n, len1, trunc);
+                nmod_poly_print(a1), flint_printf("\n\n");
+                nmod_poly_print(a2), flint_printf("\n\n");
+                fflush(stdout);
+                abort();
+            }
+
+            nmod_poly_mul(a1, b, c);
+            nmod_poly_mul_precache(a2, b, pre);
+
+            result = (nmod_poly_equal(a1, a2));
+            if (!result)
+            {
+                flint_printf("FAIL (mul):\n");
+                flint_printf("n = %wu, len1 = %wd\n", n, len1);
+                fflush(stdout);
+                abort();
+            }
+        }
+
+        nmod_poly_mul_precache_clear(pre);
+
+        nmod_poly_clear(a1);
+        nmod_poly_clear(a2);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+    }
+
+    flint_set_num_threads(1);
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef NMOD_SPARSE_MAT_H
+#define NMOD_SPARSE_MAT_H
+
+#ifdef NMOD_SPARSE_MAT_INLINES_C
+#define NMOD_SPARSE_MAT_INLINE FLINT_DLL
+#else
+#define NMOD_SPARSE_MAT_INLINE static __inline__
+#endif
+
+#undef ulong
+#define ulong ulongxx /* interferes with system includes */
+#include <stdlib.h>
+#undef ulong
+#include <gmp.h>
+#define ulong mp_limb_t
+
+#include "flint.h"
+#include "longlong.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "nmod_poly.h"
+#include "thread_support.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/*
+    Compressed sparse row storage: the nonzero entries of row i are
+    entries[rows[i]], ..., entries[rows[i + 1] - 1], with the columns
+    cols[rows[i]] < ... < cols[rows[i + 1] - 1].
+*/
+typedef struct
+{
+    mp_ptr entries;
+    slong * cols;
+    slong * rows;
+    slong r;
+    slong c;
+    slong alloc;
+    nmod_t mod;
+}
+nmod_sparse_mat_struct;
+
+typedef nmod_sparse_mat_struct nmod_sparse_mat_t[1];
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_nrows(const nmod_sparse_mat_t M)
+{
+   return M->r;
+}
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_ncols(const nmod_sparse_mat_t M)
+{
+   return M->c;
+}
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_nnz(const nmod_sparse_mat_t M)
+{
+   return M->rows[M->r];
+}
+
+NMOD_SPARSE_MAT_INLINE
+void nmod_sparse_mat_swap(nmod_sparse_mat_t M1, nmod_sparse_mat_t M2)
+{
+    nmod_sparse_mat_struct t = *M1;
+    *M1 = *M2;
+    *M2 = t;
+}
+
+/* Memory management */
+
+FLINT_DLL void nmod_sparse_mat_init(nmod_sparse_mat_t M,
+                                                 slong r, slong c, mp_limb_t n);
+
+FLINT_DLL void nmod_sparse_mat_clear(nmod_sparse_mat_t M);
+
+FLINT_DLL void _nmod_sparse_mat_fit_nnz(nmod_sparse_mat_t M, slong nnz);
+
+FLINT_DLL void nmod_sparse_mat_zero(nmod_sparse_mat_t M);
+
+/* Conversions and entries */
+
+FLINT_DLL void nmod_sparse_mat_set_entries(nmod_sparse_mat_t M,
+               const slong * rows, const slong * cols, mp_srcptr entries,
+                                                                   slong nnz);
+
+FLINT_DLL mp_limb_t nmod_sparse_mat_get_entry(const nmod_sparse_mat_t M,
+                                                             slong i, slong j);
+
+FLINT_DLL void nmod_sparse_mat_set_nmod_mat(nmod_sparse_mat_t M,
+                                                          const nmod_mat_t A);
+
+FLINT_DLL void nmod_sparse_mat_get_nmod_mat(nmod_mat_t A,
+                                                   const nmod_sparse_mat_t M);
+
+FLINT_DLL int nmod_sparse_mat_equal(const nmod_sparse_mat_t M1,
+                                                  const nmod_sparse_mat_t M2);
+
+FLINT_DLL void nmod_sparse_mat_transpose(nmod_sparse_mat_t B,
+                                                   const nmod_sparse_mat_t A);
+
+FLINT_DLL void nmod_sparse_mat_randtest(nmod_sparse_mat_t M,
+                                     flint_rand_t state, slong max_row_nnz);
+
+/* Matrix-vector products */
+
+FLINT_DLL void _nmod_sparse_mat_mul_vec_rows(mp_ptr y,
+              const nmod_sparse_mat_t M, mp_srcptr x, slong start, slong stop);
+
+FLINT_DLL void nmod_sparse_mat_mul_vec(mp_ptr y,
+                                    const nmod_sparse_mat_t M, mp_srcptr x);
+
+/* Black box operators used by the iterative algorithms */
+
+typedef struct
+{
+    const nmod_sparse_mat_struct * A;
+    const nmod_sparse_mat_struct * At;  /* NULL if the operator is A */
+    mp_ptr d1;                          /* column scaling of A */
+    mp_ptr d2;                          /* row scaling of A */
+    mp_ptr t;
+}
+_nmod_sparse_mat_op_struct;
+
+typedef _nmod_sparse_mat_op_struct _nmod_sparse_mat_op_t[1];
+
+FLINT_DLL void _nmod_sparse_mat_op_init(_nmod_sparse_mat_op_t op,
+                               const nmod_sparse_mat_t A,
+                               const nmod_sparse_mat_t At, flint_rand_t state);
+
+FLINT_DLL void _nmod_sparse_mat_op_clear(_nmod_sparse_mat_op_t op);
+
+FLINT_DLL slong _nmod_sparse_mat_op_dim(const _nmod_sparse_mat_op_t op);
+
+FLINT_DLL void _nmod_sparse_mat_op_mul(mp_ptr y,
+                                 const _nmod_sparse_mat_op_t op, mp_srcptr x);
+
+FLINT_DLL void _nmod_sparse_mat_op_minpoly(nmod_poly_t f,
+              const _nmod_sparse_mat_op_t op, mp_srcptr u, mp_srcptr v);
+
+FLINT_DLL int _nmod_sparse_mat_op_nullvector(mp_ptr x,
+        const _nmod_sparse_mat_op_t op, const nmod_poly_t f, mp_srcptr y);
+
+FLINT_DLL void _nmod_sparse_mat_rand_vec(mp_ptr v, slong len, int nonzero,
+                                              flint_rand_t state, nmod_t mod);
+
+/* Linear algebra */
+
+FLINT_DLL slong nmod_sparse_mat_rank(const nmod_sparse_mat_t M);
+
+FLINT_DLL int nmod_sparse_mat_solve_wiedemann(mp_ptr x,
+                                   const nmod_sparse_mat_t M, mp_srcptr b);
+
+FLINT_DLL int nmod_sparse_mat_solve_lanczos(mp_ptr x,
+                                   const nmod_sparse_mat_t M, mp_srcptr b);
+
+FLINT_DLL int nmod_sparse_mat_nullvector(mp_ptr x,
+                                                 const nmod_sparse_mat_t M);
+
+FLINT_DLL slong nmod_sparse_mat_nullspace(nmod_mat_t X,
+                                                 const nmod_sparse_mat_t M);
+
+/* Tuning parameters *********************************************************/
+
+/* Number of nonzero entries above which products are threaded */
+#define NMOD_SPARSE_MAT_MUL_VEC_THREADED_CUTOFF 50000
+
+/* Number of unchanged sequence terms for early termination */
+#define NMOD_SPARSE_MAT_EARLY_TERMINATION 20
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+int
+nmod_sparse_mat_equal(const nmod_sparse_mat_t M1, const nmod_sparse_mat_t M2)
+{
+    slong i, nnz;
+
+    if (M1->r != M2->r || M1->c != M2->c)
+        return 0;
+
+    for (i = 0; i <= M1->r; i++)
+        if (M1->rows[i] != M2->rows[i])
+            return 0;
+
+    nnz = nmod_sparse_mat_nnz(M1);
+
+    for (i = 0; i < nnz; i++)
+        if (M1->cols[i] != M2->cols[i] || M1->entries[i] != M2->entries[i])
+            return 0;
+
+    return 1;
+}
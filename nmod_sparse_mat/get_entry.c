@@ -0,0 +1,37 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+mp_limb_t
+nmod_sparse_mat_get_entry(const nmod_sparse_mat_t M, slong i, slong j)
+{
+    slong lo = M->rows[i], hi = M->rows[i + 1], mid;
+
+    /* binary search for column j in row i */
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo)/2;
+
+        if (M->cols[mid] < j)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo < M->rows[i + 1] && M->cols[lo] == j)
+        return M->entries[lo];
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_init(nmod_sparse_mat_t M, slong r, slong c, mp_limb_t n)
+{
+    M->rows = (slong *) flint_calloc(r + 1, sizeof(slong));
+    M->cols = NULL;
+    M->entries = NULL;
+    M->alloc = 0;
+    M->r = r;
+    M->c = c;
+    nmod_init(&M->mod, n);
+}
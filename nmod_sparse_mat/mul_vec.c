@@ -0,0 +1,150 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+void
+_nmod_sparse_mat_mul_vec_rows(mp_ptr y, const nmod_sparse_mat_t M,
+                                         mp_srcptr x, slong start, slong stop)
+{
+    slong i, k, max_len;
+    mp_srcptr e = M->entries;
+    const slong * c = M->cols;
+    nmod_t mod = M->mod;
+
+    max_len = 0;
+    for (i = start; i < stop; i++)
+        max_len = FLINT_MAX(max_len, M->rows[i + 1] - M->rows[i]);
+
+    if (_nmod_vec_dot_bound_limbs(max_len, mod) <= 1)
+    {
+        for (i = start; i < stop; i++)
+        {
+            mp_limb_t s = 0;
+
+            for (k = M->rows[i]; k < M->rows[i + 1]; k++)
+                s += e[k]*x[c[k]];
+
+            NMOD_RED(y[i], s, mod);
+        }
+    }
+    else
+    {
+        for (i = start; i < stop; i++)
+        {
+            mp_limb_t s0 = 0, s1 = 0, s2 = 0, hi, lo;
+
+            for (k = M->rows[i]; k < M->rows[i + 1]; k++)
+            {
+                umul_ppmm(hi, lo, e[k], x[c[k]]);
+                add_sssaaaaaa(s2, s1, s0, s2, s1, s0, 0, hi, lo);
+            }
+
+            NMOD_RED3(y[i], s2, s1, s0, mod);
+        }
+    }
+}
+
+typedef struct
+{
+    mp_ptr y;
+    const nmod_sparse_mat_struct * M;
+    mp_srcptr x;
+    slong start;
+    slong stop;
+} _mul_vec_arg_struct;
+
+static void
+_mul_vec_worker(void * varg)
+{
+    _mul_vec_arg_struct * arg = (_mul_vec_arg_struct *) varg;
+
+    _nmod_sparse_mat_mul_vec_rows(arg->y, arg->M, arg->x,
+                                                       arg->start, arg->stop);
+}
+
+/* first row whose entries start at or after position k */
+static slong
+_row_of_position(const nmod_sparse_mat_t M, slong k)
+{
+    slong lo = 0, hi = M->r, mid;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo)/2;
+
+        if (M->rows[mid] < k)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+static void
+_mul_vec_tasks(void * varg)
+{
+    _mul_vec_arg_struct * arg = (_mul_vec_arg_struct *) varg;
+    _mul_vec_arg_struct * args;
+    slong i, num, nnz;
+    thread_pool_task_group_t G;
+
+    /* chunks with about the same number of entries */
+    nnz = nmod_sparse_mat_nnz(arg->M);
+    num = 4*flint_get_num_threads();
+
+    args = (_mul_vec_arg_struct *) flint_malloc(num*sizeof(_mul_vec_arg_struct));
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i < num; i++)
+    {
+        args[i].y = arg->y;
+        args[i].M = arg->M;
+        args[i].x = arg->x;
+        args[i].start = (i == 0) ? 0 : args[i - 1].stop;
+        args[i].stop = (i + 1 == num) ? arg->M->r :
+                                 _row_of_position(arg->M, (i + 1)*(nnz/num));
+        args[i].stop = FLINT_MAX(args[i].stop, args[i].start);
+
+        if (i + 1 < num)
+            thread_pool_spawn(G, _mul_vec_worker, args + i);
+        else
+            _mul_vec_worker(args + i);
+    }
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    flint_free(args);
+}
+
+void
+nmod_sparse_mat_mul_vec(mp_ptr y, const nmod_sparse_mat_t M, mp_srcptr x)
+{
+    _mul_vec_arg_struct arg;
+
+    arg.y = y;
+    arg.M = M;
+    arg.x = x;
+    arg.start = 0;
+    arg.stop = M->r;
+
+    if (nmod_sparse_mat_nnz(M) < NMOD_SPARSE_MAT_MUL_VEC_THREADED_CUTOFF ||
+                                                  flint_get_num_threads() == 1)
+        _mul_vec_worker(&arg);
+    else
+        flint_run_tasks(_mul_vec_tasks, &arg, flint_get_num_threads());
+}
@@ -0,0 +1,135 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_sparse_mat.h"
+
+/*
+    Random kernel vectors are computed from a single minimal polynomial
+    and reduced against the basis found so far, which is kept in echelon
+    form with basis[k][piv[k]] = 1 and basis[k][piv[j]] = 0 for j < k.
+    The nullity is taken from nmod_sparse_mat_rank.
+*/
+slong
+nmod_sparse_mat_nullspace(nmod_mat_t X, const nmod_sparse_mat_t M)
+{
+    slong i, j, k, n = M->c, nullity, failures;
+    nmod_t mod = M->mod;
+    _nmod_sparse_mat_op_t op;
+    nmod_sparse_mat_t Mt;
+    flint_rand_t state;
+    nmod_poly_t f;
+    nmod_mat_t T;
+    mp_ptr u, y, x, * basis;
+    slong * piv;
+    int have_f = 0;
+
+    nullity = n - nmod_sparse_mat_rank(M);
+
+    basis = (mp_ptr *) flint_malloc(FLINT_MAX(nullity, 1)*sizeof(mp_ptr));
+    piv = (slong *) flint_malloc(FLINT_MAX(nullity, 1)*sizeof(slong));
+
+    if (nmod_sparse_mat_nnz(M) == 0)
+    {
+        for (k = 0; k < nullity; k++)
+        {
+            basis[k] = _nmod_vec_init(n);
+            _nmod_vec_zero(basis[k], n);
+            basis[k][k] = 1;
+        }
+    }
+    else if (nullity > 0)
+    {
+        flint_randinit(state);
+        nmod_poly_init_mod(f, mod);
+        nmod_sparse_mat_init(Mt, M->c, M->r, mod.n);
+        nmod_sparse_mat_transpose(Mt, M);
+        u = _nmod_vec_init(n);
+        y = _nmod_vec_init(n);
+        x = _nmod_vec_init(n);
+
+        _nmod_sparse_mat_op_init(op, M, Mt, state);
+
+        k = 0;
+        failures = 0;
+        while (k < nullity && failures < 8)
+        {
+            /* compute a new minimal polynomial after each failure */
+            if (!have_f)
+            {
+                _nmod_sparse_mat_rand_vec(u, n, 0, state, mod);
+                _nmod_sparse_mat_rand_vec(y, n, 0, state, mod);
+                _nmod_sparse_mat_op_minpoly(f, op, u, y);
+                have_f = 1;
+            }
+
+            _nmod_sparse_mat_rand_vec(y, n, 0, state, mod);
+
+            if (!_nmod_sparse_mat_op_nullvector(x, op, f, y))
+            {
+                failures++;
+                have_f = 0;
+                continue;
+            }
+
+            for (j = 0; j < k; j++)
+                if (x[piv[j]] != 0)
+                    _nmod_vec_scalar_addmul_nmod(x, basis[j], n,
+                                                 nmod_neg(x[piv[j]], mod), mod);
+
+            for (i = 0; i < n && x[i] == 0; i++) ;
+
+            if (i == n)
+            {
+                failures++;
+                have_f = 0;
+                continue;
+            }
+
+            piv[k] = i;
+            basis[k] = _nmod_vec_init(n);
+            _nmod_vec_scalar_mul_nmod(basis[k], x, n, nmod_inv(x[i], mod), mod);
+            k++;
+            failures = 0;
+        }
+
+        nullity = k;
+
+        _nmod_sparse_mat_op_clear(op);
+        _nmod_vec_clear(u);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(x);
+        nmod_sparse_mat_clear(Mt);
+        nmod_poly_clear(f);
+        flint_randclear(state);
+    }
+
+    nmod_mat_init(T, n, nullity, mod.n);
+
+    for (k = 0; k < nullity; k++)
+    {
+        for (i = 0; i < n; i++)
+            nmod_mat_entry(T, i, k) = basis[k][i];
+        _nmod_vec_clear(basis[k]);
+    }
+
+    nmod_mat_swap(X, T);
+    nmod_mat_clear(T);
+
+    flint_free(basis);
+    flint_free(piv);
+
+    return nullity;
+}
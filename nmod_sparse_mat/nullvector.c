@@ -0,0 +1,60 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_sparse_mat.h"
+
+int
+nmod_sparse_mat_nullvector(mp_ptr x, const nmod_sparse_mat_t M)
+{
+    slong iter, n = M->c;
+    nmod_t mod = M->mod;
+    _nmod_sparse_mat_op_t op;
+    nmod_sparse_mat_t Mt;
+    flint_rand_t state;
+    nmod_poly_t f;
+    mp_ptr u, y;
+    int success = 0;
+
+    if (n == 0)
+        return 0;
+
+    flint_randinit(state);
+    nmod_poly_init_mod(f, mod);
+    nmod_sparse_mat_init(Mt, M->c, M->r, mod.n);
+    nmod_sparse_mat_transpose(Mt, M);
+    u = _nmod_vec_init(n);
+    y = _nmod_vec_init(n);
+
+    for (iter = 0; iter < 3 && !success; iter++)
+    {
+        _nmod_sparse_mat_op_init(op, M, Mt, state);
+
+        _nmod_sparse_mat_rand_vec(u, n, 0, state, mod);
+        _nmod_sparse_mat_rand_vec(y, n, 0, state, mod);
+        _nmod_sparse_mat_op_minpoly(f, op, u, y);
+        success = _nmod_sparse_mat_op_nullvector(x, op, f, y);
+
+        _nmod_sparse_mat_op_clear(op);
+    }
+
+    _nmod_vec_clear(u);
+    _nmod_vec_clear(y);
+    nmod_sparse_mat_clear(Mt);
+    nmod_poly_clear(f);
+    flint_randclear(state);
+
+    return success;
+}
@@ -0,0 +1,219 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_sparse_mat.h"
+
+void
+_nmod_sparse_mat_rand_vec(mp_ptr v, slong len, int nonzero,
+                                                flint_rand_t state, nmod_t mod)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (nonzero && mod.n > 1)
+            v[i] = n_randint(state, mod.n - 1) + 1;
+        else
+            v[i] = n_randint(state, mod.n);
+    }
+}
+
+/*
+    If At is NULL, the operator is the square matrix A itself. Otherwise
+    it is the symmetric matrix D1 A^T D2 A D1 for random nonsingular
+    diagonal matrices D1 and D2, which with high probability has the same
+    kernel as A and a squarefree minimal polynomial away from zero.
+*/
+void
+_nmod_sparse_mat_op_init(_nmod_sparse_mat_op_t op, const nmod_sparse_mat_t A,
+                                const nmod_sparse_mat_t At, flint_rand_t state)
+{
+    op->A = A;
+    op->At = At;
+
+    if (At == NULL)
+    {
+        op->d1 = op->d2 = op->t = NULL;
+    }
+    else
+    {
+        op->d1 = _nmod_vec_init(A->c);
+        op->d2 = _nmod_vec_init(A->r);
+        op->t = _nmod_vec_init(A->r);
+        _nmod_sparse_mat_rand_vec(op->d1, A->c, 1, state, A->mod);
+        _nmod_sparse_mat_rand_vec(op->d2, A->r, 1, state, A->mod);
+    }
+}
+
+void
+_nmod_sparse_mat_op_clear(_nmod_sparse_mat_op_t op)
+{
+    if (op->At != NULL)
+    {
+        _nmod_vec_clear(op->d1);
+        _nmod_vec_clear(op->d2);
+        _nmod_vec_clear(op->t);
+    }
+}
+
+slong
+_nmod_sparse_mat_op_dim(const _nmod_sparse_mat_op_t op)
+{
+    return op->A->c;
+}
+
+static void
+_mul_diag(mp_ptr y, mp_srcptr d, mp_srcptr x, slong len, nmod_t mod)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+        y[i] = nmod_mul(d[i], x[i], mod);
+}
+
+void
+_nmod_sparse_mat_op_mul(mp_ptr y, const _nmod_sparse_mat_op_t op, mp_srcptr x)
+{
+    const nmod_sparse_mat_struct * A = op->A;
+
+    if (op->At == NULL)
+    {
+        nmod_sparse_mat_mul_vec(y, A, x);
+    }
+    else
+    {
+        _mul_diag(y, op->d1, x, A->c, A->mod);
+        nmod_sparse_mat_mul_vec(op->t, A, y);
+        _mul_diag(op->t, op->d2, op->t, A->r, A->mod);
+        nmod_sparse_mat_mul_vec(y, op->At, op->t);
+        _mul_diag(y, op->d1, y, A->c, A->mod);
+    }
+}
+
+/*
+    Sets f to the minimal polynomial of the sequence u^T B^i v, which
+    divides the minimal polynomial of B. The sequence is stopped early
+    once the generator has annihilated enough terms beyond twice its
+    degree.
+*/
+void
+_nmod_sparse_mat_op_minpoly(nmod_poly_t f, const _nmod_sparse_mat_op_t op,
+                                                   mp_srcptr u, mp_srcptr v)
+{
+    slong i, n = _nmod_sparse_mat_op_dim(op);
+    nmod_t mod = op->A->mod;
+    int nlimbs = _nmod_vec_dot_bound_limbs(n, mod);
+    nmod_berlekamp_massey_t B;
+    const nmod_poly_struct * V;
+    mp_ptr w, w2;
+
+    w = _nmod_vec_init(n);
+    w2 = _nmod_vec_init(n);
+    _nmod_vec_set(w, v, n);
+
+    nmod_berlekamp_massey_init(B, mod.n);
+
+    for (i = 0; i < 2*n; i++)
+    {
+        nmod_berlekamp_massey_add_point(B, _nmod_vec_dot(u, w, n, mod, nlimbs));
+
+        if ((i + 1) % NMOD_SPARSE_MAT_EARLY_TERMINATION == 0)
+        {
+            nmod_berlekamp_massey_reduce(B);
+            V = nmod_berlekamp_massey_V_poly(B);
+
+            if (nmod_poly_degree(nmod_berlekamp_massey_R_poly(B))
+                                                       < nmod_poly_degree(V) &&
+                i + 1 >= 2*nmod_poly_degree(V) +
+                                            NMOD_SPARSE_MAT_EARLY_TERMINATION)
+                break;
+        }
+
+        if (i + 1 < 2*n)
+        {
+            _nmod_sparse_mat_op_mul(w2, op, w);
+            MP_PTR_SWAP(w, w2);
+        }
+    }
+
+    nmod_berlekamp_massey_reduce(B);
+    nmod_poly_make_monic(f, nmod_berlekamp_massey_V_poly(B));
+
+    nmod_berlekamp_massey_clear(B);
+    _nmod_vec_clear(w);
+    _nmod_vec_clear(w2);
+}
+
+/*
+    Given the minimal polynomial f = x^k g of B, with g(0) != 0, the
+    vector g(B) y lies in the generalised kernel of B, and the last
+    nonzero vector of the sequence g(B) y, B g(B) y, ..., lies in the
+    kernel. Returns 1 and sets x to a nonzero vector with A x = 0 if this
+    succeeds and 0 otherwise.
+*/
+int
+_nmod_sparse_mat_op_nullvector(mp_ptr x, const _nmod_sparse_mat_op_t op,
+                                         const nmod_poly_t f, mp_srcptr y)
+{
+    const nmod_sparse_mat_struct * A = op->A;
+    slong i, j, k, n = A->c;
+    nmod_t mod = A->mod;
+    mp_ptr v, w, t;
+    int success = 0;
+
+    for (k = 0; k < f->length && f->coeffs[k] == 0; k++) ;
+
+    if (k == 0 || k == f->length)
+        return 0;
+
+    v = _nmod_vec_init(n);
+    w = _nmod_vec_init(n);
+    t = _nmod_vec_init(A->r);
+
+    /* v = g(B) y by Horner's rule */
+    _nmod_vec_scalar_mul_nmod(v, y, n, f->coeffs[f->length - 1], mod);
+    for (i = f->length - 2; i >= k; i--)
+    {
+        _nmod_sparse_mat_op_mul(w, op, v);
+        _nmod_vec_scalar_addmul_nmod(w, y, n, f->coeffs[i], mod);
+        MP_PTR_SWAP(v, w);
+    }
+
+    for (j = 0; j <= k && !_nmod_vec_is_zero(v, n); j++)
+    {
+        _nmod_sparse_mat_op_mul(w, op, v);
+
+        if (_nmod_vec_is_zero(w, n))
+        {
+            if (op->At != NULL)
+                _mul_diag(x, op->d1, v, n, mod);
+            else
+                _nmod_vec_set(x, v, n);
+
+            nmod_sparse_mat_mul_vec(t, A, x);
+            success = _nmod_vec_is_zero(t, A->r);
+            break;
+        }
+
+        MP_PTR_SWAP(v, w);
+    }
+
+    _nmod_vec_clear(v);
+    _nmod_vec_clear(w);
+    _nmod_vec_clear(t);
+
+    return success;
+}
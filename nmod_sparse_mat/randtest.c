@@ -0,0 +1,67 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_randtest(nmod_sparse_mat_t M, flint_rand_t state,
+                                                           slong max_row_nnz)
+{
+    slong i, j, k, len, nnz;
+
+    /* only the zero ring has no nonzero entries */
+    if (M->mod.n == 1)
+    {
+        nmod_sparse_mat_zero(M);
+        return;
+    }
+
+    max_row_nnz = FLINT_MIN(max_row_nnz, M->c);
+
+    nnz = 0;
+    for (i = 0; i < M->r; i++)
+    {
+        M->rows[i] = nnz;
+
+        len = n_randint(state, max_row_nnz + 1);
+        _nmod_sparse_mat_fit_nnz(M, nnz + len);
+
+        /* choose len distinct columns, keeping them sorted */
+        for (k = 0; k < len; k++)
+        {
+            slong c;
+            int found;
+
+            do {
+                c = n_randint(state, M->c);
+                found = 0;
+                for (j = nnz; j < nnz + k && !found; j++)
+                    found = (M->cols[j] == c);
+            } while (found);
+
+            for (j = nnz + k; j > nnz && M->cols[j - 1] > c; j--)
+            {
+                M->cols[j] = M->cols[j - 1];
+                M->entries[j] = M->entries[j - 1];
+            }
+
+            M->cols[j] = c;
+            M->entries[j] = n_randint(state, M->mod.n - 1) + 1;
+        }
+
+        nnz += len;
+    }
+
+    M->rows[M->r] = nnz;
+}
@@ -0,0 +1,75 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_sparse_mat.h"
+
+/*
+    With high probability, the minimal polynomial of B = D1 A^T D2 A D1
+    has degree rank(A) + 1 if B is singular and rank(A) otherwise. The
+    projected minimal polynomial can only have smaller degree, so the
+    best of two trials is kept.
+*/
+slong
+nmod_sparse_mat_rank(const nmod_sparse_mat_t M)
+{
+    slong i, n, rank, r;
+    nmod_t mod = M->mod;
+    _nmod_sparse_mat_op_t op;
+    nmod_sparse_mat_t Mt;
+    const nmod_sparse_mat_struct * A, * At;
+    flint_rand_t state;
+    nmod_poly_t f;
+    mp_ptr u, v;
+
+    if (nmod_sparse_mat_nnz(M) == 0)
+        return 0;
+
+    flint_randinit(state);
+    nmod_poly_init_mod(f, mod);
+    nmod_sparse_mat_init(Mt, M->c, M->r, mod.n);
+    nmod_sparse_mat_transpose(Mt, M);
+
+    /* work in the smaller dimension */
+    A = (M->r >= M->c) ? M : Mt;
+    At = (M->r >= M->c) ? Mt : M;
+    n = A->c;
+
+    u = _nmod_vec_init(n);
+    v = _nmod_vec_init(n);
+
+    rank = 0;
+    for (i = 0; i < 2 && rank < n; i++)
+    {
+        _nmod_sparse_mat_op_init(op, A, At, state);
+        _nmod_sparse_mat_rand_vec(u, n, 0, state, mod);
+        _nmod_sparse_mat_rand_vec(v, n, 0, state, mod);
+        _nmod_sparse_mat_op_minpoly(f, op, u, v);
+        _nmod_sparse_mat_op_clear(op);
+
+        r = nmod_poly_degree(f) - (f->coeffs[0] == 0);
+        rank = FLINT_MAX(rank, r);
+    }
+
+    rank = FLINT_MIN(rank, n);
+
+    _nmod_vec_clear(u);
+    _nmod_vec_clear(v);
+    nmod_sparse_mat_clear(Mt);
+    nmod_poly_clear(f);
+    flint_randclear(state);
+
+    return rank;
+}
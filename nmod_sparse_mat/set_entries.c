@@ -0,0 +1,104 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+typedef struct
+{
+    slong col;
+    mp_limb_t val;
+} _entry_struct;
+
+static int _entry_cmp(const void * a, const void * b)
+{
+    slong x = ((const _entry_struct *) a)->col;
+    slong y = ((const _entry_struct *) b)->col;
+
+    return (x > y) - (x < y);
+}
+
+void
+nmod_sparse_mat_set_entries(nmod_sparse_mat_t M, const slong * rows,
+                       const slong * cols, mp_srcptr entries, slong nnz)
+{
+    slong i, j, k, start, * pos;
+    _entry_struct * T;
+
+    for (k = 0; k < nnz; k++)
+    {
+        if (rows[k] < 0 || rows[k] >= M->r || cols[k] < 0 || cols[k] >= M->c)
+        {
+            flint_printf("Exception (nmod_sparse_mat_set_entries). "
+                         "Index out of range.\n");
+            flint_abort();
+        }
+    }
+
+    /* bucket the entries by row */
+    pos = (slong *) flint_calloc(M->r + 1, sizeof(slong));
+    for (k = 0; k < nnz; k++)
+        pos[rows[k] + 1]++;
+    for (i = 0; i < M->r; i++)
+        pos[i + 1] += pos[i];
+
+    T = (_entry_struct *) flint_malloc(FLINT_MAX(nnz, 1)*sizeof(_entry_struct));
+    for (k = 0; k < nnz; k++)
+    {
+        j = pos[rows[k]]++;
+        T[j].col = cols[k];
+        NMOD_RED(T[j].val, entries[k], M->mod);
+    }
+
+    _nmod_sparse_mat_fit_nnz(M, nnz);
+
+    /* sort each row, adding up repeated entries and dropping zeros */
+    start = 0;
+    k = 0;
+    for (i = 0; i < M->r; i++)
+    {
+        slong stop = pos[i];
+
+        qsort(T + start, stop - start, sizeof(_entry_struct), _entry_cmp);
+
+        M->rows[i] = k;
+        for (j = start; j < stop; j++)
+        {
+            if (k > M->rows[i] && M->cols[k - 1] == T[j].col)
+            {
+                M->entries[k - 1] = nmod_add(M->entries[k - 1],
+                                                           T[j].val, M->mod);
+            }
+            else
+            {
+                if (k > M->rows[i] && M->entries[k - 1] == 0)
+                    k--;
+                M->cols[k] = T[j].col;
+                M->entries[k] = T[j].val;
+                k++;
+            }
+        }
+
+        if (k > M->rows[i] && M->entries[k - 1] == 0)
+            k--;
+
+        start = stop;
+    }
+
+    M->rows[M->r] = k;
+
+    flint_free(T);
+    flint_free(pos);
+}
@@ -0,0 +1,148 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_sparse_mat.h"
+
+/*
+    Solves B y = z for the symmetric operator B = D1 M^T D2 M D1 by the
+    Lanczos algorithm in the form given by LaMacchia and Odlyzko: the
+    vectors w_0 = z, w_{i+1} = B w_i - a_i w_i - b_i w_{i-1} are pairwise
+    B-orthogonal and y is accumulated from their projections. Returns 0
+    if some w_i is nonzero but self-orthogonal.
+*/
+static int
+_lanczos(mp_ptr y, const _nmod_sparse_mat_op_t op, mp_srcptr z)
+{
+    slong n = _nmod_sparse_mat_op_dim(op);
+    nmod_t mod = op->A->mod;
+    int nlimbs = _nmod_vec_dot_bound_limbs(n, mod);
+    mp_ptr w, v, w0, v0, t;
+    mp_limb_t wv, wv0, a, b, c;
+    slong i;
+    int success = 0;
+
+    w = _nmod_vec_init(n);
+    v = _nmod_vec_init(n);
+    w0 = _nmod_vec_init(n);
+    v0 = _nmod_vec_init(n);
+    t = _nmod_vec_init(n);
+
+    _nmod_vec_zero(y, n);
+    _nmod_vec_set(w, z, n);
+    wv0 = 1;
+
+    for (i = 0; i <= n; i++)
+    {
+        if (_nmod_vec_is_zero(w, n))
+        {
+            success = 1;
+            break;
+        }
+
+        _nmod_sparse_mat_op_mul(v, op, w);
+        wv = _nmod_vec_dot(w, v, n, mod, nlimbs);
+
+        if (wv == 0)
+            break;
+
+        /* y += (w, z)/(w, B w) w */
+        c = nmod_div(_nmod_vec_dot(w, z, n, mod, nlimbs), wv, mod);
+        _nmod_vec_scalar_addmul_nmod(y, w, n, c, mod);
+
+        /* t = B w - (B w, B w)/(w, B w) w - (B w, B w0)/(w0, B w0) w0 */
+        a = nmod_div(_nmod_vec_dot(v, v, n, mod, nlimbs), wv, mod);
+        _nmod_vec_set(t, v, n);
+        _nmod_vec_scalar_addmul_nmod(t, w, n, nmod_neg(a, mod), mod);
+        if (i > 0)
+        {
+            b = nmod_div(_nmod_vec_dot(v, v0, n, mod, nlimbs), wv0, mod);
+            _nmod_vec_scalar_addmul_nmod(t, w0, n, nmod_neg(b, mod), mod);
+        }
+
+        MP_PTR_SWAP(w0, w);
+        MP_PTR_SWAP(w, t);
+        MP_PTR_SWAP(v0, v);
+        wv0 = wv;
+    }
+
+    _nmod_vec_clear(w);
+    _nmod_vec_clear(v);
+    _nmod_vec_clear(w0);
+    _nmod_vec_clear(v0);
+    _nmod_vec_clear(t);
+
+    return success;
+}
+
+int
+nmod_sparse_mat_solve_lanczos(mp_ptr x, const nmod_sparse_mat_t M,
+                                                                 mp_srcptr b)
+{
+    slong i, iter, n = M->c;
+    nmod_t mod = M->mod;
+    _nmod_sparse_mat_op_t op;
+    nmod_sparse_mat_t Mt;
+    flint_rand_t state;
+    mp_ptr y, z, t;
+    int success = 0;
+
+    if (_nmod_vec_is_zero(b, M->r))
+    {
+        _nmod_vec_zero(x, n);
+        return 1;
+    }
+
+    if (n == 0)
+        return 0;
+
+    flint_randinit(state);
+    nmod_sparse_mat_init(Mt, M->c, M->r, mod.n);
+    nmod_sparse_mat_transpose(Mt, M);
+    y = _nmod_vec_init(n);
+    z = _nmod_vec_init(n);
+    t = _nmod_vec_init(M->r);
+
+    for (iter = 0; iter < 3 && !success; iter++)
+    {
+        _nmod_sparse_mat_op_init(op, M, Mt, state);
+
+        /* z = D1 M^T D2 b */
+        for (i = 0; i < M->r; i++)
+            t[i] = nmod_mul(op->d2[i], b[i], mod);
+        nmod_sparse_mat_mul_vec(z, Mt, t);
+        for (i = 0; i < n; i++)
+            z[i] = nmod_mul(op->d1[i], z[i], mod);
+
+        if (_lanczos(y, op, z))
+        {
+            /* x = D1 y */
+            for (i = 0; i < n; i++)
+                x[i] = nmod_mul(op->d1[i], y[i], mod);
+
+            nmod_sparse_mat_mul_vec(t, M, x);
+            success = _nmod_vec_equal(t, b, M->r);
+        }
+
+        _nmod_sparse_mat_op_clear(op);
+    }
+
+    _nmod_vec_clear(y);
+    _nmod_vec_clear(z);
+    _nmod_vec_clear(t);
+    nmod_sparse_mat_clear(Mt);
+    flint_randclear(state);
+
+    return success;
+}
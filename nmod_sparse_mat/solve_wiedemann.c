@@ -0,0 +1,87 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_sparse_mat.h"
+
+int
+nmod_sparse_mat_solve_wiedemann(mp_ptr x, const nmod_sparse_mat_t M,
+                                                                 mp_srcptr b)
+{
+    slong i, iter, n = M->r;
+    nmod_t mod = M->mod;
+    _nmod_sparse_mat_op_t op;
+    flint_rand_t state;
+    nmod_poly_t f;
+    mp_ptr u, v, w;
+    mp_limb_t c;
+    int success = 0;
+
+    if (M->r != M->c)
+    {
+        flint_printf("Exception (nmod_sparse_mat_solve_wiedemann). "
+                     "Non-square matrix.\n");
+        flint_abort();
+    }
+
+    if (_nmod_vec_is_zero(b, n))
+    {
+        _nmod_vec_zero(x, n);
+        return 1;
+    }
+
+    flint_randinit(state);
+    nmod_poly_init_mod(f, mod);
+    _nmod_sparse_mat_op_init(op, M, NULL, state);
+    u = _nmod_vec_init(n);
+    v = _nmod_vec_init(n);
+    w = _nmod_vec_init(n);
+
+    for (iter = 0; iter < 3 && !success; iter++)
+    {
+        /* f(M) b = 0 for the minimal polynomial f of the projected
+           Krylov sequence, with high probability */
+        _nmod_sparse_mat_rand_vec(u, n, 0, state, mod);
+        _nmod_sparse_mat_op_minpoly(f, op, u, b);
+
+        if (f->length < 2 || f->coeffs[0] == 0)
+            continue;
+
+        /* x = -f(0)^(-1) (f(M) - f(0))/M b */
+        _nmod_vec_scalar_mul_nmod(v, b, n, f->coeffs[f->length - 1], mod);
+        for (i = f->length - 2; i >= 1; i--)
+        {
+            nmod_sparse_mat_mul_vec(w, M, v);
+            _nmod_vec_scalar_addmul_nmod(w, b, n, f->coeffs[i], mod);
+            MP_PTR_SWAP(v, w);
+        }
+
+        c = nmod_neg(nmod_inv(f->coeffs[0], mod), mod);
+        _nmod_vec_scalar_mul_nmod(x, v, n, c, mod);
+
+        nmod_sparse_mat_mul_vec(w, M, x);
+        success = _nmod_vec_equal(w, b, n);
+    }
+
+    _nmod_vec_clear(u);
+    _nmod_vec_clear(v);
+    _nmod_vec_clear(w);
+    _nmod_sparse_mat_op_clear(op);
+    nmod_poly_clear(f);
+    flint_randclear(state);
+
+    return success;
+}
@@ -0,0 +1,96 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_vec....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t M;
+        nmod_mat_t A, X, Y;
+        mp_ptr x, y;
+        mp_limb_t n;
+        slong r, c, i, max_nnz;
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        /* sometimes large enough to be threaded */
+        if (n_randint(state, 50) == 0)
+        {
+            r = n_randint(state, 2000) + 1;
+            c = n_randint(state, 2000) + 1;
+            max_nnz = 100;
+        }
+        else
+        {
+            r = n_randint(state, 30);
+            c = n_randint(state, 30);
+            max_nnz = n_randint(state, 20);
+        }
+
+        n = n_randtest_not_zero(state);
+
+        nmod_sparse_mat_init(M, r, c, n);
+        nmod_mat_init(A, r, c, n);
+        nmod_mat_init(X, c, 1, n);
+        nmod_mat_init(Y, r, 1, n);
+        x = _nmod_vec_init(c);
+        y = _nmod_vec_init(r);
+
+        nmod_sparse_mat_randtest(M, state, max_nnz);
+        nmod_sparse_mat_get_nmod_mat(A, M);
+        nmod_mat_randtest(X, state);
+
+        for (i = 0; i < c; i++)
+            x[i] = nmod_mat_entry(X, i, 0);
+
+        nmod_sparse_mat_mul_vec(y, M, x);
+        nmod_mat_mul(Y, A, X);
+
+        for (i = 0; i < r; i++)
+        {
+            if (y[i] != nmod_mat_entry(Y, i, 0))
+            {
+                flint_printf("FAIL\n");
+                flint_printf("r = %wd, c = %wd, n = %wu\n", r, c, n);
+                abort();
+            }
+        }
+
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        nmod_sparse_mat_clear(M);
+        nmod_mat_clear(A);
+        nmod_mat_clear(X);
+        nmod_mat_clear(Y);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
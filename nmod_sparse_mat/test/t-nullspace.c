@@ -0,0 +1,123 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+/* sparse matrices of prescribed or random rank */
+static void
+_randtest_rank(nmod_sparse_mat_t M, flint_rand_t state)
+{
+    if (n_randint(state, 2))
+    {
+        nmod_mat_t A;
+
+        nmod_mat_init(A, M->r, M->c, M->mod.n);
+        nmod_mat_randrank(A, state, n_randint(state, FLINT_MIN(M->r, M->c) + 1));
+        if (n_randint(state, 2))
+            nmod_mat_randops(A, n_randint(state, 2*M->r + 1), state);
+        nmod_sparse_mat_set_nmod_mat(M, A);
+        nmod_mat_clear(A);
+    }
+    else
+    {
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 6));
+    }
+}
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("nullspace....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t M;
+        nmod_mat_t A, X, Y;
+        mp_ptr x, t;
+        mp_limb_t n;
+        slong r, c, nullity;
+
+        r = n_randint(state, 40);
+        c = n_randint(state, 40);
+        n = n_randprime(state, 40 + n_randint(state, 24), 0);
+
+        nmod_sparse_mat_init(M, r, c, n);
+        nmod_mat_init(A, r, c, n);
+        nmod_mat_init(X, 0, 0, n);
+        x = _nmod_vec_init(c);
+        t = _nmod_vec_init(r);
+
+        _randtest_rank(M, state);
+        nmod_sparse_mat_get_nmod_mat(A, M);
+
+        nullity = nmod_sparse_mat_nullspace(X, M);
+
+        if (nullity != c - nmod_mat_rank(A) || X->r != c || X->c != nullity
+            || nmod_mat_rank(X) != nullity)
+        {
+            flint_printf("FAIL: wrong nullity\n");
+            flint_printf("nullity = %wd\n", nullity);
+            nmod_mat_print_pretty(A);
+            abort();
+        }
+
+        nmod_mat_init(Y, r, nullity, n);
+        nmod_mat_mul(Y, A, X);
+
+        if (!nmod_mat_is_zero(Y))
+        {
+            flint_printf("FAIL: not in the kernel\n");
+            abort();
+        }
+
+        if (nullity > 0)
+        {
+            if (!nmod_sparse_mat_nullvector(x, M) || _nmod_vec_is_zero(x, c))
+            {
+                flint_printf("FAIL: nullvector\n");
+                nmod_mat_print_pretty(A);
+                abort();
+            }
+
+            nmod_sparse_mat_mul_vec(t, M, x);
+
+            if (!_nmod_vec_is_zero(t, r))
+            {
+                flint_printf("FAIL: nullvector not in the kernel\n");
+                abort();
+            }
+        }
+
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(t);
+        nmod_sparse_mat_clear(M);
+        nmod_mat_clear(A);
+        nmod_mat_clear(X);
+        nmod_mat_clear(Y);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("set_entries....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t M, N;
+        nmod_mat_t A, B;
+        mp_limb_t n;
+        slong r, c, i, j, k, nnz, * rows, * cols;
+        mp_ptr vals;
+
+        r = n_randint(state, 20);
+        c = n_randint(state, 20);
+        n = n_randtest_not_zero(state);
+        nnz = n_randint(state, 3*r*c + 1);
+
+        nmod_sparse_mat_init(M, r, c, n);
+        nmod_sparse_mat_init(N, r, c, n);
+        nmod_mat_init(A, r, c, n);
+        nmod_mat_init(B, r, c, n);
+
+        rows = flint_malloc((nnz + 1)*sizeof(slong));
+        cols = flint_malloc((nnz + 1)*sizeof(slong));
+        vals = flint_malloc((nnz + 1)*sizeof(mp_limb_t));
+
+        /* repeated positions and unreduced values are summed */
+        for (k = 0; k < nnz; k++)
+        {
+            rows[k] = n_randint(state, r);
+            cols[k] = n_randint(state, c);
+            vals[k] = n_randtest(state);
+            nmod_mat_entry(A, rows[k], cols[k]) = nmod_add(
+                      nmod_mat_entry(A, rows[k], cols[k]),
+                      n_mod2_preinv(vals[k], n, A->mod.ninv), A->mod);
+        }
+
+        nmod_sparse_mat_set_entries(M, rows, cols, vals, nnz);
+        nmod_sparse_mat_get_nmod_mat(B, M);
+
+        if (!nmod_mat_equal(A, B))
+        {
+            flint_printf("FAIL: set_entries\n");
+            nmod_mat_print_pretty(A);
+            nmod_mat_print_pretty(B);
+            abort();
+        }
+
+        for (i = 0; i < r; i++)
+        {
+            for (j = 0; j < c; j++)
+            {
+                if (nmod_sparse_mat_get_entry(M, i, j) != nmod_mat_entry(A, i, j))
+                {
+                    flint_printf("FAIL: get_entry\n");
+                    abort();
+                }
+            }
+
+            for (k = M->rows[i]; k < M->rows[i + 1]; k++)
+            {
+                if (M->entries[k] == 0 ||
+                    (k > M->rows[i] && M->cols[k - 1] >= M->cols[k]))
+                {
+                    flint_printf("FAIL: not canonical\n");
+                    abort();
+                }
+            }
+        }
+
+        nmod_sparse_mat_set_nmod_mat(N, A);
+
+        if (!nmod_sparse_mat_equal(M, N))
+        {
+            flint_printf("FAIL: set_nmod_mat\n");
+            abort();
+        }
+
+        flint_free(rows);
+        flint_free(cols);
+        flint_free(vals);
+        nmod_sparse_mat_clear(M);
+        nmod_sparse_mat_clear(N);
+        nmod_mat_clear(A);
+        nmod_mat_clear(B);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
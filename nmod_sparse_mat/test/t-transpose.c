@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("transpose....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t M, N;
+        nmod_mat_t A, B, C;
+        mp_limb_t n;
+        slong r, c;
+
+        r = n_randint(state, 30);
+        c = n_randint(state, 30);
+        n = n_randtest_not_zero(state);
+
+        nmod_sparse_mat_init(M, r, c, n);
+        nmod_sparse_mat_init(N, c, r, n);
+        nmod_mat_init(A, r, c, n);
+        nmod_mat_init(B, c, r, n);
+        nmod_mat_init(C, c, r, n);
+
+        nmod_sparse_mat_randtest(M, state, n_randint(state, 10));
+        nmod_sparse_mat_transpose(N, M);
+
+        nmod_sparse_mat_get_nmod_mat(A, M);
+        nmod_sparse_mat_get_nmod_mat(B, N);
+        nmod_mat_transpose(C, A);
+
+        if (!nmod_mat_equal(B, C))
+        {
+            flint_printf("FAIL: transpose\n");
+            abort();
+        }
+
+        /* aliasing */
+        nmod_sparse_mat_transpose(N, N);
+
+        if (!nmod_sparse_mat_equal(M, N))
+        {
+            flint_printf("FAIL: aliasing\n");
+            abort();
+        }
+
+        nmod_sparse_mat_clear(M);
+        nmod_sparse_mat_clear(N);
+        nmod_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_mat_clear(C);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,57 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_transpose(nmod_sparse_mat_t B, const nmod_sparse_mat_t A)
+{
+    slong i, j, k, nnz;
+
+    if (B == A)
+    {
+        nmod_sparse_mat_t T;
+        nmod_sparse_mat_init(T, A->c, A->r, A->mod.n);
+        nmod_sparse_mat_transpose(T, A);
+        nmod_sparse_mat_swap(B, T);
+        nmod_sparse_mat_clear(T);
+        return;
+    }
+
+    nnz = nmod_sparse_mat_nnz(A);
+    _nmod_sparse_mat_fit_nnz(B, nnz);
+
+    /* counting sort by column; rows are visited in order, so the
+       columns of B come out sorted */
+    for (j = 0; j <= B->r; j++)
+        B->rows[j] = 0;
+    for (k = 0; k < nnz; k++)
+        B->rows[A->cols[k] + 1]++;
+    for (j = 0; j < B->r; j++)
+        B->rows[j + 1] += B->rows[j];
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (k = A->rows[i]; k < A->rows[i + 1]; k++)
+        {
+            j = B->rows[A->cols[k]]++;
+            B->cols[j] = i;
+            B->entries[j] = A->entries[k];
+        }
+    }
+
+    for (j = B->r; j > 0; j--)
+        B->rows[j] = B->rows[j - 1];
+    B->rows[0] = 0;
+}
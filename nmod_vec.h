@@ -340,6 +340,58 @@ FLINT_DLL mp_limb_t _nmod_vec_dot_ptr(mp_srcptr vec1, const mp_ptr * vec2, slong
     slong len, nmod_t mod, int nlimbs);
 
 
+/* SIMD kernels ***************************************************************/
+
+/*
+    On x86-64 the kernels below are compiled for AVX2 and AVX-512 with
+    function target attributes, whatever the flags of the rest of the build,
+    and the scalar functions above switch to them when the running CPU
+    supports the instructions. Define FLINT_NO_NMOD_VEC_SIMD to disable.
+*/
+#if FLINT64 && (defined(__x86_64__) || defined(__amd64__)) && \
+    ((defined(__GNUC__) && __GNUC__ >= 6) || defined(__clang__)) && \
+    !defined(FLINT_NO_NMOD_VEC_SIMD)
+#define FLINT_NMOD_VEC_X86 1
+#else
+#define FLINT_NMOD_VEC_X86 0
+#endif
+
+#define NMOD_VEC_SIMD_NONE 0
+#define NMOD_VEC_SIMD_AVX2 1
+#define NMOD_VEC_SIMD_AVX512 2
+
+FLINT_DLL int _nmod_vec_simd_level(void);
+
+FLINT_DLL void _nmod_vec_set_simd_level(int level);
+
+#if FLINT_NMOD_VEC_X86
+
+FLINT_DLL mp_limb_t _nmod_vec_dot_avx2(mp_srcptr vec1, mp_srcptr vec2,
+                                    slong len, nmod_t mod, int nlimbs);
+
+FLINT_DLL void _nmod_vec_reduce_avx2(mp_ptr res, mp_srcptr vec,
+                                                    slong len, nmod_t mod);
+
+FLINT_DLL void _nmod_vec_scalar_mul_nmod_shoup_avx2(mp_ptr res,
+                        mp_srcptr vec, slong len, mp_limb_t c, nmod_t mod);
+
+FLINT_DLL void _nmod_vec_scalar_addmul_nmod_avx2(mp_ptr res,
+                        mp_srcptr vec, slong len, mp_limb_t c, nmod_t mod);
+
+FLINT_DLL mp_limb_t _nmod_vec_dot_avx512(mp_srcptr vec1, mp_srcptr vec2,
+                                    slong len, nmod_t mod, int nlimbs);
+
+FLINT_DLL void _nmod_vec_reduce_avx512(mp_ptr res, mp_srcptr vec,
+                                                    slong len, nmod_t mod);
+
+FLINT_DLL void _nmod_vec_scalar_mul_nmod_shoup_avx512(mp_ptr res,
+                        mp_srcptr vec, slong len, mp_limb_t c, nmod_t mod);
+
+FLINT_DLL void _nmod_vec_scalar_addmul_nmod_avx512(mp_ptr res,
+                        mp_srcptr vec, slong len, mp_limb_t c, nmod_t mod);
+
+#endif
+
 /* discrete logs a la Pohlig - Hellman ***************************************/
 
 typedef struct {
@@ -0,0 +1,196 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+
+#if FLINT_NMOD_VEC_X86
+
+#include <immintrin.h>
+
+/*
+    AVX2 versions of the basic kernels, four limbs per vector. AVX2 has no
+    64 x 64 bit multiplication, so the low and high halves of the products
+    are assembled from the 32 x 32 -> 64 bit multiplies of vpmuludq.
+*/
+
+#define AVX2_FN __attribute__((target("avx2")))
+
+#define SIGN_BIT _mm256_set1_epi64x(WORD_MIN)
+
+static AVX2_FN __inline__ __m256i
+_mul_lo(__m256i a, __m256i b)
+{
+    __m256i ah = _mm256_srli_epi64(a, 32);
+    __m256i bh = _mm256_srli_epi64(b, 32);
+    __m256i t = _mm256_add_epi64(_mm256_mul_epu32(a, bh),
+                                 _mm256_mul_epu32(ah, b));
+
+    return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(t, 32));
+}
+
+static AVX2_FN __inline__ __m256i
+_mul_hi(__m256i a, __m256i b)
+{
+    const __m256i lo32 = _mm256_set1_epi64x(0xffffffff);
+    __m256i ah = _mm256_srli_epi64(a, 32);
+    __m256i bh = _mm256_srli_epi64(b, 32);
+    __m256i ll = _mm256_mul_epu32(a, b);
+    __m256i lh = _mm256_mul_epu32(a, bh);
+    __m256i hl = _mm256_mul_epu32(ah, b);
+    __m256i hh = _mm256_mul_epu32(ah, bh);
+    __m256i t, w;
+
+    t = _mm256_add_epi64(hl, _mm256_srli_epi64(ll, 32));
+    w = _mm256_add_epi64(_mm256_and_si256(t, lo32), lh);
+    hh = _mm256_add_epi64(hh, _mm256_srli_epi64(t, 32));
+
+    return _mm256_add_epi64(hh, _mm256_srli_epi64(w, 32));
+}
+
+/* r - n if r >= n, else r, for unsigned r, n */
+static AVX2_FN __inline__ __m256i
+_sub_if_ge(__m256i r, __m256i n)
+{
+    __m256i lt = _mm256_cmpgt_epi64(_mm256_xor_si256(n, SIGN_BIT),
+                                    _mm256_xor_si256(r, SIGN_BIT));
+
+    return _mm256_sub_epi64(r, _mm256_andnot_si256(lt, n));
+}
+
+/* requires n <= 2^32, so that the products fit in a limb */
+AVX2_FN mp_limb_t
+_nmod_vec_dot_avx2(mp_srcptr vec1, mp_srcptr vec2, slong len,
+                                                     nmod_t mod, int nlimbs)
+{
+    const __m256i lo32 = _mm256_set1_epi64x(0xffffffff);
+    __m256i slo = _mm256_setzero_si256(), shi = _mm256_setzero_si256();
+    mp_limb_t s0 = 0, s1 = 0, t[4], u[4];
+    slong i;
+
+    if (nlimbs == 1)
+    {
+        /* the sum fits in a limb */
+        for (i = 0; i + 4 <= len; i += 4)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+            __m256i b = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+            slo = _mm256_add_epi64(slo, _mm256_mul_epu32(a, b));
+        }
+
+        _mm256_storeu_si256((__m256i *) t, slo);
+        s0 = t[0] + t[1] + t[2] + t[3];
+
+        for ( ; i < len; i++)
+            s0 += vec1[i]*vec2[i];
+
+        NMOD_RED(s0, s0, mod);
+        return s0;
+    }
+
+    /* sum the low and high halves of the products separately */
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+        __m256i p = _mm256_mul_epu32(a, b);
+        slo = _mm256_add_epi64(slo, _mm256_and_si256(p, lo32));
+        shi = _mm256_add_epi64(shi, _mm256_srli_epi64(p, 32));
+    }
+
+    _mm256_storeu_si256((__m256i *) t, slo);
+    _mm256_storeu_si256((__m256i *) u, shi);
+
+    for (i = 0; i < 4; i++)
+    {
+        add_ssaaaa(s1, s0, s1, s0, 0, t[i]);
+        add_ssaaaa(s1, s0, s1, s0, u[i] >> 32, u[i] << 32);
+    }
+
+    for (i = len & ~WORD(3); i < len; i++)
+        add_ssaaaa(s1, s0, s1, s0, 0, vec1[i]*vec2[i]);
+
+    NMOD2_RED2(s0, s1, s0, mod);
+    return s0;
+}
+
+AVX2_FN void
+_nmod_vec_reduce_avx2(mp_ptr res, mp_srcptr vec, slong len, nmod_t mod)
+{
+    /* q = floor(x m / 2^64) with m = floor((2^64 - 1)/n) is at most 1 short */
+    const __m256i n = _mm256_set1_epi64x(mod.n);
+    const __m256i m = _mm256_set1_epi64x(UWORD_MAX / mod.n);
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (vec + i));
+        __m256i r = _mm256_sub_epi64(x, _mul_lo(_mul_hi(x, m), n));
+        _mm256_storeu_si256((__m256i *) (res + i), _sub_if_ge(r, n));
+    }
+
+    for ( ; i < len; i++)
+        NMOD_RED(res[i], vec[i], mod);
+}
+
+/* requires n < 2^63 */
+AVX2_FN void
+_nmod_vec_scalar_mul_nmod_shoup_avx2(mp_ptr res, mp_srcptr vec,
+                                       slong len, mp_limb_t c, nmod_t mod)
+{
+    const mp_limb_t c_pr = n_mulmod_precomp_shoup(c, mod.n);
+    const __m256i n = _mm256_set1_epi64x(mod.n);
+    const __m256i w = _mm256_set1_epi64x(c);
+    const __m256i w_pr = _mm256_set1_epi64x(c_pr);
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (vec + i));
+        __m256i r = _mm256_sub_epi64(_mul_lo(x, w),
+                                     _mul_lo(_mul_hi(x, w_pr), n));
+        _mm256_storeu_si256((__m256i *) (res + i), _sub_if_ge(r, n));
+    }
+
+    for ( ; i < len; i++)
+        res[i] = n_mulmod_shoup(c, vec[i], c_pr, mod.n);
+}
+
+/* requires n < 2^63 */
+AVX2_FN void
+_nmod_vec_scalar_addmul_nmod_avx2(mp_ptr res, mp_srcptr vec,
+                                       slong len, mp_limb_t c, nmod_t mod)
+{
+    const mp_limb_t c_pr = n_mulmod_precomp_shoup(c, mod.n);
+    const __m256i n = _mm256_set1_epi64x(mod.n);
+    const __m256i w = _mm256_set1_epi64x(c);
+    const __m256i w_pr = _mm256_set1_epi64x(c_pr);
+    slong i;
+
+    for (i = 0; i + 4 <= len; i += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (vec + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *) (res + i));
+        __m256i r = _mm256_sub_epi64(_mul_lo(x, w),
+                                     _mul_lo(_mul_hi(x, w_pr), n));
+        r = _sub_if_ge(r, n);
+        r = _sub_if_ge(_mm256_add_epi64(r, y), n);
+        _mm256_storeu_si256((__m256i *) (res + i), r);
+    }
+
+    for ( ; i < len; i++)
+        res[i] = n_addmod(res[i],
+                          n_mulmod_shoup(c, vec[i], c_pr, mod.n), mod.n);
+}
+
+#endif
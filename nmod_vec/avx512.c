@@ -0,0 +1,180 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+
+#if FLINT_NMOD_VEC_X86
+
+#include <immintrin.h>
+
+/*
+    AVX-512 versions of the basic kernels, eight limbs per vector. The low
+    halves of 64 x 64 bit products come from vpmullq (AVX-512DQ), the high
+    halves are assembled from 32 x 32 -> 64 bit multiplies as for AVX2.
+*/
+
+#define AVX512_FN __attribute__((target("avx512f,avx512dq")))
+
+static AVX512_FN __inline__ __m512i
+_mul_hi(__m512i a, __m512i b)
+{
+    const __m512i lo32 = _mm512_set1_epi64(0xffffffff);
+    __m512i ah = _mm512_srli_epi64(a, 32);
+    __m512i bh = _mm512_srli_epi64(b, 32);
+    __m512i ll = _mm512_mul_epu32(a, b);
+    __m512i lh = _mm512_mul_epu32(a, bh);
+    __m512i hl = _mm512_mul_epu32(ah, b);
+    __m512i hh = _mm512_mul_epu32(ah, bh);
+    __m512i t, w;
+
+    t = _mm512_add_epi64(hl, _mm512_srli_epi64(ll, 32));
+    w = _mm512_add_epi64(_mm512_and_si512(t, lo32), lh);
+    hh = _mm512_add_epi64(hh, _mm512_srli_epi64(t, 32));
+
+    return _mm512_add_epi64(hh, _mm512_srli_epi64(w, 32));
+}
+
+/* r - n if r >= n, else r, for unsigned r, n */
+static AVX512_FN __inline__ __m512i
+_sub_if_ge(__m512i r, __m512i n)
+{
+    return _mm512_mask_sub_epi64(r, _mm512_cmpge_epu64_mask(r, n), r, n);
+}
+
+/* requires n <= 2^32, so that the products fit in a limb */
+AVX512_FN mp_limb_t
+_nmod_vec_dot_avx512(mp_srcptr vec1, mp_srcptr vec2, slong len,
+                                                     nmod_t mod, int nlimbs)
+{
+    const __m512i lo32 = _mm512_set1_epi64(0xffffffff);
+    __m512i slo = _mm512_setzero_si512(), shi = _mm512_setzero_si512();
+    mp_limb_t s0 = 0, s1 = 0, t[8], u[8];
+    slong i;
+
+    if (nlimbs == 1)
+    {
+        /* the sum fits in a limb */
+        for (i = 0; i + 8 <= len; i += 8)
+        {
+            __m512i a = _mm512_loadu_si512((const void *) (vec1 + i));
+            __m512i b = _mm512_loadu_si512((const void *) (vec2 + i));
+            slo = _mm512_add_epi64(slo, _mm512_mul_epu32(a, b));
+        }
+
+        s0 = _mm512_reduce_add_epi64(slo);
+
+        for ( ; i < len; i++)
+            s0 += vec1[i]*vec2[i];
+
+        NMOD_RED(s0, s0, mod);
+        return s0;
+    }
+
+    /* sum the low and high halves of the products separately */
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        __m512i a = _mm512_loadu_si512((const void *) (vec1 + i));
+        __m512i b = _mm512_loadu_si512((const void *) (vec2 + i));
+        __m512i p = _mm512_mul_epu32(a, b);
+        slo = _mm512_add_epi64(slo, _mm512_and_si512(p, lo32));
+        shi = _mm512_add_epi64(shi, _mm512_srli_epi64(p, 32));
+    }
+
+    _mm512_storeu_si512((void *) t, slo);
+    _mm512_storeu_si512((void *) u, shi);
+
+    for (i = 0; i < 8; i++)
+    {
+        add_ssaaaa(s1, s0, s1, s0, 0, t[i]);
+        add_ssaaaa(s1, s0, s1, s0, u[i] >> 32, u[i] << 32);
+    }
+
+    for (i = len & ~WORD(7); i < len; i++)
+        add_ssaaaa(s1, s0, s1, s0, 0, vec1[i]*vec2[i]);
+
+    NMOD2_RED2(s0, s1, s0, mod);
+    return s0;
+}
+
+AVX512_FN void
+_nmod_vec_reduce_avx512(mp_ptr res, mp_srcptr vec, slong len, nmod_t mod)
+{
+    /* q = floor(x m / 2^64) with m = floor((2^64 - 1)/n) is at most 1 short */
+    const __m512i n = _mm512_set1_epi64(mod.n);
+    const __m512i m = _mm512_set1_epi64(UWORD_MAX / mod.n);
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        __m512i x = _mm512_loadu_si512((const void *) (vec + i));
+        __m512i r = _mm512_sub_epi64(x,
+                               _mm512_mullo_epi64(_mul_hi(x, m), n));
+        _mm512_storeu_si512((void *) (res + i), _sub_if_ge(r, n));
+    }
+
+    for ( ; i < len; i++)
+        NMOD_RED(res[i], vec[i], mod);
+}
+
+/* requires n < 2^63 */
+AVX512_FN void
+_nmod_vec_scalar_mul_nmod_shoup_avx512(mp_ptr res, mp_srcptr vec,
+                                       slong len, mp_limb_t c, nmod_t mod)
+{
+    const mp_limb_t c_pr = n_mulmod_precomp_shoup(c, mod.n);
+    const __m512i n = _mm512_set1_epi64(mod.n);
+    const __m512i w = _mm512_set1_epi64(c);
+    const __m512i w_pr = _mm512_set1_epi64(c_pr);
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        __m512i x = _mm512_loadu_si512((const void *) (vec + i));
+        __m512i r = _mm512_sub_epi64(_mm512_mullo_epi64(x, w),
+                           _mm512_mullo_epi64(_mul_hi(x, w_pr), n));
+        _mm512_storeu_si512((void *) (res + i), _sub_if_ge(r, n));
+    }
+
+    for ( ; i < len; i++)
+        res[i] = n_mulmod_shoup(c, vec[i], c_pr, mod.n);
+}
+
+/* requires n < 2^63 */
+AVX512_FN void
+_nmod_vec_scalar_addmul_nmod_avx512(mp_ptr res, mp_srcptr vec,
+                                       slong len, mp_limb_t c, nmod_t mod)
+{
+    const mp_limb_t c_pr = n_mulmod_precomp_shoup(c, mod.n);
+    const __m512i n = _mm512_set1_epi64(mod.n);
+    const __m512i w = _mm512_set1_epi64(c);
+    const __m512i w_pr = _mm512_set1_epi64(c_pr);
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        __m512i x = _mm512_loadu_si512((const void *) (vec + i));
+        __m512i y = _mm512_loadu_si512((const void *) (res + i));
+        __m512i r = _mm512_sub_epi64(_mm512_mullo_epi64(x, w),
+                           _mm512_mullo_epi64(_mul_hi(x, w_pr), n));
+        r = _sub_if_ge(r, n);
+        r = _sub_if_ge(_mm512_add_epi64(r, y), n);
+        _mm512_storeu_si512((void *) (res + i), r);
+    }
+
+    for ( ; i < len; i++)
+        res[i] = n_addmod(res[i],
+                          n_mulmod_shoup(c, vec[i], c_pr, mod.n), mod.n);
+}
+
+#endif
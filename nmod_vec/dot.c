@@ -20,6 +20,19 @@ _nmod_vec_dot(mp_srcptr vec1, mp_srcptr vec2, slong len, nmod_t mod, int nlimbs)
 {
     mp_limb_t res;
     slong i;
+
+#if FLINT_NMOD_VEC_X86
+    if (len >= 16 && mod.n <= (UWORD(1) << (FLINT_BITS / 2)))
+    {
+        int level = _nmod_vec_simd_level();
+
+        if (level == NMOD_VEC_SIMD_AVX512)
+            return _nmod_vec_dot_avx512(vec1, vec2, len, mod, nlimbs);
+        else if (level == NMOD_VEC_SIMD_AVX2)
+            return _nmod_vec_dot_avx2(vec1, vec2, len, mod, nlimbs);
+    }
+#endif
+
     NMOD_VEC_DOT(res, i, len, vec1[i], vec2[i], mod, nlimbs);
     return res;
 }
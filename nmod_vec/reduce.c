@@ -18,6 +18,25 @@
 void _nmod_vec_reduce(mp_ptr res, mp_srcptr vec, slong len, nmod_t mod)
 {
     slong i;
+
+#if FLINT_NMOD_VEC_X86
+    if (len >= 8)
+    {
+        int level = _nmod_vec_simd_level();
+
+        if (level == NMOD_VEC_SIMD_AVX512)
+        {
+            _nmod_vec_reduce_avx512(res, vec, len, mod);
+            return;
+        }
+        else if (level == NMOD_VEC_SIMD_AVX2)
+        {
+            _nmod_vec_reduce_avx2(res, vec, len, mod);
+            return;
+        }
+    }
+#endif
+
     for (i = 0 ; i < len; i++)
         NMOD_RED(res[i], vec[i], mod);
 }
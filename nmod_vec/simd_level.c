@@ -0,0 +1,49 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+
+static int _nmod_vec_simd_detected = -1;
+static int _nmod_vec_simd_limit = NMOD_VEC_SIMD_AVX512;
+
+static int
+_nmod_vec_simd_detect(void)
+{
+#if FLINT_NMOD_VEC_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+        return NMOD_VEC_SIMD_AVX512;
+
+    if (__builtin_cpu_supports("avx2"))
+        return NMOD_VEC_SIMD_AVX2;
+#endif
+
+    return NMOD_VEC_SIMD_NONE;
+}
+
+int
+_nmod_vec_simd_level(void)
+{
+    /* the detection gives the same answer in every thread */
+    if (_nmod_vec_simd_detected < 0)
+        _nmod_vec_simd_detected = _nmod_vec_simd_detect();
+
+    return FLINT_MIN(_nmod_vec_simd_detected, _nmod_vec_simd_limit);
+}
+
+void
+_nmod_vec_set_simd_level(int level)
+{
+    _nmod_vec_simd_limit = FLINT_MAX(level, NMOD_VEC_SIMD_NONE);
+}
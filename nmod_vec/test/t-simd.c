@@ -0,0 +1,143 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "ulong_extras.h"
+
+/* compare the SIMD kernels of each available level with the scalar code */
+int
+main(void)
+{
+    int i, level, max_level;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("simd....");
+    fflush(stdout);
+
+    max_level = _nmod_vec_simd_level();
+
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        slong len, j;
+        nmod_t mod;
+        mp_limb_t m, c, d1, d2;
+        mp_ptr x, y, r1, r2;
+        int nlimbs;
+
+        len = n_randint(state, 100) + 1;
+
+        switch (n_randint(state, 4))
+        {
+            case 0:
+                m = n_randtest_not_zero(state);
+                break;
+            case 1:
+                m = n_randtest_not_zero(state) >> (FLINT_BITS / 2);
+                m = FLINT_MAX(m, 1);
+                break;
+            case 2:
+                m = (UWORD(1) << (FLINT_BITS / 2)) - n_randint(state, 3);
+                break;
+            default:
+                m = UWORD_HALF - 1 - n_randint(state, 3);
+        }
+
+        nmod_init(&mod, m);
+
+        x = _nmod_vec_init(len);
+        y = _nmod_vec_init(len);
+        r1 = _nmod_vec_init(len);
+        r2 = _nmod_vec_init(len);
+
+        _nmod_vec_randtest(x, state, len, mod);
+        _nmod_vec_randtest(y, state, len, mod);
+        c = n_randint(state, m);
+        nlimbs = _nmod_vec_dot_bound_limbs(len, mod);
+
+        for (level = NMOD_VEC_SIMD_AVX2; level <= max_level; level++)
+        {
+            /* reduce, of arbitrary limbs */
+            for (j = 0; j < len; j++)
+                r1[j] = n_randtest(state);
+
+            _nmod_vec_set_simd_level(NMOD_VEC_SIMD_NONE);
+            _nmod_vec_reduce(r2, r1, len, mod);
+            _nmod_vec_set_simd_level(level);
+            _nmod_vec_reduce(r1, r1, len, mod);
+
+            if (!_nmod_vec_equal(r1, r2, len))
+            {
+                flint_printf("FAIL (reduce):\n");
+                flint_printf("level = %d, m = %wu, len = %wd\n", level, m, len);
+                abort();
+            }
+
+            /* dot */
+            _nmod_vec_set_simd_level(NMOD_VEC_SIMD_NONE);
+            d1 = _nmod_vec_dot(x, y, len, mod, nlimbs);
+            _nmod_vec_set_simd_level(level);
+            d2 = _nmod_vec_dot(x, y, len, mod, nlimbs);
+
+            if (d1 != d2)
+            {
+                flint_printf("FAIL (dot):\n");
+                flint_printf("level = %d, m = %wu, len = %wd\n", level, m, len);
+                abort();
+            }
+
+            if (m >= UWORD_HALF)
+                continue;
+
+            /* scalar_mul_nmod_shoup */
+            _nmod_vec_set_simd_level(NMOD_VEC_SIMD_NONE);
+            _nmod_vec_scalar_mul_nmod_shoup(r1, x, len, c, mod);
+            _nmod_vec_set_simd_level(level);
+            _nmod_vec_scalar_mul_nmod_shoup(r2, x, len, c, mod);
+
+            if (!_nmod_vec_equal(r1, r2, len))
+            {
+                flint_printf("FAIL (scalar_mul_nmod_shoup):\n");
+                flint_printf("level = %d, m = %wu, len = %wd\n", level, m, len);
+                abort();
+            }
+
+            /* scalar_addmul_nmod */
+            _nmod_vec_set(r1, y, len);
+            _nmod_vec_set(r2, y, len);
+            _nmod_vec_set_simd_level(NMOD_VEC_SIMD_NONE);
+            _nmod_vec_scalar_addmul_nmod(r1, x, len, c, mod);
+            _nmod_vec_set_simd_level(level);
+            _nmod_vec_scalar_addmul_nmod(r2, x, len, c, mod);
+
+            if (!_nmod_vec_equal(r1, r2, len))
+            {
+                flint_printf("FAIL (scalar_addmul_nmod):\n");
+                flint_printf("level = %d, m = %wu, len = %wd\n", level, m, len);
+                abort();
+            }
+        }
+
+        _nmod_vec_set_simd_level(NMOD_VEC_SIMD_AVX512);
+
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(r1);
+        _nmod_vec_clear(r2);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    flint_printf("PASS\n");
+    return 0;
+}
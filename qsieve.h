@@ -36,6 +36,8 @@
 
 #define BLOCK_SIZE (4*65536) /* size of sieving cache block */
 
+#define QS_DENSE_NULLSPACE_CUTOFF 2048 /* max columns for dense linear algebra */
+
 typedef struct prime_t
 {
    mp_limb_t pinv;     /* precomputed inverse */
@@ -62,11 +64,13 @@ typedef struct hash_t   /* entry in hash table */
    mp_limb_t prime;    /* value of prime */
    mp_limb_t next;     /* next prime which have same hash value as 'prime' */
    mp_limb_t count;    /* number of occurrence of 'prime' */
+   mp_limb_t parent;   /* offset of parent in union-find forest of primes */
 } hash_t;
 
 typedef struct relation_t  /* format for relation */
 {
    mp_limb_t lp;          /* large prime, is 1, if relation is full */
+   mp_limb_t lp2;         /* second large prime, is 1 unless double partial */
    slong num_factors;     /* number of factors, excluding small factor */
    slong small_primes;   /* number of small factors */
    slong * small;         /* exponent of small factors */
@@ -74,6 +78,23 @@ typedef struct relation_t  /* format for relation */
    fmpz_t Y;              /* square root of sieve value for relation */
 } relation_t;
 
+/*
+   Relations are stored packed into words as follows: the two large primes
+   (1 for a full relation, the second is 1 for a single partial), the number
+   of factors, the exponents of the small
+   primes, an index and exponent for each factor and finally the signed
+   size of Y followed by its limbs.
+*/
+typedef struct rel_store_t
+{
+   mp_limb_t * data;      /* packed relations held in memory */
+   slong length;          /* number of words used in data */
+   slong alloc;           /* number of words allocated for data */
+   slong num;             /* number of relations, including spilled ones */
+   slong limit;           /* spill data once it exceeds this many bytes */
+   FILE * spill;          /* spilled relations, or NULL */
+} rel_store_t;
+
 typedef struct qs_poly_s
 {
    fmpz_t B;          /* current B coeff of poly */
@@ -84,6 +105,10 @@ typedef struct qs_poly_s
    slong * small;     /* exponents of small prime factors in relations */
    fac_t * factor;    /* factors for a relation */
    slong num_factors; /* number of factors found in a relation */
+   mp_limb_t * rel_buf; /* relations found by this thread, packed */
+   slong rel_len;       /* number of words used in rel_buf */
+   slong rel_alloc;     /* number of words allocated for rel_buf */
+   slong rel_num;       /* number of relations in rel_buf */
 } qs_poly_s;
 
 typedef qs_poly_s qs_poly_t[1];
@@ -176,14 +201,13 @@ typedef struct qs_s
                        RELATION DATA
    ***************************************************************************/
 
-   FILE * siqs;           /* pointer to file for storing relations */
-   char * fname;          /* name of file used for relations */
+   rel_store_t store;     /* relations found so far */
 
    slong full_relation;   /* number of full relations */
    slong num_cycles;      /* number of possible full relations from partials */
 
    slong vertices;        /* number of different primes in partials */
-   slong components;      /* equal to 1 */
+   slong components;      /* number of connected components of graph */
    slong edges;           /* total number of partials */
 
    slong table_size;      /* size of table */
@@ -202,6 +226,8 @@ typedef struct qs_s
 
    ulong small_factor;    /* small factor found when merging relations */
 
+   int dlp;               /* whether to use the double large prime variant */
+
    /***************************************************************************
                        LINEAR ALGEBRA DATA
    ***************************************************************************/
@@ -222,89 +248,134 @@ typedef struct qs_s
 typedef qs_s qs_t[1];
 
 /*
-   Tuning parameters { bits, ks_primes, fb_primes, small_primes, sieve_size}
-   for qsieve_factor_threaded where:
+   Checkpoint of a quadratic sieve run, see qsieve_checkpoint_write
+*/
+#define QS_CHECKPOINT_VERSION 2
+
+typedef struct qs_checkpoint_s
+{
+   fmpz_t n;              /* number being factored */
+   mp_limb_t k;           /* multiplier */
+   slong num_primes;      /* number of factor base primes */
+   slong s;               /* number of prime factors of A */
+   slong low, high, span; /* range of possible factors of A */
+   slong h, m;            /* state of the ordering of tuples */
+   mp_limb_t j;           /* s-th factor of first A */
+   slong A_ind_diff;
+   mp_limb_t * curr_subset;
+   mp_limb_t * first_subset;
+   mp_limb_t * A_ind;
+   fmpz_t A;              /* A coefficient to sieve with next */
+   slong full_relation;   /* number of full relations */
+   slong edges;           /* number of partials */
+   slong num_relations;   /* number of packed relations */
+   slong length;          /* number of words of packed relations */
+   mp_limb_t * relations; /* packed relations */
+} qs_checkpoint_s;
+
+typedef qs_checkpoint_s qs_checkpoint_t[1];
+
+/*
+   Tuning parameters { bits, ks_primes, fb_primes, small_primes, sieve_size,
+   sieve_bits, dlp_bits } for qsieve_factor_threaded where:
      * bits is the number of bits of n
      * ks_primes is the max number of primes to try in Knuth-Schroeppel function
      * fb_primes is the number of factor base primes to use (including k and 2)
      * small_primes is the number of small primes to not factor with (including k and 2)
      * sieve_size is the size of the sieve to use
      * sieve_bits - sieve_fill
+     * dlp_bits is zero if double large primes are not used by default, else
+       the number of bits the sieve threshold is lowered by to find them
+
+   The dlp_bits column was chosen from single threaded timings of products
+   of two random primes with the threshold lowered by 0 (no double large
+   primes), 4, 8, 12 and 16 bits. At 200 bits no setting beat 0 by more than
+   the noise (8.9 s and 9.3 s without, 8.0-11.1 s with). At 220 bits lowering
+   by 8-12 bits saved 10-18% (36.7 s -> 30.2 s, 31.1 s -> 25.4 s), and at 240
+   bits lowering by 4-8 bits saved up to 18% (170 s -> 140 s, 92 s -> 79 s)
+   while 12-16 bits was slower than no double large primes. Since the gain
+   is small and noisy below 280 bits the column is only set from there,
+   lowering the threshold by about a tenth of sieve_bits, which grows with
+   the size of the cycles needed as the large prime bound increases.
+   QS_DLP_BITS_DEFAULT is used when double large primes are forced on with
+   qsieve_set_double_large_prime where the column is zero.
 */
 
+#define QS_DLP_BITS_DEFAULT 8
+
 #if 0 /* TODO have the tuning values taken from here if multithreaded */
 
-static const mp_limb_t qsieve_tune[][6] =
+static const mp_limb_t qsieve_tune[][7] =
 {
-   {10,   50,   100,  5,   2 *  2000,  30}, /* */
-   {20,   50,   120,  6,   2 *  2500,  30}, /* */
-   {30,   50,   150,  6,   2 *  2000,  31}, /* */
-   {40,   50,   150,  8,   2 *  3000,  32}, /* 12 digits */
-   {50,   50,   150,  8,   2 *  3000,  34}, /* 15 digits */
-   {60,   50,   150,  9,   2 *  3500,  36}, /* 18 digits */
-   {70,  100,   200,  9,   2 *  4000,  42}, /* 21 digits */
-   {80,  100,   200,  9,   2 *  6000,  44}, /* 24 digits */
-   {90,  100,   200,  9,   2 *  6000,  50}, /* */
-   {100, 100,   300,  9,   2 *  7000,  54}, /* */
-   {110, 100,   500,  9,   2 *  25000, 62}, /* 31 digits */
-   {120, 100,   800,  9,   2 *  30000, 64}, /* */
-   {130, 100,  1000,  9,   2 *  30000, 64}, /* 41 digits */
-   {140, 100,  1200,  9,   2 *  30000, 66}, /* */
-   {150, 100,  1500, 10,   2 *  32000, 68}, /* 45 digit */
-   {160, 150,  1800, 11,   2 *  32000, 70}, /* */
-   {170, 150,  2000, 12,   2 *  32000, 72}, /* 50 digits */
-   {180, 150,  2500, 12,   2 *  32000, 73}, /* */
-   {190, 150,  2800, 12,   2 *  32000, 76}, /* */
-   {200, 200,  4000, 12,   2 *  32000, 80}, /* 60 digits */
-   {210, 100,  3600, 12,   2 *  32000, 83}, /* */
-   {220, 300,  6000, 15,   2 *  65536, 87}, /* */
-   {230, 350,  8500, 17,   3 *  65536, 90}, /* 70 digits */
-   {240, 400, 10000, 19,   4 *  65536, 93}, /* */
-   {250, 500, 15000, 19,   4 *  65536, 97}, /* 75 digits */
-   {260, 600, 25000, 25,   4 *  65536, 100}, /* 80 digits */
-   {270, 800, 35000, 27,   5 *  65536, 104}  /* */
+   {10,   50,   100,  5,   2 *  2000,  30,   0}, /* */
+   {20,   50,   120,  6,   2 *  2500,  30,   0}, /* */
+   {30,   50,   150,  6,   2 *  2000,  31,   0}, /* */
+   {40,   50,   150,  8,   2 *  3000,  32,   0}, /* 12 digits */
+   {50,   50,   150,  8,   2 *  3000,  34,   0}, /* 15 digits */
+   {60,   50,   150,  9,   2 *  3500,  36,   0}, /* 18 digits */
+   {70,  100,   200,  9,   2 *  4000,  42,   0}, /* 21 digits */
+   {80,  100,   200,  9,   2 *  6000,  44,   0}, /* 24 digits */
+   {90,  100,   200,  9,   2 *  6000,  50,   0}, /* */
+   {100, 100,   300,  9,   2 *  7000,  54,   0}, /* */
+   {110, 100,   500,  9,   2 *  25000, 62,   0}, /* 31 digits */
+   {120, 100,   800,  9,   2 *  30000, 64,   0}, /* */
+   {130, 100,  1000,  9,   2 *  30000, 64,   0}, /* 41 digits */
+   {140, 100,  1200,  9,   2 *  30000, 66,   0}, /* */
+   {150, 100,  1500, 10,   2 *  32000, 68,   0}, /* 45 digit */
+   {160, 150,  1800, 11,   2 *  32000, 70,   0}, /* */
+   {170, 150,  2000, 12,   2 *  32000, 72,   0}, /* 50 digits */
+   {180, 150,  2500, 12,   2 *  32000, 73,   0}, /* */
+   {190, 150,  2800, 12,   2 *  32000, 76,   0}, /* */
+   {200, 200,  4000, 12,   2 *  32000, 80,   0}, /* 60 digits */
+   {210, 100,  3600, 12,   2 *  32000, 83,   0}, /* */
+   {220, 300,  6000, 15,   2 *  65536, 87,   0}, /* */
+   {230, 350,  8500, 17,   3 *  65536, 90,   0}, /* 70 digits */
+   {240, 400, 10000, 19,   4 *  65536, 93,   0}, /* */
+   {250, 500, 15000, 19,   4 *  65536, 97,   0}, /* 75 digits */
+   {260, 600, 25000, 25,   4 *  65536, 100,   0}, /* 80 digits */
+   {270, 800, 35000, 27,   5 *  65536, 104,   0}  /* */
 };
 
 #else /* currently tuned for four threads */
 
-static const mp_limb_t qsieve_tune[][6] =
+static const mp_limb_t qsieve_tune[][7] =
 {
-   {10,   50,   90,  5,   2 *  1500,  18}, /* */
-   {20,   50,   90,  6,   2 *  1600,  18}, /* */
-   {30,   50,   100,  6,   2 *  1800,  19}, /* */
-   {40,   50,   100,  8,   2 *  2000,  20}, /* 13 digits */
-   {50,   50,   100,  8,   2 *  2500,  22}, /* 16 digits */
-   {60,   50,   100,  9,   2 *  3000,  24}, /* 19 digits */
-   {70,  100,   250,  9,   2 *  6000,  25}, /* 22 digits */
-   {80,  100,   250,  9,   2 *  8000,  26}, /* 25 digits */
-   {90,  100,   250,  9,   2 *  9000,  30}, /* 28 digits */
-   {100, 100,   250,  9,   2 *  10000, 34}, /* 31 digits */
-   {110, 100,   250,  9,   2 *  30000, 38}, /* 34 digits */
-   {120, 100,   700,  9,   2 *  40000, 49}, /* 37 digits */
-   {130, 100,   800,  9,   2 *  50000, 59}, /* 40 digits */
-   {140, 100,  1200,  9,   2 *  65536, 66}, /* 43 digits */
-   {150, 100,  1500, 10,   2 *  65536, 70}, /* 46 digit */
-   {160, 150,  2000, 11,   4 *  65536, 73}, /* 49 digit */
-   {170, 150,  2000, 12,   4 *  65536, 75}, /* 52 digits */
-   {180, 150,  3000, 12,   4 *  65536, 76}, /* 55 digits */
-   {190, 150,  3000, 13,   4 *  65536, 78}, /* 58 digit */
-   {200, 200,  4500, 14,   4 *  65536, 81}, /* 61 digits */
-   {210, 100,  8000, 14,   12 *  65536, 84}, /* 64 digits */
-   {220, 300, 10000, 15,   12 *  65536, 88}, /* 67 digits */
-   {230, 400, 20000, 17,   20 *  65536, 90}, /* 70 digits */
-   {240, 450, 20000, 19,   20 *  65536, 93}, /* 73 digis */
-   {250, 500, 22000, 22,   24 *  65536, 97}, /* 76 digits */
-   {260, 600, 25000, 25,   24 *  65536, 100}, /* 79 digits */
-   {270, 800, 35000, 27,   28 *  65536, 102}, /* 82 digits */
-   {280, 900, 40000, 29,   28 *  65536, 104}, /* 85 digits */
-   {290, 1000, 60000, 29,  32 *  65536, 106}, /* 88 digits */
-   {300, 1100, 140000, 30,  32 * 65536, 108} /* 91 digits */ 
+   {10,   50,   90,  5,   2 *  1500,  18,   0}, /* */
+   {20,   50,   90,  6,   2 *  1600,  18,   0}, /* */
+   {30,   50,   100,  6,   2 *  1800,  19,   0}, /* */
+   {40,   50,   100,  8,   2 *  2000,  20,   0}, /* 13 digits */
+   {50,   50,   100,  8,   2 *  2500,  22,   0}, /* 16 digits */
+   {60,   50,   100,  9,   2 *  3000,  24,   0}, /* 19 digits */
+   {70,  100,   250,  9,   2 *  6000,  25,   0}, /* 22 digits */
+   {80,  100,   250,  9,   2 *  8000,  26,   0}, /* 25 digits */
+   {90,  100,   250,  9,   2 *  9000,  30,   0}, /* 28 digits */
+   {100, 100,   250,  9,   2 *  10000, 34,   0}, /* 31 digits */
+   {110, 100,   250,  9,   2 *  30000, 38,   0}, /* 34 digits */
+   {120, 100,   700,  9,   2 *  40000, 49,   0}, /* 37 digits */
+   {130, 100,   800,  9,   2 *  50000, 59,   0}, /* 40 digits */
+   {140, 100,  1200,  9,   2 *  65536, 66,   0}, /* 43 digits */
+   {150, 100,  1500, 10,   2 *  65536, 70,   0}, /* 46 digit */
+   {160, 150,  2000, 11,   4 *  65536, 73,   0}, /* 49 digit */
+   {170, 150,  2000, 12,   4 *  65536, 75,   0}, /* 52 digits */
+   {180, 150,  3000, 12,   4 *  65536, 76,   0}, /* 55 digits */
+   {190, 150,  3000, 13,   4 *  65536, 78,   0}, /* 58 digit */
+   {200, 200,  4500, 14,   4 *  65536, 81,   0}, /* 61 digits */
+   {210, 100,  8000, 14,   12 *  65536, 84,   0}, /* 64 digits */
+   {220, 300, 10000, 15,   12 *  65536, 88,   0}, /* 67 digits */
+   {230, 400, 20000, 17,   20 *  65536, 90,   0}, /* 70 digits */
+   {240, 450, 20000, 19,   20 *  65536, 93,   0}, /* 73 digis */
+   {250, 500, 22000, 22,   24 *  65536, 97,   0}, /* 76 digits */
+   {260, 600, 25000, 25,   24 *  65536, 100,   0}, /* 79 digits */
+   {270, 800, 35000, 27,   28 *  65536, 102,   0}, /* 82 digits */
+   {280, 900, 40000, 29,   28 *  65536, 104,  10}, /* 85 digits */
+   {290, 1000, 60000, 29,  32 *  65536, 106,  12}, /* 88 digits */
+   {300, 1100, 140000, 30,  32 * 65536, 108,  14} /* 91 digits */ 
 };
 
 #endif
 
 /* number of entries in the tuning table */
-#define QS_TUNE_SIZE (sizeof(qsieve_tune)/(6*sizeof(mp_limb_t)))
+#define QS_TUNE_SIZE (sizeof(qsieve_tune)/(7*sizeof(mp_limb_t)))
 
 FLINT_DLL void qsieve_init(qs_t qs_inf, const fmpz_t n);
 
@@ -314,6 +385,19 @@ FLINT_DLL void qsieve_clear(qs_t qs_inf);
 
 FLINT_DLL void qsieve_factor(fmpz_factor_t factors, const fmpz_t n);
 
+FLINT_DLL void qsieve_factor_checkpoint(fmpz_factor_t factors,
+                        const fmpz_t n, const char * fname, double interval);
+
+FLINT_DLL void qsieve_checkpoint_init(qs_checkpoint_t C);
+
+FLINT_DLL void qsieve_checkpoint_clear(qs_checkpoint_t C);
+
+FLINT_DLL int qsieve_checkpoint_write(qs_t qs_inf, const char * fname);
+
+FLINT_DLL int qsieve_checkpoint_read(qs_checkpoint_t C, const char * fname);
+
+FLINT_DLL int qsieve_checkpoint_restore(qs_t qs_inf, const qs_checkpoint_t C);
+
 FLINT_DLL prime_t * compute_factor_base(mp_limb_t * small_factor, qs_t qs_inf,
                                                              slong num_primes);
 
@@ -359,14 +443,47 @@ FLINT_DLL int qsieve_relations_cmp(const void * a, const void * b);
 
 FLINT_DLL slong qsieve_merge_relations(qs_t qs_inf);
 
-FLINT_DLL void qsieve_write_to_file(qs_t qs_inf, mp_limb_t prime,
-                                                     fmpz_t Y, qs_poly_t poly);
+FLINT_DLL void qsieve_set_double_large_prime(int flag);
+
+FLINT_DLL int qsieve_get_double_large_prime(void);
+
+FLINT_DLL void qsieve_set_spill_limit(slong bytes);
+
+FLINT_DLL slong qsieve_get_spill_limit(void);
+
+FLINT_DLL void qsieve_store_init(qs_t qs_inf);
+
+FLINT_DLL void qsieve_store_clear(qs_t qs_inf);
+
+FLINT_DLL void qsieve_store_reset(qs_t qs_inf);
+
+FLINT_DLL void qsieve_store_append(qs_t qs_inf, const mp_limb_t * rels,
+                                                        slong len, slong num);
+
+FLINT_DLL slong qsieve_store_read_spill(qs_t qs_inf,
+                                         mp_limb_t ** buf, slong * alloc);
+
+static __inline__
+slong qsieve_packed_length(qs_t qs_inf, const mp_limb_t * rel)
+{
+   slong pos = 3 + qs_inf->small_primes + 2*(slong) rel[2];
+   slong size = (slong) rel[pos];
+
+   return pos + 1 + FLINT_ABS(size);
+}
+
+FLINT_DLL void qsieve_write_to_buffer(qs_t qs_inf, mp_limb_t prime,
+                                mp_limb_t prime2, fmpz_t Y, qs_poly_t poly);
+
+FLINT_DLL void qsieve_flush_relations(qs_t qs_inf);
 
 FLINT_DLL hash_t * qsieve_get_table_entry(qs_t qs_inf, mp_limb_t prime);
 
 FLINT_DLL void qsieve_add_to_hashtable(qs_t qs_inf, mp_limb_t prime);
 
-FLINT_DLL relation_t qsieve_parse_relation(qs_t qs_inf, char * str);
+FLINT_DLL void qsieve_add_edge(qs_t qs_inf, mp_limb_t prime, mp_limb_t prime2);
+
+FLINT_DLL relation_t qsieve_unpack_relation(qs_t qs_inf, const mp_limb_t * rel);
 
 FLINT_DLL relation_t qsieve_merge_relation(qs_t qs_inf, relation_t  a, relation_t  b);
 
@@ -426,9 +543,22 @@ FLINT_DLL void reduce_matrix(qs_t qs_inf, slong *nrows, slong *ncols, la_col_t *
 FLINT_DLL uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 			slong dense_rows, slong ncols, la_col_t *B);
 
+FLINT_DLL uint64_t * block_lanczos_threaded_pool(flint_rand_t state,
+                      slong nrows, slong dense_rows, slong ncols, la_col_t *B,
+                      const thread_pool_handle * handles, slong num_handles);
+
+FLINT_DLL uint64_t * qsieve_dense_nullspace(flint_rand_t state, slong nrows,
+                                                 slong ncols, la_col_t * B);
+
+FLINT_DLL void _qsieve_square_root(fmpz_t X, fmpz_t Y, qs_t qs_inf,
+   uint64_t * nullrows, slong ncols, slong l, fmpz_t N, slong * prime_count);
+
 FLINT_DLL void qsieve_square_root(fmpz_t X, fmpz_t Y, qs_t qs_inf,
    uint64_t * nullrows, slong ncols, slong l, fmpz_t N);
 
+FLINT_DLL slong qsieve_square_root_factors(fmpz * facs, qs_t qs_inf,
+                           uint64_t * nullrows, slong ncols, uint64_t mask);
+
 #ifdef __cplusplus
 }
 #endif
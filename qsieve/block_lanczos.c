@@ -25,6 +25,9 @@ benefit from your work.
 
 #define BIT(x) (((uint64_t)(1)) << (x))
 
+/* minimum number of matrix columns per thread in block_lanczos */
+#define LANCZOS_THREAD_MIN_COLS 2000
+
 static const uint64_t bitmask[64] = {
 	BIT( 0), BIT( 1), BIT( 2), BIT( 3), BIT( 4), BIT( 5), BIT( 6), BIT( 7),
 	BIT( 8), BIT( 9), BIT(10), BIT(11), BIT(12), BIT(13), BIT(14), BIT(15),
@@ -475,20 +478,15 @@ static slong find_nonsingular_sub(uint64_t *t, slong *s,
 }
 
 /*-------------------------------------------------------------------*/
-void mul_MxN_Nx64(slong vsize, slong dense_rows,
-		slong ncols, la_col_t *A,
-		uint64_t *x, uint64_t *b) {
+static void mul_MxN_Nx64_cols(slong dense_rows, slong start, slong stop,
+		la_col_t *A, uint64_t *x, uint64_t *b) {
 
-	/* Multiply the vector x[] by the matrix A (stored
-	   columnwise) and put the result in b[]. vsize
-	   refers to the number of uint64_t's allocated for
-	   x[] and b[]; vsize is probably different from ncols */
+	/* XOR the product of columns start to stop - 1 of A
+	   by the corresponding entries of x[] into b[] */
 
 	slong i, j;
 
-	memset(b, 0, vsize * sizeof(uint64_t));
-	
-	for (i = 0; i < ncols; i++) {
+	for (i = start; i < stop; i++) {
 		la_col_t *col = A + i;
 		slong *row_entries = col->data;
 		uint64_t tmp = x[i];
@@ -499,7 +497,7 @@ void mul_MxN_Nx64(slong vsize, slong dense_rows,
 	}
 
 	if (dense_rows) {
-		for (i = 0; i < ncols; i++) {
+		for (i = start; i < stop; i++) {
 			la_col_t *col = A + i;
 			slong *row_entries = col->data + col->weight;
 			uint64_t tmp = x[i];
@@ -515,16 +513,30 @@ void mul_MxN_Nx64(slong vsize, slong dense_rows,
 }
 
 /*-------------------------------------------------------------------*/
-void mul_trans_MxN_Nx64(slong dense_rows, slong ncols,
-			la_col_t *A, uint64_t *x, uint64_t *b) {
+void mul_MxN_Nx64(slong vsize, slong dense_rows,
+		slong ncols, la_col_t *A,
+		uint64_t *x, uint64_t *b) {
 
-	/* Multiply the vector x[] by the transpose of the
-	   matrix A and put the result in b[]. Since A is stored
-	   by columns, this is just a matrix-vector product */
+	/* Multiply the vector x[] by the matrix A (stored
+	   columnwise) and put the result in b[]. vsize
+	   refers to the number of uint64_t's allocated for
+	   x[] and b[]; vsize is probably different from ncols */
+
+	memset(b, 0, vsize * sizeof(uint64_t));
+	
+	mul_MxN_Nx64_cols(dense_rows, 0, ncols, A, x, b);
+}
+
+/*-------------------------------------------------------------------*/
+static void mul_trans_MxN_Nx64_cols(slong dense_rows, slong start,
+		slong stop, la_col_t *A, uint64_t *x, uint64_t *b) {
+
+	/* compute entries start to stop - 1 of the product
+	   of x[] by the transpose of A */
 
 	slong i, j;
 
-	for (i = 0; i < ncols; i++) {
+	for (i = start; i < stop; i++) {
 		la_col_t *col = A + i;
 		slong *row_entries = col->data;
 		uint64_t accum = 0;
@@ -536,7 +548,7 @@ void mul_trans_MxN_Nx64(slong dense_rows, slong ncols,
 	}
 
 	if (dense_rows) {
-		for (i = 0; i < ncols; i++) {
+		for (i = start; i < stop; i++) {
 			la_col_t *col = A + i;
 			slong *row_entries = col->data + col->weight;
 			uint64_t accum = b[i];
@@ -552,6 +564,183 @@ void mul_trans_MxN_Nx64(slong dense_rows, slong ncols,
 	}
 }
 
+/*-------------------------------------------------------------------*/
+void mul_trans_MxN_Nx64(slong dense_rows, slong ncols,
+			la_col_t *A, uint64_t *x, uint64_t *b) {
+
+	/* Multiply the vector x[] by the transpose of the
+	   matrix A and put the result in b[]. Since A is stored
+	   by columns, this is just a matrix-vector product */
+
+	mul_trans_MxN_Nx64_cols(dense_rows, 0, ncols, A, x, b);
+}
+
+/*-------------------------------------------------------------------*/
+
+/* The threaded matrix products below split the columns of A into
+   ranges of roughly equal weight, one per thread. For the product
+   by A each thread accumulates its columns into a private vector,
+   then the private vectors are XORed into b[], each thread summing
+   a range of rows. The product by the transpose of A needs no
+   reduction since each column gives one entry of the result */
+
+typedef struct {
+	la_col_t *A;
+	slong dense_rows;
+	slong vsize;
+	slong num_threads;
+	const thread_pool_handle *handles;
+	slong *col_split;     /* thread i handles columns col_split[i] to
+				 col_split[i + 1] - 1 */
+	uint64_t **partial;   /* private products, partial[0] is b */
+	uint64_t *x, *b;
+} mul_ctx_struct;
+
+typedef struct {
+	mul_ctx_struct *ctx;
+	slong idx;
+} mul_arg_t;
+
+static void mul_MxN_worker(void *varg) {
+
+	mul_arg_t *arg = (mul_arg_t *) varg;
+	mul_ctx_struct *ctx = arg->ctx;
+	uint64_t *b = ctx->partial[arg->idx];
+
+	memset(b, 0, ctx->vsize * sizeof(uint64_t));
+	mul_MxN_Nx64_cols(ctx->dense_rows, ctx->col_split[arg->idx],
+			ctx->col_split[arg->idx + 1], ctx->A, ctx->x, b);
+}
+
+static void mul_reduce_worker(void *varg) {
+
+	mul_arg_t *arg = (mul_arg_t *) varg;
+	mul_ctx_struct *ctx = arg->ctx;
+	slong start = (arg->idx * ctx->vsize) / ctx->num_threads;
+	slong stop = ((arg->idx + 1) * ctx->vsize) / ctx->num_threads;
+	slong i, j;
+
+	for (i = 1; i < ctx->num_threads; i++) {
+		uint64_t *p = ctx->partial[i];
+
+		for (j = start; j < stop; j++)
+			ctx->b[j] ^= p[j];
+	}
+}
+
+static void mul_trans_worker(void *varg) {
+
+	mul_arg_t *arg = (mul_arg_t *) varg;
+	mul_ctx_struct *ctx = arg->ctx;
+
+	mul_trans_MxN_Nx64_cols(ctx->dense_rows, ctx->col_split[arg->idx],
+			ctx->col_split[arg->idx + 1], ctx->A, ctx->x, ctx->b);
+}
+
+static void mul_run(mul_arg_t *args, void (*f)(void *)) {
+
+	mul_ctx_struct *ctx = args[0].ctx;
+	slong i;
+
+	for (i = 1; i < ctx->num_threads; i++)
+		thread_pool_wake(global_thread_pool, ctx->handles[i - 1], 0,
+							f, args + i);
+
+	f(args + 0);
+
+	for (i = 1; i < ctx->num_threads; i++)
+		thread_pool_wait(global_thread_pool, ctx->handles[i - 1]);
+}
+
+static void mul_ctx_init(mul_ctx_struct *ctx, mul_arg_t *args,
+		slong vsize, slong dense_rows, slong ncols, la_col_t *A,
+		const thread_pool_handle *handles, slong num_handles) {
+
+	slong i, j, weight, total;
+
+	ctx->A = A;
+	ctx->dense_rows = dense_rows;
+	ctx->vsize = vsize;
+	ctx->num_threads = num_handles + 1;
+	ctx->handles = handles;
+	ctx->col_split = (slong *)flint_malloc((num_handles + 2) * 
+						sizeof(slong));
+	ctx->partial = (uint64_t **)flint_malloc((num_handles + 1) *
+						sizeof(uint64_t *));
+
+	ctx->partial[0] = NULL;
+	for (i = 1; i <= num_handles; i++)
+		ctx->partial[i] = (uint64_t *)flint_malloc(vsize *
+						sizeof(uint64_t));
+
+	/* split the columns into ranges of roughly equal weight */
+
+	for (i = total = 0; i < ncols; i++)
+		total += A[i].weight + dense_rows;
+
+	ctx->col_split[0] = 0;
+	for (i = j = weight = 0; i < ncols && j < num_handles; i++) {
+		weight += A[i].weight + dense_rows;
+		if (weight * (num_handles + 1) >= (j + 1) * total)
+			ctx->col_split[++j] = i + 1;
+	}
+	while (j < num_handles)
+		ctx->col_split[++j] = ncols;
+	ctx->col_split[num_handles + 1] = ncols;
+
+	for (i = 0; i <= num_handles; i++) {
+		args[i].ctx = ctx;
+		args[i].idx = i;
+	}
+}
+
+static void mul_ctx_clear(mul_ctx_struct *ctx) {
+
+	slong i;
+
+	for (i = 1; i < ctx->num_threads; i++)
+		flint_free(ctx->partial[i]);
+
+	flint_free(ctx->partial);
+	flint_free(ctx->col_split);
+}
+
+static void mul_MxN_Nx64_threaded(mul_arg_t *args, 
+		uint64_t *x, uint64_t *b) {
+
+	mul_ctx_struct *ctx = args[0].ctx;
+
+	if (ctx->num_threads == 1) {
+		mul_MxN_Nx64(ctx->vsize, ctx->dense_rows, 
+			ctx->col_split[1], ctx->A, x, b);
+		return;
+	}
+
+	ctx->x = x;
+	ctx->b = b;
+	ctx->partial[0] = b;
+
+	mul_run(args, mul_MxN_worker);
+	mul_run(args, mul_reduce_worker);
+}
+
+static void mul_trans_MxN_Nx64_threaded(mul_arg_t *args,
+		uint64_t *x, uint64_t *b) {
+
+	mul_ctx_struct *ctx = args[0].ctx;
+
+	if (ctx->num_threads == 1) {
+		mul_trans_MxN_Nx64(ctx->dense_rows, ctx->col_split[1],
+				ctx->A, x, b);
+		return;
+	}
+
+	ctx->x = x;
+	ctx->b = b;
+
+	mul_run(args, mul_trans_worker);
+}
+
 /*-----------------------------------------------------------------------*/
 static void transpose_vector(slong ncols, uint64_t *v, uint64_t **trans) {
 
@@ -695,12 +884,14 @@ void combine_cols(slong ncols,
 }
 
 /*-----------------------------------------------------------------------*/
-uint64_t * block_lanczos(flint_rand_t state, slong nrows, 
-			slong dense_rows, slong ncols, la_col_t *B) {
+uint64_t * block_lanczos_threaded_pool(flint_rand_t state, slong nrows, 
+			slong dense_rows, slong ncols, la_col_t *B,
+			const thread_pool_handle *handles, slong num_handles) {
 	
 	/* Solve Bx = 0 for some nonzero x; the computed
 	   solution, containing up to 64 of these nullspace
-	   vectors, is returned */
+	   vectors, is returned. The products by B and its
+	   transpose are shared among the given threads */
 
 	uint64_t *vnext, *v[3], *x, *v0;
 	uint64_t *winv[3];
@@ -714,6 +905,8 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	slong dim0, dim1;
 	uint64_t mask0, mask1;
 	slong vsize;
+	mul_ctx_struct ctx;
+	mul_arg_t *args;
 
 	/* allocate all of the size-n variables. Note that because
 	   B has been preprocessed to ignore singleton rows, the
@@ -744,6 +937,16 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	f = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
 	f2 = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
 
+	/* small matrices are not worth splitting up */
+
+	num_handles = FLINT_MIN(num_handles, 
+				ncols / LANCZOS_THREAD_MIN_COLS);
+	num_handles = FLINT_MAX(num_handles, 0);
+	args = (mul_arg_t *)flint_malloc((num_handles + 1) *
+						sizeof(mul_arg_t));
+	mul_ctx_init(&ctx, args, vsize, dense_rows, ncols, B,
+						handles, num_handles);
+
 	/* The iterations computes v[0], vt_a_v[0],
 	   vt_a2_v[0], s[0] and winv[0]. Subscripts larger
 	   than zero represent past versions of these
@@ -777,8 +980,8 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 #endif
 
 	memcpy(x, v[0], vsize * sizeof(uint64_t));
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], scratch);
-	mul_trans_MxN_Nx64(dense_rows, ncols, B, scratch, v[0]);
+	mul_MxN_Nx64_threaded(args, v[0], scratch);
+	mul_trans_MxN_Nx64_threaded(args, scratch, v[0]);
 	memcpy(v0, v[0], vsize * sizeof(uint64_t));
 
 	/* perform the iteration */
@@ -790,8 +993,8 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 		   version of B, or B'B (apostrophe means 
 		   transpose). Use "A" to refer to B'B  */
 
-		mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], scratch);
-		mul_trans_MxN_Nx64(dense_rows, ncols, B, scratch, vnext);
+		mul_MxN_Nx64_threaded(args, v[0], scratch);
+		mul_trans_MxN_Nx64_threaded(args, scratch, vnext);
 
 		/* compute v0'*A*v0 and (A*v0)'(A*v0) */
 
@@ -923,6 +1126,8 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 #if QS_DEBUG
 		flint_printf("linear algebra failed; retrying...\n");
 #endif
+		mul_ctx_clear(&ctx);
+		flint_free(args);
 		flint_free(x);
 		flint_free(v[0]);
 		flint_free(v[1]);
@@ -933,14 +1138,17 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	/* convert the output of the iteration to an actual
 	   collection of nullspace vectors */
 
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, x, v[1]);
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], v[2]);
+	mul_MxN_Nx64_threaded(args, x, v[1]);
+	mul_MxN_Nx64_threaded(args, v[0], v[2]);
 
 	combine_cols(ncols, x, v[0], v[1], v[2]);
 
 	/* verify that these really are linear dependencies of B */
 
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, x, v[0]);
+	mul_MxN_Nx64_threaded(args, x, v[0]);
+
+	mul_ctx_clear(&ctx);
+	flint_free(args);
 	
 	for (i = 0; i < ncols; i++) {
 		if (v[0][i] != 0)
@@ -956,3 +1164,22 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	flint_free(v[2]);
 	return x;
 }
+
+/*-----------------------------------------------------------------------*/
+uint64_t * block_lanczos(flint_rand_t state, slong nrows, 
+			slong dense_rows, slong ncols, la_col_t *B) {
+
+	thread_pool_handle *handles;
+	slong num_handles;
+	uint64_t *x;
+
+	num_handles = flint_request_threads(&handles,
+					flint_get_num_threads());
+
+	x = block_lanczos_threaded_pool(state, nrows, dense_rows,
+					ncols, B, handles, num_handles);
+
+	flint_give_back_threads(handles, num_handles);
+
+	return x;
+}
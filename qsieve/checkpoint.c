@@ -0,0 +1,344 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "qsieve.h"
+
+/*
+   A checkpoint file consists of words: a magic number, the format version
+   and FLINT_BITS, then n, the multiplier, the number of factor base
+   primes, the state of the enumeration of A coefficients and the next A,
+   the relation counts, the packed relations in blocks each preceded by its
+   length and terminated by an empty block, and finally a checksum of all
+   the preceding words. Integers are written as their number of limbs
+   followed by the limbs.
+*/
+
+#define QS_CHECKPOINT_MAGIC UWORD(0x5153434b)
+
+/* bound on the limbs of an integer, to reject corrupt files early */
+#define QS_CHECKPOINT_MAX_SIZE 4096
+
+static void _checksum(mp_limb_t * sum, const mp_limb_t * w, slong len)
+{
+   slong i;
+
+   for (i = 0; i < len; i++)
+      *sum = ((*sum << 1) | (*sum >> (FLINT_BITS - 1))) ^ w[i];
+}
+
+static int _write_words(FILE * f, const mp_limb_t * w, slong len,
+                                                             mp_limb_t * sum)
+{
+   _checksum(sum, w, len);
+
+   return fwrite(w, sizeof(mp_limb_t), len, f) == (size_t) len;
+}
+
+static int _write_word(FILE * f, mp_limb_t w, mp_limb_t * sum)
+{
+   return _write_words(f, &w, 1, sum);
+}
+
+static int _write_fmpz(FILE * f, const fmpz_t x, mp_limb_t * sum)
+{
+   slong size = fmpz_size(x);
+   mp_limb_t * limbs;
+   int ok;
+
+   if (!_write_word(f, size, sum))
+      return 0;
+
+   if (size == 0)
+      return 1;
+
+   limbs = flint_malloc(size*sizeof(mp_limb_t));
+   fmpz_get_ui_array(limbs, size, x);
+   ok = _write_words(f, limbs, size, sum);
+   flint_free(limbs);
+
+   return ok;
+}
+
+static int _read_words(FILE * f, mp_limb_t * w, slong len, mp_limb_t * sum)
+{
+   if (fread(w, sizeof(mp_limb_t), len, f) != (size_t) len)
+      return 0;
+
+   _checksum(sum, w, len);
+
+   return 1;
+}
+
+static int _read_slong(FILE * f, slong * w, mp_limb_t * sum)
+{
+   mp_limb_t t;
+
+   if (!_read_words(f, &t, 1, sum))
+      return 0;
+
+   *w = t;
+
+   return 1;
+}
+
+static int _read_fmpz(FILE * f, fmpz_t x, mp_limb_t * sum)
+{
+   slong size;
+   mp_limb_t * limbs;
+   int ok;
+
+   if (!_read_slong(f, &size, sum) || size < 0
+                                     || size > QS_CHECKPOINT_MAX_SIZE)
+      return 0;
+
+   if (size == 0)
+   {
+      fmpz_zero(x);
+      return 1;
+   }
+
+   limbs = flint_malloc(size*sizeof(mp_limb_t));
+   ok = _read_words(f, limbs, size, sum);
+   if (ok)
+      fmpz_set_ui_array(x, limbs, size);
+   flint_free(limbs);
+
+   return ok;
+}
+
+void qsieve_checkpoint_init(qs_checkpoint_t C)
+{
+   fmpz_init(C->n);
+   fmpz_init(C->A);
+   C->s = 0;
+   C->curr_subset = NULL;
+   C->first_subset = NULL;
+   C->A_ind = NULL;
+   C->num_relations = 0;
+   C->length = 0;
+   C->relations = NULL;
+}
+
+void qsieve_checkpoint_clear(qs_checkpoint_t C)
+{
+   fmpz_clear(C->n);
+   fmpz_clear(C->A);
+   flint_free(C->curr_subset);
+   flint_free(C->first_subset);
+   flint_free(C->A_ind);
+   flint_free(C->relations);
+}
+
+/*
+   Write the state of the sieve at the start of sieving with the current A
+   coefficient to fname. The file is written under a temporary name which
+   then replaces fname, so that an interrupted write does not destroy an
+   earlier checkpoint. Returns 1 if successful, 0 otherwise.
+*/
+int qsieve_checkpoint_write(qs_t qs_inf, const char * fname)
+{
+   rel_store_t * store = &qs_inf->store;
+   char * tmpname;
+   FILE * f;
+   mp_limb_t sum = 0, * buf = NULL;
+   slong s = qs_inf->s, len, alloc = 0;
+   int ok;
+
+   tmpname = flint_malloc(strlen(fname) + 5);
+   strcpy(tmpname, fname);
+   strcat(tmpname, ".tmp");
+
+   f = fopen(tmpname, "wb");
+
+   if (f == NULL)
+   {
+      flint_free(tmpname);
+      return 0;
+   }
+
+   ok = _write_word(f, QS_CHECKPOINT_MAGIC, &sum)
+     && _write_word(f, QS_CHECKPOINT_VERSION, &sum)
+     && _write_word(f, FLINT_BITS, &sum)
+     && _write_fmpz(f, qs_inf->n, &sum)
+     && _write_word(f, qs_inf->k, &sum)
+     && _write_word(f, qs_inf->num_primes, &sum)
+     && _write_word(f, s, &sum)
+     && _write_word(f, qs_inf->low, &sum)
+     && _write_word(f, qs_inf->high, &sum)
+     && _write_word(f, qs_inf->span, &sum)
+     && _write_word(f, qs_inf->h, &sum)
+     && _write_word(f, qs_inf->m, &sum)
+     && _write_word(f, qs_inf->j, &sum)
+     && _write_word(f, qs_inf->A_ind_diff, &sum)
+     && _write_words(f, qs_inf->curr_subset, s, &sum)
+     && _write_words(f, qs_inf->first_subset, s, &sum)
+     && _write_words(f, qs_inf->A_ind, s, &sum)
+     && _write_fmpz(f, qs_inf->A, &sum)
+     && _write_word(f, qs_inf->full_relation, &sum)
+     && _write_word(f, qs_inf->edges, &sum)
+     && _write_word(f, store->num, &sum);
+
+   /* relations spilled to file, then those held in memory */
+   if (ok && store->spill != NULL)
+   {
+      rewind(store->spill);
+
+      while (ok && (len = qsieve_store_read_spill(qs_inf, &buf, &alloc)) != 0)
+      {
+         ok = _write_word(f, len, &sum)
+           && _write_words(f, buf, len, &sum);
+      }
+
+      flint_free(buf);
+   }
+
+   if (ok && store->length != 0)
+   {
+      ok = _write_word(f, store->length, &sum)
+        && _write_words(f, store->data, store->length, &sum);
+   }
+
+   ok = ok && _write_word(f, 0, &sum);
+   ok = ok && (fwrite(&sum, sizeof(mp_limb_t), 1, f) == 1);
+   ok = (fclose(f) == 0) && ok;
+
+   if (ok && rename(tmpname, fname) != 0)
+   {
+      /* rename does not replace existing files on some systems */
+      remove(fname);
+      ok = (rename(tmpname, fname) == 0);
+   }
+
+   if (!ok)
+      remove(tmpname);
+
+   flint_free(tmpname);
+
+   return ok;
+}
+
+/*
+   Read the checkpoint in fname into C. Returns 1 if successful, 0 if the
+   file does not exist, or -1 if it is for a different version of the
+   format or word size, or is corrupt.
+*/
+int qsieve_checkpoint_read(qs_checkpoint_t C, const char * fname)
+{
+   FILE * f;
+   mp_limb_t sum = 0, check, word[3];
+   slong len;
+   int ok;
+
+   f = fopen(fname, "rb");
+
+   if (f == NULL)
+      return 0;
+
+   ok = _read_words(f, word, 3, &sum)
+     && word[0] == QS_CHECKPOINT_MAGIC
+     && word[1] == QS_CHECKPOINT_VERSION
+     && word[2] == FLINT_BITS
+     && _read_fmpz(f, C->n, &sum)
+     && _read_words(f, &C->k, 1, &sum)
+     && _read_slong(f, &C->num_primes, &sum)
+     && _read_slong(f, &C->s, &sum)
+     && C->s > 0 && C->s <= FLINT_BITS
+     && _read_slong(f, &C->low, &sum)
+     && _read_slong(f, &C->high, &sum)
+     && _read_slong(f, &C->span, &sum)
+     && _read_slong(f, &C->h, &sum)
+     && _read_slong(f, &C->m, &sum)
+     && _read_words(f, &C->j, 1, &sum)
+     && _read_slong(f, &C->A_ind_diff, &sum);
+
+   if (ok)
+   {
+      C->curr_subset = flint_realloc(C->curr_subset, C->s*sizeof(mp_limb_t));
+      C->first_subset = flint_realloc(C->first_subset, C->s*sizeof(mp_limb_t));
+      C->A_ind = flint_realloc(C->A_ind, C->s*sizeof(mp_limb_t));
+
+      ok = _read_words(f, C->curr_subset, C->s, &sum)
+        && _read_words(f, C->first_subset, C->s, &sum)
+        && _read_words(f, C->A_ind, C->s, &sum)
+        && _read_fmpz(f, C->A, &sum)
+        && _read_slong(f, &C->full_relation, &sum)
+        && _read_slong(f, &C->edges, &sum)
+        && _read_slong(f, &C->num_relations, &sum);
+   }
+
+   C->length = 0;
+
+   while (ok && (ok = _read_slong(f, &len, &sum)) && len != 0)
+   {
+      if (len < 0 || len > WORD_MAX/(2*sizeof(mp_limb_t)) - C->length)
+      {
+         ok = 0;
+         break;
+      }
+
+      C->relations = flint_realloc(C->relations,
+                                       (C->length + len)*sizeof(mp_limb_t));
+      ok = _read_words(f, C->relations + C->length, len, &sum);
+      C->length += len;
+   }
+
+   ok = ok && (fread(&check, sizeof(mp_limb_t), 1, f) == 1) && check == sum;
+
+   fclose(f);
+
+   return ok ? 1 : -1;
+}
+
+/*
+   Restore the enumeration of A coefficients and the relations from the
+   checkpoint C. This must be called after qsieve_init_A for a factor base
+   of the same size as that of the checkpoint. Returns 1 if successful, or
+   0 if the checkpoint does not match the parameters of qs_inf, in which
+   case qs_inf is unchanged.
+*/
+int qsieve_checkpoint_restore(qs_t qs_inf, const qs_checkpoint_t C)
+{
+   slong i, s = qs_inf->s;
+
+   if (C->k != qs_inf->k || C->num_primes != qs_inf->num_primes
+    || C->s != s || C->low != qs_inf->low || C->high != qs_inf->high
+    || C->span != qs_inf->span)
+      return 0;
+
+   qs_inf->h = C->h;
+   qs_inf->m = C->m;
+   qs_inf->j = C->j;
+   qs_inf->A_ind_diff = C->A_ind_diff;
+
+   for (i = 0; i < s; i++)
+   {
+      qs_inf->curr_subset[i] = C->curr_subset[i];
+      qs_inf->first_subset[i] = C->first_subset[i];
+      qs_inf->A_ind[i] = C->A_ind[i];
+   }
+
+   fmpz_set(qs_inf->A, C->A);
+
+   /* the graph of large primes is rebuilt from the partials */
+   for (i = 0; i < C->length; i += qsieve_packed_length(qs_inf, C->relations + i))
+   {
+      if (C->relations[i] != 1)
+         qsieve_add_edge(qs_inf, C->relations[i], C->relations[i + 1]);
+   }
+
+   qsieve_store_append(qs_inf, C->relations, C->length, C->num_relations);
+
+   qs_inf->full_relation = C->full_relation;
+   qs_inf->edges = C->edges;
+
+   return 1;
+}
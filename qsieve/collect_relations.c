@@ -203,7 +203,7 @@ void qsieve_do_sieving2(qs_t qs_inf, unsigned char * sieve, qs_poly_t poly)
 slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_poly_t poly)
 {
    slong bits, exp, extra_bits;
-   mp_limb_t modp, prime;
+   mp_limb_t modp, prime, prime2, cofactor, lp_bound;
    slong num_primes = qs_inf->num_primes;
    prime_t * factor_base = qs_inf->factor_base;
    slong * small = poly->small; /* exponents of small primes and mult. */
@@ -369,16 +369,8 @@ slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_
 
          poly->num_factors = num_factors;
 
-#if FLINT_USES_PTHREAD
-         pthread_mutex_lock(&qs_inf->mutex);
-#endif
-	 qsieve_write_to_file(qs_inf, 1, Y, poly);
-         
-         qs_inf->full_relation++;
+         qsieve_write_to_buffer(qs_inf, 1, 1, Y, poly);
 
-#if FLINT_USES_PTHREAD
-         pthread_mutex_unlock(&qs_inf->mutex);
-#endif
          relations++;
       } else /* not a relation, perhaps a partial? */
       {
@@ -390,45 +382,67 @@ slong qsieve_evaluate_candidate(qs_t qs_inf, ulong i, unsigned char * sieve, qs_
           } else
               small[2] = 0;
 
-          /* if we have a small cofactor (at most 30 bits) */
-          if (fmpz_bits(res) <= 30)
+          /*
+             a large prime is taken heuristically to be < 60 times largest
+             FB prime; skip values not coprime with multiplier, as this
+             will lead to factors of kn, not n
+          */
+          lp_bound = 60*factor_base[qs_inf->num_primes - 1].p;
+          prime = prime2 = 0;
+
+          if (fmpz_abs_fits_ui(res))
           {
-              prime = fmpz_get_ui(res);
-              
-              /*
-                 a large prime is taken heuristically to be < 60 times largest
-                 FB prime; skip values not coprime with multiplier, as this
-                 will lead to factors of kn, not n
-              */ 
-              if (prime < 60*factor_base[qs_inf->num_primes - 1].p && n_gcd(prime, qs_inf->k) == 1)
+              cofactor = fmpz_get_ui(res);
+
+              /* if we have a small cofactor (at most 30 bits) */
+              if (FLINT_BIT_COUNT(cofactor) <= 30 && cofactor < lp_bound)
+              {
+                  prime = cofactor;
+                  prime2 = 1;
+              } else if (qs_inf->dlp && cofactor / lp_bound < lp_bound
+                                     && !n_is_prime(cofactor))
               {
-                  for (k = 0; k < qs_inf->s; k++)  /* commit any outstanding A factors */
+                  /*
+                     a composite cofactor below the square of the large prime
+                     bound may split into two large primes, a double partial
+                  */
+                  prime = n_factor_SQUFOF(cofactor, 1000);
+
+                  if (prime != 0)
                   {
-                      if (A_ind[k] >= j) /* check beyond where loop above ended */
+                      prime2 = cofactor / prime;
+
+                      if (prime > prime2)
                       {
-                          factor[num_factors].ind = A_ind[k];
-                          factor[num_factors++].exp = 1;
+                          cofactor = prime;
+                          prime = prime2;
+                          prime2 = cofactor;
                       }
-                  }
-
-                  poly->num_factors = num_factors;
-
-#if FLINT_USES_PTHREAD
-                  pthread_mutex_lock(&qs_inf->mutex);
-#endif
-                  /* store this partial in file */
 
-                  qsieve_write_to_file(qs_inf, prime, Y, poly);
+                      if (prime2 >= lp_bound || !n_is_prime(prime)
+                                             || !n_is_prime(prime2))
+                          prime = 0;
+                  }
+              }
+          }
 
-                  qs_inf->edges++;
+          if (prime != 0 && n_gcd(prime, qs_inf->k) == 1
+                         && n_gcd(prime2, qs_inf->k) == 1)
+          {
+              for (k = 0; k < qs_inf->s; k++)  /* commit any outstanding A factors */
+              {
+                  if (A_ind[k] >= j) /* check beyond where loop above ended */
+                  {
+                      factor[num_factors].ind = A_ind[k];
+                      factor[num_factors++].exp = 1;
+                  }
+              }
 
-                  qsieve_add_to_hashtable(qs_inf, prime);
+              poly->num_factors = num_factors;
 
-#if FLINT_USES_PTHREAD
-                  pthread_mutex_unlock(&qs_inf->mutex);
-#endif
+              /* store this partial in the buffer of this thread */
 
-              }
+              qsieve_write_to_buffer(qs_inf, prime, prime2, Y, poly);
           }
       }
 
@@ -577,6 +591,8 @@ slong qsieve_collect_relations(qs_t qs_inf, unsigned char * sieve)
         relations += args[i].rels;
     }
 
+    qsieve_flush_relations(qs_inf);
+
     flint_free(args);
 
     return relations;
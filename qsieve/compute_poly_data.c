@@ -47,7 +47,7 @@
 */
 int qsieve_init_A(qs_t qs_inf)
 {
-    slong i, j;
+    slong i, j, tries = 0;
     slong s, low, high, span, m, h;
     mp_limb_t bits, num_factors, rem, mid;
     mp_limb_t factor_bound[40];
@@ -226,6 +226,12 @@ int qsieve_init_A(qs_t qs_inf)
                 goto init_A_cleanup;
             }
 
+            if ((++tries & 1023) == 0 && flint_cancelled())
+            {
+                ret = 0;
+                goto init_A_cleanup;
+            }
+
             fmpz_set_ui(prod, 1);
 
             for (j = 0; j < s - 1; j++)
@@ -0,0 +1,69 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "qsieve.h"
+#include "gf2_mat.h"
+
+/*
+   Dense alternative to block Lanczos for small matrices: eliminate the
+   packed nrows x ncols matrix over GF(2) and return, as block_lanczos
+   does, 64 random combinations of a basis of its nullspace, bit l of
+   entry i being the i-th entry of the l-th vector. Unlike block Lanczos
+   this never fails.
+*/
+uint64_t * qsieve_dense_nullspace(flint_rand_t state, slong nrows,
+                                                 slong ncols, la_col_t * B)
+{
+   slong i, j, nullity;
+   uint64_t * nullrows;
+   gf2_mat_t A, X, R, Y;
+
+   gf2_mat_init(A, nrows, ncols);
+   gf2_mat_init(X, ncols, ncols);
+   gf2_mat_init(R, ncols, 64);
+   gf2_mat_init(Y, ncols, 64);
+
+   for (j = 0; j < ncols; j++)
+   {
+      for (i = 0; i < B[j].weight; i++)
+      {
+         slong r = B[j].data[i];
+         A->rows[r][j / FLINT_BITS] ^= UWORD(1) << (j % FLINT_BITS);
+      }
+   }
+
+   nullity = gf2_mat_nullspace(X, A);
+
+   /* mix the basis vectors so that repeated calls give new vectors */
+   for (i = 0; i < nullity; i++)
+      for (j = 0; j < R->stride; j++)
+         R->rows[i][j] = n_randlimb(state);
+
+   gf2_mat_mul(Y, X, R);
+
+   nullrows = (uint64_t *) flint_malloc(FLINT_MAX(ncols, 1)*sizeof(uint64_t));
+
+   for (i = 0; i < ncols; i++)
+   {
+#if FLINT64
+      nullrows[i] = Y->rows[i][0];
+#else
+      nullrows[i] = Y->rows[i][0] | ((uint64_t) Y->rows[i][1] << 32);
+#endif
+   }
+
+   gf2_mat_clear(A);
+   gf2_mat_clear(X);
+   gf2_mat_clear(R);
+   gf2_mat_clear(Y);
+
+   return nullrows;
+}
@@ -21,14 +21,6 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include <sys/types.h>
-#if (!defined (__WIN32) || defined(__CYGWIN__)) && !defined(_MSC_VER)
-#include <unistd.h>
-#endif
-#if defined (__WIN32) && !defined(__CYGWIN__)
-#include <windows.h>
-#endif
-
 int compare_facs(const void * a, const void * b)
 {
    fmpz * x = (fmpz *) a;
@@ -37,14 +29,39 @@ int compare_facs(const void * a, const void * b)
    return fmpz_cmp(x, y);
 }
 
+/* keep an unusable checkpoint, which would otherwise be overwritten */
+static void _qsieve_checkpoint_set_aside(const char * fname)
+{
+    char * badname = flint_malloc(strlen(fname) + 5);
+
+    strcpy(badname, fname);
+    strcat(badname, ".bad");
+
+    remove(badname);
+    rename(fname, badname);
+
+    flint_free(badname);
+}
+
 /*
    Finds at least one nontrivial factor of n using the self initialising
    multiple polynomial quadratic sieve with single large prime variation.
    Assumes n is not prime and not a perfect power.
+
+   If fname is not NULL, the run is resumed from the checkpoint in fname if
+   there is one, and a checkpoint is written to fname at the start of a new
+   A coefficient once at least interval seconds have passed since the last
+   one, and when the run is cancelled. The checkpoint is removed once the
+   run has finished. A checkpoint which cannot be used is kept under the
+   name fname.bad.
 */
-void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
+static void _qsieve_factor_checkpoint(fmpz_factor_t factors, const fmpz_t n,
+                                         const char * fname, double interval)
 {
     qs_t qs_inf;
+    qs_checkpoint_t ckpt;
+    int resume = 0, was_cancelled = 0;
+    time_t last_time;
     mp_limb_t small_factor, delta;
     ulong expt = 0;
     unsigned char * sieve;
@@ -52,10 +69,9 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
     uint64_t * nullrows = NULL;
     uint64_t mask;
     flint_rand_t state;
-    fmpz_t temp, temp2, X, Y;
+    fmpz_t temp, temp2;
     slong num_facs;
     fmpz * facs;
-    int nchars;
 
     if (fmpz_sgn(n) < 0)
     {
@@ -66,7 +82,7 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
        factors->sign *= -1;
        
-       qsieve_factor(factors, n2);
+       qsieve_factor_checkpoint(factors, n2, fname, interval);
 
        fmpz_clear(n2);
        
@@ -134,6 +150,28 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
     flint_printf("kn bits = %wd\n", qs_inf->bits);
 #endif
 
+    /* read checkpoint, if any */
+    qsieve_checkpoint_init(ckpt);
+
+    if (fname != NULL)
+    {
+        int res = qsieve_checkpoint_read(ckpt, fname);
+
+        if (res == 1 && !fmpz_equal(ckpt->n, qs_inf->n))
+        {
+            qsieve_checkpoint_clear(ckpt);
+            qsieve_clear(qs_inf);
+
+            flint_throw(FLINT_ERROR, "Checkpoint %s is for a different "
+                            "integer in qsieve_factor_checkpoint\n", fname);
+        }
+
+        if (res == 1)
+            resume = 1;
+        else if (res == -1)
+            _qsieve_checkpoint_set_aside(fname);
+    }
+
     /**************************************************************************
         COMPUTE FACTOR BASE:
     **************************************************************************/
@@ -145,6 +183,11 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
     /* compute factor base primes and associated data */
     small_factor = qsieve_primes_init(qs_inf);
 
+    /* factor base was enlarged before the checkpoint */
+    if (!small_factor && resume && ckpt->num_primes > qs_inf->num_primes)
+        small_factor = qsieve_primes_increment(qs_inf,
+                                     ckpt->num_primes - qs_inf->num_primes);
+
     if (small_factor)
     {
 
@@ -159,18 +202,20 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
         _fmpz_factor_append_ui(factors, small_factor, expt);
         
         qsieve_clear(qs_inf);
+        qsieve_checkpoint_clear(ckpt);
 
         fmpz_factor_no_trial(factors, temp);
 
         fmpz_clear(temp);
 
+        if (fname != NULL)
+            remove(fname);
+
         return;
     }
 
     fmpz_init(temp);
     fmpz_init(temp2);
-    fmpz_init(X);
-    fmpz_init(Y);
 
     /**************************************************************************
         INITIALISE RELATION/LINEAR ALGEBRA DATA:
@@ -201,16 +246,8 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 #if FLINT_USES_PTHREAD
     pthread_mutex_init(&qs_inf->mutex, NULL);
 #endif
-    
-#if defined (__WIN32) && !defined(__CYGWIN__)
-    srand((int) GetCurrentProcessId());
-#else
-    srand((int) getpid());
-#endif
-    nchars = sprintf(qs_inf->fname, "%d", (int) rand());
-    strcat(qs_inf->fname + nchars, "siqs.dat");
 
-    qs_inf->siqs = fopen(qs_inf->fname, "w");
+    qsieve_store_init(qs_inf);
 
     for (j = qs_inf->small_primes; j < qs_inf->num_primes; j++)
     {
@@ -231,13 +268,38 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
         else
         {
             if (!qsieve_init_A(qs_inf))
+            {
+                if (flint_cancelled())
+                    goto cancelled;
+
                 goto more_primes; /* initialisation failed, increase FB */
+            }
+
+            if (resume) /* continue from the checkpoint */
+            {
+                if (!qsieve_checkpoint_restore(qs_inf, ckpt))
+                    _qsieve_checkpoint_set_aside(fname);
+
+                resume = 0;
+            }
         }
 
+        last_time = time(NULL);
+
         do
         {           
+            if (fname != NULL && (flint_cancelled()
+                    || difftime(time(NULL), last_time) >= interval))
+            {
+                qsieve_checkpoint_write(qs_inf, fname);
+                last_time = time(NULL);
+            }
+
+            if (flint_cancelled())
+                goto cancelled;
+
             relation += qsieve_collect_relations(qs_inf, sieve);
-                
+
             qs_inf->num_cycles = qs_inf->edges + qs_inf->components - qs_inf->vertices;
 
 #if QS_DEBUG
@@ -252,8 +314,6 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
             {
                 int ok;
 
-                fclose(qs_inf->siqs);
-
                 ok = qsieve_process_relation(qs_inf);
 
                 if (ok == -1)
@@ -293,9 +353,12 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
  
                     flint_randinit(state); /* initialise the random generator */
 
-                    do /* repeat block lanczos until it succeeds */
+                    if (ncols <= QS_DENSE_NULLSPACE_CUTOFF) /* small matrices are eliminated directly */
+                        nullrows = qsieve_dense_nullspace(state, nrows, ncols, qs_inf->matrix);
+                    else do /* repeat block lanczos until it succeeds */
                     {
-                        nullrows = block_lanczos(state, nrows, 0, ncols, qs_inf->matrix);
+                        nullrows = block_lanczos_threaded_pool(state, nrows, 0, ncols,
+                                         qs_inf->matrix, qs_inf->handles, qs_inf->num_handles);
                     } while (nullrows == NULL);
 
                     for (i = 0, mask = 0; i < ncols; i++) /* create mask of nullspace vectors */
@@ -320,21 +383,7 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 #endif
 
                     facs = _fmpz_vec_init(100);
-                    num_facs = 0;
-
-                    for (i = 0; i < 64; i++)
-                    {
-                        if (mask & ((uint64_t)(1) << i))
-                        {
-                            qsieve_square_root(X, Y, qs_inf, nullrows, ncols, i, qs_inf->kn);
-
-                            fmpz_sub(X, X, Y);
-                            fmpz_gcd(X, X, qs_inf->n);
-
-                            if (fmpz_cmp(X, qs_inf->n) != 0 && fmpz_cmp_ui(X, 1) != 0) /* have a factor */
-                                fmpz_set(facs + num_facs++, X);
-                        }
-                    }
+                    num_facs = qsieve_square_root_factors(facs, qs_inf, nullrows, ncols, mask);
 
                     flint_free(nullrows);
 
@@ -366,7 +415,7 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
                     _fmpz_vec_clear(facs, 100);
 
-                    qs_inf->siqs = fopen(qs_inf->fname, "w");
+                    qsieve_store_reset(qs_inf);
                     qs_inf->num_primes = num_primes; /* linear algebra adjusts this */
                     goto more_primes; /* factoring failed, may need more primes */
                 }
@@ -427,6 +476,11 @@ found_small_factor:
         relation = 0;
     }
 
+cancelled: /* leave n unfactored */
+
+    was_cancelled = 1;
+    _fmpz_factor_append(factors, qs_inf->n, 1);
+
     /**************************************************************************
         CLEANUP:
         Clean up allocated memory
@@ -445,12 +499,29 @@ cleanup:
     flint_give_back_threads(qs_inf->handles, qs_inf->num_handles);
 
     flint_free(sieve);
-    remove(qs_inf->fname);
+    qsieve_store_clear(qs_inf);
+    qsieve_checkpoint_clear(ckpt);
+
+    if (fname != NULL && !was_cancelled)
+        remove(fname);
     qsieve_clear(qs_inf);
     qsieve_linalg_clear(qs_inf);
     qsieve_poly_clear(qs_inf);
-    fmpz_clear(X);
-    fmpz_clear(Y);
     fmpz_clear(temp);
     fmpz_clear(temp2);
 }
+
+void qsieve_factor_checkpoint(fmpz_factor_t factors, const fmpz_t n,
+                                         const char * fname, double interval)
+{
+    slong module = _flint_memory_stats_enter("qsieve_factor");
+
+    _qsieve_factor_checkpoint(factors, n, fname, interval);
+
+    flint_memory_stats_set_module(module);
+}
+
+void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
+{
+    qsieve_factor_checkpoint(factors, n, NULL, 0);
+}
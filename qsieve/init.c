@@ -12,12 +12,26 @@
 
 #include "qsieve.h"
 
+/*
+   Whether to use the double large prime variant: -1 to decide from the
+   tuning table, 0 to never use it and 1 to always use it
+*/
+FLINT_TLS_PREFIX int _qsieve_dlp = -1;
+
+void qsieve_set_double_large_prime(int flag)
+{
+    _qsieve_dlp = flag < 0 ? -1 : (flag != 0);
+}
+
+int qsieve_get_double_large_prime(void)
+{
+    return _qsieve_dlp;
+}
+
 void qsieve_init(qs_t qs_inf, const fmpz_t n)
 {
     slong i;
 
-    qs_inf->fname = (char *) flint_malloc(20); /* space for filename */
-
     /* store n in struct */
     fmpz_init_set(qs_inf->n, n);
 
@@ -33,6 +47,13 @@ void qsieve_init(qs_t qs_inf, const fmpz_t n)
     i--;
 
     qs_inf->ks_primes = qsieve_tune[i][1]; /* number of Knuth-Schroeppel primes */
+
+    /* use double large primes where the tuning table lowers the threshold */
+    if (_qsieve_dlp < 0)
+        qs_inf->dlp = (qsieve_tune[i][6] != 0);
+    else
+        qs_inf->dlp = _qsieve_dlp;
+
     qs_inf->num_primes  = 0;
     qs_inf->num_relations = 0;
     qs_inf->full_relation = 0;
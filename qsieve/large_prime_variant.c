@@ -10,7 +10,6 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
-#include <ctype.h>
 #include "qsieve.h"
 
 #define HASH_MULT (2654435761U)       /* hash function, taken from 'msieve' */
@@ -29,7 +28,7 @@ void qsieve_display_relation(qs_t qs_inf, relation_t a)
 {
     slong i;
 
-    flint_printf("%wu ", a.lp);
+    flint_printf("%wu %wu ", a.lp, a.lp2);
 
     for (i = 0; i < qs_inf->small_primes; i++)
         flint_printf("%wd ", a.small[i]);
@@ -73,6 +72,7 @@ int qsieve_is_relation(qs_t qs_inf, relation_t a)
     }
 
     fmpz_mul_ui(temp2, temp2, a.lp);
+    fmpz_mul_ui(temp2, temp2, a.lp2);
     fmpz_pow_ui(temp, a.Y, UWORD(2));
     fmpz_mod(temp, temp, qs_inf->kn);
     fmpz_mod(temp2, temp2, qs_inf->kn);
@@ -89,30 +89,100 @@ int qsieve_is_relation(qs_t qs_inf, relation_t a)
 }
 
 /*
-    Write partial or full relation to file
+    Append partial or full relation, packed, to the relation buffer of the
+    thread owning 'poly'. For a full relation both primes are 1, for a
+    single partial 'prime2' is 1. This lets sieving threads record relations without
+    taking a lock; the buffers are moved to the relation store by
+    qsieve_flush_relations.
 */
-void qsieve_write_to_file(qs_t qs_inf, mp_limb_t prime, fmpz_t Y, qs_poly_t poly)
+void qsieve_write_to_buffer(qs_t qs_inf, mp_limb_t prime, mp_limb_t prime2,
+                                                     fmpz_t Y, qs_poly_t poly)
 {
-    slong i;
-    char * str = NULL;
+    slong i, len, size;
+    mp_limb_t * rel;
     slong num_factors = poly->num_factors;
     slong * small = poly->small;
     fac_t * factor = poly->factor;
 
-    flint_fprintf(qs_inf->siqs, "%X ", prime); /* write large prime */
+    size = fmpz_size(Y);
+    len = 4 + qs_inf->small_primes + 2*num_factors + size;
 
-    for (i = 0; i < qs_inf->small_primes; i++) /* write small primes */
-        flint_fprintf(qs_inf->siqs, "%X ", small[i]);
+    if (poly->rel_len + len > poly->rel_alloc)
+    {
+        poly->rel_alloc = FLINT_MAX(poly->rel_len + len, 2*poly->rel_alloc);
+        poly->rel_buf = flint_realloc(poly->rel_buf,
+                                           poly->rel_alloc*sizeof(mp_limb_t));
+    }
 
-    flint_fprintf(qs_inf->siqs, "%X ", num_factors); /* write number of factors */
+    rel = poly->rel_buf + poly->rel_len;
+
+    *rel++ = prime; /* write large primes */
+    *rel++ = prime2;
+
+    *rel++ = num_factors; /* write number of factors */
+
+    for (i = 0; i < qs_inf->small_primes; i++) /* write small primes */
+        *rel++ = small[i];
 
     for (i = 0; i < num_factors; i++) /* write factor along with exponent */
-        flint_fprintf(qs_inf->siqs, "%wx %X ", factor[i].ind, factor[i].exp);
+    {
+        *rel++ = factor[i].ind;
+        *rel++ = factor[i].exp;
+    }
+
+    if (fmpz_sgn(Y) < 0) /* write value of 'Y' */
+    {
+        *rel++ = -size;
+        fmpz_neg(Y, Y);
+        fmpz_get_ui_array(rel, size, Y);
+        fmpz_neg(Y, Y);
+    } else
+    {
+        *rel++ = size;
+        if (size != 0)
+            fmpz_get_ui_array(rel, size, Y);
+    }
+
+    poly->rel_len += len;
+    poly->rel_num++;
+}
+
+/*
+    Move the relations buffered by each thread to the relation store, count
+    them and enter the large primes of partials into the hash table
+*/
+void qsieve_flush_relations(qs_t qs_inf)
+{
+    slong i, j;
+    mp_limb_t prime;
+    qs_poly_s * poly;
+
+    for (i = 0; i <= qs_inf->num_handles; i++)
+    {
+        poly = qs_inf->poly + i;
 
-    str = fmpz_get_str(str, 16, Y); /* converting value of 'Y'  to hex */
+        if (poly->rel_len == 0)
+            continue;
 
-    flint_fprintf(qs_inf->siqs, "%s\n", str); /* write value of 'Y' */
-    flint_free(str);
+        for (j = 0; j < poly->rel_len;
+                             j += qsieve_packed_length(qs_inf, poly->rel_buf + j))
+        {
+            prime = poly->rel_buf[j];
+
+            if (prime == 1)
+                qs_inf->full_relation++;
+            else
+            {
+                qs_inf->edges++;
+                qsieve_add_edge(qs_inf, prime, poly->rel_buf[j + 1]);
+            }
+        }
+
+        qsieve_store_append(qs_inf, poly->rel_buf, poly->rel_len, poly->rel_num);
+
+        poly->rel_len = 0;
+        poly->rel_num = 0;
+    }
 }
 
 /******************************************************************************
@@ -169,6 +239,7 @@ hash_t * qsieve_get_table_entry(qs_t qs_inf, mp_limb_t prime)
         entry->prime = prime;
         entry->next = hash_table[first_offset];
         entry->count = 0;
+        entry->parent = qs_inf->vertices;
         hash_table[first_offset] = qs_inf->vertices;
     }
     
@@ -187,6 +258,70 @@ void qsieve_add_to_hashtable(qs_t qs_inf, mp_limb_t prime)
     entry->count++;
 }
 
+/*
+   find the root of the tree containing the prime at 'offset' in the
+   union-find forest of large primes, halving the path on the way
+*/
+static mp_limb_t _qsieve_find_root(hash_t * table, mp_limb_t offset)
+{
+    while (table[offset].parent != offset)
+    {
+        table[offset].parent = table[table[offset].parent].parent;
+        offset = table[offset].parent;
+    }
+
+    return offset;
+}
+
+/*
+   add a partial with large primes 'prime' and 'prime2' (1 for a single
+   partial) as an edge to the graph whose vertices are 1 and the large
+   primes, keeping count of the connected components so that the number of
+   independent cycles, each giving a full relation, is
+   edges + components - vertices. Vertex 1 and its component are entered
+   by qsieve_linalg_init.
+
+   Without the double large prime variant all edges join vertex 1 and only
+   the number of occurrences of each prime is recorded.
+*/
+void qsieve_add_edge(qs_t qs_inf, mp_limb_t prime, mp_limb_t prime2)
+{
+    hash_t * entry;
+    mp_limb_t off1, off2;
+    slong vertices;
+
+    if (!qs_inf->dlp)
+    {
+        if (prime2 == 1)
+            qsieve_add_to_hashtable(qs_inf, prime);
+
+        return;
+    }
+
+    vertices = qs_inf->vertices;
+    entry = qsieve_get_table_entry(qs_inf, prime);
+    entry->count++;
+    off1 = entry - qs_inf->table;
+    if (qs_inf->vertices != vertices)
+        qs_inf->components++;
+
+    vertices = qs_inf->vertices;
+    entry = qsieve_get_table_entry(qs_inf, prime2);
+    entry->count++;
+    off2 = entry - qs_inf->table;
+    if (qs_inf->vertices != vertices)
+        qs_inf->components++;
+
+    off1 = _qsieve_find_root(qs_inf->table, off1);
+    off2 = _qsieve_find_root(qs_inf->table, off2);
+
+    if (off1 != off2)
+    {
+        qs_inf->table[off1].parent = off2;
+        qs_inf->components--;
+    }
+}
+
 /******************************************************************************
  * 
  *  Large prime functionality
@@ -194,57 +329,42 @@ void qsieve_add_to_hashtable(qs_t qs_inf, mp_limb_t prime)
  *****************************************************************************/
 
 /*
-   given a string representing a relation, parse it to
-   obtain relation
+   given a packed relation, unpack it to obtain relation
 */
-relation_t qsieve_parse_relation(qs_t qs_inf, char * str)
+relation_t qsieve_unpack_relation(qs_t qs_inf, const mp_limb_t * rel)
 {
-    slong i;
-    char * next;
-    relation_t rel;
+    slong i, size;
+    relation_t r;
 
-    rel.lp = UWORD(1);
-    rel.small = flint_malloc(qs_inf->small_primes * sizeof(slong));
-    rel.factor = flint_malloc(qs_inf->max_factors * sizeof(fac_t));
+    r.lp = *rel++;
+    r.lp2 = *rel++;
+    r.num_factors = *rel++;
+    r.small_primes = qs_inf->small_primes;
+    r.small = flint_malloc(qs_inf->small_primes * sizeof(slong));
+    r.factor = flint_malloc(qs_inf->max_factors * sizeof(fac_t));
 
     for (i = 0; i < qs_inf->small_primes; i++)
-    {
-        while (isspace(*str))
-            str++;
+        r.small[i] = *rel++;
 
-        rel.small[i] = strtoul(str, &next, 16);
-        str = next;
+    for (i = 0; i < r.num_factors; i++)
+    {
+        r.factor[i].ind = *rel++;
+        r.factor[i].exp = *rel++;
     }
 
-    while (isspace(*str))
-        str++;
+    size = (slong) *rel++;
 
-    rel.num_factors = strtoul(str, &next, 16);
-    rel.small_primes = qs_inf->small_primes;
-    str = next;
+    fmpz_init(r.Y);
 
-    for (i = 0; i < rel.num_factors; i++)
+    if (size != 0)
     {
-        while (isspace(*str))
-            str++;
-
-        rel.factor[i].ind = strtoul(str, &next, 16);
-        str = next;
-
-        while (isspace(*str))
-            str++;
+        fmpz_set_ui_array(r.Y, rel, FLINT_ABS(size));
 
-        rel.factor[i].exp = strtoul(str, &next, 16);
-        str = next;
+        if (size < 0)
+            fmpz_neg(r.Y, r.Y);
     }
 
-    while (isspace(*str))
-        str++;
-
-    fmpz_init(rel.Y);
-    fmpz_set_str(rel.Y, str, 16);
-
-    return rel;
+    return r;
 }
 
 /*
@@ -258,6 +378,7 @@ relation_t qsieve_merge_relation(qs_t qs_inf, relation_t a, relation_t b)
     fmpz_t temp;
 
     c.lp = UWORD(1);
+    c.lp2 = UWORD(1);
     c.small = flint_malloc(qs_inf->small_primes * sizeof(slong));
     c.factor = flint_malloc(qs_inf->max_factors * sizeof(fac_t));
     fmpz_init(c.Y);
@@ -338,7 +459,7 @@ relation_t qsieve_merge_relation(qs_t qs_inf, relation_t a, relation_t b)
 
 /*
    compare two relations in the following order,
-   large_prime, number of factors, factor, small_prime
+   large primes, number of factors, factor, small_prime
 */
 int qsieve_compare_relation(const void * a, const void * b)
 {
@@ -352,6 +473,12 @@ int qsieve_compare_relation(const void * a, const void * b)
     if (r1->lp < r2->lp)
         return -1;
 
+    if (r1->lp2 > r2->lp2)
+        return 1;
+
+    if (r1->lp2 < r2->lp2)
+        return -1;
+
     if (r1->num_factors > r2->num_factors)
         return 1;
 
@@ -477,49 +604,324 @@ void qsieve_insert_relation(qs_t qs_inf, relation_t * rel_list, slong num_relati
 }
 
 /*
-   process relations from the file
+   unpack the full relations and the partials whose large primes each occur
+   more than once from the len words of packed relations in data, appending
+   them to rel_list
+*/
+static slong _qsieve_get_relations(qs_t qs_inf, relation_t ** rel_list,
+            slong * rel_size, slong num_relations, const mp_limb_t * data, slong len)
+{
+    slong j;
+    mp_limb_t prime, prime2, count;
+
+    for (j = 0; j < len; j += qsieve_packed_length(qs_inf, data + j))
+    {
+        prime = data[j];
+        prime2 = data[j + 1];
+        count = qsieve_get_table_entry(qs_inf, prime)->count;
+
+        if (qs_inf->dlp)
+        {
+            if (qsieve_get_table_entry(qs_inf, prime2)->count < 2)
+                count = 0;
+        } else if (prime2 != 1)
+            count = 0;
+
+        if (num_relations == *rel_size)
+        {
+           *rel_list = (relation_t *) flint_realloc(*rel_list, 2*(*rel_size) * sizeof(relation_t));
+           *rel_size *= 2;
+        }
+        
+        if (prime == 1 || count >= 2)
+            (*rel_list)[num_relations++] = qsieve_unpack_relation(qs_inf, data + j);
+    }
+
+    return num_relations;
+}
+
+/*
+   multiply the relation c by the relation a, returns 0 if the product has
+   too many factors
+*/
+static int _qsieve_mul_relation(qs_t qs_inf, relation_t * c,
+                                          const relation_t * a, fac_t * temp)
+{
+    slong i = 0, j = 0, k = 0;
+
+    for (i = 0; i < qs_inf->small_primes; i++)
+        c->small[i] += a->small[i];
+
+    i = 0;
+
+    while (i < c->num_factors || j < a->num_factors)
+    {
+        if (k >= qs_inf->max_factors)
+            return 0;
+
+        if (j == a->num_factors || (i < c->num_factors
+                                   && c->factor[i].ind < a->factor[j].ind))
+            temp[k++] = c->factor[i++];
+        else if (i == c->num_factors || a->factor[j].ind < c->factor[i].ind)
+            temp[k++] = a->factor[j++];
+        else
+        {
+            temp[k].ind = c->factor[i].ind;
+            temp[k++].exp = c->factor[i++].exp + a->factor[j++].exp;
+        }
+    }
+
+    for (i = 0; i < k; i++)
+        c->factor[i] = temp[i];
+
+    c->num_factors = k;
+
+    fmpz_mul(c->Y, c->Y, a->Y);
+    fmpz_mod(c->Y, c->Y, qs_inf->kn);
+
+    return 1;
+}
+
+/*
+   combine the partials in rel_list along independent cycles of the graph
+   whose vertices are 1 and the large primes and whose edges are the
+   partials, appending the full relations obtained to rlist until it has
+   'needed' of them. Each prime on a cycle occurs in exactly two of its
+   partials, so the product of the partials is a full relation once Y is
+   divided by the primes on the cycle. Cycles are found by building a
+   breadth first spanning forest; every edge not in it closes a cycle with
+   the paths from its ends to their common ancestor. Returns 0 if a large
+   prime divides kn, in which case it is stored in small_factor, else 1.
+*/
+static int _qsieve_merge_cycles(qs_t qs_inf, relation_t * rlist,
+    slong * rlist_length, relation_t * rel_list, slong num_relations, slong needed)
+{
+    slong i, j, e, u, v, nv, ne, qhead, qtail, len;
+    int ok, res = 1;
+    slong * eu, * ev, * erel, * start, * adj, * depth, * pedge, * queue, * cycle;
+    char * tree;
+    fac_t * temp;
+    hash_t * table;
+    fmpz_t lp;
+    relation_t c;
+
+    eu = flint_malloc(3*num_relations*sizeof(slong));
+    ev = eu + num_relations;
+    erel = ev + num_relations;
+
+    /* edges of the graph, vertices being offsets in the hash table */
+    for (i = 0, ne = 0; i < num_relations; i++)
+    {
+        if (rel_list[i].lp == UWORD(1))
+            continue;
+
+        eu[ne] = qsieve_get_table_entry(qs_inf, rel_list[i].lp) - qs_inf->table;
+        ev[ne] = qsieve_get_table_entry(qs_inf, rel_list[i].lp2) - qs_inf->table;
+        erel[ne++] = i;
+    }
+
+    nv = qs_inf->vertices + 1;
+    table = qs_inf->table;
+
+    start = flint_calloc(nv + 1, sizeof(slong));
+    adj = flint_malloc((2*ne + 1)*sizeof(slong));
+    depth = flint_malloc(nv*sizeof(slong));
+    pedge = flint_malloc(nv*sizeof(slong));
+    queue = flint_malloc(nv*sizeof(slong));
+    cycle = flint_malloc((nv + 1)*sizeof(slong));
+    tree = flint_calloc(ne + 1, sizeof(char));
+    temp = flint_malloc(qs_inf->max_factors*sizeof(fac_t));
+
+    /* adjacency lists */
+    for (e = 0; e < ne; e++)
+    {
+        start[eu[e] + 1]++;
+        start[ev[e] + 1]++;
+    }
+
+    for (v = 0; v < nv; v++)
+        start[v + 1] += start[v];
+
+    for (v = 0; v < nv; v++)
+        queue[v] = start[v];
+
+    for (e = 0; e < ne; e++)
+    {
+        adj[queue[eu[e]]++] = e;
+        adj[queue[ev[e]]++] = e;
+    }
+
+    /* breadth first spanning forest */
+    for (v = 0; v < nv; v++)
+        depth[v] = -1;
+
+    for (v = 0; v < nv; v++)
+    {
+        if (depth[v] != -1 || start[v] == start[v + 1])
+            continue;
+
+        depth[v] = 0;
+        pedge[v] = -1;
+        queue[0] = v;
+
+        for (qhead = 0, qtail = 1; qhead < qtail; qhead++)
+        {
+            u = queue[qhead];
+
+            for (j = start[u]; j < start[u + 1]; j++)
+            {
+                e = adj[j];
+                i = (eu[e] == u) ? ev[e] : eu[e];
+
+                if (depth[i] == -1)
+                {
+                    depth[i] = depth[u] + 1;
+                    pedge[i] = e;
+                    tree[e] = 1;
+                    queue[qtail++] = i;
+                }
+            }
+        }
+    }
+
+    fmpz_init(lp);
+
+    /* each edge not in the forest closes a cycle */
+    for (e = 0; e < ne && *rlist_length < needed; e++)
+    {
+        if (tree[e])
+            continue;
+
+        u = eu[e];
+        v = ev[e];
+        len = 0;
+        cycle[len++] = e;
+        fmpz_one(lp);
+
+        if (table[u].prime != 1)
+            fmpz_mul_ui(lp, lp, table[u].prime);
+
+        if (v != u && table[v].prime != 1)
+            fmpz_mul_ui(lp, lp, table[v].prime);
+
+        while (u != v)
+        {
+            if (depth[u] >= depth[v])
+            {
+                j = pedge[u];
+                cycle[len++] = j;
+                u = (eu[j] == u) ? ev[j] : eu[j];
+
+                if (u != v && table[u].prime != 1)
+                    fmpz_mul_ui(lp, lp, table[u].prime);
+            } else
+            {
+                j = pedge[v];
+                cycle[len++] = j;
+                v = (eu[j] == v) ? ev[j] : eu[j];
+
+                if (u != v && table[v].prime != 1)
+                    fmpz_mul_ui(lp, lp, table[v].prime);
+            }
+        }
+
+        if (fmpz_invmod(lp, lp, qs_inf->kn) == 0)
+        {
+            for (i = 0; i < len; i++)
+            {
+                j = erel[cycle[i]];
+
+                if (fmpz_fdiv_ui(qs_inf->kn, rel_list[j].lp) == 0)
+                    qs_inf->small_factor = rel_list[j].lp;
+                else if (fmpz_fdiv_ui(qs_inf->kn, rel_list[j].lp2) == 0)
+                    qs_inf->small_factor = rel_list[j].lp2;
+            }
+
+            res = 0;
+            break;
+        }
+
+        /* multiply the partials on the cycle */
+        j = erel[cycle[0]];
+        c.lp = UWORD(1);
+        c.lp2 = UWORD(1);
+        c.small_primes = qs_inf->small_primes;
+        c.num_factors = rel_list[j].num_factors;
+        c.small = flint_malloc(qs_inf->small_primes*sizeof(slong));
+        c.factor = flint_malloc(qs_inf->max_factors*sizeof(fac_t));
+        fmpz_init(c.Y);
+
+        for (i = 0; i < qs_inf->small_primes; i++)
+            c.small[i] = rel_list[j].small[i];
+
+        for (i = 0; i < c.num_factors; i++)
+            c.factor[i] = rel_list[j].factor[i];
+
+        fmpz_mul(c.Y, rel_list[j].Y, lp);
+        fmpz_mod(c.Y, c.Y, qs_inf->kn);
+
+        for (i = 1, ok = 1; i < len && ok; i++)
+            ok = _qsieve_mul_relation(qs_inf, &c, rel_list + erel[cycle[i]], temp);
+
+        if (ok)
+            rlist[(*rlist_length)++] = c;
+        else /* too many factors, skip this cycle */
+        {
+            flint_free(c.small);
+            flint_free(c.factor);
+            fmpz_clear(c.Y);
+        }
+    }
+
+    fmpz_clear(lp);
+
+    flint_free(eu);
+    flint_free(start);
+    flint_free(adj);
+    flint_free(depth);
+    flint_free(pedge);
+    flint_free(queue);
+    flint_free(cycle);
+    flint_free(tree);
+    flint_free(temp);
+
+    return res;
+}
+
+/*
+   process relations from the relation store
 */
 int qsieve_process_relation(qs_t qs_inf)
 {
-    char buf[1024];
-    char * str;
     slong i, num_relations = 0, num_relations2, full = 0;
     slong rel_list_length;
     slong rlist_length;
-    mp_limb_t prime;
+    slong len, buf_alloc = 0;
+    mp_limb_t * buf = NULL;
     hash_t * entry;
     mp_limb_t * hash_table = qs_inf->hash_table;
     slong rel_size = 50000;
     relation_t * rel_list = (relation_t *) flint_malloc(rel_size * sizeof(relation_t));
     relation_t * rlist;
     int done = 0;
-  
-    qs_inf->siqs = fopen(qs_inf->fname, "r");
 
 #if QS_DEBUG & 64
     printf("Getting relations\n");
 #endif
 
-    while (fgets(buf, sizeof(buf), qs_inf->siqs) != NULL)
+    if (qs_inf->store.spill != NULL)
     {
-        prime = strtoul(buf, &str, 16);
-        entry = qsieve_get_table_entry(qs_inf, prime);
+        rewind(qs_inf->store.spill);
 
-        if (num_relations == rel_size)
-        {
-           rel_list = (relation_t *) flint_realloc(rel_list, 2*rel_size * sizeof(relation_t));
-           rel_size *= 2;
-        }
-        
-        if (prime == 1 || entry->count >= 2)
-        {
-            rel_list[num_relations] = qsieve_parse_relation(qs_inf, str);
-            rel_list[num_relations].lp = prime;
-            num_relations++;
-        }
+        while ((len = qsieve_store_read_spill(qs_inf, &buf, &buf_alloc)) != 0)
+            num_relations = _qsieve_get_relations(qs_inf, &rel_list, &rel_size,
+                                                     num_relations, buf, len);
+
+        flint_free(buf);
     }
 
-    fclose(qs_inf->siqs);
+    num_relations = _qsieve_get_relations(qs_inf, &rel_list, &rel_size,
+                 num_relations, qs_inf->store.data, qs_inf->store.length);
 
 #if QS_DEBUG & 64
     printf("Removing duplicates\n");
@@ -533,32 +935,53 @@ int qsieve_process_relation(qs_t qs_inf)
 #endif
 
     rlist = flint_malloc(num_relations * sizeof(relation_t));
-    memset(hash_table, 0, (1 << 20) * sizeof(mp_limb_t));
-    qs_inf->vertices = 0;
-
     rlist_length = 0;
-    for (i = 0; i < num_relations; i++)
+
+    if (qs_inf->dlp)
     {
-        if (rel_list[i].lp == UWORD(1))
+        for (i = 0; i < num_relations; i++)
         {
-            rlist[rlist_length++] = rel_list[i];
-            full++;
+            if (rel_list[i].lp == UWORD(1))
+            {
+                rlist[rlist_length++] = rel_list[i];
+                full++;
+            }
         }
-        else
+
+        if (!_qsieve_merge_cycles(qs_inf, rlist, &rlist_length, rel_list,
+              num_relations, qs_inf->num_primes + qs_inf->ks_primes + qs_inf->extra_rels))
         {
-            entry = qsieve_get_table_entry(qs_inf, rel_list[i].lp);
+            done = -1;
+            goto cleanup;
+        }
+    } else
+    {
+        memset(hash_table, 0, (1 << 20) * sizeof(mp_limb_t));
+        qs_inf->vertices = 0;
 
-            if (entry->count == 0) entry->count = i;
+        for (i = 0; i < num_relations; i++)
+        {
+            if (rel_list[i].lp == UWORD(1))
+            {
+                rlist[rlist_length++] = rel_list[i];
+                full++;
+            }
             else
             {
-                if (fmpz_fdiv_ui(qs_inf->kn, rel_list[i].lp) == 0)
+                entry = qsieve_get_table_entry(qs_inf, rel_list[i].lp);
+
+                if (entry->count == 0) entry->count = i;
+                else
                 {
-                   qs_inf->small_factor = rel_list[i].lp;
-                   
-                   done = -1;
-                   goto cleanup;
+                    if (fmpz_fdiv_ui(qs_inf->kn, rel_list[i].lp) == 0)
+                    {
+                       qs_inf->small_factor = rel_list[i].lp;
+                       
+                       done = -1;
+                       goto cleanup;
+                    }
+                    rlist[rlist_length++] = qsieve_merge_relation(qs_inf, rel_list[i], rel_list[entry->count]);
                 }
-                rlist[rlist_length++] = qsieve_merge_relation(qs_inf, rel_list[i], rel_list[entry->count]);
             }
         }
     }
@@ -573,7 +996,6 @@ int qsieve_process_relation(qs_t qs_inf)
     {
        qs_inf->edges -= 100;
        done = 0;
-       qs_inf->siqs = fopen(qs_inf->fname, "a");
     } else
     {
        done = 1;
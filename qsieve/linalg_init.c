@@ -55,6 +55,10 @@ void qsieve_linalg_init(qs_t qs_inf)
     qs_inf->table_size = 10000;
     qs_inf->hash_table = flint_calloc((1 << 20), sizeof(mp_limb_t));
     qs_inf->table = flint_malloc(qs_inf->table_size * sizeof(hash_t));
+
+    /* vertex 1, which the single partials join, is in the graph from the start */
+    if (qs_inf->dlp)
+        qsieve_get_table_entry(qs_inf, UWORD(1));
 }
 
 /* 
@@ -108,4 +112,7 @@ void qsieve_linalg_realloc(qs_t qs_inf)
     qs_inf->num_cycles = 0;
 
     memset(qs_inf->hash_table, 0, (1 << 20)*sizeof(mp_limb_t));
+
+    if (qs_inf->dlp)
+        qsieve_get_table_entry(qs_inf, UWORD(1));
 }
@@ -121,6 +121,9 @@ mp_limb_t qsieve_primes_init(qs_t qs_inf)
     qs_inf->small_primes = qsieve_tune[i][3]; /* number of primes to not sieve with */
     
     bits = qsieve_tune[i][5];
+    if (qs_inf->dlp) /* lower the threshold to catch double partials */
+       bits -= (qsieve_tune[i][6] != 0) ? qsieve_tune[i][6] : QS_DLP_BITS_DEFAULT;
+
     if (bits >= 64)
     {
        qs_inf->sieve_bits = bits;
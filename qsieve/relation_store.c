@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "qsieve.h"
+
+/*
+   Relations are kept in memory in packed form. If a spill limit is set,
+   the packed relations are appended to an anonymous temporary file whenever
+   they take more than that many bytes, each block of words written being
+   preceded by its length.
+*/
+
+FLINT_TLS_PREFIX slong _qsieve_spill_limit = 0;
+
+void qsieve_set_spill_limit(slong bytes)
+{
+   _qsieve_spill_limit = FLINT_MAX(bytes, 0);
+}
+
+slong qsieve_get_spill_limit(void)
+{
+   return _qsieve_spill_limit;
+}
+
+void qsieve_store_init(qs_t qs_inf)
+{
+   rel_store_t * store = &qs_inf->store;
+
+   store->data = NULL;
+   store->length = 0;
+   store->alloc = 0;
+   store->num = 0;
+   store->limit = _qsieve_spill_limit;
+   store->spill = NULL;
+}
+
+void qsieve_store_clear(qs_t qs_inf)
+{
+   rel_store_t * store = &qs_inf->store;
+
+   flint_free(store->data);
+
+   if (store->spill != NULL)
+      fclose(store->spill);
+
+   store->data = NULL;
+   store->spill = NULL;
+}
+
+void qsieve_store_reset(qs_t qs_inf)
+{
+   rel_store_t * store = &qs_inf->store;
+
+   store->length = 0;
+   store->num = 0;
+
+   if (store->spill != NULL)
+   {
+      fclose(store->spill);
+      store->spill = NULL;
+   }
+}
+
+static void _qsieve_store_spill(rel_store_t * store)
+{
+   if (store->spill == NULL)
+   {
+      store->spill = tmpfile();
+
+      if (store->spill == NULL) /* keep everything in memory */
+      {
+         store->limit = 0;
+         return;
+      }
+   } else
+      fseek(store->spill, 0, SEEK_END);
+
+   if (fwrite(&store->length, sizeof(slong), 1, store->spill) != 1
+    || fwrite(store->data, sizeof(mp_limb_t), store->length, store->spill)
+                                                     != (size_t) store->length)
+   {
+      flint_printf("Exception (qsieve_store_append). Unable to write "
+                   "relations to spill file.\n");
+      flint_abort();
+   }
+
+   store->length = 0;
+}
+
+/*
+   append the len words of num packed relations in rels to the store
+*/
+void qsieve_store_append(qs_t qs_inf, const mp_limb_t * rels,
+                                                         slong len, slong num)
+{
+   rel_store_t * store = &qs_inf->store;
+
+   if (store->length + len > store->alloc)
+   {
+      store->alloc = FLINT_MAX(store->length + len, 2*store->alloc);
+      store->data = flint_realloc(store->data,
+                                            store->alloc*sizeof(mp_limb_t));
+   }
+
+   memcpy(store->data + store->length, rels, len*sizeof(mp_limb_t));
+   store->length += len;
+   store->num += num;
+
+   if (store->limit > 0
+         && store->length*sizeof(mp_limb_t) > (ulong) store->limit)
+      _qsieve_store_spill(store);
+}
+
+/*
+   read the next block of spilled relations into buf, reallocating it if
+   necessary, and return its length in words, or 0 if there are no more;
+   the spill file must be rewound before reading the first block
+*/
+slong qsieve_store_read_spill(qs_t qs_inf, mp_limb_t ** buf, slong * alloc)
+{
+   rel_store_t * store = &qs_inf->store;
+   slong len;
+
+   if (store->spill == NULL)
+      return 0;
+
+   if (fread(&len, sizeof(slong), 1, store->spill) != 1)
+      return 0;
+
+   if (len > *alloc)
+   {
+      *alloc = len;
+      *buf = flint_realloc(*buf, len*sizeof(mp_limb_t));
+   }
+
+   if (fread(*buf, sizeof(mp_limb_t), len, store->spill) != (size_t) len)
+   {
+      flint_printf("Exception (qsieve_store_read_spill). Unable to read "
+                   "relations from spill file.\n");
+      flint_abort();
+   }
+
+   return len;
+}
@@ -12,13 +12,12 @@
 
 #include "qsieve.h"
 
-void qsieve_square_root(fmpz_t X, fmpz_t Y, qs_t qs_inf,
-   uint64_t * nullrows, slong ncols, slong l, fmpz_t N)
+void _qsieve_square_root(fmpz_t X, fmpz_t Y, qs_t qs_inf,
+   uint64_t * nullrows, slong ncols, slong l, fmpz_t N, slong * prime_count)
 {
    slong position, i, j;
    slong * relation = qs_inf->relation;
    prime_t * factor_base = qs_inf->factor_base;
-   slong * prime_count = qs_inf->prime_count;
    slong num_primes = qs_inf->num_primes;
    fmpz * Y_arr = qs_inf->Y_arr;
    fmpz_t pow;
@@ -69,3 +68,120 @@ void qsieve_square_root(fmpz_t X, fmpz_t Y, qs_t qs_inf,
    fmpz_clear(pow);
 }
 
+void qsieve_square_root(fmpz_t X, fmpz_t Y, qs_t qs_inf,
+   uint64_t * nullrows, slong ncols, slong l, fmpz_t N)
+{
+   _qsieve_square_root(X, Y, qs_inf, nullrows, ncols, l, N,
+                                                        qs_inf->prime_count);
+}
+
+typedef struct
+{
+   qs_s * inf;
+   uint64_t * nullrows;
+   slong ncols;
+   uint64_t mask;
+   fmpz * gcds;
+   slong * prime_count;
+   slong start;
+   slong step;
+}
+_sqrt_worker_arg_struct;
+
+/*
+   for every l in the range handled by this thread with bit l of the mask
+   set, compute gcd(X - Y, n) from nullspace vector l
+*/
+static void _qsieve_square_root_worker(void * varg)
+{
+   _sqrt_worker_arg_struct * arg = (_sqrt_worker_arg_struct *) varg;
+   qs_s * qs_inf = arg->inf;
+   fmpz_t X, Y;
+   slong l;
+
+   fmpz_init(X);
+   fmpz_init(Y);
+
+   for (l = arg->start; l < 64; l += arg->step)
+   {
+      if (arg->mask & ((uint64_t)(1) << l))
+      {
+         _qsieve_square_root(X, Y, qs_inf, arg->nullrows, arg->ncols, l,
+                                                qs_inf->kn, arg->prime_count);
+
+         fmpz_sub(X, X, Y);
+         fmpz_gcd(arg->gcds + l, X, qs_inf->n);
+      }
+   }
+
+   fmpz_clear(X);
+   fmpz_clear(Y);
+}
+
+/*
+   Compute the square roots for the nullspace vectors l of nullrows with bit
+   l of mask set and store the nontrivial factors of n they give in facs,
+   in order of l. The vectors are shared among the threads of qs_inf.
+   Returns the number of factors found.
+*/
+slong qsieve_square_root_factors(fmpz * facs, qs_t qs_inf,
+                             uint64_t * nullrows, slong ncols, uint64_t mask)
+{
+   slong i, l, count, num_threads, num_facs;
+   _sqrt_worker_arg_struct * args;
+   fmpz * gcds;
+
+   for (l = count = 0; l < 64; l++)
+   {
+      if (mask & ((uint64_t)(1) << l))
+         count++;
+   }
+
+   num_threads = FLINT_MIN(qs_inf->num_handles + 1, count);
+   num_threads = FLINT_MAX(num_threads, 1);
+
+   args = (_sqrt_worker_arg_struct *) flint_malloc(num_threads
+                                          *sizeof(_sqrt_worker_arg_struct));
+   gcds = _fmpz_vec_init(64);
+
+   for (i = 0; i < num_threads; i++)
+   {
+      args[i].inf = qs_inf;
+      args[i].nullrows = nullrows;
+      args[i].ncols = ncols;
+      args[i].mask = mask;
+      args[i].gcds = gcds;
+      args[i].start = i;
+      args[i].step = num_threads;
+      args[i].prime_count = (i == 0) ? qs_inf->prime_count :
+                     (slong *) flint_malloc(qs_inf->num_primes*sizeof(slong));
+   }
+
+   for (i = 1; i < num_threads; i++)
+   {
+      thread_pool_wake(global_thread_pool, qs_inf->handles[i - 1], 0,
+                                         _qsieve_square_root_worker, &args[i]);
+   }
+
+   _qsieve_square_root_worker(&args[0]);
+
+   for (i = 1; i < num_threads; i++)
+   {
+      thread_pool_wait(global_thread_pool, qs_inf->handles[i - 1]);
+      flint_free(args[i].prime_count);
+   }
+
+   num_facs = 0;
+
+   for (l = 0; l < 64; l++)
+   {
+      if ((mask & ((uint64_t)(1) << l)) && fmpz_cmp(gcds + l, qs_inf->n) != 0
+                                      && fmpz_cmp_ui(gcds + l, 1) != 0)
+         fmpz_set(facs + num_facs++, gcds + l);
+   }
+
+   _fmpz_vec_clear(gcds, 64);
+   flint_free(args);
+
+   return num_facs;
+}
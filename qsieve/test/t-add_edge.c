@@ -0,0 +1,126 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "qsieve.h"
+
+static slong find_root(slong * parent, slong v)
+{
+   while (parent[v] != v)
+   {
+      parent[v] = parent[parent[v]];
+      v = parent[v];
+   }
+
+   return v;
+}
+
+int main(void)
+{
+   slong i, j, m, num_edges, unions, cycles;
+   mp_limb_t * primes;
+   slong * parent;
+   qs_t qs_inf;
+   fmpz_t n;
+
+   FLINT_TEST_INIT(state);
+
+   flint_printf("add_edge....");
+   fflush(stdout);
+
+   /* random graphs of partials, the cycle count against a spanning forest */
+   for (i = 0; i < 100 * flint_test_multiplier(); i++)
+   {
+      fmpz_init(n);
+      fmpz_randtest_unsigned(n, state, 100);
+      fmpz_add_ui(n, n, 1000);
+
+      qsieve_init(qs_inf, n);
+      qs_inf->dlp = 1;
+      qsieve_linalg_init(qs_inf);
+
+      m = n_randint(state, 2000) + 1;
+      num_edges = n_randint(state, 3*m);
+
+      /* distinct large primes, vertex 0 standing for 1 */
+      primes = flint_malloc((m + 1)*sizeof(mp_limb_t));
+      parent = flint_malloc((m + 1)*sizeof(slong));
+
+      primes[0] = 1;
+      for (j = 1; j <= m; j++)
+         primes[j] = primes[j - 1] + n_randint(state, 1000) + 1;
+
+      for (j = 0; j <= m; j++)
+         parent[j] = j;
+
+      unions = 0;
+
+      for (j = 0; j < num_edges; j++)
+      {
+         slong u, v, t;
+
+         /* a single partial joins vertex 1 */
+         u = n_randint(state, m) + 1;
+         v = n_randint(state, 4) == 0 ? 0 : n_randint(state, m) + 1;
+
+         if (u == v)
+            v = 0;
+
+         if (u < v)
+         {
+            t = u;
+            u = v;
+            v = t;
+         }
+
+         qsieve_add_edge(qs_inf, primes[v == 0 ? u : v], primes[v == 0 ? 0 : u]);
+
+         u = find_root(parent, u);
+         v = find_root(parent, v);
+
+         if (u != v)
+         {
+            parent[u] = v;
+            unions++;
+         }
+      }
+
+      /* every edge outside a spanning forest closes one independent cycle */
+      cycles = num_edges + qs_inf->components - qs_inf->vertices;
+
+      if (cycles != num_edges - unions)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("m = %wd, edges = %wd, vertices = %wd, components = %wd\n",
+                m, num_edges, qs_inf->vertices, qs_inf->components);
+         flint_printf("cycles = %wd, expected %wd\n", cycles, num_edges - unions);
+         abort();
+      }
+
+      flint_free(primes);
+      flint_free(parent);
+
+      qsieve_linalg_clear(qs_inf);
+      qsieve_clear(qs_inf);
+      fmpz_clear(n);
+   }
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
@@ -0,0 +1,132 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "qsieve.h"
+
+static int slong_cmp(const void * a, const void * b)
+{
+   slong x = *((const slong *) a), y = *((const slong *) b);
+
+   return (x > y) - (x < y);
+}
+
+int main(void)
+{
+   slong i, j, k, nrows, ncols, tries;
+   la_col_t * B;
+   uint64_t * x, * b, lanes;
+   qs_t qs_inf;
+
+   FLINT_TEST_INIT(state);
+
+   flint_printf("block_lanczos....");
+   fflush(stdout);
+
+   /* sparse matrices large enough for the products to be split among threads */
+   for (i = 0; i < 4 * flint_test_multiplier(); i++)
+   {
+      ncols = 2000 + n_randint(state, 8000);
+      nrows = ncols - 64 - n_randint(state, 200);
+
+      B = flint_malloc(ncols*sizeof(la_col_t));
+
+      for (j = 0; j < ncols; j++)
+      {
+         slong w = 5 + n_randint(state, 20);
+
+         B[j].data = flint_malloc(w*sizeof(slong));
+         B[j].orig = j;
+         B[j].weight = 0;
+
+         for (k = 0; k < w; k++)
+            B[j].data[k] = n_randint(state, nrows);
+
+         /* distinct rows in increasing order */
+         qsort(B[j].data, w, sizeof(slong), slong_cmp);
+
+         for (k = 0; k < w; k++)
+         {
+            if (B[j].weight == 0 || B[j].data[k] != B[j].data[B[j].weight - 1])
+               B[j].data[B[j].weight++] = B[j].data[k];
+         }
+      }
+
+      /* only extra_rels is read by reduce_matrix */
+      qs_inf->extra_rels = 64;
+      reduce_matrix(qs_inf, &nrows, &ncols, B);
+
+      flint_set_num_threads(n_randint(state, 4) + 1);
+
+      tries = 0;
+      do {
+         x = block_lanczos(state, nrows, 0, ncols, B);
+      } while (x == NULL && ++tries < 10);
+
+      if (x == NULL)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("no dependencies found, nrows = %wd, ncols = %wd\n",
+                                                                 nrows, ncols);
+         abort();
+      }
+
+      /* each bit of x gives a set of columns summing to zero */
+      b = flint_calloc(nrows, sizeof(uint64_t));
+      lanes = 0;
+
+      for (j = 0; j < ncols; j++)
+      {
+         lanes |= x[j];
+
+         for (k = 0; k < B[j].weight; k++)
+            b[B[j].data[k]] ^= x[j];
+      }
+
+      for (j = 0; j < nrows; j++)
+      {
+         if (b[j] != 0)
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("row %wd of B*x is nonzero, nrows = %wd, ncols = %wd, "
+                  "threads = %d\n", j, nrows, ncols, flint_get_num_threads());
+            abort();
+         }
+      }
+
+      if (lanes == 0)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("only the zero vector found\n");
+         abort();
+      }
+
+      flint_free(b);
+      flint_free(x);
+
+      for (j = 0; j < ncols; j++)
+         free_col(B + j);
+      flint_free(B);
+   }
+
+   flint_set_num_threads(1);
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
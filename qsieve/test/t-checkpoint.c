@@ -0,0 +1,218 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include "qsieve.h"
+#include "thread_support.h"
+
+void randprime(fmpz_t p, flint_rand_t state, slong bits)
+{
+    fmpz_randbits(p, state, bits);
+ 
+    if (fmpz_sgn(p) < 0)
+       fmpz_neg(p, p);
+
+    if (fmpz_is_even(p))
+       fmpz_add_ui(p, p, 1);
+ 
+    while (!fmpz_is_probabprime(p))
+       fmpz_add_ui(p, p, 2);
+}
+
+int main(void)
+{
+   slong i, j, runs, resumed = 0;
+   fmpz_t n, x, y, p;
+   fmpz_factor_t factors;
+   flint_cancel_t C;
+   qs_checkpoint_t C1, C2;
+   const char * fname = "qsieve_t-checkpoint.dat";
+   const char * badname = "qsieve_t-checkpoint.dat.bad";
+   FILE * f;
+   FLINT_TEST_INIT(state);
+
+   fmpz_init(x);
+   fmpz_init(y);
+   fmpz_init(n);
+   fmpz_init(p);
+
+   flint_printf("checkpoint....");
+   fflush(stdout);
+
+   remove(fname);
+   remove(badname);
+
+   /* Test runs interrupted by deadlines and resumed from checkpoints */
+   for (i = 0; i < flint_test_multiplier(); i++)
+   {
+      randprime(x, state, 60 + n_randint(state, 20));
+      do {
+         randprime(y, state, 60 + n_randint(state, 20));
+      } while (fmpz_equal(x, y));
+
+      fmpz_mul(n, x, y);
+
+      flint_set_num_threads(n_randint(state, 3) + 1);
+
+      for (runs = 1; ; runs++)
+      {
+         fmpz_factor_init(factors);
+
+         flint_cancel_init(C);
+         flint_cancel_set_timeout(C, 0.002*runs*runs);
+         flint_set_cancel(C);
+
+         qsieve_factor_checkpoint(factors, n, fname, 0);
+
+         flint_set_cancel(NULL);
+         flint_cancel_clear(C);
+
+         fmpz_one(p);
+         for (j = 0; j < factors->num; j++)
+            fmpz_mul(p, p, factors->p + j);
+
+         if (!fmpz_equal(p, n))
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("product of factors, i = %wd, run = %wd\n", i, runs);
+            fmpz_print(n); flint_printf("\n");
+            fmpz_factor_print(factors); flint_printf("\n");
+            abort();
+         }
+
+         if (factors->num >= 2)
+         {
+            fmpz_factor_clear(factors);
+            break;
+         }
+
+         fmpz_factor_clear(factors);
+
+         /* a resumed run restores the relations of the checkpoint */
+         qsieve_checkpoint_init(C1);
+
+         if (qsieve_checkpoint_read(C1, fname) == -1)
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("invalid checkpoint, i = %wd, run = %wd\n", i, runs);
+            abort();
+         }
+
+         if (C1->num_relations > 0)
+         {
+            fmpz_factor_init(factors);
+
+            flint_cancel_init(C);
+            flint_cancel_request(C);
+            flint_set_cancel(C);
+
+            qsieve_factor_checkpoint(factors, n, fname, 0);
+
+            flint_set_cancel(NULL);
+            flint_cancel_clear(C);
+
+            fmpz_factor_clear(factors);
+
+            qsieve_checkpoint_init(C2);
+
+            if (qsieve_checkpoint_read(C2, fname) != 1
+             || C2->num_relations != C1->num_relations
+             || C2->full_relation != C1->full_relation
+             || C2->edges != C1->edges || C2->length != C1->length)
+            {
+               flint_printf("FAIL:\n");
+               flint_printf("relations not restored, i = %wd, run = %wd\n",
+                                                                     i, runs);
+               flint_printf("%wd relations saved, %wd restored\n",
+                                      C1->num_relations, C2->num_relations);
+               abort();
+            }
+
+            qsieve_checkpoint_clear(C2);
+
+            resumed++;
+         }
+
+         qsieve_checkpoint_clear(C1);
+      }
+
+      f = fopen(fname, "rb");
+      if (f != NULL)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("checkpoint not removed, i = %wd\n", i);
+         abort();
+      }
+   }
+
+   if (resumed == 0)
+   {
+      flint_printf("FAIL:\n");
+      flint_printf("no checkpoint with relations was resumed\n");
+      abort();
+   }
+
+   /* Test corrupt checkpoints are set aside */
+   for (i = 0; i < flint_test_multiplier(); i++)
+   {
+      randprime(x, state, 60);
+      do {
+         randprime(y, state, 60);
+      } while (fmpz_equal(x, y));
+
+      fmpz_mul(n, x, y);
+
+      f = fopen(fname, "wb");
+      for (j = 0; j < (slong) n_randint(state, 100); j++)
+         fputc((int) n_randint(state, 256), f);
+      fclose(f);
+
+      fmpz_factor_init(factors);
+
+      qsieve_factor_checkpoint(factors, n, fname, 0);
+
+      fmpz_one(p);
+      for (j = 0; j < factors->num; j++)
+         fmpz_mul(p, p, factors->p + j);
+
+      if (factors->num < 2 || !fmpz_equal(p, n))
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("corrupt checkpoint, i = %wd\n", i);
+         abort();
+      }
+
+      f = fopen(badname, "rb");
+      if (f == NULL)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("corrupt checkpoint not kept, i = %wd\n", i);
+         abort();
+      }
+      fclose(f);
+      remove(badname);
+
+      fmpz_factor_clear(factors);
+   }
+
+   remove(fname);
+
+   fmpz_clear(n);
+   fmpz_clear(x);
+   fmpz_clear(y);
+   fmpz_clear(p);
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
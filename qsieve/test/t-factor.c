@@ -36,7 +36,7 @@ void randprime(fmpz_t p, flint_rand_t state, slong bits)
 
 int main(void)
 {
-   slong i;
+   slong i, j;
    fmpz_t n, x, y, z;
    fmpz_factor_t factors;
    slong max_threads = 5;
@@ -162,6 +162,117 @@ int main(void)
       fmpz_factor_clear(factors);
    }
 
+   /* Test random n, two factors, double large primes */
+   for (i = 0; i < flint_test_multiplier(); i++)
+   {
+      fmpz_t p;
+
+      randprime(x, state, 50 + n_randint(state, 20));
+      do {
+         randprime(y, state, 50 + n_randint(state, 20));
+      } while (fmpz_equal(x, y));
+
+      fmpz_mul(n, x, y);
+
+      fmpz_factor_init(factors);
+
+      flint_set_num_threads(n_randint(state, max_threads) + 1);
+      qsieve_set_double_large_prime(1);
+
+      qsieve_factor(factors, n);
+
+      qsieve_set_double_large_prime(-1);
+
+      fmpz_init_set_ui(p, 1);
+      for (j = 0; j < factors->num; j++)
+         fmpz_mul(p, p, factors->p + j);
+
+      if (factors->num < 2 || !fmpz_equal(p, n))
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("Test random n, double large primes\ni = %wd\n", i);
+         flint_printf("%ld factors found\n", factors->num);
+         abort();
+      }
+
+      fmpz_clear(p);
+      fmpz_factor_clear(factors);
+   }
+
+   /*
+      Test random n of 180 bits with several threads, for which the factor
+      base is large enough for the block Lanczos products to be split
+   */
+   for (i = 2; i <= 4; i += 2)
+   {
+      fmpz_t p;
+
+      randprime(x, state, 91);
+      do {
+         randprime(y, state, 91);
+      } while (fmpz_equal(x, y));
+
+      fmpz_mul(n, x, y);
+
+      fmpz_factor_init(factors);
+
+      flint_set_num_threads(i);
+
+      qsieve_factor(factors, n);
+
+      fmpz_init_set_ui(p, 1);
+      for (j = 0; j < factors->num; j++)
+         fmpz_mul(p, p, factors->p + j);
+
+      if (factors->num < 2 || !fmpz_equal(p, n))
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("Test random n of 180 bits, %wd threads\n", i);
+         flint_printf("%ld factors found\n", factors->num);
+         abort();
+      }
+
+      fmpz_clear(p);
+      fmpz_factor_clear(factors);
+   }
+
+   /* Test random n, two factors, relations spilled to file */
+   for (i = 0; i < flint_test_multiplier(); i++)
+   {
+      fmpz_t p;
+
+      randprime(x, state, 40);
+      do {
+         randprime(y, state, 40);
+      } while (fmpz_equal(x, y));
+
+      fmpz_mul(n, x, y);
+
+      fmpz_factor_init(factors);
+
+      flint_set_num_threads(n_randint(state, max_threads) + 1);
+      qsieve_set_spill_limit(n_randint(state, 4000) + 1);
+
+      qsieve_factor(factors, n);
+
+      qsieve_set_spill_limit(0);
+
+      fmpz_init_set_ui(p, 1);
+      for (j = 0; j < factors->num; j++)
+         fmpz_mul(p, p, factors->p + j);
+
+      if (factors->num < 2 || !fmpz_equal(p, n))
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("Test random n, relations spilled to file\ni = %wd\n", i);
+         flint_printf("%ld factors found\n", factors->num);
+         abort();
+      }
+
+      fmpz_clear(p);
+      fmpz_factor_clear(factors);
+   }
+
    fmpz_clear(n);
    fmpz_clear(x);
    fmpz_clear(y);
@@ -0,0 +1,257 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_factor.h"
+#include "fmpz_mpoly_factor.h"
+#include "qsieve.h"
+#include "aprcl.h"
+#include "ulong_extras.h"
+
+/* the product of the factors must be n */
+void check_expand(const fmpz_factor_t fac, const fmpz_t n, const char * s)
+{
+    fmpz_t m;
+
+    fmpz_init(m);
+    fmpz_factor_expand(m, fac);
+
+    if (!fmpz_equal(m, n))
+    {
+        flint_printf("FAIL (%s):\n", s);
+        fmpz_print(n); flint_printf("\n");
+        fmpz_factor_print(fac); flint_printf("\n");
+        fflush(stdout);
+        flint_abort();
+    }
+
+    fmpz_clear(m);
+}
+
+int main(void)
+{
+    int i, result;
+    flint_cancel_t C;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("cancel....");
+    fflush(stdout);
+
+    /* token */
+    flint_cancel_init(C);
+
+    result = !flint_cancel_is_requested(C) && !flint_cancelled() &&
+             flint_set_cancel(C) == NULL && !flint_cancelled();
+    flint_cancel_request(C);
+    result = result && flint_cancel_is_requested(C) && flint_cancelled();
+    result = result && flint_set_cancel(NULL) == C && !flint_cancelled();
+
+    if (!result)
+    {
+        flint_printf("FAIL (token)\n");
+        fflush(stdout);
+        flint_abort();
+    }
+
+    flint_cancel_clear(C);
+
+    /* deadline */
+    flint_cancel_init(C);
+    flint_cancel_set_timeout(C, 0.001);
+
+    for (i = 0; i < 1000000000 && !flint_cancel_is_requested(C); i++) ;
+
+    if (!flint_cancel_is_requested(C))
+    {
+        flint_printf("FAIL (deadline)\n");
+        fflush(stdout);
+        flint_abort();
+    }
+
+    flint_cancel_clear(C);
+
+    /* cancelled algorithms leave valid outputs */
+    for (i = 0; i < 2 * flint_test_multiplier(); i++)
+    {
+        fmpz_t n, p, q, f;
+        fmpz_factor_t fac;
+        flint_bitcnt_t bits = 60 + n_randint(state, 80);
+
+        fmpz_init(n);
+        fmpz_init(p);
+        fmpz_init(q);
+        fmpz_init(f);
+        fmpz_factor_init(fac);
+
+        fmpz_randprime(p, state, bits, 0);
+        fmpz_randprime(q, state, bits, 0);
+        fmpz_mul(n, p, q);
+
+        flint_cancel_init(C);
+        flint_set_cancel(C);
+
+        if (n_randint(state, 2))
+            flint_cancel_request(C);
+        else
+            flint_cancel_set_timeout(C, 0.0001*n_randint(state, 10));
+
+        fmpz_factor(fac, n);
+        check_expand(fac, n, "fmpz_factor");
+
+        fmpz_factor_clear(fac);
+        fmpz_factor_init(fac);
+
+        qsieve_factor(fac, n);
+        check_expand(fac, n, "qsieve_factor");
+
+        if (flint_cancelled())
+        {
+            if (fmpz_factor_ecm(f, 1000, 5000, 500000, state, n) != 0 ||
+                aprcl_is_prime(p) != APRCL_CANCELLED)
+            {
+                flint_printf("FAIL (finished after cancellation)\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        flint_set_cancel(NULL);
+        flint_cancel_clear(C);
+
+        if (!aprcl_is_prime(p))
+        {
+            flint_printf("FAIL (aprcl after cancellation)\n");
+            fmpz_print(p); flint_printf("\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_clear(n);
+        fmpz_clear(p);
+        fmpz_clear(q);
+        fmpz_clear(f);
+        fmpz_factor_clear(fac);
+    }
+
+    /* a cancelled primality proof does not report a prime composite */
+    for (i = 0; i < 5 * flint_test_multiplier(); i++)
+    {
+        fmpz_t p;
+        flint_bitcnt_t bits = 90 + n_randint(state, 100);
+        int r1, r2, r3, requested = n_randint(state, 2);
+
+        fmpz_init(p);
+        fmpz_randprime(p, state, bits, 0);
+
+        flint_cancel_init(C);
+        flint_set_cancel(C);
+
+        if (requested)
+            flint_cancel_request(C);
+        else
+            flint_cancel_set_timeout(C, 0.0001*n_randint(state, 10));
+
+        r1 = fmpz_is_prime(p);
+        r2 = aprcl_is_prime_gauss(p);
+        r3 = aprcl_is_prime_jacobi(p);
+
+        result = (r1 == 1 || r1 == -1) &&
+                 (r2 == 1 || r2 == APRCL_CANCELLED) &&
+                 (r3 == 1 || r3 == APRCL_CANCELLED);
+
+        if (requested)
+            result = result && r3 == APRCL_CANCELLED;
+
+        if (!result)
+        {
+            flint_printf("FAIL (cancelled primality test)\n");
+            fmpz_print(p); flint_printf("\n");
+            flint_printf("%d %d %d\n", r1, r2, r3);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_set_cancel(NULL);
+        flint_cancel_clear(C);
+        fmpz_clear(p);
+    }
+
+    /* multivariate factorisation */
+    for (i = 0; i < 2 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t a, b, c;
+        fmpz_mpoly_factor_t fac;
+
+        fmpz_mpoly_ctx_init(ctx, 4, ORD_LEX);
+        fmpz_mpoly_init(a, ctx);
+        fmpz_mpoly_init(b, ctx);
+        fmpz_mpoly_init(c, ctx);
+        fmpz_mpoly_factor_init(fac, ctx);
+
+        do {
+            fmpz_mpoly_randtest_bound(a, state, 6, 10, 3, ctx);
+            fmpz_mpoly_randtest_bound(b, state, 6, 10, 3, ctx);
+        } while (fmpz_mpoly_total_degree_si(a, ctx) < 2 ||
+                 fmpz_mpoly_total_degree_si(b, ctx) < 2);
+        fmpz_mpoly_mul(a, a, b, ctx);
+
+        flint_cancel_init(C);
+        flint_cancel_request(C);
+        flint_set_cancel(C);
+
+        /* either not finished, or a correct factorisation */
+        if (fmpz_mpoly_factor(fac, a, ctx))
+        {
+            fmpz_mpoly_factor_expand(c, fac, ctx);
+
+            if (!fmpz_mpoly_equal(c, a, ctx))
+            {
+                flint_printf("FAIL (fmpz_mpoly_factor)\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        flint_set_cancel(NULL);
+        flint_cancel_clear(C);
+
+        if (!fmpz_mpoly_factor(fac, a, ctx))
+        {
+            flint_printf("FAIL (fmpz_mpoly_factor after cancellation)\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mpoly_factor_expand(c, fac, ctx);
+
+        if (!fmpz_mpoly_equal(c, a, ctx))
+        {
+            flint_printf("FAIL (fmpz_mpoly_factor after cancellation)\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mpoly_factor_clear(fac, ctx);
+        fmpz_mpoly_clear(a, ctx);
+        fmpz_mpoly_clear(b, ctx);
+        fmpz_mpoly_clear(c, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
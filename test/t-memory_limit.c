@@ -0,0 +1,230 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <setjmp.h>
+#include <stdio.h>
+#if (!defined (__WIN32) || defined(__CYGWIN__)) && !defined(_MSC_VER)
+#include <fcntl.h>
+#include <unistd.h>
+#define SILENCE_STDOUT 1
+#else
+#define SILENCE_STDOUT 0
+#endif
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+static jmp_buf env;
+
+/* the messages of the expected exceptions are discarded */
+static int out = -1, null = -1;
+
+static void quiet(void)
+{
+    fflush(stdout);
+#if SILENCE_STDOUT
+    if (out != -1 && null != -1)
+        dup2(null, 1);
+#endif
+}
+
+static void loud(void)
+{
+    fflush(stdout);
+#if SILENCE_STDOUT
+    if (out != -1 && null != -1)
+        dup2(out, 1);
+#endif
+}
+
+FLINT_NORETURN static void jump_back(void)
+{
+    loud();
+    longjmp(env, 1);
+}
+
+int main(void)
+{
+    int i;
+    flint_memory_stats_t s;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("memory_limit....");
+    fflush(stdout);
+
+#if SILENCE_STDOUT
+    out = dup(1);
+    null = open("/dev/null", O_WRONLY);
+#endif
+
+    flint_set_thread_abort(jump_back);
+
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        void * volatile a = NULL;
+        void * volatile b = NULL;
+        mpz_t z;
+        slong limit = 1000 + n_randint(state, 10000);
+        slong size1 = n_randint(state, limit) + 1;
+        slong size2 = n_randint(state, 2 * limit) + 1;
+        volatile int thrown = 0;
+
+        flint_memory_stats_reset();
+        flint_set_memory_limit(limit);
+
+        if (flint_get_memory_limit() != limit)
+        {
+            flint_printf("FAIL (get):\n");
+            flint_printf("limit = %wd\n", limit);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* within the limit */
+        if (setjmp(env) == 0)
+            a = flint_malloc(size1);
+        else
+            thrown = 1;
+
+        if (thrown || a == NULL)
+        {
+            flint_printf("FAIL (within limit):\n");
+            flint_printf("limit = %wd, size1 = %wd\n", limit, size1);
+            fflush(stdout);
+            flint_set_thread_abort(NULL);
+            flint_abort();
+        }
+
+        /* grow a, the old block counts towards the limit only once */
+        if (setjmp(env) == 0)
+        {
+            quiet();
+            a = flint_realloc(a, size2);
+            loud();
+        }
+        else
+            thrown = 1;
+
+        if (thrown != (size2 > limit))
+        {
+            flint_printf("FAIL (realloc):\n");
+            flint_printf("limit = %wd, size2 = %wd\n", limit, size2);
+            fflush(stdout);
+            flint_set_thread_abort(NULL);
+            flint_abort();
+        }
+
+        if (flint_get_memory_limit() != limit)
+        {
+            flint_printf("FAIL (limit not restored):\n");
+            flint_printf("limit = %wd\n", flint_get_memory_limit());
+            fflush(stdout);
+            flint_set_thread_abort(NULL);
+            flint_abort();
+        }
+
+        flint_memory_stats_get(s);
+
+        if (s->live != (thrown ? size1 : size2) || s->live > limit)
+        {
+            flint_printf("FAIL (live after realloc):\n");
+            flint_printf("limit = %wd, live = %wd\n", limit, s->live);
+            fflush(stdout);
+            flint_set_thread_abort(NULL);
+            flint_abort();
+        }
+
+        /* an allocation over the remaining budget */
+        thrown = 0;
+
+        if (setjmp(env) == 0)
+        {
+            quiet();
+            b = flint_calloc(limit - s->live + 1, 1);
+            loud();
+        }
+        else
+            thrown = 1;
+
+        if (!thrown || b != NULL)
+        {
+            flint_printf("FAIL (over limit):\n");
+            flint_printf("limit = %wd, live = %wd\n", limit, s->live);
+            fflush(stdout);
+            flint_set_thread_abort(NULL);
+            flint_abort();
+        }
+
+        flint_free(a);
+
+        flint_memory_stats_get(s);
+
+        if (s->live != 0)
+        {
+            flint_printf("FAIL (live after free):\n");
+            flint_printf("live = %wd\n", s->live);
+            fflush(stdout);
+            flint_set_thread_abort(NULL);
+            flint_abort();
+        }
+
+        /* GMP allocations count towards the limit */
+        mpz_init2(z, FLINT_BITS*(limit/2/sizeof(mp_limb_t)));
+
+        thrown = 0;
+
+        if (setjmp(env) == 0)
+        {
+            quiet();
+            b = flint_malloc(limit - limit/2 + sizeof(mp_limb_t));
+            loud();
+        }
+        else
+            thrown = 1;
+
+        if (!thrown || b != NULL)
+        {
+            flint_printf("FAIL (GMP allocation):\n");
+            flint_printf("limit = %wd\n", limit);
+            fflush(stdout);
+            flint_set_thread_abort(NULL);
+            flint_abort();
+        }
+
+        mpz_clear(z);
+
+        b = flint_malloc(limit);
+        flint_free(b);
+        b = NULL;
+    }
+
+    flint_set_memory_limit(0);
+    flint_set_thread_abort(NULL);
+
+#if SILENCE_STDOUT
+    if (out != -1)
+        close(out);
+    if (null != -1)
+        close(null);
+#endif
+
+    /* no limit */
+    {
+        void * a = flint_malloc(100000);
+        flint_free(a);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
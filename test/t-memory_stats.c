@@ -0,0 +1,300 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "thread_support.h"
+
+static void pool_alloc(void * arg)
+{
+    *(void **) arg = flint_malloc(500);
+}
+
+#if FLINT_USES_PTHREAD
+#include <pthread.h>
+
+static void * worker(void * arg)
+{
+    flint_memory_stats_t s;
+    void ** blocks = (void **) arg;
+    slong i;
+
+    flint_memory_stats_reset();
+
+    for (i = 0; i < 10; i++)
+        blocks[i] = flint_malloc(100);
+
+    flint_memory_stats_get(s);
+
+    if (s->allocs != 10 || s->live != 1000 || s->peak != 1000)
+    {
+        flint_printf("FAIL (worker):\n");
+        flint_printf("allocs = %wu, live = %wd, peak = %wd\n",
+                                                  s->allocs, s->live, s->peak);
+        fflush(stdout);
+        flint_abort();
+    }
+
+    return NULL;
+}
+#endif
+
+int main(void)
+{
+    int i, j, result;
+    flint_memory_stats_t s0, s1;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("memory_stats....");
+    fflush(stdout);
+
+    flint_memory_stats_enable(1);
+
+    /* random sequences of allocations */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        void * blocks[20];
+        slong sizes[20];
+        slong live = 0, peak = 0;
+        ulong allocs = 0, reallocs = 0, frees = 0;
+
+        for (j = 0; j < 20; j++)
+            blocks[j] = NULL;
+
+        flint_memory_stats_reset();
+        flint_memory_stats_get(s0);
+
+        for (j = 0; j < 200; j++)
+        {
+            slong k = n_randint(state, 20);
+            slong size = n_randint(state, 1000) + 1;
+
+            if (blocks[k] == NULL)
+            {
+                if (n_randint(state, 2))
+                    blocks[k] = flint_malloc(size);
+                else
+                    blocks[k] = flint_calloc(size, 1);
+                allocs++;
+                live += size;
+            }
+            else if (n_randint(state, 2))
+            {
+                blocks[k] = flint_realloc(blocks[k], size);
+                reallocs++;
+                live += size - sizes[k];
+            }
+            else
+            {
+                flint_free(blocks[k]);
+                blocks[k] = NULL;
+                frees++;
+                live -= sizes[k];
+                size = 0;
+            }
+
+            sizes[k] = size;
+            peak = FLINT_MAX(peak, live);
+        }
+
+        flint_memory_stats_get(s1);
+
+        result = (s1->allocs == allocs && s1->reallocs == reallocs &&
+                  s1->frees == frees && s1->live - s0->live == live &&
+                  s1->peak - s0->live == peak);
+        if (!result)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("allocs = %wu, %wu\n", s1->allocs, allocs);
+            flint_printf("reallocs = %wu, %wu\n", s1->reallocs, reallocs);
+            flint_printf("frees = %wu, %wu\n", s1->frees, frees);
+            flint_printf("live = %wd, %wd\n", s1->live - s0->live, live);
+            flint_printf("peak = %wd, %wd\n", s1->peak - s0->live, peak);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        for (j = 0; j < 20; j++)
+            flint_free(blocks[j]);
+
+        flint_memory_stats_get(s1);
+
+        result = (s1->live == s0->live);
+        if (!result)
+        {
+            flint_printf("FAIL (live):\n");
+            flint_printf("live = %wd, %wd\n", s1->live, s0->live);
+            fflush(stdout);
+            flint_abort();
+        }
+    }
+
+    /* modules */
+    {
+        slong m, prev;
+        void * p, * q;
+
+        m = flint_memory_stats_module("test");
+
+        result = (m > 0 && flint_memory_stats_module("test") == m);
+        if (!result)
+        {
+            flint_printf("FAIL (module id):\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_memory_stats_reset_module(m);
+        prev = flint_memory_stats_set_module(m);
+        p = flint_malloc(1000);
+        q = flint_malloc(500);
+        flint_memory_stats_set_module(prev);
+        flint_free(q);
+        q = flint_malloc(100);
+
+        flint_memory_stats_get_module(s1, m);
+
+        result = (s1->allocs == 2 && s1->frees == 1 && s1->live == 1000
+                  && s1->peak == 1500);
+        if (!result)
+        {
+            flint_printf("FAIL (module):\n");
+            flint_printf("allocs = %wu, frees = %wu, live = %wd, peak = %wd\n",
+                                      s1->allocs, s1->frees, s1->live, s1->peak);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_free(p);
+        flint_free(q);
+    }
+
+    /* entry point tags, which are inherited by pool threads */
+    {
+        slong m, prev, num;
+        void * p = NULL, * q = NULL;
+        thread_pool_handle * handles;
+
+        m = flint_memory_stats_module("test entry");
+        flint_memory_stats_reset_module(m);
+
+        prev = _flint_memory_stats_enter("test entry");
+        p = flint_malloc(1000);
+
+        flint_set_num_threads(2);
+        num = flint_request_threads(&handles, 2);
+        if (num > 0)
+        {
+            thread_pool_wake(global_thread_pool, handles[0], 0, pool_alloc, &q);
+            thread_pool_wait(global_thread_pool, handles[0]);
+        }
+        else
+            pool_alloc(&q);
+        flint_give_back_threads(handles, num);
+        flint_set_num_threads(1);
+
+        flint_memory_stats_set_module(prev);
+
+        flint_memory_stats_get_module(s1, m);
+
+        /* the handles of the helper thread are also counted */
+        result = (prev == 0 && s1->allocs >= 2 && s1->live == 1500);
+        if (!result)
+        {
+            flint_printf("FAIL (entry point):\n");
+            flint_printf("allocs = %wu, live = %wd\n", s1->allocs, s1->live);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* a module set by the caller takes precedence */
+        prev = flint_memory_stats_set_module(m);
+        result = (_flint_memory_stats_enter("test other") == m
+                  && _flint_memory_stats_current_module() == m);
+        flint_memory_stats_set_module(prev);
+        if (!result)
+        {
+            flint_printf("FAIL (nested entry point):\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_free(p);
+        flint_free(q);
+    }
+
+    /* blocks allocated while disabled are ignored */
+    {
+        void * p;
+
+        flint_memory_stats_enable(0);
+        p = flint_malloc(1000);
+        flint_memory_stats_enable(1);
+
+        flint_memory_stats_get(s0);
+        p = flint_realloc(p, 2000);
+        flint_free(p);
+        flint_memory_stats_get(s1);
+
+        result = (s1->live == s0->live && s1->allocs == s0->allocs + 1);
+        if (!result)
+        {
+            flint_printf("FAIL (untracked):\n");
+            fflush(stdout);
+            flint_abort();
+        }
+    }
+
+#if FLINT_USES_PTHREAD
+    /* blocks freed by another thread are charged to the allocating thread */
+    {
+        pthread_t thread;
+        void * blocks[10];
+
+        flint_memory_stats_get_total(s0);
+
+        pthread_create(&thread, NULL, worker, blocks);
+        pthread_join(thread, NULL);
+
+        flint_memory_stats_get_total(s1);
+
+        result = (s1->live == s0->live + 1000);
+        if (!result)
+        {
+            flint_printf("FAIL (total):\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        for (j = 0; j < 10; j++)
+            flint_free(blocks[j]);
+
+        flint_memory_stats_get_total(s1);
+
+        result = (s1->live == s0->live);
+        if (!result)
+        {
+            flint_printf("FAIL (total after free):\n");
+            fflush(stdout);
+            flint_abort();
+        }
+    }
+#endif
+
+    flint_memory_stats_enable(0);
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -41,6 +41,7 @@ typedef struct
     volatile int idx;
     volatile int available;
     volatile int max_workers;
+    slong module;       /* memory statistics module of the waking thread */
     void (* fxn)(void *);
     void * fxnarg;
     volatile int working;
@@ -93,6 +94,81 @@ FLINT_DLL void thread_pool_give_back(thread_pool_t T, thread_pool_handle i);
 
 FLINT_DLL void thread_pool_clear(thread_pool_t T);
 
+/* work stealing tasks *******************************************************/
+
+/*
+    A task group counts the spawned tasks that have not yet finished.
+    Tasks are pushed onto the deque of the worker that spawns them; idle
+    workers steal from the opposite end of the other deques.
+*/
+typedef struct
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+    volatile slong pending;
+} thread_pool_task_group_struct;
+
+typedef thread_pool_task_group_struct thread_pool_task_group_t[1];
+
+typedef struct
+{
+    void (* fxn)(void *);
+    void * fxnarg;
+    thread_pool_task_group_struct * group;
+} _thread_pool_task_struct;
+
+typedef struct
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+    _thread_pool_task_struct * tasks;   /* circular buffer */
+    slong alloc;
+    volatile slong top;                 /* thieves take from here */
+    volatile slong length;              /* owner pushes/pops at top + length */
+} _thread_pool_deque_struct;
+
+typedef struct
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+    pthread_cond_t sleep;
+#endif
+    _thread_pool_deque_struct * deques; /* deques[0] belongs to the master */
+    slong num_workers;                  /* including the master */
+    volatile slong idle;
+    volatile int done;
+} _thread_pool_scheduler_struct;
+
+FLINT_DLL void thread_pool_task_group_init(thread_pool_task_group_t G);
+
+FLINT_DLL void thread_pool_task_group_clear(thread_pool_task_group_t G);
+
+FLINT_DLL void thread_pool_spawn(thread_pool_task_group_t G,
+                                                 void (* f)(void *), void * a);
+
+FLINT_DLL void thread_pool_sync(thread_pool_task_group_t G);
+
+FLINT_DLL void thread_pool_run_tasks(thread_pool_t T,
+                              thread_pool_handle * handles, slong num_handles,
+                                                 void (* f)(void *), void * a);
+
+FLINT_DLL void thread_pool_run_task_array(thread_pool_t T,
+                              thread_pool_handle * handles, slong num_handles,
+                       void (* f)(void *), void * args, slong size, slong num);
+
+FLINT_DLL int thread_pool_in_tasks(void);
+
+FLINT_DLL slong thread_pool_task_workers(void);
+
+FLINT_DLL extern FLINT_TLS_PREFIX
+                     _thread_pool_scheduler_struct * _thread_pool_scheduler;
+FLINT_DLL extern FLINT_TLS_PREFIX slong _thread_pool_scheduler_index;
+
+FLINT_DLL int _thread_pool_execute_one(_thread_pool_scheduler_struct * S,
+                                                                 slong index);
+
 /* misc internal helpers *****************************************************/
 
 FLINT_DLL void _thread_pool_distribute_work_2(slong start, slong stop,
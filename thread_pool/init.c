@@ -24,7 +24,9 @@ void * thread_pool_idle_loop(void * varg)
 thread_pool_DoWork:
 
     _flint_set_num_workers(arg->max_workers);
+    flint_memory_stats_set_module(arg->module);
     arg->fxn(arg->fxnarg);
+    flint_memory_stats_set_module(0);
 
 thread_pool_Lock:
 
@@ -103,6 +105,7 @@ void thread_pool_init(thread_pool_t T, slong size)
         D[i].fxnarg = NULL;
         D[i].working = -1;
 	D[i].max_workers = 0;
+        D[i].module = 0;
         D[i].exit = 0;
 #if FLINT_USES_PTHREAD
         pthread_mutex_lock(&D[i].mutex);
@@ -0,0 +1,290 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_pool.h"
+
+FLINT_TLS_PREFIX _thread_pool_scheduler_struct * _thread_pool_scheduler = NULL;
+FLINT_TLS_PREFIX slong _thread_pool_scheduler_index = 0;
+
+int thread_pool_in_tasks(void)
+{
+    return _thread_pool_scheduler != NULL;
+}
+
+slong thread_pool_task_workers(void)
+{
+    return _thread_pool_scheduler != NULL ?
+                                      _thread_pool_scheduler->num_workers : 1;
+}
+
+/* take the newest task from our own deque or the oldest from someone else */
+static int _take_task(_thread_pool_task_struct * t,
+                                 _thread_pool_scheduler_struct * S, slong index)
+{
+    slong i, j;
+    _thread_pool_deque_struct * Q;
+
+    for (i = 0; i < S->num_workers; i++)
+    {
+        j = index + i;
+        if (j >= S->num_workers)
+            j -= S->num_workers;
+
+        Q = S->deques + j;
+
+        if (Q->length == 0)
+            continue;
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&Q->mutex);
+#endif
+        if (Q->length > 0)
+        {
+            Q->length--;
+            if (i == 0)
+            {
+                *t = Q->tasks[(Q->top + Q->length) % Q->alloc];
+            }
+            else
+            {
+                *t = Q->tasks[Q->top];
+                Q->top = (Q->top + 1) % Q->alloc;
+            }
+#if FLINT_USES_PTHREAD
+            pthread_mutex_unlock(&Q->mutex);
+#endif
+            return 1;
+        }
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&Q->mutex);
+#endif
+    }
+
+    return 0;
+}
+
+int _thread_pool_execute_one(_thread_pool_scheduler_struct * S, slong index)
+{
+    _thread_pool_task_struct t;
+
+    if (!_take_task(&t, S, index))
+        return 0;
+
+    t.fxn(t.fxnarg);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&t.group->mutex);
+#endif
+    t.group->pending--;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&t.group->mutex);
+#endif
+
+    return 1;
+}
+
+static int _have_work(_thread_pool_scheduler_struct * S)
+{
+    slong i, length;
+
+    for (i = 0; i < S->num_workers; i++)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&S->deques[i].mutex);
+#endif
+        length = S->deques[i].length;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&S->deques[i].mutex);
+#endif
+        if (length > 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+typedef struct
+{
+    _thread_pool_scheduler_struct * S;
+    slong index;
+} _worker_arg_struct;
+
+static void _thread_pool_task_worker(void * varg)
+{
+    _worker_arg_struct * arg = (_worker_arg_struct *) varg;
+    _thread_pool_scheduler_struct * S = arg->S;
+
+    _thread_pool_scheduler = S;
+    _thread_pool_scheduler_index = arg->index;
+
+    while (1)
+    {
+        if (_thread_pool_execute_one(S, arg->index))
+            continue;
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&S->mutex);
+#endif
+        if (S->done)
+        {
+#if FLINT_USES_PTHREAD
+            pthread_mutex_unlock(&S->mutex);
+#endif
+            break;
+        }
+
+        S->idle++;
+#if FLINT_USES_PTHREAD
+        while (!S->done && !_have_work(S))
+            pthread_cond_wait(&S->sleep, &S->mutex);
+#endif
+        S->idle--;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&S->mutex);
+#endif
+    }
+
+    _thread_pool_scheduler = NULL;
+    _thread_pool_scheduler_index = 0;
+}
+
+void thread_pool_run_tasks(thread_pool_t T,
+                              thread_pool_handle * handles, slong num_handles,
+                                                  void (* f)(void *), void * a)
+{
+    slong i;
+    _thread_pool_scheduler_struct S[1];
+    _worker_arg_struct * args;
+
+    /*
+        Nested calls join the scheduler that is already running on this
+        thread, so that tasks spawned by f can be stolen by its workers.
+    */
+    if (_thread_pool_scheduler != NULL || num_handles <= 0)
+    {
+        f(a);
+        return;
+    }
+
+    S->num_workers = num_handles + 1;
+    S->idle = 0;
+    S->done = 0;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&S->mutex, NULL);
+    pthread_cond_init(&S->sleep, NULL);
+#endif
+    S->deques = (_thread_pool_deque_struct *) flint_malloc(
+                            S->num_workers*sizeof(_thread_pool_deque_struct));
+    for (i = 0; i < S->num_workers; i++)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_init(&S->deques[i].mutex, NULL);
+#endif
+        S->deques[i].tasks = NULL;
+        S->deques[i].alloc = 0;
+        S->deques[i].top = 0;
+        S->deques[i].length = 0;
+    }
+
+    args = (_worker_arg_struct *) flint_malloc(
+                                     num_handles*sizeof(_worker_arg_struct));
+
+    _thread_pool_scheduler = S;
+    _thread_pool_scheduler_index = 0;
+
+    for (i = 0; i < num_handles; i++)
+    {
+        args[i].S = S;
+        args[i].index = i + 1;
+        thread_pool_wake(T, handles[i], 0, _thread_pool_task_worker, args + i);
+    }
+
+    f(a);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&S->mutex);
+#endif
+    S->done = 1;
+#if FLINT_USES_PTHREAD
+    pthread_cond_broadcast(&S->sleep);
+    pthread_mutex_unlock(&S->mutex);
+#endif
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(T, handles[i]);
+
+    _thread_pool_scheduler = NULL;
+    _thread_pool_scheduler_index = 0;
+
+    for (i = 0; i < S->num_workers; i++)
+    {
+        /* f should have synced everything it spawned */
+        FLINT_ASSERT(S->deques[i].length == 0);
+#if FLINT_USES_PTHREAD
+        pthread_mutex_destroy(&S->deques[i].mutex);
+#endif
+        if (S->deques[i].tasks != NULL)
+            flint_free(S->deques[i].tasks);
+    }
+
+    flint_free(S->deques);
+    flint_free(args);
+
+#if FLINT_USES_PTHREAD
+    pthread_cond_destroy(&S->sleep);
+    pthread_mutex_destroy(&S->mutex);
+#endif
+}
+
+typedef struct
+{
+    void (* f)(void *);
+    char * args;
+    slong size;
+    slong num;
+} _task_array_struct;
+
+static void _task_array(void * varg)
+{
+    _task_array_struct * arg = (_task_array_struct *) varg;
+    slong i;
+    thread_pool_task_group_t G;
+
+    thread_pool_task_group_init(G);
+
+    for (i = 0; i + 1 < arg->num; i++)
+        thread_pool_spawn(G, arg->f, arg->args + i*arg->size);
+    arg->f(arg->args + (arg->num - 1)*arg->size);
+
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+}
+
+void thread_pool_run_task_array(thread_pool_t T,
+                              thread_pool_handle * handles, slong num_handles,
+                        void (* f)(void *), void * args, slong size, slong num)
+{
+    _task_array_struct arg;
+
+    if (num <= 1)
+    {
+        if (num == 1)
+            f(args);
+        return;
+    }
+
+    arg.f = f;
+    arg.args = (char *) args;
+    arg.size = size;
+    arg.num = num;
+
+    thread_pool_run_tasks(T, handles, num_handles, _task_array, &arg);
+}
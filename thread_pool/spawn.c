@@ -0,0 +1,86 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_pool.h"
+
+static void _deque_fit_length(_thread_pool_deque_struct * Q)
+{
+    slong i, new_alloc;
+    _thread_pool_task_struct * t;
+
+    if (Q->length < Q->alloc)
+        return;
+
+    new_alloc = FLINT_MAX(WORD(8), 2*Q->alloc);
+    t = (_thread_pool_task_struct *) flint_malloc(
+                                   new_alloc*sizeof(_thread_pool_task_struct));
+
+    /* unwrap the circular buffer */
+    for (i = 0; i < Q->length; i++)
+        t[i] = Q->tasks[(Q->top + i) % Q->alloc];
+
+    if (Q->tasks != NULL)
+        flint_free(Q->tasks);
+
+    Q->tasks = t;
+    Q->alloc = new_alloc;
+    Q->top = 0;
+}
+
+void thread_pool_spawn(thread_pool_task_group_t G, void (* f)(void *), void * a)
+{
+    _thread_pool_scheduler_struct * S = _thread_pool_scheduler;
+    _thread_pool_deque_struct * Q;
+    _thread_pool_task_struct * t;
+    slong idle;
+
+    /* outside of thread_pool_run_tasks the task is run immediately */
+    if (S == NULL)
+    {
+        f(a);
+        return;
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&G->mutex);
+#endif
+    G->pending++;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&G->mutex);
+#endif
+
+    Q = S->deques + _thread_pool_scheduler_index;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&Q->mutex);
+#endif
+    _deque_fit_length(Q);
+    t = Q->tasks + (Q->top + Q->length) % Q->alloc;
+    t->fxn = f;
+    t->fxnarg = a;
+    t->group = G;
+    Q->length++;
+    /*
+        Reading S->idle under the deque lock guarantees that a worker going
+        to sleep either sees this task or is counted here.
+    */
+    idle = S->idle;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&Q->mutex);
+
+    if (idle > 0)
+    {
+        pthread_mutex_lock(&S->mutex);
+        pthread_cond_signal(&S->sleep);
+        pthread_mutex_unlock(&S->mutex);
+    }
+#endif
+}
@@ -0,0 +1,43 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_pool.h"
+#if FLINT_USES_PTHREAD
+#include <sched.h>
+#endif
+
+void thread_pool_sync(thread_pool_task_group_t G)
+{
+    _thread_pool_scheduler_struct * S = _thread_pool_scheduler;
+    slong pending;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&G->mutex);
+#endif
+        pending = G->pending;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&G->mutex);
+#endif
+        if (pending == 0)
+            return;
+
+        /* help out while waiting: run our own tasks first, then steal */
+        FLINT_ASSERT(S != NULL);
+        if (!_thread_pool_execute_one(S, _thread_pool_scheduler_index))
+        {
+#if FLINT_USES_PTHREAD
+            sched_yield();
+#endif
+        }
+    }
+}
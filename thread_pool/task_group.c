@@ -0,0 +1,29 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_pool.h"
+
+void thread_pool_task_group_init(thread_pool_task_group_t G)
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&G->mutex, NULL);
+#endif
+    G->pending = 0;
+}
+
+void thread_pool_task_group_clear(thread_pool_task_group_t G)
+{
+    /* all tasks should have been synced */
+    FLINT_ASSERT(G->pending == 0);
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&G->mutex);
+#endif
+}
@@ -0,0 +1,184 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_pool.h"
+#include "thread_support.h"
+#include "fmpz.h"
+
+/*
+    set x = product of numbers in (min, max] by spawning one half as a task;
+    every few levels the recursion goes through flint_run_tasks again to
+    check that nested calls share the scheduler that is already running
+*/
+
+typedef struct
+{
+    ulong min;
+    ulong max;
+    slong depth;
+    fmpz_t ans;
+}
+prod_arg_struct;
+
+void prod_helper(fmpz_t x, ulong min, ulong max, slong depth);
+
+void prod_run(void * varg)
+{
+    prod_arg_struct * arg = (prod_arg_struct *) varg;
+
+    prod_helper(arg->ans, arg->min, arg->max, arg->depth);
+}
+
+void prod_worker(void * varg)
+{
+    prod_arg_struct * arg = (prod_arg_struct *) varg;
+
+    if (arg->depth % 3 == 0)
+        flint_run_tasks(prod_run, arg, FLINT_DEFAULT_THREAD_LIMIT);
+    else
+        prod_run(arg);
+}
+
+void prod_helper(fmpz_t x, ulong min, ulong max, slong depth)
+{
+    ulong i, mid;
+    prod_arg_struct arg[1];
+    thread_pool_task_group_t G;
+
+    if (max - min <= UWORD(20))
+    {
+        fmpz_one(x);
+        for (i = max; i > min; i--)
+            fmpz_mul_ui(x, x, i);
+        return;
+    }
+
+    mid = min + (max - min)/2;
+
+    arg->min = min;
+    arg->max = mid;
+    arg->depth = depth + 1;
+    fmpz_init(arg->ans);
+
+    thread_pool_task_group_init(G);
+    thread_pool_spawn(G, prod_worker, arg);
+    prod_helper(x, mid, max, depth + 1);
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+
+    fmpz_mul(x, x, arg->ans);
+    fmpz_clear(arg->ans);
+}
+
+/* many small independent tasks in one group */
+
+typedef struct
+{
+    ulong i;
+    ulong ans;
+}
+square_arg_struct;
+
+void square_worker(void * varg)
+{
+    square_arg_struct * arg = (square_arg_struct *) varg;
+
+    arg->ans = arg->i*arg->i;
+}
+
+typedef struct
+{
+    slong n;
+    square_arg_struct * args;
+}
+squares_arg_struct;
+
+void squares_run(void * varg)
+{
+    squares_arg_struct * arg = (squares_arg_struct *) varg;
+    thread_pool_task_group_t G;
+    slong i;
+
+    thread_pool_task_group_init(G);
+    for (i = 0; i < arg->n; i++)
+        thread_pool_spawn(G, square_worker, arg->args + i);
+    thread_pool_sync(G);
+    thread_pool_task_group_clear(G);
+}
+
+int
+main(void)
+{
+    slong i, j;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("run_tasks....");
+    fflush(stdout);
+
+    for (i = 0; i < 10*flint_test_multiplier(); i++)
+    {
+        fmpz_t y;
+        prod_arg_struct arg[1];
+        squares_arg_struct sarg[1];
+
+        fmpz_init(y);
+        flint_set_num_threads(n_randint(state, 10) + 1);
+
+        for (j = 0; j < 10; j++)
+        {
+            ulong n = n_randint(state, 2000);
+
+            fmpz_fac_ui(y, n);
+
+            arg->min = 0;
+            arg->max = n;
+            arg->depth = 1;
+            fmpz_init(arg->ans);
+            flint_run_tasks(prod_run, arg, n_randint(state, 12) + 1);
+
+            if (!fmpz_equal(arg->ans, y) || thread_pool_in_tasks())
+            {
+                flint_printf("FAIL: product\n");
+                flint_printf("n: %wu\n", n);
+                flint_abort();
+            }
+
+            fmpz_clear(arg->ans);
+        }
+
+        sarg->n = n_randint(state, 1000);
+        sarg->args = (square_arg_struct *) flint_malloc(
+                                     (sarg->n + 1)*sizeof(square_arg_struct));
+        for (j = 0; j < sarg->n; j++)
+            sarg->args[j].i = j;
+
+        flint_run_tasks(squares_run, sarg, FLINT_DEFAULT_THREAD_LIMIT);
+
+        for (j = 0; j < sarg->n; j++)
+        {
+            if (sarg->args[j].ans != (ulong) j*j)
+            {
+                flint_printf("FAIL: squares\n");
+                flint_printf("j: %wd\n", j);
+                flint_abort();
+            }
+        }
+
+        flint_free(sarg->args);
+
+        fmpz_clear(y);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -33,6 +33,7 @@ void thread_pool_wake(thread_pool_t T, thread_pool_handle i,
     FLINT_ASSERT(D[i].available == 0);
 
     D[i].max_workers = max_workers;
+    D[i].module = _flint_memory_stats_current_module();
     D[i].working = 1;
     D[i].fxn = f;
     D[i].fxnarg = a;
@@ -10,6 +10,12 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#if defined( _MSC_VER )
+#include "gettimeofday.h"
+#else
+#include <sys/time.h>
+#endif
+
 #include "flint.h"
 #include "thread_pool.h"
 #include "thread_support.h"
@@ -123,3 +129,105 @@ void flint_give_back_threads(thread_pool_handle * handles, slong num_handles)
         flint_free(handles);
 }
 
+
+void flint_run_tasks(void (* f)(void *), void * a, slong thread_limit)
+{
+    thread_pool_handle * handles;
+    slong num_handles;
+
+    /* already inside a scheduler: spawned tasks go to its workers */
+    if (thread_pool_in_tasks())
+    {
+        f(a);
+        return;
+    }
+
+    num_handles = flint_request_threads(&handles, thread_limit);
+
+    thread_pool_run_tasks(global_thread_pool, handles, num_handles, f, a);
+
+    flint_give_back_threads(handles, num_handles);
+}
+
+void flint_run_task_array(void (* f)(void *), void * args, slong size,
+                                                                   slong num)
+{
+    thread_pool_handle * handles;
+    slong num_handles;
+
+    /* already inside a scheduler: spawned tasks go to its workers */
+    if (num <= 1 || thread_pool_in_tasks())
+    {
+        thread_pool_run_task_array(global_thread_pool, NULL, 0,
+                                                         f, args, size, num);
+        return;
+    }
+
+    num_handles = flint_request_threads(&handles, num);
+
+    thread_pool_run_task_array(global_thread_pool, handles, num_handles,
+                                                         f, args, size, num);
+
+    flint_give_back_threads(handles, num_handles);
+}
+
+/* cancellation *************************************************************/
+
+FLINT_TLS_PREFIX flint_cancel_struct * _flint_cancel = NULL;
+
+static double _flint_cancel_time(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, 0);
+
+    return tv.tv_sec + 1e-6*tv.tv_usec;
+}
+
+void flint_cancel_init(flint_cancel_t C)
+{
+    C->cancelled = 0;
+    C->deadline = 0;
+}
+
+void flint_cancel_clear(flint_cancel_t C)
+{
+}
+
+void flint_cancel_request(flint_cancel_t C)
+{
+    C->cancelled = 1;
+}
+
+void flint_cancel_set_timeout(flint_cancel_t C, double seconds)
+{
+    C->deadline = _flint_cancel_time() + FLINT_MAX(seconds, 1e-6);
+}
+
+int flint_cancel_is_requested(flint_cancel_t C)
+{
+    if (C->cancelled)
+        return 1;
+
+    if (C->deadline != 0 && _flint_cancel_time() >= C->deadline)
+    {
+        C->cancelled = 1;
+        return 1;
+    }
+
+    return 0;
+}
+
+flint_cancel_struct * flint_set_cancel(flint_cancel_struct * C)
+{
+    flint_cancel_struct * old = _flint_cancel;
+
+    _flint_cancel = C;
+
+    return old;
+}
+
+int flint_cancelled(void)
+{
+    return _flint_cancel != NULL && flint_cancel_is_requested(_flint_cancel);
+}
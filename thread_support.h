@@ -27,6 +27,12 @@ FLINT_DLL slong flint_request_threads(thread_pool_handle ** handles,
 FLINT_DLL void flint_give_back_threads(thread_pool_handle * handles,
                                                             slong num_handles);
 
+FLINT_DLL void flint_run_tasks(void (* f)(void *), void * a,
+                                                           slong thread_limit);
+
+FLINT_DLL void flint_run_task_array(void (* f)(void *), void * args,
+                                                        slong size, slong num);
+
 #ifdef __cplusplus
 }
 #endif
@@ -95,6 +95,15 @@ FLINT_DLL void n_primes_sieve_range(n_primes_t iter, ulong a, ulong b);
 
 FLINT_DLL void n_primes_jump_after(n_primes_t iter, ulong n);
 
+FLINT_DLL ulong * n_primes_range(slong * num, ulong a, ulong b);
+
+FLINT_DLL ulong n_primes_range_count(ulong a, ulong b);
+
+typedef int (* n_primes_range_func)(const ulong * primes, slong num, void * arg);
+
+FLINT_DLL int n_primes_range_foreach(ulong a, ulong b,
+                                       n_primes_range_func func, void * arg);
+
 ULONG_EXTRAS_INLINE ulong
 n_primes_next(n_primes_t iter)
 {
@@ -116,9 +125,18 @@ n_primes_next(n_primes_t iter)
 
 FLINT_DLL extern const unsigned int flint_primes_small[];
 
-extern FLINT_TLS_PREFIX ulong * _flint_primes[FLINT_BITS];
-extern FLINT_TLS_PREFIX double * _flint_prime_inverses[FLINT_BITS];
-extern FLINT_TLS_PREFIX int _flint_primes_used;
+FLINT_DLL extern ulong * _flint_primes[FLINT_BITS];
+FLINT_DLL extern double * _flint_prime_inverses[FLINT_BITS];
+FLINT_DLL extern int _flint_primes_used;
+
+/* the prime tables are shared between threads */
+#if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)) && FLINT_USES_PTHREAD
+#define _flint_primes_used_get() __atomic_load_n(&_flint_primes_used, __ATOMIC_ACQUIRE)
+#define _flint_primes_used_set(v) __atomic_store_n(&_flint_primes_used, (v), __ATOMIC_RELEASE)
+#else
+#define _flint_primes_used_get() (_flint_primes_used)
+#define _flint_primes_used_set(v) (_flint_primes_used = (v))
+#endif
 
 FLINT_DLL void n_compute_primes(ulong num_primes);
 
@@ -397,12 +415,16 @@ FLINT_DLL int n_is_prime_pocklington(ulong n, ulong iterations);
 
 FLINT_DLL int n_is_prime(ulong n);
 
+FLINT_DLL void n_is_prime_vec(ulong * res, const ulong * v, slong len);
+
 FLINT_DLL ulong n_nth_prime(ulong n);
 
 FLINT_DLL void n_nth_prime_bounds(ulong *lo, ulong *hi, ulong n);
 
 FLINT_DLL ulong n_prime_pi(ulong n);
 
+FLINT_DLL ulong n_prime_pi_lmo(ulong n);
+
 FLINT_DLL void n_prime_pi_bounds(ulong *lo, ulong *hi, ulong n);
 
 FLINT_DLL int n_remove(ulong * n, ulong p);
@@ -22,7 +22,7 @@
 #include "flint.h"
 #include "ulong_extras.h"
 
-#if FLINT_REENTRANT && !FLINT_USES_TLS
+#if FLINT_USES_PTHREAD
 #include <pthread.h>
 
 static pthread_once_t primes_initialised = PTHREAD_ONCE_INIT;
@@ -44,12 +44,16 @@ const unsigned int flint_primes_small[] =
 };
 
 
-/* _flint_primes[i] holds an array of 2^i primes */
-FLINT_TLS_PREFIX mp_limb_t * _flint_primes[FLINT_BITS];
-FLINT_TLS_PREFIX double * _flint_prime_inverses[FLINT_BITS];
-FLINT_TLS_PREFIX int _flint_primes_used = 0;
+/*
+    _flint_primes[i] holds an array of 2^i primes. The tables are shared by
+    all threads; arrays are only added, under the lock, until n_cleanup_primes
+    is called, so pointers to them stay valid.
+*/
+mp_limb_t * _flint_primes[FLINT_BITS];
+double * _flint_prime_inverses[FLINT_BITS];
+int _flint_primes_used = 0;
 
-#if FLINT_REENTRANT && !FLINT_USES_TLS
+#if FLINT_USES_PTHREAD
 void n_compute_primes_init()
 {
    pthread_mutex_init(&primes_lock, NULL);
@@ -62,16 +66,13 @@ n_compute_primes(ulong num_primes)
     int i, m;
     ulong num_computed;
 
-#if FLINT_REENTRANT && !FLINT_USES_TLS
+#if FLINT_USES_PTHREAD
     pthread_once(&primes_initialised, n_compute_primes_init);
     pthread_mutex_lock(&primes_lock);
 #endif
 
     m = FLINT_CLOG2(num_primes);
 
-    if (_flint_primes_used == 0)
-        flint_register_cleanup_function(n_cleanup_primes);
-
     if (m >= _flint_primes_used)
     {
         n_primes_t iter;
@@ -94,10 +95,11 @@ n_compute_primes(ulong num_primes)
             _flint_primes[i] = _flint_primes[m];
             _flint_prime_inverses[i] = _flint_prime_inverses[m];
         }
-        _flint_primes_used = m + 1;
+        /* publish the new arrays before the new count */
+        _flint_primes_used_set(m + 1);
     }
 
-#if FLINT_REENTRANT && !FLINT_USES_TLS
+#if FLINT_USES_PTHREAD
     pthread_mutex_unlock(&primes_lock);
 #endif
 }
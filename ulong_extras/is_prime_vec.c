@@ -0,0 +1,327 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+#define IS_PRIME_VEC_LANES 4
+
+/* as in n_is_prime: 1 if prime, 0 if composite, -1 if undecided */
+static __inline__ int
+_n_is_prime_trial(ulong n)
+{
+    if (n < 11) {
+        if (n == 2 || n == 3 || n == 5 || n == 7)   return 1;
+        else                                        return 0;
+    }
+    if (!(n%2) || !(n%3) || !(n%5) || !(n%7))       return 0;
+    if (n <  121) /* 11*11 */                       return 1;
+    if (!(n%11) || !(n%13) || !(n%17) || !(n%19) ||
+        !(n%23) || !(n%29) || !(n%31) || !(n%37) ||
+        !(n%41) || !(n%43) || !(n%47) || !(n%53))   return 0;
+    if (n < 3481) /* 59*59 */                       return 1;
+    if (n > 1000000 &&
+        (!(n% 59) || !(n% 61) || !(n% 67) || !(n% 71) || !(n% 73) ||
+         !(n% 79) || !(n% 83) || !(n% 89) || !(n% 97) || !(n%101) ||
+         !(n%103) || !(n%107) || !(n%109) || !(n%113) || !(n%127) ||
+         !(n%131) || !(n%137) || !(n%139) || !(n%149)))  return 0;
+
+    return -1;
+}
+
+#if FLINT64
+
+/*
+    Montgomery multiplication: a*b/2^64 mod n for odd n, where ninv is
+    -1/n mod 2^64. No normalisation is needed, so this is cheaper than
+    n_mulmod2_preinv in long chains of multiplications.
+*/
+static __inline__ ulong
+_n_mulmod_redc(ulong a, ulong b, ulong n, ulong ninv)
+{
+    ulong hi, lo, mhi, mlo, r;
+
+    umul_ppmm(hi, lo, a, b);
+    umul_ppmm(mhi, mlo, lo * ninv, n);
+
+    /* lo + mlo is 0 mod 2^64, with a carry unless lo is 0 */
+    r = hi + (lo != 0);
+    r += mhi;
+
+    if (r < mhi || r >= n)
+        r -= n;
+
+    return r;
+}
+
+/*
+    Run the base 2 exponentiations of the BPSW test for the odd moduli n[0],
+    ..., n[IS_PRIME_VEC_LANES - 1] in lockstep. The chains are independent, so
+    the multiplications of different lanes overlap in the pipeline. Lanes with
+    a shorter exponent start with leading zero bits, which leave y = 1, and
+    multiplying by the base 2 is a modular doubling, also in Montgomery form.
+    Moduli congruent to 3 or 7 mod 10 need to pass the Fermat test to base 2,
+    the others the strong test; res[i] is set to 1 if n[i] does so.
+*/
+static void
+_n_is_prime_base2_lanes(int * res, const ulong * n)
+{
+    ulong ninv[IS_PRIME_VEC_LANES], d[IS_PRIME_VEC_LANES];
+    ulong one[IS_PRIME_VEC_LANES], y[IS_PRIME_VEC_LANES];
+    ulong dmax = 0, t;
+    slong i, b, j;
+    int strong;
+
+    for (i = 0; i < IS_PRIME_VEC_LANES; i++)
+    {
+        /* Newton iteration for 1/n mod 2^64, correct to 3 bits at first */
+        ninv[i] = n[i];
+        for (j = 0; j < 5; j++)
+            ninv[i] *= 2 - n[i]*ninv[i];
+        ninv[i] = -ninv[i];
+
+        one[i] = (-n[i]) % n[i];
+
+        d[i] = n[i] - 1;
+        while ((d[i] & UWORD(1)) == 0)
+            d[i] >>= 1;
+        dmax |= d[i];
+        y[i] = one[i];
+    }
+
+    for (b = FLINT_BIT_COUNT(dmax) - 1; b >= 0; b--)
+    {
+        for (i = 0; i < IS_PRIME_VEC_LANES; i++)
+        {
+            y[i] = _n_mulmod_redc(y[i], y[i], n[i], ninv[i]);
+
+            if ((d[i] >> b) & 1)
+                y[i] = n_addmod(y[i], y[i], n[i]);
+        }
+    }
+
+    for (i = 0; i < IS_PRIME_VEC_LANES; i++)
+    {
+        strong = (y[i] == one[i]);
+
+        for (t = d[i]; !strong && t != n[i] - 1; t <<= 1)
+        {
+            if (y[i] == n[i] - one[i])
+                strong = 1;
+            else
+                y[i] = _n_mulmod_redc(y[i], y[i], n[i], ninv[i]);
+        }
+
+        /* y = 2^(n - 1) unless the strong test was passed */
+        if ((n[i] % 10) == 3 || (n[i] % 10) == 7)
+            res[i] = strong || y[i] == one[i];
+        else
+            res[i] = strong;
+    }
+}
+
+/*
+    Run the Lucas chains of the BPSW test for the moduli n[i] in lockstep.
+    The Fibonacci test used by n_is_probabprime_BPSW for moduli congruent to
+    3 or 7 mod 10 is the chain for m = (n - (5/n))/2 and a = -3, the Lucas
+    test for the others the chain for m = n + 1 and a = 1/Q - 2 with the
+    parameters chosen as in n_is_probabprime_lucas. In both cases n passes
+    if a V_m = 2 V_(m+1). The pair (2, a) is fixed by zero bits of m, so
+    lanes with shorter m need no special handling.
+*/
+static void
+_n_is_prime_lucas_lanes(int * res, const ulong * n)
+{
+    ulong ninv[IS_PRIME_VEC_LANES], m[IS_PRIME_VEC_LANES];
+    ulong a[IS_PRIME_VEC_LANES], two[IS_PRIME_VEC_LANES];
+    ulong x[IS_PRIME_VEC_LANES], y[IS_PRIME_VEC_LANES];
+    ulong mmax = 0, one, xy, pinv, A;
+    slong i, b, j;
+    int D, Q;
+
+    for (i = 0; i < IS_PRIME_VEC_LANES; i++)
+    {
+        res[i] = -1;
+
+        if ((n[i] % 10) == 3 || (n[i] % 10) == 7)
+        {
+            m[i] = (n[i] - n_jacobi(WORD(5), n[i])) / 2;
+            A = n[i] - 3;
+        } else
+        {
+            for (j = 0; j < 100; j++)
+            {
+                D = 5 + 2 * j;
+                if (n_gcd(D, n[i] % D) != UWORD(1))
+                    break;
+                if (j % 2 == 1)
+                    D = -D;
+                if (n_jacobi(D, n[i]) == -1)
+                    break;
+            }
+
+            if (j == 100 || n_gcd(FLINT_ABS(D), n[i] % FLINT_ABS(D)) != UWORD(1))
+            {
+                res[i] = (j == 100 && !n_is_square(n[i]));
+                m[i] = 1;
+                A = 1;
+            } else
+            {
+                Q = (1 - D) / 4;
+                if (Q < 0)
+                    A = n_submod(n_invmod(Q + n[i], n[i]), UWORD(2), n[i]);
+                else
+                    A = n_submod(n_invmod(Q, n[i]), UWORD(2), n[i]);
+                m[i] = n[i] + 1;
+            }
+        }
+
+        mmax |= m[i];
+
+        ninv[i] = n[i];
+        for (j = 0; j < 5; j++)
+            ninv[i] *= 2 - n[i]*ninv[i];
+        ninv[i] = -ninv[i];
+
+        /* convert the constants to Montgomery form */
+        one = (-n[i]) % n[i];
+        pinv = n_preinvert_limb(n[i]);
+        a[i] = n_mulmod2_preinv(A, one, n[i], pinv);
+        two[i] = n_addmod(one, one, n[i]);
+        x[i] = two[i];
+        y[i] = a[i];
+    }
+
+    for (b = FLINT_BIT_COUNT(mmax) - 1; b >= 0; b--)
+    {
+        for (i = 0; i < IS_PRIME_VEC_LANES; i++)
+        {
+            xy = n_submod(_n_mulmod_redc(x[i], y[i], n[i], ninv[i]), a[i], n[i]);
+
+            if ((m[i] >> b) & 1)
+            {
+                y[i] = n_submod(_n_mulmod_redc(y[i], y[i], n[i], ninv[i]), two[i], n[i]);
+                x[i] = xy;
+            } else
+            {
+                x[i] = n_submod(_n_mulmod_redc(x[i], x[i], n[i], ninv[i]), two[i], n[i]);
+                y[i] = xy;
+            }
+        }
+    }
+
+    for (i = 0; i < IS_PRIME_VEC_LANES; i++)
+    {
+        if (res[i] == -1)
+            res[i] = (_n_mulmod_redc(a[i], x[i], n[i], ninv[i])
+                        == _n_mulmod_redc(two[i], y[i], n[i], ninv[i]));
+    }
+}
+
+/*
+    Run the lanes of one stage on the num queued moduli, padding the unused
+    lanes with a copy of the first
+*/
+static void
+_n_is_prime_run_lanes(int * r, ulong * n, slong num,
+                               void (* lanes)(int *, const ulong *))
+{
+    slong j;
+
+    for (j = num; j < IS_PRIME_VEC_LANES; j++)
+        n[j] = n[0];
+
+    lanes(r, n);
+}
+
+#endif
+
+void
+n_is_prime_vec(ulong * res, const ulong * v, slong len)
+{
+    slong i;
+#if FLINT64
+    slong j, k, num1 = 0, num2 = 0;
+    ulong n1[IS_PRIME_VEC_LANES], n2[IS_PRIME_VEC_LANES];
+    slong ind1[IS_PRIME_VEC_LANES], ind2[IS_PRIME_VEC_LANES];
+    int r1[IS_PRIME_VEC_LANES], r2[IS_PRIME_VEC_LANES];
+#endif
+    int t;
+
+    for (i = 0; i < (len + FLINT_BITS - 1)/FLINT_BITS; i++)
+        res[i] = 0;
+
+    for (i = 0; i <= len; i++)
+    {
+#if FLINT64
+        /*
+           values which need the BPSW test are queued for the base 2 stage,
+           those passing it for the Lucas stage, each stage being run once
+           its queue is full, or at the end on whatever is left
+        */
+        if (num1 == IS_PRIME_VEC_LANES || (i == len && num1 != 0))
+        {
+            _n_is_prime_run_lanes(r1, n1, num1, _n_is_prime_base2_lanes);
+
+            for (j = 0; j < num1; j++)
+            {
+                if (!r1[j])
+                    continue;
+
+                n2[num2] = n1[j];
+                ind2[num2++] = ind1[j];
+
+                if (num2 == IS_PRIME_VEC_LANES)
+                {
+                    _n_is_prime_run_lanes(r2, n2, num2, _n_is_prime_lucas_lanes);
+                    for (k = 0; k < num2; k++)
+                        res[ind2[k] / FLINT_BITS] |= ((ulong) r2[k]) << (ind2[k] % FLINT_BITS);
+                    num2 = 0;
+                }
+            }
+
+            num1 = 0;
+        }
+
+        if (i == len)
+        {
+            if (num2 != 0)
+            {
+                _n_is_prime_run_lanes(r2, n2, num2, _n_is_prime_lucas_lanes);
+                for (k = 0; k < num2; k++)
+                    res[ind2[k] / FLINT_BITS] |= ((ulong) r2[k]) << (ind2[k] % FLINT_BITS);
+            }
+
+            break;
+        }
+#else
+        if (i == len)
+            break;
+#endif
+
+        t = _n_is_prime_trial(v[i]);
+
+#if FLINT64
+        if (t == -1 && v[i] >= UWORD(1050535501))
+        {
+            n1[num1] = v[i];
+            ind1[num1++] = i;
+            continue;
+        }
+#endif
+
+        if (t == -1)
+            t = n_is_probabprime(v[i]);
+
+        res[i / FLINT_BITS] |= ((ulong) t) << (i % FLINT_BITS);
+    }
+}
@@ -12,11 +12,111 @@
 #define ulong ulongxx /* interferes with system includes */
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
 #undef ulong
 #define ulong mp_limb_t
 #include "flint.h"
 #include "ulong_extras.h"
 
+#define NTH_PRIME_LMO_CUTOFF (UWORD(1) << 20)
+#define NTH_PRIME_BLOCK (UWORD(1) << 24)
+
+/* logarithmic integral, from its series in log(x) */
+static double
+_n_li(double x)
+{
+    double l = log(x), t = 1.0, s = 0.0;
+    slong k;
+
+    for (k = 1; k < 1000; k++)
+    {
+        t *= l / k;
+        s += t / k;
+        if (t < 1e-17 * s)
+            break;
+    }
+
+    return 0.5772156649015329 + log(l) + s;
+}
+
+/*
+    For large n, estimate p_n as the inverse of li, count the primes up to
+    the estimate with n_prime_pi and sieve the short stretch between them
+*/
+static mp_limb_t
+_n_nth_prime_lmo(ulong n)
+{
+    double x, l;
+    ulong lo, hi, c, * primes;
+    slong i, num;
+
+    l = log((double) n);
+    x = n * (l + log(l) - 1);
+    for (i = 0; i < 4; i++)
+        x -= (_n_li(x) - n) * log(x);
+
+    if (x >= (double) UWORD_MAX)
+    {
+        flint_printf("Exception (n_nth_prime). n_nth_prime(%wu) does not fit "
+                     "in a word.\n", n);
+        flint_abort();
+    }
+
+    lo = (ulong) x;
+    c = n_prime_pi(lo);
+
+    if (c >= n)
+    {
+        /* go down from lo, with c = pi(hi - 1) */
+        hi = lo + 1;
+        while (1)
+        {
+            lo = (hi > NTH_PRIME_BLOCK) ? hi - NTH_PRIME_BLOCK : 0;
+            primes = n_primes_range(&num, lo, hi);
+
+            if (c - num < n)
+            {
+                lo = primes[n - (c - num) - 1];
+                flint_free(primes);
+                return lo;
+            }
+
+            c -= num;
+            hi = lo;
+            flint_free(primes);
+        }
+    }
+    else
+    {
+        /* go up from lo, with c = pi(lo) */
+        lo = lo + 1;
+        while (1)
+        {
+            hi = (lo < UWORD_MAX - NTH_PRIME_BLOCK) ?
+                                             lo + NTH_PRIME_BLOCK : UWORD_MAX;
+            primes = n_primes_range(&num, lo, hi);
+
+            if (c + num >= n)
+            {
+                lo = primes[n - c - 1];
+                flint_free(primes);
+                return lo;
+            }
+
+            if (hi == UWORD_MAX)
+            {
+                flint_printf("Exception (n_nth_prime). n_nth_prime(%wu) does "
+                             "not fit in a word.\n", n);
+                flint_abort();
+            }
+
+            c += num;
+            lo = hi;
+            flint_free(primes);
+        }
+    }
+}
+
 mp_limb_t n_nth_prime(ulong n)
 {
     if (n == 0)
@@ -25,6 +125,9 @@ mp_limb_t n_nth_prime(ulong n)
         flint_abort();
     }
 
+    /* prefer the cached primes when they already reach p_n */
+    if (n >= NTH_PRIME_LMO_CUTOFF && FLINT_CLOG2(n) >= _flint_primes_used_get())
+        return _n_nth_prime_lmo(n);
+
     return n_primes_arr_readonly(n)[n-1];
 }
-
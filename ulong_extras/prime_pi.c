@@ -13,6 +13,8 @@
 #include "flint.h"
 #include "ulong_extras.h"
 
+#define PRIME_PI_LMO_CUTOFF (UWORD(1) << 24)
+
 const unsigned char FLINT_PRIME_PI_ODD_LOOKUP[] =
 {
   0,2,3,4,4,5,6,6,7,8,8,9,9,9,10,11,11,11,12,12,13,14,14,15,15,15,16,16,16,17,
@@ -36,6 +38,9 @@ ulong n_prime_pi(mp_limb_t n)
         return FLINT_PRIME_PI_ODD_LOOKUP[(n-1)/2];
     }
 
+    if (n >= PRIME_PI_LMO_CUTOFF)
+        return n_prime_pi_lmo(n);
+
     n_prime_pi_bounds(&low, &high, n);
     primes = n_primes_arr_readonly(high + 1);
 
@@ -0,0 +1,467 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <limits.h>
+#include <string.h>
+#include <gmp.h>
+#include "flint.h"
+#include "longlong.h"
+#include "ulong_extras.h"
+#include "thread_pool.h"
+#include "thread_support.h"
+
+/*
+    Prime counting by the method of Lagarias, Miller and Odlyzko, as refined
+    by Deleglise and Rivat. With y >= x^(1/3), a = pi(y) and z = x/y,
+
+       pi(x) = phi(x, a) + a - 1 - P2(x, a),
+
+    where phi(x, b) counts the integers in [1, x] free of the first b primes
+    and P2 counts those with exactly two prime factors greater than y. The
+    recursion phi(x, b) = phi(x, b - 1) - phi(x/p_b, b - 1), stopped as soon
+    as the denominator exceeds y, splits phi(x, a) into the ordinary leaves
+
+       S1 = sum_{n <= y} mu(n) floor(x/n)
+
+    and the special leaves
+
+       S2 = - sum_{b <= a} sum_{m} mu(m) phi(x/(p_b m), b - 1),
+
+    over squarefree m <= y < m p_b with lpf(m) > p_b. The arguments of the
+    special leaves are at most z, and they are evaluated by sieving [1, z]
+    in segments, removing the primes p_1, p_2, ... in turn and reading off
+    phi from a bit array of the survivors with a counter for each block.
+    The range is split into chunks handled independently by the thread
+    pool, one round of chunks at a time; each chunk records how many
+    survivors it had at each level and the sum of mu(m) over its leaves
+    so that the contributions of the earlier chunks can be added after the
+    round, and the buffers are reused by the next round.
+    P2 only needs pi at the points x/p, y < p <= sqrt(x), and is found with
+    the segmented sieve of n_primes_range. Both parts take O(x^(2/3)) time
+    and O(x^(1/3)) memory, up to logarithmic factors.
+*/
+
+#define PRIME_PI_LMO_SEGMENT (1 << 16)     /* bits sieved at a time */
+#define PRIME_PI_LMO_COUNTER (1 << 8)      /* bits per survivor counter */
+#define PRIME_PI_LMO_BLOCK (1 << 24)
+#define PRIME_PI_LMO_CHUNKS_PER_THREAD 4
+
+/* (hi, lo) += c for a signed two limb accumulator */
+#define _acc_add(hi, lo, c)                                           \
+    do {                                                              \
+        slong __c = (c);                                              \
+        add_ssaaaa(hi, lo, hi, lo, (ulong) (__c < 0 ? -1 : 0), (ulong) __c); \
+    } while (0)
+
+/* (hi, lo) += s*c with c unsigned */
+#define _acc_addmul(hi, lo, s, c)                                     \
+    do {                                                              \
+        ulong __ph, __pl;                                             \
+        slong __s = (s);                                              \
+        umul_ppmm(__ph, __pl, (ulong) FLINT_ABS(__s), (c));           \
+        if (__s >= 0)                                                 \
+            add_ssaaaa(hi, lo, hi, lo, __ph, __pl);                   \
+        else                                                          \
+            sub_ddmmss(hi, lo, hi, lo, __ph, __pl);                   \
+    } while (0)
+
+typedef struct
+{
+    ulong x, y, z;
+    const ulong * primes;       /* p_1, ..., p_a */
+    slong a;
+    const signed char * mu;
+    const unsigned int * lpf;
+    const unsigned int * pi;    /* pi(m) for m <= y */
+    slong num_chunks;
+    slong chunk;                /* chunk handled in the current round */
+    ulong * count;              /* survivors per level */
+    slong * musum;              /* sum of -mu(m) per level */
+    ulong s2[2];                /* S2 contribution of the chunk */
+}
+_prime_pi_lmo_arg_t;
+
+static void
+_prime_pi_lmo_chunk(_prime_pi_lmo_arg_t * arg)
+{
+    const ulong x = arg->x, y = arg->y;
+    const slong a = arg->a;
+    ulong chunk, clo, chi, low, high, len, p, xp, j, mmin, mmax, m, v, phi;
+    ulong pos, before, word, s2hi = 0, s2lo = 0;
+    ulong * next, * count, * phi_run, * sieve;
+    slong * musum;
+    ulong * counter, total;
+    slong b, i, k = 0, kmin = 0, bmax;
+    int primes_only;
+
+    chunk = (arg->z + arg->num_chunks - 1) / arg->num_chunks;
+    clo = 1 + arg->chunk*chunk;
+    chi = FLINT_MIN(clo + chunk, arg->z + 1);
+
+    count = arg->count;
+    musum = arg->musum;
+
+    memset(count, 0, (a + 1)*sizeof(ulong));
+    memset(musum, 0, (a + 1)*sizeof(slong));
+    arg->s2[0] = arg->s2[1] = 0;
+
+    if (clo >= chi)
+        return;
+
+    next = flint_malloc((a + 1)*sizeof(ulong));
+    phi_run = flint_calloc(a + 1, sizeof(ulong));
+    sieve = flint_malloc(PRIME_PI_LMO_SEGMENT/8);
+    counter = flint_malloc((PRIME_PI_LMO_SEGMENT/PRIME_PI_LMO_COUNTER)
+                                                              *sizeof(ulong));
+
+    /* first multiple of each prime at or after the chunk */
+    for (b = 1; b <= a; b++)
+    {
+        p = arg->primes[b - 1];
+        next[b] = ((clo + p - 1)/p)*p;
+    }
+
+    bmax = a;
+
+    for (low = clo; low < chi; low += len)
+    {
+        len = FLINT_MIN(PRIME_PI_LMO_SEGMENT, chi - low);
+        high = low + len;
+
+        /* phi(x/(p m), b - 1) with x/(p m) >= low needs x/p^2 >= low */
+        while (bmax > 0 && x/arg->primes[bmax - 1]/arg->primes[bmax - 1] < low)
+            bmax--;
+
+        if (bmax == 0)
+            break;
+
+        /* bit i of the sieve is low + i, bits beyond len are never read */
+        memset(sieve, 0xff, PRIME_PI_LMO_SEGMENT/8);
+        for (i = 0; i < PRIME_PI_LMO_SEGMENT/PRIME_PI_LMO_COUNTER; i++)
+            counter[i] = PRIME_PI_LMO_COUNTER;
+        total = len;
+
+        for (b = 1; b <= bmax; b++)
+        {
+            p = arg->primes[b - 1];
+            xp = x / p;
+
+            /*
+                leaves with low <= x/(p m) < high, y/p < m <= y, lpf(m) > p,
+                taken with m decreasing so that x/(p m) increases and the
+                survivors can be counted with a moving position
+            */
+            mmax = FLINT_MIN(y, xp/low);
+            mmin = FLINT_MAX(y/p, xp/high);
+            mmin = FLINT_MAX(mmin, p);
+
+            pos = 0;        /* survivors below pos are counted in before */
+            before = 0;
+
+            /* once p^2 > y the only m left are the primes in (p, y] */
+            primes_only = (p > y/p);
+            if (primes_only)
+                k = kmin = (mmax > mmin) ? arg->pi[mmin] : 0;
+            if (primes_only && mmax > mmin)
+                k = arg->pi[mmax];
+
+            m = mmax + 1;
+
+            while (1)
+            {
+                if (primes_only)
+                {
+                    if (k == kmin)
+                        break;
+                    m = arg->primes[--k];
+                }
+                else
+                {
+                    if (--m <= mmin)
+                        break;
+                    if (arg->mu[m] == 0 || arg->lpf[m] <= p)
+                        continue;
+                }
+
+                v = xp/m - low;
+
+                while (pos + PRIME_PI_LMO_COUNTER <= v)
+                {
+                    before += counter[pos/PRIME_PI_LMO_COUNTER];
+                    pos += PRIME_PI_LMO_COUNTER;
+                }
+
+                phi = phi_run[b] + before;
+                for (j = pos/FLINT_BITS; j < v/FLINT_BITS; j++)
+                    phi += mpn_popcount(sieve + j, 1);
+                word = sieve[j] & ((UWORD(2) << (v % FLINT_BITS)) - 1);
+                phi += mpn_popcount(&word, 1);
+
+                if (arg->mu[m] > 0)
+                    sub_ddmmss(s2hi, s2lo, s2hi, s2lo, 0, phi);
+                else
+                    add_ssaaaa(s2hi, s2lo, s2hi, s2lo, 0, phi);
+
+                musum[b] -= arg->mu[m];
+            }
+
+            /* survivors at level b - 1 in this segment */
+            phi_run[b] += total;
+            count[b] += total;
+
+            /* remove the multiples of p */
+            for (j = next[b]; j < high; j += p)
+            {
+                ulong k = j - low, bit = UWORD(1) << (k % FLINT_BITS);
+
+                if (sieve[k/FLINT_BITS] & bit)
+                {
+                    sieve[k/FLINT_BITS] &= ~bit;
+                    counter[k/PRIME_PI_LMO_COUNTER]--;
+                    total--;
+                }
+            }
+
+            next[b] = j;
+        }
+    }
+
+    arg->s2[0] = s2lo;
+    arg->s2[1] = s2hi;
+
+    flint_free(next);
+    flint_free(phi_run);
+    flint_free(sieve);
+    flint_free(counter);
+}
+
+static void
+_prime_pi_lmo_worker(void * varg)
+{
+    _prime_pi_lmo_chunk((_prime_pi_lmo_arg_t *) varg);
+}
+
+/* pi(t) for increasing t >= sqrt(x), sieving ahead in blocks */
+typedef struct
+{
+    ulong lo, hi;       /* primes of [lo, hi) are listed */
+    ulong end;          /* queries are below end */
+    ulong * list;
+    slong num, idx;
+    ulong base;         /* pi(lo - 1) */
+}
+_prime_pi_cursor_t;
+
+static ulong
+_prime_pi_cursor_query(_prime_pi_cursor_t * cur, ulong t)
+{
+    if (t < cur->lo)
+        return cur->base;
+
+    if (t >= cur->hi)
+    {
+        ulong lo = (t < cur->hi + PRIME_PI_LMO_BLOCK) ? cur->hi : t;
+
+        cur->base += cur->num;
+        if (lo > cur->hi)
+            cur->base += n_primes_range_count(cur->hi, lo);
+
+        flint_free(cur->list);
+        cur->lo = lo;
+        cur->hi = FLINT_MIN(lo + PRIME_PI_LMO_BLOCK, cur->end);
+        cur->list = n_primes_range(&cur->num, cur->lo, cur->hi);
+        cur->idx = 0;
+    }
+
+    while (cur->idx < cur->num && cur->list[cur->idx] <= t)
+        cur->idx++;
+
+    return cur->base + cur->idx;
+}
+
+ulong
+n_prime_pi_lmo(ulong x)
+{
+    _prime_pi_lmo_arg_t * args;
+    thread_pool_handle * threads;
+    _prime_pi_cursor_t cur[1];
+    signed char * mu;
+    unsigned int * lpf, * pi;
+    ulong * primes, * count, * run, * pblock;
+    slong * musum;
+    ulong y, z, sq, cb, alpha, p, j, b, phi, plo;
+    ulong hi = 0, lo = 0;
+    slong a, i, c, num_threads, num_chunks, num_pblock;
+
+    if (x < 2)
+        return 0;
+
+    sq = n_sqrt(x);
+    cb = n_cbrt(x);
+
+    if (sq <= 7)
+        return n_primes_range_count(0, x + 1);
+
+    /*
+        Larger y shifts work from the sieve of [1, x/y] to the leaves
+        m <= y; y = alpha x^(1/3) with alpha growing like log(x) roughly
+        balances them
+    */
+    alpha = FLINT_BIT_COUNT(x);
+    alpha = (alpha >= 20) ? (alpha - 10)/10 : 1;
+    y = FLINT_MIN(alpha*(cb + 1), sq);
+    z = x / y;
+
+    primes = n_primes_range(&a, 0, y + 1);
+
+    /* Moebius function and least prime factor up to y */
+    mu = flint_malloc(y + 1);
+    lpf = flint_calloc(y + 1, sizeof(unsigned int));
+    memset(mu, 1, y + 1);
+
+    for (i = 0; i < a; i++)
+    {
+        p = primes[i];
+
+        for (j = p; j <= y; j += p)
+        {
+            if (lpf[j] == 0)
+                lpf[j] = p;
+            mu[j] = -mu[j];
+        }
+
+        if (p <= y / p)
+        {
+            for (j = p*p; j <= y; j += p*p)
+                mu[j] = 0;
+        }
+    }
+
+    lpf[1] = UINT_MAX;
+
+    pi = flint_malloc((y + 1)*sizeof(unsigned int));
+    for (j = 0, i = 0; j <= y; j++)
+    {
+        if (i < a && primes[i] == j)
+            i++;
+        pi[j] = i;
+    }
+
+    /* ordinary leaves */
+    for (j = 1; j <= y; j++)
+    {
+        if (mu[j] > 0)
+            add_ssaaaa(hi, lo, hi, lo, 0, x/j);
+        else if (mu[j] < 0)
+            sub_ddmmss(hi, lo, hi, lo, 0, x/j);
+    }
+
+    /*
+        special leaves, in rounds of one chunk per thread so that only
+        num_threads chunks of per level counts are held at a time
+    */
+    num_threads = flint_request_threads(&threads,
+                     FLINT_MIN(flint_get_num_threads(), z/(1 << 20) + 1)) + 1;
+    num_chunks = num_threads*PRIME_PI_LMO_CHUNKS_PER_THREAD;
+
+    count = flint_malloc(num_threads*(a + 1)*sizeof(ulong));
+    musum = flint_malloc(num_threads*(a + 1)*sizeof(slong));
+    run = flint_calloc(a + 1, sizeof(ulong));
+    args = flint_malloc(num_threads*sizeof(_prime_pi_lmo_arg_t));
+
+    for (i = 0; i < num_threads; i++)
+    {
+        args[i].x = x;
+        args[i].y = y;
+        args[i].z = z;
+        args[i].primes = primes;
+        args[i].a = a;
+        args[i].mu = mu;
+        args[i].lpf = lpf;
+        args[i].pi = pi;
+        args[i].num_chunks = num_chunks;
+        args[i].count = count + i*(a + 1);
+        args[i].musum = musum + i*(a + 1);
+    }
+
+    for (c = 0; c < num_chunks; c += num_threads)
+    {
+        for (i = 0; i < num_threads; i++)
+            args[i].chunk = c + i;
+
+        for (i = 1; i < num_threads; i++)
+            thread_pool_wake(global_thread_pool, threads[i - 1], 0,
+                                             _prime_pi_lmo_worker, args + i);
+
+        _prime_pi_lmo_worker(args + 0);
+
+        for (i = 1; i < num_threads; i++)
+            thread_pool_wait(global_thread_pool, threads[i - 1]);
+
+        /* leaves in each chunk still need the survivors of earlier chunks */
+        for (i = 0; i < num_threads; i++)
+        {
+            add_ssaaaa(hi, lo, hi, lo, args[i].s2[1], args[i].s2[0]);
+
+            for (j = 1; j <= (ulong) a; j++)
+            {
+                _acc_addmul(hi, lo, args[i].musum[j], run[j]);
+                run[j] += args[i].count[j];
+            }
+        }
+    }
+
+    flint_give_back_threads(threads, num_threads - 1);
+
+    flint_free(args);
+    flint_free(run);
+    flint_free(musum);
+    flint_free(count);
+    flint_free(pi);
+    flint_free(lpf);
+    flint_free(mu);
+    flint_free(primes);
+
+    /* pi(x) = phi(x, a) + a - 1 - P2(x, a) */
+    _acc_add(hi, lo, a - 1);
+
+    /* P2 = sum_{y < p_k <= sqrt(x)} (pi(x/p_k) - (k - 1)) */
+    b = n_primes_range_count(0, sq + 1);
+    if (b > (ulong) a)
+    {
+        phi = (b*(b - 1))/2 - (a*(a - 1))/2;
+        add_ssaaaa(hi, lo, hi, lo, 0, phi);
+    }
+
+    cur->lo = cur->hi = sq + 1;
+    cur->end = x/(y + 1) + 1;
+    cur->list = NULL;
+    cur->num = cur->idx = 0;
+    cur->base = b;
+
+    for (p = sq + 1; p > y + 1; p = plo)
+    {
+        plo = (p - (y + 1) > (1 << 20)) ? p - (1 << 20) : y + 1;
+        pblock = n_primes_range(&num_pblock, plo, p);
+
+        for (i = num_pblock - 1; i >= 0; i--)
+        {
+            phi = _prime_pi_cursor_query(cur, x / pblock[i]);
+            sub_ddmmss(hi, lo, hi, lo, 0, phi);
+        }
+
+        flint_free(pblock);
+    }
+
+    flint_free(cur->list);
+
+    return lo;
+}
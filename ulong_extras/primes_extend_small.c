@@ -30,10 +30,21 @@ n_primes_extend_small(n_primes_t iter, mp_limb_t bound)
             iter->small_primes = flint_realloc(iter->small_primes,
                 num * sizeof(unsigned int));
 
-        n_primes_init(iter2);
-        for (i = 0; i < num; i++)
-            iter->small_primes[i] = n_primes_next(iter2);
-        n_primes_clear(iter2);
+        /* copy from the shared table if it is large enough */
+        if (FLINT_CLOG2(num) < _flint_primes_used_get())
+        {
+            const ulong * primes = _flint_primes[FLINT_CLOG2(num)];
+
+            for (i = 0; i < num; i++)
+                iter->small_primes[i] = primes[i];
+        }
+        else
+        {
+            n_primes_init(iter2);
+            for (i = 0; i < num; i++)
+                iter->small_primes[i] = n_primes_next(iter2);
+            n_primes_clear(iter2);
+        }
 
         iter->small_num = num;
         iter->small_i = num;
@@ -0,0 +1,593 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "thread_pool.h"
+#include "thread_support.h"
+
+/*
+    Segmented sieve of Eratosthenes with a mod 30 wheel: bit k of byte i
+    stands for 30 i + r_k with r_k the k-th residue coprime to 30, so that a
+    byte holds the candidates among 30 consecutive integers. For a sieving
+    prime p the multiples p q with q = r_k mod 30 all have their bit in the
+    same position, at bytes p apart, so each prime is crossed off by eight
+    strided loops over a segment small enough to stay in the L1 cache.
+
+    The sieving primes are found by the same sieve into temporary arrays.
+    Primes up to a limit of at most PRIMES_RANGE_LARGE, and at most about
+    the length of the range, are kept for the whole range together with
+    their next multiple in each residue class. Larger primes are generated
+    a block at a time for each window of PRIMES_RANGE_WINDOW bytes and
+    nothing is kept for them, so the memory used does not grow with b.
+    When this would cost more than testing the candidates which are left,
+    as for short ranges near 2^64, these are tested with n_is_prime.
+*/
+
+#define PRIMES_RANGE_SEGMENT 32768          /* bytes sieved at a time */
+#define PRIMES_RANGE_WINDOW (1 << 20)       /* bytes sieved by large primes */
+#define PRIMES_RANGE_LARGE (30*PRIMES_RANGE_SEGMENT)
+#define PRIMES_RANGE_MIN_CHUNK (1 << 18)    /* bytes sieved by each thread */
+#define PRIMES_RANGE_TEST_RATIO 32         /* test if 32 30 len < sqrt(b) */
+#define PRIMES_RANGE_FOREACH_CHUNK (1 << 19) /* bytes per worker and round */
+
+static const unsigned char _wheel_res[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+
+static const signed char _wheel_bit[30] = {
+   -1, 0, -1, -1, -1, -1, -1, 1, -1, -1, -1, 2, -1, 3, -1,
+   -1, -1, 4, -1, 5, -1, -1, -1, 6, -1, -1, -1, -1, -1, 7 };
+
+typedef struct
+{
+    ulong a, b;                 /* range [a, b) */
+    ulong lo, hi;               /* bytes [lo, hi) sieved by this worker */
+    const ulong * base;         /* sieving primes 7 <= p <= lim */
+    slong num_base;
+    ulong lim;
+    ulong * primes;             /* primes found, or NULL to count only */
+    slong num, alloc;
+}
+_primes_range_arg_t;
+
+/*
+    Clear the bits of byte i standing for integers outside [a, b). Bytes
+    sieved satisfy 30 i < b, so 30 i does not overflow.
+*/
+static unsigned char
+_primes_range_mask(ulong i, ulong a, ulong b)
+{
+    unsigned char mask = 0xff;
+    ulong k, n = 30*i;
+
+    for (k = 0; k < 8; k++)
+    {
+        if ((n < a && _wheel_res[k] < a - n) || _wheel_res[k] >= b - n)
+            mask &= ~(1 << k);
+    }
+
+    return mask;
+}
+
+/* cross off the multiples p q >= p^2 of p from bytes [lo, hi) */
+static void
+_primes_range_cross(unsigned char * seg, ulong lo, ulong hi, ulong p)
+{
+    ulong q, t, j;
+    slong r;
+
+    q = (30*lo) / p + ((30*lo) % p != 0);
+    q = FLINT_MAX(p, q);
+
+    for (r = 0; r < 8; r++)
+    {
+        unsigned char mask = ~(1 << _wheel_bit[(p*_wheel_res[r]) % 30]);
+
+        t = (q + 29 - _wheel_res[r]) / 30; /* q_r = 30 t + r_r >= q */
+
+        for (j = p*t + (p*_wheel_res[r]) / 30; j < hi; j += p)
+            seg[j - lo] &= mask;
+    }
+}
+
+/* clear the bits of the composites left in bytes [lo, lo + len) */
+static void
+_primes_range_test(unsigned char * seg, ulong lo, ulong len)
+{
+    ulong i, t, bits;
+
+    for (i = 0; i < len; i++)
+    {
+        bits = seg[i];
+
+        while (bits != 0)
+        {
+            count_trailing_zeros(t, bits);
+
+            if (!n_is_prime(30*(lo + i) + _wheel_res[t]))
+                seg[i] &= ~(1 << t);
+
+            bits &= bits - 1;
+        }
+    }
+}
+
+/*
+    Cross off the base primes from seg, which starts at byte lo, up to byte
+    hi, where next[8 k + r] is the byte of the next multiple p q of the
+    k-th prime with q = r_r mod 30
+*/
+static void
+_primes_range_sieve_small(unsigned char * seg, ulong lo, ulong hi,
+                          const ulong * base, slong num_base, ulong * next)
+{
+    ulong p, j;
+    slong k, r;
+
+    for (k = 0; k < num_base; k++)
+    {
+        p = base[k];
+
+        for (r = 0; r < 8; r++)
+        {
+            unsigned char mask = ~(1 << _wheel_bit[(p*_wheel_res[r]) % 30]);
+
+            for (j = next[8*k + r]; j < hi; j += p)
+                seg[j - lo] &= mask;
+
+            next[8*k + r] = j;
+        }
+    }
+}
+
+static void _primes_range_worker(void * varg);
+
+/*
+    Cross off the primes in (lim, sq] from bytes [lo, hi), where the base
+    primes up to lim include those up to sqrt(sq)
+*/
+static void
+_primes_range_sieve_large(unsigned char * seg, ulong lo, ulong hi, ulong sq,
+                              const ulong * base, slong num_base, ulong lim)
+{
+    _primes_range_arg_t arg;
+    ulong x, y;
+    slong i;
+
+    arg.base = base;
+    arg.num_base = num_base;
+    arg.lim = lim;
+    arg.primes = NULL;
+    arg.alloc = 0;
+
+    for (x = lim + 1; x <= sq; x = y)
+    {
+        y = FLINT_MIN(x + 30*PRIMES_RANGE_WINDOW, sq + 1);
+
+        arg.a = x;
+        arg.b = y;
+        arg.lo = x / 30;
+        arg.hi = (y - 1) / 30 + 1;
+        arg.num = 0;
+
+        if (arg.primes == NULL)
+        {
+            arg.alloc = 30*PRIMES_RANGE_WINDOW / 16;
+            arg.primes = flint_malloc(arg.alloc*sizeof(ulong));
+        }
+
+        _primes_range_worker(&arg);
+
+        for (i = 0; i < arg.num; i++)
+            _primes_range_cross(seg, lo, hi, arg.primes[i]);
+    }
+
+    flint_free(arg.primes);
+}
+
+static void
+_primes_range_worker(void * varg)
+{
+    _primes_range_arg_t * arg = (_primes_range_arg_t *) varg;
+    unsigned char * seg;
+    ulong * next;
+    ulong lo, hi, slo, shi, len, window, i, p, q, t, bits, word, sq;
+    slong k, r, num_base;
+    int large;
+
+    /* only primes with p^2 < b are needed */
+    sq = n_sqrt(arg->b - 1);
+    for (num_base = 0; num_base < arg->num_base; num_base++)
+    {
+        if (arg->base[num_base] > sq)
+            break;
+    }
+
+    large = (sq > arg->lim);
+    window = large ? PRIMES_RANGE_WINDOW : PRIMES_RANGE_SEGMENT;
+    window = FLINT_MIN(window, arg->hi - arg->lo);
+
+    seg = flint_malloc(window);
+
+    next = flint_malloc((8*num_base + 1)*sizeof(ulong));
+
+    for (k = 0; k < num_base; k++)
+    {
+        p = arg->base[k];
+
+        /* first q >= p with p q in a byte >= lo */
+        q = (30*arg->lo) / p + ((30*arg->lo) % p != 0);
+        q = FLINT_MAX(p, q);
+
+        for (r = 0; r < 8; r++)
+        {
+            t = (q + 29 - _wheel_res[r]) / 30; /* q_r = 30 t + r_r >= q */
+            next[8*k + r] = p*t + (p*_wheel_res[r]) / 30;
+        }
+    }
+
+    for (lo = arg->lo; lo < arg->hi; lo += len)
+    {
+        len = FLINT_MIN(window, arg->hi - lo);
+        hi = lo + len;
+
+        memset(seg, 0xff, len);
+        if (lo == 0)
+            seg[0] &= 0xfe; /* 1 is not prime */
+
+        for (slo = lo; slo < hi; slo = shi)
+        {
+            shi = FLINT_MIN(slo + PRIMES_RANGE_SEGMENT, hi);
+
+            _primes_range_sieve_small(seg, lo, shi,
+                                                 arg->base, num_base, next);
+        }
+
+        /* the first and last bytes may extend outside [a, b) */
+        seg[0] &= _primes_range_mask(lo, arg->a, arg->b);
+        seg[len - 1] &= _primes_range_mask(hi - 1, arg->a, arg->b);
+
+        if (large && 30*len < sq / PRIMES_RANGE_TEST_RATIO)
+            _primes_range_test(seg, lo, len);
+        else if (large)
+            _primes_range_sieve_large(seg, lo, hi, sq,
+                                      arg->base, arg->num_base, arg->lim);
+
+        if (arg->primes == NULL)
+        {
+            for (i = 0; i + sizeof(ulong) <= len; i += sizeof(ulong))
+            {
+                memcpy(&word, seg + i, sizeof(ulong));
+                arg->num += mpn_popcount(&word, 1);
+            }
+
+            for ( ; i < len; i++)
+            {
+                word = seg[i];
+                arg->num += mpn_popcount(&word, 1);
+            }
+        } else
+        {
+            for (i = 0; i < len; i++)
+            {
+                bits = seg[i];
+
+                while (bits != 0)
+                {
+                    if (arg->num == arg->alloc)
+                    {
+                        arg->alloc = FLINT_MAX(2*arg->alloc, 64);
+                        arg->primes = flint_realloc(arg->primes,
+                                                 arg->alloc*sizeof(ulong));
+                    }
+
+                    count_trailing_zeros(t, bits);
+                    arg->primes[arg->num++] = 30*(lo + i) + _wheel_res[t];
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+    flint_free(next);
+    flint_free(seg);
+}
+
+/*
+    Set *base to an array of the primes 7 <= p <= n, for n at most
+    PRIMES_RANGE_LARGE, and return their number
+*/
+static slong
+_primes_range_base(ulong ** base, ulong n)
+{
+    _primes_range_arg_t arg;
+    ulong boot[168], p, s;
+    slong i, num = 0;
+
+    *base = NULL;
+
+    if (n < 7)
+        return 0;
+
+    /* the primes 7 <= p <= sqrt(n) by trial division */
+    s = n_sqrt(n);
+    for (p = 7; p <= s; p += 2)
+    {
+        for (i = 0; i < num && boot[i]*boot[i] <= p; i++)
+        {
+            if (p % boot[i] == 0)
+                break;
+        }
+
+        if ((i == num || boot[i]*boot[i] > p) && p % 3 != 0 && p % 5 != 0)
+            boot[num++] = p;
+    }
+
+    arg.a = 7;
+    arg.b = n + 1;
+    arg.lo = 0;
+    arg.hi = n / 30 + 1;
+    arg.base = boot;
+    arg.num_base = num;
+    arg.lim = s;
+    arg.num = 0;
+    arg.alloc = n / 8 + 64;
+    arg.primes = flint_malloc(arg.alloc*sizeof(ulong));
+
+    _primes_range_worker(&arg);
+
+    *base = arg.primes;
+
+    return arg.num;
+}
+
+/*
+    Sieve [a, b) with the thread pool, returning the number of primes and,
+    if primes is not NULL, setting *primes to an array of them
+*/
+static slong
+_n_primes_range(ulong ** primes, ulong a, ulong b)
+{
+    _primes_range_arg_t * args;
+    thread_pool_handle * threads;
+    ulong * base;
+    ulong lo, hi, blo, bhi, chunk, sq, lim;
+    slong i, j, num, num_threads, num_base, num_small = 0;
+    ulong small[3];
+
+    /* 2, 3 and 5 are not on the wheel */
+    for (i = 0; i < 3; i++)
+    {
+        ulong p = (i == 0) ? 2 : (i == 1) ? 3 : 5;
+        if (p >= a && p < b)
+            small[num_small++] = p;
+    }
+
+    if (b <= 7 || a >= b)
+    {
+        if (primes != NULL)
+        {
+            *primes = flint_malloc(FLINT_MAX(num_small, 1)*sizeof(ulong));
+            for (i = 0; i < num_small; i++)
+                (*primes)[i] = small[i];
+        }
+
+        return num_small;
+    }
+
+    lo = a / 30;
+    hi = (b - 1) / 30 + 1;
+
+    /*
+        sieving primes up to sqrt(b), of which those above lim are found by
+        the workers; a short range is not worth more base primes than its
+        length, but those up to sqrt(sqrt(b)) are needed to find the others
+    */
+    sq = n_sqrt(b - 1);
+    lim = FLINT_MIN(sq, PRIMES_RANGE_LARGE);
+    lim = FLINT_MIN(lim, FLINT_MAX(b - a, n_sqrt(sq) + 1));
+    num_base = _primes_range_base(&base, lim);
+
+    num_threads = (hi - lo) / PRIMES_RANGE_MIN_CHUNK;
+    num_threads = FLINT_MIN(num_threads, flint_get_num_threads());
+    num_threads = FLINT_MAX(num_threads, 1);
+    num_threads = flint_request_threads(&threads, num_threads) + 1;
+
+    args = flint_malloc(num_threads*sizeof(_primes_range_arg_t));
+    chunk = (hi - lo + num_threads - 1) / num_threads;
+
+    for (i = 0; i < num_threads; i++)
+    {
+        blo = FLINT_MIN(lo + i*chunk, hi);
+        bhi = FLINT_MIN(blo + chunk, hi);
+
+        args[i].a = a;
+        args[i].b = b;
+        args[i].lo = blo;
+        args[i].hi = bhi;
+        args[i].base = base;
+        args[i].num_base = num_base;
+        args[i].lim = lim;
+        args[i].primes = NULL;
+        args[i].num = 0;
+        args[i].alloc = 0;
+
+        if (primes != NULL)
+        {
+            /* a little more than the expected number of primes */
+            args[i].alloc = FLINT_MAX(64, 30*(bhi - blo) /
+                                         (FLINT_BIT_COUNT(bhi) + 3) + 64);
+            args[i].primes = flint_malloc(args[i].alloc*sizeof(ulong));
+        }
+    }
+
+    for (i = 1; i < num_threads; i++)
+    {
+        if (args[i].lo < args[i].hi)
+            thread_pool_wake(global_thread_pool, threads[i - 1], 0,
+                                                 _primes_range_worker, args + i);
+    }
+
+    if (args[0].lo < args[0].hi)
+        _primes_range_worker(args + 0);
+
+    for (i = 1; i < num_threads; i++)
+    {
+        if (args[i].lo < args[i].hi)
+            thread_pool_wait(global_thread_pool, threads[i - 1]);
+    }
+
+    flint_give_back_threads(threads, num_threads - 1);
+
+    num = num_small;
+    for (i = 0; i < num_threads; i++)
+        num += args[i].num;
+
+    if (primes != NULL)
+    {
+        *primes = flint_malloc(FLINT_MAX(num, 1)*sizeof(ulong));
+
+        for (j = 0; j < num_small; j++)
+            (*primes)[j] = small[j];
+
+        for (i = 0; i < num_threads; i++)
+        {
+            memcpy(*primes + j, args[i].primes, args[i].num*sizeof(ulong));
+            j += args[i].num;
+            flint_free(args[i].primes);
+        }
+    }
+
+    flint_free(args);
+    flint_free(base);
+
+    return num;
+}
+
+ulong *
+n_primes_range(slong * num, ulong a, ulong b)
+{
+    ulong * primes;
+
+    *num = _n_primes_range(&primes, a, b);
+
+    return primes;
+}
+
+ulong
+n_primes_range_count(ulong a, ulong b)
+{
+    return _n_primes_range(NULL, a, b);
+}
+
+/*
+    Pass the primes in [a, b) to func in increasing order, a block at a time.
+    In each round every worker sieves the next PRIMES_RANGE_FOREACH_CHUNK
+    bytes, then func is called on their primes in order, so that the memory
+    used does not grow with b - a.
+*/
+int
+n_primes_range_foreach(ulong a, ulong b, n_primes_range_func func, void * arg)
+{
+    _primes_range_arg_t * args;
+    thread_pool_handle * threads;
+    ulong * base;
+    ulong lo, hi, sq, lim, chunk;
+    slong i, num_threads, num_base, num_small = 0;
+    ulong small[3];
+    int stop = 0;
+
+    /* 2, 3 and 5 are not on the wheel */
+    for (i = 0; i < 3; i++)
+    {
+        ulong p = (i == 0) ? 2 : (i == 1) ? 3 : 5;
+        if (p >= a && p < b)
+            small[num_small++] = p;
+    }
+
+    if (num_small != 0 && func(small, num_small, arg))
+        return 1;
+
+    if (b <= 7 || a >= b)
+        return 0;
+
+    lo = a / 30;
+    hi = (b - 1) / 30 + 1;
+
+    /* sieving primes as in _n_primes_range */
+    sq = n_sqrt(b - 1);
+    lim = FLINT_MIN(sq, PRIMES_RANGE_LARGE);
+    lim = FLINT_MIN(lim, FLINT_MAX(b - a, n_sqrt(sq) + 1));
+    num_base = _primes_range_base(&base, lim);
+
+    chunk = PRIMES_RANGE_FOREACH_CHUNK;
+    num_threads = (hi - lo + chunk - 1) / chunk;
+    num_threads = FLINT_MIN(num_threads, flint_get_num_threads());
+    num_threads = FLINT_MAX(num_threads, 1);
+    num_threads = flint_request_threads(&threads, num_threads) + 1;
+
+    args = flint_malloc(num_threads*sizeof(_primes_range_arg_t));
+
+    for (i = 0; i < num_threads; i++)
+    {
+        args[i].a = a;
+        args[i].b = b;
+        args[i].base = base;
+        args[i].num_base = num_base;
+        args[i].lim = lim;
+        args[i].alloc = 30*chunk / (FLINT_BIT_COUNT(b) + 3) + 64;
+        args[i].primes = flint_malloc(args[i].alloc*sizeof(ulong));
+    }
+
+    while (lo < hi && !stop)
+    {
+        for (i = 0; i < num_threads; i++)
+        {
+            args[i].lo = FLINT_MIN(lo + i*chunk, hi);
+            args[i].hi = FLINT_MIN(args[i].lo + chunk, hi);
+            args[i].num = 0;
+        }
+
+        lo = args[num_threads - 1].hi;
+
+        for (i = 1; i < num_threads; i++)
+        {
+            if (args[i].lo < args[i].hi)
+                thread_pool_wake(global_thread_pool, threads[i - 1], 0,
+                                             _primes_range_worker, args + i);
+        }
+
+        _primes_range_worker(args + 0);
+
+        for (i = 1; i < num_threads; i++)
+        {
+            if (args[i].lo < args[i].hi)
+                thread_pool_wait(global_thread_pool, threads[i - 1]);
+        }
+
+        for (i = 0; i < num_threads && !stop; i++)
+        {
+            if (args[i].num != 0)
+                stop = func(args[i].primes, args[i].num, arg);
+        }
+    }
+
+    flint_give_back_threads(threads, num_threads - 1);
+
+    for (i = 0; i < num_threads; i++)
+        flint_free(args[i].primes);
+
+    flint_free(args);
+    flint_free(base);
+
+    return stop;
+}
@@ -0,0 +1,114 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+   slong i, j, len;
+   ulong * v, * res;
+
+   FLINT_TEST_INIT(state);
+
+   flint_printf("is_prime_vec....");
+   fflush(stdout);
+
+   /* Compare with n_is_prime on mixtures of primes and composites */
+   for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+   {
+      len = n_randint(state, 300);
+
+      v = flint_malloc((len + 1)*sizeof(ulong));
+      res = flint_malloc(((len + FLINT_BITS - 1)/FLINT_BITS + 1)*sizeof(ulong));
+
+      for (j = 0; j < len; j++)
+      {
+         switch (n_randint(state, 4))
+         {
+            case 0:
+               v[j] = n_randtest(state);
+               break;
+            case 1:
+               v[j] = n_randtest_prime(state, 0);
+               break;
+            case 2: /* product of two primes, possibly a pseudoprime */
+               v[j] = n_randprime(state, n_randint(state, FLINT_BITS/2 - 1) + 2, 0);
+               v[j] *= n_randprime(state, n_randint(state, FLINT_BITS/2 - 1) + 2, 0);
+               break;
+            default:
+               v[j] = n_randbits(state, n_randint(state, FLINT_BITS) + 1) | 1;
+         }
+      }
+
+      /* the bits beyond len must be cleared */
+      res[(len + FLINT_BITS - 1)/FLINT_BITS] = UWORD(0);
+      if (len % FLINT_BITS != 0)
+         res[len / FLINT_BITS] = ~UWORD(0);
+
+      n_is_prime_vec(res, v, len);
+
+      for (j = 0; j < len; j++)
+      {
+         if (((res[j / FLINT_BITS] >> (j % FLINT_BITS)) & 1) != n_is_prime(v[j]))
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("v[%wd] = %wu, %d, %d\n", j, v[j],
+                (int) ((res[j / FLINT_BITS] >> (j % FLINT_BITS)) & 1), n_is_prime(v[j]));
+            abort();
+         }
+      }
+
+      if (len % FLINT_BITS != 0 && (res[len / FLINT_BITS] >> (len % FLINT_BITS)) != 0)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("bits beyond len set, len = %wd\n", len);
+         abort();
+      }
+
+      flint_free(v);
+      flint_free(res);
+   }
+
+#if FLINT64
+   /* Strong pseudoprimes to base 2 and Fermat pseudoprimes */
+   {
+      ulong psp[] = {
+         UWORD(3215031751), UWORD(2152302898747), UWORD(3474749660383),
+         UWORD(341550071728321), UWORD(3825123056546413051),
+         UWORD(4294967297), UWORD(1093266739), UWORD(18446744073709551557),
+         UWORD(1194649), UWORD(12327121)
+      };
+      ulong r[1];
+
+      len = sizeof(psp) / sizeof(ulong);
+      n_is_prime_vec(r, psp, len);
+
+      for (j = 0; j < len; j++)
+      {
+         if (((r[0] >> j) & 1) != n_is_prime(psp[j]))
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("psp[%wd] = %wu\n", j, psp[j]);
+            abort();
+         }
+      }
+   }
+#endif
+
+   FLINT_TEST_CLEANUP(state);
+   
+   flint_printf("PASS\n");
+   return 0;
+}
@@ -0,0 +1,92 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    slong i;
+    ulong n, x, p, count;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("prime_pi_lmo....");
+    fflush(stdout);
+
+    /* compare with the sieve */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        if (n_randint(state, 2))
+            x = n_randint(state, 100000);
+        else
+            x = n_randint(state, UWORD(1) << (n_randint(state, 29) + 1));
+
+        count = n_primes_range_count(0, x + 1);
+
+        if (n_prime_pi_lmo(x) != count)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("x = %wu, %wu, %wu\n", x, n_prime_pi_lmo(x), count);
+            abort();
+        }
+    }
+
+    /* count primes up to powers of 10 */
+    {
+        const ulong primepi[] = {
+            0, 4, 25, 168, 1229, 9592, 78498, 664579, 5761455, 50847534,
+#if FLINT64
+            UWORD(455052511), UWORD(4118054813), UWORD(37607912018)
+#endif
+        };
+
+        for (i = 0, x = 1; i < sizeof(primepi) / sizeof(ulong); i++, x *= 10)
+        {
+            flint_set_num_threads(n_randint(state, 5) + 1);
+
+            count = n_prime_pi_lmo(x);
+
+            if (count != primepi[i])
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("pi(%wu) = %wu\n", x, count);
+                abort();
+            }
+        }
+    }
+
+    /* large n_nth_prime and n_prime_pi */
+    for (i = 0; i < 5 * flint_test_multiplier(); i++)
+    {
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        n = n_randint(state, UWORD(1) << 26) + 1;
+        p = n_nth_prime(n);
+
+        if (!n_is_prime(p) || n_prime_pi(p) != n || n_prime_pi(p - 1) != n - 1)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("n = %wu, p = %wu\n", n, p);
+            abort();
+        }
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}
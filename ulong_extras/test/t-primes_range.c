@@ -0,0 +1,238 @@
+/*
+    Copyright (C) 2021 Brent Baccala
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    ulong * primes;
+    slong num;
+    slong alloc;
+    slong stop;
+} collect_struct;
+
+/* append the block to arg, stopping once arg->stop > 0 primes are found */
+static int
+collect(const ulong * primes, slong num, void * varg)
+{
+    collect_struct * arg = (collect_struct *) varg;
+    slong j;
+
+    for (j = 0; j < num; j++)
+    {
+        if (arg->num == arg->alloc)
+        {
+            arg->alloc = FLINT_MAX(2*arg->alloc, 64);
+            arg->primes = flint_realloc(arg->primes, arg->alloc*sizeof(ulong));
+        }
+
+        arg->primes[arg->num++] = primes[j];
+    }
+
+    return arg->stop > 0 && arg->num >= arg->stop;
+}
+
+int main(void)
+{
+    slong i, j, num;
+    ulong a, b, p, count;
+    ulong * primes;
+    n_primes_t iter;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("primes_range....");
+    fflush(stdout);
+
+    /* compare with the prime iterator */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        switch (n_randint(state, 4))
+        {
+            case 0:
+                a = n_randint(state, 1000);
+                b = a + n_randint(state, 1000);
+                break;
+            case 1:
+                a = n_randint(state, UWORD(1) << 24);
+                b = a + n_randint(state, UWORD(1) << 20);
+                break;
+            case 2:
+                /* sieving primes beyond the ones kept by the workers */
+                a = (UWORD(1) << (FLINT_BITS - 24)) +
+                                n_randint(state, UWORD(1) << (FLINT_BITS - 24));
+                b = a + n_randint(state, UWORD(1) << 16);
+                break;
+            default:
+                a = n_randtest(state) >> (FLINT_BITS / 4);
+                b = a + n_randint(state, UWORD(1) << 16);
+        }
+
+        primes = n_primes_range(&num, a, b);
+        count = n_primes_range_count(a, b);
+
+        n_primes_init(iter);
+        if (a > 0)
+            n_primes_jump_after(iter, a - 1);
+
+        for (j = 0; ; j++)
+        {
+            p = n_primes_next(iter);
+
+            if (p >= b)
+                break;
+
+            if (j >= num || primes[j] != p)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("a = %wu, b = %wu, j = %wd, p = %wu\n", a, b, j, p);
+                abort();
+            }
+        }
+
+        n_primes_clear(iter);
+
+        if (j != num || count != num)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("a = %wu, b = %wu, %wd, %wd, %wu\n", a, b, j, num, count);
+            abort();
+        }
+
+        flint_free(primes);
+    }
+
+    /* ranges ending at UWORD_MAX, compared with n_is_prime */
+    for (i = 0; i < 2; i++)
+    {
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        b = UWORD_MAX;
+        a = b - n_randint(state, 20000);
+
+        primes = n_primes_range(&num, a, b);
+        count = n_primes_range_count(a, b);
+
+        for (j = 0, p = a; p < b; p++)
+        {
+            if (n_is_prime(p))
+            {
+                if (j >= num || primes[j] != p)
+                {
+                    flint_printf("FAIL:\n");
+                    flint_printf("a = %wu, b = %wu, j = %wd, p = %wu\n", a, b, j, p);
+                    abort();
+                }
+
+                j++;
+            }
+        }
+
+        if (j != num || count != num)
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("a = %wu, b = %wu, %wd, %wd, %wu\n", a, b, j, num, count);
+            abort();
+        }
+
+        flint_free(primes);
+    }
+
+    /* compare n_primes_range_foreach with n_primes_range */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        collect_struct C;
+        int stopped;
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        if (n_randint(state, 2))
+        {
+            a = n_randint(state, 1000);
+            b = a + n_randint(state, 1000);
+        }
+        else
+        {
+            /* several rounds of several workers */
+            a = n_randint(state, UWORD(1) << 30);
+            b = a + n_randint(state, UWORD(1) << 26);
+        }
+
+        primes = n_primes_range(&num, a, b);
+
+        C.primes = NULL;
+        C.num = C.alloc = 0;
+        C.stop = n_randint(state, 2) ? 0 : (slong) n_randint(state, num + 2);
+
+        stopped = n_primes_range_foreach(a, b, collect, &C);
+
+        if (C.stop > 0 && C.stop <= num)
+        {
+            /* stopped within a block, so at least C.stop primes were seen */
+            if (!stopped || C.num < C.stop)
+            {
+                flint_printf("FAIL (early stop):\n");
+                flint_printf("a = %wu, b = %wu, %wd, %wd\n", a, b, C.num, C.stop);
+                abort();
+            }
+        }
+        else if (stopped || C.num != num)
+        {
+            flint_printf("FAIL (count):\n");
+            flint_printf("a = %wu, b = %wu, %wd, %wd\n", a, b, C.num, num);
+            abort();
+        }
+
+        for (j = 0; j < C.num; j++)
+        {
+            if (j >= num || C.primes[j] != primes[j])
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("a = %wu, b = %wu, j = %wd\n", a, b, j);
+                abort();
+            }
+        }
+
+        flint_free(C.primes);
+        flint_free(primes);
+    }
+
+    /* count primes up to powers of 10 */
+    {
+        const ulong primepi[9] = {
+            0, 4, 25, 168, 1229, 9592, 78498, 664579, 5761455 };
+
+        for (i = 0, a = 1; i < 9; i++, a *= 10)
+        {
+            flint_set_num_threads(n_randint(state, 5) + 1);
+
+            count = n_primes_range_count(0, a + 1);
+
+            if (count != primepi[i])
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("pi(%wu) = %wu\n", a, count);
+                abort();
+            }
+        }
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    
+    flint_printf("PASS\n");
+    return 0;
+}